@@ -259,6 +259,110 @@ STATIC void fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, u
     formats[fb->format].fill_rect(fb, x, y, xend - x, yend - y, col);
 }
 
+// Copies a w by h block between framebufs of the same format. Rows and columns are walked in the
+// order that keeps copies within one buffer correct when the source and destination overlap.
+STATIC void copy_rect(const mp_obj_framebuf_t *dst, int x0, int y0, const mp_obj_framebuf_t *src, int x1, int y1, int w, int h) {
+    bool same = dst->buf == src->buf;
+    bool reverse_rows = same && y0 > y1;
+    bool reverse_cols = same && x0 > x1;
+    uint8_t *dst_buf = dst->buf;
+    const uint8_t *src_buf = src->buf;
+
+    switch (dst->format) {
+        case FRAMEBUF_RGB565:
+        case FRAMEBUF_GS8: {
+            // Whole rows are contiguous bytes.
+            int bpp = dst->format == FRAMEBUF_RGB565 ? 2 : 1;
+            for (int i = 0; i < h; i++) {
+                int row = reverse_rows ? h - 1 - i : i;
+                memmove(dst_buf + ((y0 + row) * dst->stride + x0) * bpp,
+                    src_buf + ((y1 + row) * src->stride + x1) * bpp, w * bpp);
+            }
+            return;
+        }
+        case FRAMEBUF_MVLSB: {
+            // Each byte is a column of 8 rows. Build every destination byte from the one or two source
+            // bytes that cover its rows and merge it in under a mask of the rows being copied.
+            int dy = y0 - y1;
+            int first_page = y0 >> 3;
+            int last_page = (y0 + h - 1) >> 3;
+            int src_pages = (src->height + 7) >> 3;
+            for (int i = 0; i <= last_page - first_page; i++) {
+                int page = reverse_rows ? last_page - i : first_page + i;
+                int top = MAX(page << 3, y0);
+                int bottom = MIN((page << 3) + 8, y0 + h);
+                uint8_t mask = ((1 << (bottom - top)) - 1) << (top & 7);
+                // The source row that lands on the first row of this page. It is never below -7.
+                int src_row = (page << 3) - dy + 8;
+                int src_page = src_row / 8 - 1;
+                int shift = src_row % 8;
+                for (int j = 0; j < w; j++) {
+                    int col = reverse_cols ? w - 1 - j : j;
+                    uint8_t lo = 0;
+                    uint8_t hi = 0;
+                    if (src_page >= 0) {
+                        lo = src_buf[src_page * src->stride + x1 + col];
+                    }
+                    if (shift != 0 && src_page + 1 < src_pages) {
+                        hi = src_buf[(src_page + 1) * src->stride + x1 + col];
+                    }
+                    uint8_t bits = shift == 0 ? lo : (lo >> shift) | (hi << (8 - shift));
+                    uint8_t *b = &dst_buf[page * dst->stride + x0 + col];
+                    *b = (*b & ~mask) | (bits & mask);
+                }
+            }
+            return;
+        }
+        case FRAMEBUF_MHLSB:
+        case FRAMEBUF_MHMSB:
+        case FRAMEBUF_GS2_HMSB:
+        case FRAMEBUF_GS4_HMSB: {
+            // Packed rows can be moved a byte at a time when both sides start at the same position
+            // within a byte. The partial bytes at either end are done a pixel at a time.
+            int bits = dst->format == FRAMEBUF_GS4_HMSB ? 4 : dst->format == FRAMEBUF_GS2_HMSB ? 2 : 1;
+            int ppb = 8 / bits;
+            if ((x0 - x1) % ppb != 0) {
+                break;
+            }
+            int lead = MIN(w, (ppb - (x0 % ppb)) % ppb);
+            int bytes = (w - lead) / ppb;
+            int trail = w - lead - bytes * ppb;
+            for (int i = 0; i < h; i++) {
+                int row = reverse_rows ? h - 1 - i : i;
+                // Read the partial pixels first because moving the bytes may overwrite them.
+                uint8_t lead_pixels[8];
+                uint8_t trail_pixels[8];
+                for (int k = 0; k < lead; k++) {
+                    lead_pixels[k] = getpixel(src, x1 + k, y1 + row);
+                }
+                for (int k = 0; k < trail; k++) {
+                    trail_pixels[k] = getpixel(src, x1 + w - trail + k, y1 + row);
+                }
+                memmove(dst_buf + ((y0 + row) * dst->stride + x0 + lead) / ppb,
+                    src_buf + ((y1 + row) * src->stride + x1 + lead) / ppb, bytes);
+                for (int k = 0; k < lead; k++) {
+                    setpixel(dst, x0 + k, y0 + row, lead_pixels[k]);
+                }
+                for (int k = 0; k < trail; k++) {
+                    setpixel(dst, x0 + w - trail + k, y0 + row, trail_pixels[k]);
+                }
+            }
+            return;
+        }
+    }
+
+    // Fall back to copying pixel by pixel.
+    getpixel_t get = formats[src->format].getpixel;
+    setpixel_t set = formats[dst->format].setpixel;
+    for (int i = 0; i < h; i++) {
+        int row = reverse_rows ? h - 1 - i : i;
+        for (int j = 0; j < w; j++) {
+            int col = reverse_cols ? w - 1 - j : j;
+            set(dst, x0 + col, y0 + row, get(src, x1 + col, y1 + row));
+        }
+    }
+}
+
 STATIC mp_obj_t framebuf_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     mp_arg_check_num(n_args, kw_args, 4, 5, false);
 
@@ -429,34 +533,47 @@ STATIC mp_obj_t framebuf_line(size_t n_args, const mp_obj_t *args) {
         sy = -1;
     }
 
-    bool steep;
-    if (dy > dx) {
-        mp_int_t temp;
-        temp = x1; x1 = y1; y1 = temp;
-        temp = dx; dx = dy; dy = temp;
-        temp = sx; sx = sy; sy = temp;
-        steep = true;
-    } else {
-        steep = false;
+    if (dx == 0 || dy == 0) {
+        // Horizontal and vertical lines are rectangles.
+        fill_rect(self, MIN(x1, x2), MIN(y1, y2), dx + 1, dy + 1, col);
+        return mp_const_none;
     }
 
-    mp_int_t e = 2 * dy - dx;
-    for (mp_int_t i = 0; i < dx; ++i) {
-        if (steep) {
-            if (0 <= y1 && y1 < self->width && 0 <= x1 && x1 < self->height) {
-                setpixel(self, y1, x1, col);
-            }
-        } else {
-            if (0 <= x1 && x1 < self->width && 0 <= y1 && y1 < self->height) {
-                setpixel(self, x1, y1, col);
+    // Step along the major axis and occasionally along the minor one. 8 and 16 bit formats also
+    // step through the buffer so they can store pixels directly.
+    bool steep = dy > dx;
+    mp_int_t major = steep ? dy : dx;
+    mp_int_t minor = steep ? dx : dy;
+    mp_int_t major_x = steep ? 0 : sx;
+    mp_int_t major_y = steep ? sy : 0;
+    mp_int_t minor_x = steep ? sx : 0;
+    mp_int_t minor_y = steep ? 0 : sy;
+    mp_int_t major_offset = major_x + major_y * self->stride;
+    mp_int_t minor_offset = minor_x + minor_y * self->stride;
+    mp_int_t offset = x1 + y1 * self->stride;
+    setpixel_t set = formats[self->format].setpixel;
+
+    mp_int_t e = 2 * minor - major;
+    for (mp_int_t i = 0; i < major; ++i) {
+        if (0 <= x1 && x1 < self->width && 0 <= y1 && y1 < self->height) {
+            if (self->format == FRAMEBUF_RGB565) {
+                ((uint16_t*)self->buf)[offset] = col;
+            } else if (self->format == FRAMEBUF_GS8) {
+                ((uint8_t*)self->buf)[offset] = col;
+            } else {
+                set(self, x1, y1, col);
             }
         }
         while (e >= 0) {
-            y1 += sy;
-            e -= 2 * dx;
+            x1 += minor_x;
+            y1 += minor_y;
+            offset += minor_offset;
+            e -= 2 * major;
         }
-        x1 += sx;
-        e += 2 * dy;
+        x1 += major_x;
+        y1 += major_y;
+        offset += major_offset;
+        e += 2 * minor;
     }
 
     if (0 <= x2 && x2 < self->width && 0 <= y2 && y2 < self->height) {
@@ -476,6 +593,10 @@ STATIC mp_obj_t framebuf_blit(size_t n_args, const mp_obj_t *args) {
     if (n_args > 4) {
         key = mp_obj_get_int(args[4]);
     }
+    mp_obj_framebuf_t *palette = NULL;
+    if (n_args > 5 && args[5] != mp_const_none) {
+        palette = MP_OBJ_TO_PTR(args[5]);
+    }
 
     if (
         (x >= self->width) ||
@@ -495,12 +616,23 @@ STATIC mp_obj_t framebuf_blit(size_t n_args, const mp_obj_t *args) {
     int x0end = MIN(self->width, x + source->width);
     int y0end = MIN(self->height, y + source->height);
 
+    if (palette == NULL && key == -1 && source->format == self->format) {
+        copy_rect(self, x0, y0, source, x1, y1, x0end - x0, y0end - y0);
+        return mp_const_none;
+    }
+
+    getpixel_t get = formats[source->format].getpixel;
+    setpixel_t set = formats[self->format].setpixel;
     for (; y0 < y0end; ++y0) {
         int cx1 = x1;
         for (int cx0 = x0; cx0 < x0end; ++cx0) {
-            uint32_t col = getpixel(source, cx1, y1);
+            uint32_t col = get(source, cx1, y1);
+            if (palette) {
+                // The palette is a framebuf whose first row maps source colors to our colors.
+                col = col < palette->width ? getpixel(palette, col, 0) : 0;
+            }
             if (col != (uint32_t)key) {
-                setpixel(self, cx0, y0, col);
+                set(self, cx0, y0, col);
             }
             ++cx1;
         }
@@ -508,36 +640,19 @@ STATIC mp_obj_t framebuf_blit(size_t n_args, const mp_obj_t *args) {
     }
     return mp_const_none;
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_blit_obj, 4, 5, framebuf_blit);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_blit_obj, 4, 6, framebuf_blit);
 
 STATIC mp_obj_t framebuf_scroll(mp_obj_t self_in, mp_obj_t xstep_in, mp_obj_t ystep_in) {
     mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
     mp_int_t xstep = mp_obj_get_int(xstep_in);
     mp_int_t ystep = mp_obj_get_int(ystep_in);
-    int sx, y, xend, yend, dx, dy;
-    if (xstep < 0) {
-        sx = 0;
-        xend = self->width + xstep;
-        dx = 1;
-    } else {
-        sx = self->width - 1;
-        xend = xstep - 1;
-        dx = -1;
-    }
-    if (ystep < 0) {
-        y = 0;
-        yend = self->height + ystep;
-        dy = 1;
-    } else {
-        y = self->height - 1;
-        yend = ystep - 1;
-        dy = -1;
-    }
-    for (; y != yend; y += dy) {
-        for (int x = sx; x != xend; x += dx) {
-            setpixel(self, x, y, getpixel(self, x - xstep, y - ystep));
-        }
+    if (xstep >= self->width || -xstep >= self->width ||
+        ystep >= self->height || -ystep >= self->height) {
+        // Everything moves out of view, so nothing is copied.
+        return mp_const_none;
     }
+    copy_rect(self, MAX(0, xstep), MAX(0, ystep), self, MAX(0, -xstep), MAX(0, -ystep),
+        self->width - (xstep < 0 ? -xstep : xstep), self->height - (ystep < 0 ? -ystep : ystep));
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(framebuf_scroll_obj, framebuf_scroll);
@@ -553,8 +668,15 @@ STATIC mp_obj_t framebuf_text(size_t n_args, const mp_obj_t *args) {
         col = mp_obj_get_int(args[4]);
     }
 
+    // MVLSB stores columns like the font does, so fully visible rows of glyphs are merged straight
+    // into the buffer a column at a time.
+    bool direct = self->format == FRAMEBUF_MVLSB && 0 <= y0 && y0 + 8 <= self->height;
+    uint8_t *page = (uint8_t*)self->buf + (y0 >> 3) * self->stride;
+    uint8_t shift = y0 & 0x07;
+    setpixel_t set = formats[self->format].setpixel;
+
     // loop over chars
-    for (; *str; ++str) {
+    for (; *str && x0 < self->width; ++str) {
         // get char and make sure its in range of font
         int chr = *(uint8_t*)str;
         if (chr < 32 || chr > 127) {
@@ -566,10 +688,26 @@ STATIC mp_obj_t framebuf_text(size_t n_args, const mp_obj_t *args) {
         for (int j = 0; j < 8; j++, x0++) {
             if (0 <= x0 && x0 < self->width) { // clip x
                 uint vline_data = chr_data[j]; // each byte is a column of 8 pixels, LSB at top
+                if (direct) {
+                    uint8_t lo = vline_data << shift;
+                    uint8_t hi = shift ? vline_data >> (8 - shift) : 0;
+                    if (col) {
+                        page[x0] |= lo;
+                        if (hi) {
+                            page[self->stride + x0] |= hi;
+                        }
+                    } else {
+                        page[x0] &= ~lo;
+                        if (hi) {
+                            page[self->stride + x0] &= ~hi;
+                        }
+                    }
+                    continue;
+                }
                 for (int y = y0; vline_data; vline_data >>= 1, y++) { // scan over vertical column
                     if (vline_data & 1) { // only draw if pixel set
                         if (0 <= y && y < self->height) { // clip y
-                            setpixel(self, x0, y, col);
+                            set(self, x0, y, col);
                         }
                     }
                 }
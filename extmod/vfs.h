@@ -44,6 +44,7 @@
 #define BP_IOCTL_SYNC           (3)
 #define BP_IOCTL_SEC_COUNT      (4)
 #define BP_IOCTL_SEC_SIZE       (5)
+#define BP_IOCTL_TRIM           (6) // arg is a block the filesystem no longer uses, see FSUSER_HAVE_TRIM
 
 // At the moment the VFS protocol just has import_stat, but could be extended to other methods
 typedef struct _mp_vfs_proto_t {
@@ -135,9 +135,22 @@ typedef struct _mp_vfs_fat_ilistdir_it_t {
     mp_obj_base_t base;
     mp_fun_1_t iternext;
     bool is_str;
+    bool with_mtime;
     FF_DIR dir;
 } mp_vfs_fat_ilistdir_it_t;
 
+// Converts a FAT directory entry timestamp into seconds since the epoch.
+STATIC mp_uint_t fat_vfs_timestamp(const FILINFO *fno) {
+    return timeutils_seconds_since_epoch(
+        1980 + ((fno->fdate >> 9) & 0x7f),
+        (fno->fdate >> 5) & 0x0f,
+        fno->fdate & 0x1f,
+        (fno->ftime >> 11) & 0x1f,
+        (fno->ftime >> 5) & 0x3f,
+        2 * (fno->ftime & 0x1f)
+    );
+}
+
 STATIC mp_obj_t mp_vfs_fat_ilistdir_it_iternext(mp_obj_t self_in) {
     mp_vfs_fat_ilistdir_it_t *self = MP_OBJ_TO_PTR(self_in);
 
@@ -152,8 +165,9 @@ STATIC mp_obj_t mp_vfs_fat_ilistdir_it_iternext(mp_obj_t self_in) {
 
         // Note that FatFS already filters . and .., so we don't need to
 
-        // make 4-tuple with info about this entry
-        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(4, NULL));
+        // make 4-tuple with info about this entry, plus the modification
+        // time when listing for os.scandir
+        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(self->with_mtime ? 5 : 4, NULL));
         if (self->is_str) {
             t->items[0] = mp_obj_new_str(fn, strlen(fn));
         } else {
@@ -168,6 +182,9 @@ STATIC mp_obj_t mp_vfs_fat_ilistdir_it_iternext(mp_obj_t self_in) {
         }
         t->items[2] = MP_OBJ_NEW_SMALL_INT(0); // no inode number
         t->items[3] = mp_obj_new_int_from_uint(fno.fsize);
+        if (self->with_mtime) {
+            t->items[4] = mp_obj_new_int_from_uint(fat_vfs_timestamp(&fno));
+        }
 
         return MP_OBJ_FROM_PTR(t);
     }
@@ -191,19 +208,32 @@ STATIC mp_obj_t fat_vfs_ilistdir_func(size_t n_args, const mp_obj_t *args) {
         path = "";
     }
 
+    return fat_vfs_ilistdir2(self, path, is_str_type);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(fat_vfs_ilistdir_obj, 1, 2, fat_vfs_ilistdir_func);
+
+STATIC mp_obj_t fat_vfs_new_ilistdir_it(fs_user_mount_t *vfs, const char *path, bool is_str_type, bool with_mtime) {
     // Create a new iterator object to list the dir
     mp_vfs_fat_ilistdir_it_t *iter = m_new_obj(mp_vfs_fat_ilistdir_it_t);
     iter->base.type = &mp_type_polymorph_iter;
     iter->iternext = mp_vfs_fat_ilistdir_it_iternext;
     iter->is_str = is_str_type;
-    FRESULT res = f_opendir(&self->fatfs, &iter->dir, path);
+    iter->with_mtime = with_mtime;
+    FRESULT res = f_opendir(&vfs->fatfs, &iter->dir, path);
     if (res != FR_OK) {
         mp_raise_OSError(fresult_to_errno_table[res]);
     }
 
     return MP_OBJ_FROM_PTR(iter);
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(fat_vfs_ilistdir_obj, 1, 2, fat_vfs_ilistdir_func);
+
+mp_obj_t fat_vfs_ilistdir2(fs_user_mount_t *vfs, const char *path, bool is_str_type) {
+    return fat_vfs_new_ilistdir_it(vfs, path, is_str_type, false);
+}
+
+mp_obj_t fat_vfs_scandir(fs_user_mount_t *vfs, const char *path) {
+    return fat_vfs_new_ilistdir_it(vfs, path, true, true);
+}
 
 STATIC mp_obj_t fat_vfs_remove_internal(mp_obj_t vfs_in, mp_obj_t path_in, mp_int_t attr) {
     mp_obj_fat_vfs_t *self = MP_OBJ_TO_PTR(vfs_in);
@@ -345,14 +375,7 @@ STATIC mp_obj_t fat_vfs_stat(mp_obj_t vfs_in, mp_obj_t path_in) {
     } else {
         mode |= MP_S_IFREG;
     }
-    mp_uint_t seconds = timeutils_seconds_since_epoch(
-        1980 + ((fno.fdate >> 9) & 0x7f),
-        (fno.fdate >> 5) & 0x0f,
-        fno.fdate & 0x1f,
-        (fno.ftime >> 11) & 0x1f,
-        (fno.ftime >> 5) & 0x3f,
-        2 * (fno.ftime & 0x1f)
-    );
+    mp_uint_t seconds = fat_vfs_timestamp(&fno);
     t->items[0] = MP_OBJ_NEW_SMALL_INT(mode); // st_mode
     t->items[1] = MP_OBJ_NEW_SMALL_INT(0); // st_ino
     t->items[2] = MP_OBJ_NEW_SMALL_INT(0); // st_dev
@@ -424,8 +447,9 @@ STATIC mp_obj_t vfs_fat_mount(mp_obj_t self_in, mp_obj_t readonly, mp_obj_t mkfs
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(vfs_fat_mount_obj, vfs_fat_mount);
 
 STATIC mp_obj_t vfs_fat_umount(mp_obj_t self_in) {
-    (void)self_in;
-    // keep the FAT filesystem mounted internally so the VFS methods can still be used
+    // keep the FAT filesystem mounted internally so the VFS methods can still be used, but
+    // don't hold on to its sectors once it's gone from the mount table
+    fat_vfs_release_sector_cache(MP_OBJ_TO_PTR(self_in));
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(fat_vfs_umount_obj, vfs_fat_umount);
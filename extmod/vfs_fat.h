@@ -40,6 +40,8 @@
 #define FSUSER_USB_WRITABLE  (0x0010)
 // Bit set when the above flag is checked before opening a file for write.
 #define FSUSER_CONCURRENT_WRITE_PROTECTED (0x0020)
+// Device ioctl accepts BP_IOCTL_TRIM. Other devices aren't told about freed blocks.
+#define FSUSER_HAVE_TRIM     (0x0040)
 
 typedef struct _fs_user_mount_t {
     mp_obj_base_t base;
@@ -67,11 +69,19 @@ extern const mp_obj_type_t mp_fat_vfs_type;
 extern const mp_obj_type_t mp_type_vfs_fat_fileio;
 extern const mp_obj_type_t mp_type_vfs_fat_textio;
 
+// Writes back and drops the sectors cached for vfs, or for every device when vfs is NULL.
+void fat_vfs_release_sector_cache(fs_user_mount_t *vfs);
+// Writes back the dirty sectors cached for vfs, or for every device when vfs is NULL, but keeps
+// them cached.
+void fat_vfs_sync_sector_cache(fs_user_mount_t *vfs);
+
 mp_import_stat_t fat_vfs_import_stat(void *vfs, const char *path);
 
 MP_DECLARE_CONST_FUN_OBJ_3(fat_vfs_open_obj);
 
 mp_obj_t fat_vfs_ilistdir2(struct _fs_user_mount_t *vfs, const char *path, bool is_str_type);
+// Like ilistdir but each entry also carries its modification time as a fifth item.
+mp_obj_t fat_vfs_scandir(struct _fs_user_mount_t *vfs, const char *path);
 
 MP_DECLARE_CONST_FUN_OBJ_KW(fsuser_mount_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(fsuser_umount_obj);
@@ -32,6 +32,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "py/mphal.h"
 
@@ -53,22 +54,7 @@ STATIC fs_user_mount_t *disk_get_device(void *bdev) {
     return (fs_user_mount_t*)bdev;
 }
 
-/*-----------------------------------------------------------------------*/
-/* Read Sector(s)                                                        */
-/*-----------------------------------------------------------------------*/
-
-DRESULT disk_read (
-    bdev_t pdrv,      /* Physical drive nmuber (0..) */
-    BYTE *buff,        /* Data buffer to store read data */
-    DWORD sector,    /* Sector address (LBA) */
-    UINT count        /* Number of sectors to read (1..128) */
-)
-{
-    fs_user_mount_t *vfs = disk_get_device(pdrv);
-    if (vfs == NULL) {
-        return RES_PARERR;
-    }
-
+STATIC DRESULT device_read(fs_user_mount_t *vfs, BYTE *buff, DWORD sector, UINT count) {
     if (vfs->flags & FSUSER_NATIVE) {
         mp_uint_t (*f)(uint8_t*, uint32_t, uint32_t) = (void*)(uintptr_t)vfs->readblocks[2];
         if (f(buff, sector, count) != 0) {
@@ -94,6 +80,252 @@ DRESULT disk_read (
     return RES_OK;
 }
 
+STATIC DRESULT device_write(fs_user_mount_t *vfs, const BYTE *buff, DWORD sector, UINT count) {
+    if (vfs->flags & FSUSER_NATIVE) {
+        mp_uint_t (*f)(const uint8_t*, uint32_t, uint32_t) = (void*)(uintptr_t)vfs->writeblocks[2];
+        if (f(buff, sector, count) != 0) {
+            return RES_ERROR;
+        }
+    } else {
+        mp_obj_array_t ar = {{&mp_type_bytearray}, BYTEARRAY_TYPECODE, 0, count * SECSIZE(&vfs->fatfs), (void*)buff};
+        vfs->writeblocks[2] = MP_OBJ_NEW_SMALL_INT(sector);
+        vfs->writeblocks[3] = MP_OBJ_FROM_PTR(&ar);
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            mp_obj_t ret = mp_call_method_n_kw(2, 0, vfs->writeblocks);
+            nlr_pop();
+            if (ret != mp_const_none && MP_OBJ_SMALL_INT_VALUE(ret) != 0) {
+                return RES_ERROR;
+            }
+        } else {
+            // Exception thrown by writeblocks or something it calls.
+            return RES_ERROR;
+        }
+    }
+
+    return RES_OK;
+}
+
+#if MICROPY_FATFS_SECTOR_CACHE
+// Single sectors are cached write-back for all mounted devices. This keeps the FAT and
+// directory sectors, and the sectors that file buffers move through, in RAM while several
+// files are open instead of reloading them every time FatFs switches between them. Multi
+// sector transfers are file data and go straight to the device.
+
+#if MICROPY_FATFS_READ_AHEAD < MICROPY_FATFS_SECTOR_CACHE
+#define READ_AHEAD_SECTORS (MICROPY_FATFS_READ_AHEAD)
+#else
+#define READ_AHEAD_SECTORS (MICROPY_FATFS_SECTOR_CACHE - 1)
+#endif
+
+typedef struct {
+    fs_user_mount_t *vfs; // NULL when the entry is unused.
+    DWORD sector;
+    uint32_t last_use;
+    bool dirty;
+} cached_sector_t;
+
+STATIC cached_sector_t cached_sectors[MICROPY_FATFS_SECTOR_CACHE];
+// Kept separate from the entries so that neighbouring entries form one buffer for read-ahead.
+STATIC BYTE cache_data[MICROPY_FATFS_SECTOR_CACHE][_MAX_SS] __attribute__((aligned(4)));
+STATIC uint32_t cache_clock;
+// The sector after the last single sector read, used to spot sequential reads.
+STATIC fs_user_mount_t *next_read_vfs;
+STATIC DWORD next_read_sector;
+
+STATIC int find_cached_sector(fs_user_mount_t *vfs, DWORD sector) {
+    for (int i = 0; i < MICROPY_FATFS_SECTOR_CACHE; i++) {
+        if (cached_sectors[i].vfs == vfs && cached_sectors[i].sector == sector) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+STATIC DRESULT write_back(int index) {
+    cached_sector_t *cached = &cached_sectors[index];
+    if (!cached->dirty) {
+        return RES_OK;
+    }
+    DRESULT res = device_write(cached->vfs, cache_data[index], cached->sector, 1);
+    if (res == RES_OK) {
+        cached->dirty = false;
+    }
+    return res;
+}
+
+// Frees up count neighbouring entries, choosing the run whose newest entry is oldest, and
+// returns the index of the first one.
+STATIC int claim_cached_sectors(UINT count) {
+    int best = -1;
+    uint32_t best_age = 0;
+    for (int i = 0; i + count <= MICROPY_FATFS_SECTOR_CACHE; i++) {
+        uint32_t age = UINT32_MAX;
+        for (UINT j = 0; j < count; j++) {
+            cached_sector_t *cached = &cached_sectors[i + j];
+            uint32_t entry_age = cached->vfs == NULL ? UINT32_MAX : cache_clock - cached->last_use;
+            if (entry_age < age) {
+                age = entry_age;
+            }
+        }
+        if (best == -1 || age > best_age) {
+            best = i;
+            best_age = age;
+        }
+    }
+    for (UINT j = 0; j < count; j++) {
+        if (write_back(best + j) != RES_OK) {
+            return -1;
+        }
+        cached_sectors[best + j].vfs = NULL;
+    }
+    return best;
+}
+
+// Number of sectors worth reading ahead of sector, staying inside the mounted volume.
+STATIC UINT read_ahead_count(fs_user_mount_t *vfs, DWORD sector) {
+    if (vfs != next_read_vfs || sector != next_read_sector ||
+        vfs->fatfs.fs_type == 0 || SECSIZE(&vfs->fatfs) != _MAX_SS) {
+        return 0;
+    }
+    DWORD volume_end = vfs->fatfs.database + (vfs->fatfs.n_fatent - 2) * vfs->fatfs.csize;
+    UINT count = READ_AHEAD_SECTORS;
+    while (count > 0 && sector + count >= volume_end) {
+        count--;
+    }
+    for (UINT i = 1; i <= count; i++) {
+        if (find_cached_sector(vfs, sector + i) != -1) {
+            return i - 1;
+        }
+    }
+    return count;
+}
+
+STATIC DRESULT cached_read(fs_user_mount_t *vfs, BYTE *buff, DWORD sector) {
+    int index = find_cached_sector(vfs, sector);
+    if (index == -1) {
+        UINT ahead = read_ahead_count(vfs, sector);
+        index = claim_cached_sectors(1 + ahead);
+        if (index == -1) {
+            return RES_ERROR;
+        }
+        DRESULT res = device_read(vfs, cache_data[index], sector, 1 + ahead);
+        if (res != RES_OK && ahead > 0) {
+            ahead = 0;
+            res = device_read(vfs, cache_data[index], sector, 1);
+        }
+        if (res != RES_OK) {
+            return res;
+        }
+        for (UINT i = 0; i <= ahead; i++) {
+            cached_sector_t *cached = &cached_sectors[index + i];
+            cached->vfs = vfs;
+            cached->sector = sector + i;
+            cached->last_use = cache_clock;
+            cached->dirty = false;
+        }
+    }
+    cached_sectors[index].last_use = ++cache_clock;
+    next_read_vfs = vfs;
+    next_read_sector = sector + 1;
+    memcpy(buff, cache_data[index], SECSIZE(&vfs->fatfs));
+    return RES_OK;
+}
+
+STATIC DRESULT cached_write(fs_user_mount_t *vfs, const BYTE *buff, DWORD sector) {
+    int index = find_cached_sector(vfs, sector);
+    if (index == -1) {
+        index = claim_cached_sectors(1);
+        if (index == -1) {
+            return RES_ERROR;
+        }
+        cached_sectors[index].vfs = vfs;
+        cached_sectors[index].sector = sector;
+    }
+    memcpy(cache_data[index], buff, SECSIZE(&vfs->fatfs));
+    cached_sectors[index].last_use = ++cache_clock;
+    cached_sectors[index].dirty = true;
+    return RES_OK;
+}
+
+// Writes back the dirty sectors of vfs, or of every device when vfs is NULL.
+STATIC DRESULT sync_cached_sectors(fs_user_mount_t *vfs) {
+    DRESULT res = RES_OK;
+    for (int i = 0; i < MICROPY_FATFS_SECTOR_CACHE; i++) {
+        if (cached_sectors[i].vfs != NULL && (vfs == NULL || cached_sectors[i].vfs == vfs) &&
+            write_back(i) != RES_OK) {
+            res = RES_ERROR;
+        }
+    }
+    return res;
+}
+
+STATIC void forget_cached_sectors(fs_user_mount_t *vfs) {
+    for (int i = 0; i < MICROPY_FATFS_SECTOR_CACHE; i++) {
+        if (vfs == NULL || cached_sectors[i].vfs == vfs) {
+            cached_sectors[i].vfs = NULL;
+        }
+    }
+    next_read_vfs = NULL;
+}
+#endif
+
+void fat_vfs_release_sector_cache(fs_user_mount_t *vfs) {
+    #if MICROPY_FATFS_SECTOR_CACHE
+    sync_cached_sectors(vfs);
+    forget_cached_sectors(vfs);
+    #else
+    (void) vfs;
+    #endif
+}
+
+void fat_vfs_sync_sector_cache(fs_user_mount_t *vfs) {
+    #if MICROPY_FATFS_SECTOR_CACHE
+    sync_cached_sectors(vfs);
+    #else
+    (void) vfs;
+    #endif
+}
+
+/*-----------------------------------------------------------------------*/
+/* Read Sector(s)                                                        */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_read (
+    bdev_t pdrv,      /* Physical drive nmuber (0..) */
+    BYTE *buff,        /* Data buffer to store read data */
+    DWORD sector,    /* Sector address (LBA) */
+    UINT count        /* Number of sectors to read (1..128) */
+)
+{
+    fs_user_mount_t *vfs = disk_get_device(pdrv);
+    if (vfs == NULL) {
+        return RES_PARERR;
+    }
+
+    #if MICROPY_FATFS_SECTOR_CACHE
+    if (count == 1) {
+        return cached_read(vfs, buff, sector);
+    }
+    DRESULT res = device_read(vfs, buff, sector, count);
+    if (res != RES_OK) {
+        return res;
+    }
+    // Sectors that haven't been written back yet are newer than the device's copy.
+    for (int i = 0; i < MICROPY_FATFS_SECTOR_CACHE; i++) {
+        cached_sector_t *cached = &cached_sectors[i];
+        if (cached->vfs == vfs && cached->dirty &&
+            cached->sector >= sector && cached->sector < sector + count) {
+            memcpy(buff + (cached->sector - sector) * SECSIZE(&vfs->fatfs), cache_data[i],
+                SECSIZE(&vfs->fatfs));
+        }
+    }
+    return RES_OK;
+    #else
+    return device_read(vfs, buff, sector, count);
+    #endif
+}
+
 /*-----------------------------------------------------------------------*/
 /* Write Sector(s)                                                       */
 /*-----------------------------------------------------------------------*/
@@ -115,29 +347,27 @@ DRESULT disk_write (
         return RES_WRPRT;
     }
 
-    if (vfs->flags & FSUSER_NATIVE) {
-        mp_uint_t (*f)(const uint8_t*, uint32_t, uint32_t) = (void*)(uintptr_t)vfs->writeblocks[2];
-        if (f(buff, sector, count) != 0) {
-            return RES_ERROR;
-        }
-    } else {
-        mp_obj_array_t ar = {{&mp_type_bytearray}, BYTEARRAY_TYPECODE, 0, count * SECSIZE(&vfs->fatfs), (void*)buff};
-        vfs->writeblocks[2] = MP_OBJ_NEW_SMALL_INT(sector);
-        vfs->writeblocks[3] = MP_OBJ_FROM_PTR(&ar);
-        nlr_buf_t nlr;
-        if (nlr_push(&nlr) == 0) {
-            mp_obj_t ret = mp_call_method_n_kw(2, 0, vfs->writeblocks);
-            nlr_pop();
-            if (ret != mp_const_none && MP_OBJ_SMALL_INT_VALUE(ret) != 0) {
-                return RES_ERROR;
-            }
-        } else {
-            // Exception thrown by writeblocks or something it calls.
-            return RES_ERROR;
+    #if MICROPY_FATFS_SECTOR_CACHE
+    if (count == 1) {
+        return cached_write(vfs, buff, sector);
+    }
+    DRESULT res = device_write(vfs, buff, sector, count);
+    if (res != RES_OK) {
+        return res;
+    }
+    // Keep cached copies in step with what was just written.
+    for (int i = 0; i < MICROPY_FATFS_SECTOR_CACHE; i++) {
+        cached_sector_t *cached = &cached_sectors[i];
+        if (cached->vfs == vfs && cached->sector >= sector && cached->sector < sector + count) {
+            memcpy(cache_data[i], buff + (cached->sector - sector) * SECSIZE(&vfs->fatfs),
+                SECSIZE(&vfs->fatfs));
+            cached->dirty = false;
         }
     }
-
     return RES_OK;
+    #else
+    return device_write(vfs, buff, sector, count);
+    #endif
 }
 
 
@@ -156,6 +386,16 @@ DRESULT disk_ioctl (
         return RES_PARERR;
     }
 
+    #if MICROPY_FATFS_SECTOR_CACHE
+    if (cmd == CTRL_SYNC && sync_cached_sectors(vfs) != RES_OK) {
+        return RES_ERROR;
+    }
+    if (cmd == IOCTL_INIT) {
+        // Anything cached under this pointer may belong to an earlier, collected mount.
+        forget_cached_sectors(vfs);
+    }
+    #endif
+
     // First part: call the relevant method of the underlying block device
     mp_obj_t ret = mp_const_none;
     if (vfs->flags & FSUSER_HAVE_IOCTL) {
@@ -167,7 +407,23 @@ DRESULT disk_ioctl (
             [IOCTL_INIT] = BP_IOCTL_INIT,
         };
         uint8_t bp_op = op_map[cmd & 7];
-        if (bp_op != 0) {
+        if (cmd == CTRL_TRIM) {
+            // FatFs gives an inclusive range of sectors but the protocol takes one block at a
+            // time. Trimming is only a hint so devices that don't ask for it are skipped and
+            // errors are ignored.
+            if (vfs->flags & FSUSER_HAVE_TRIM) {
+                DWORD *range = buff;
+                vfs->u.ioctl[2] = MP_OBJ_NEW_SMALL_INT(BP_IOCTL_TRIM);
+                nlr_buf_t nlr;
+                if (nlr_push(&nlr) == 0) {
+                    for (DWORD block = range[0]; block <= range[1]; block++) {
+                        vfs->u.ioctl[3] = MP_OBJ_NEW_SMALL_INT(block);
+                        mp_call_method_n_kw(2, 0, vfs->u.ioctl);
+                    }
+                    nlr_pop();
+                }
+            }
+        } else if (bp_op != 0) {
             vfs->u.ioctl[2] = MP_OBJ_NEW_SMALL_INT(bp_op);
             vfs->u.ioctl[3] = MP_OBJ_NEW_SMALL_INT(0); // unused
             ret = mp_call_method_n_kw(2, 0, vfs->u.ioctl);
@@ -198,6 +454,7 @@ DRESULT disk_ioctl (
     // Second part: convert the result for return
     switch (cmd) {
         case CTRL_SYNC:
+        case CTRL_TRIM:
             return RES_OK;
 
         case GET_SECTOR_COUNT: {
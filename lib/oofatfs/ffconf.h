@@ -238,7 +238,11 @@
 /  disk_ioctl() function. */
 
 
+#ifdef MICROPY_FATFS_USE_TRIM
+#define _USE_TRIM   (MICROPY_FATFS_USE_TRIM)
+#else
 #define _USE_TRIM   0
+#endif
 /* This option switches support of ATA-TRIM. (0:Disable or 1:Enable)
 /  To enable Trim function, also CTRL_TRIM command should be implemented to the
 /  disk_ioctl() function. */
@@ -261,7 +265,11 @@
 / System Configurations
 /---------------------------------------------------------------------------*/
 
+#ifdef MICROPY_FATFS_TINY
+#define _FS_TINY    (MICROPY_FATFS_TINY)
+#else
 #define _FS_TINY    1
+#endif
 /* This option switches tiny buffer configuration. (0:Normal or 1:Tiny)
 /  At the tiny configuration, size of file object (FIL) is reduced _MAX_SS bytes.
 /  Instead of private sector buffer eliminated from the file object, common sector
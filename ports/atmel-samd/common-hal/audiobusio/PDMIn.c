@@ -36,6 +36,7 @@
 #include "shared-bindings/analogio/AnalogOut.h"
 #include "shared-bindings/audiobusio/PDMIn.h"
 #include "shared-bindings/microcontroller/Pin.h"
+#include "shared-module/audiobusio/PDMDecimator.h"
 #include "supervisor/shared/translate.h"
 
 #include "atmel_start_pins.h"
@@ -51,7 +52,6 @@
 #include "audio_dma.h"
 #include "tick.h"
 
-#define OVERSAMPLING 64
 #define SAMPLES_PER_BUFFER 32
 
 // MEMS microphones must be clocked at at least 1MHz.
@@ -130,8 +130,11 @@ void common_hal_audiobusio_pdmin_construct(audiobusio_pdmin_obj_t* self,
         mp_raise_ValueError_varg(translate("Invalid %q pin"), MP_QSTR_data);
     }
 
-    if (!(bit_depth == 16 || bit_depth == 8) || !mono || oversample != OVERSAMPLING) {
-        mp_raise_NotImplementedError(translate("Only 8 or 16 bit mono with " MP_STRINGIFY(OVERSAMPLING) "x oversampling is supported."));
+    // Each DMA word carries 16 bits of PDM so whole samples pack into 32-bit words when the
+    // oversample is a multiple of 32.
+    if (!(bit_depth == 16 || bit_depth == 8) || !mono || oversample % 32 != 0 ||
+        !pdm_decimator_init(&self->decimator, oversample)) {
+        mp_raise_NotImplementedError(translate("Only 8 or 16 bit mono with 32, 64, 96 or 128x oversampling is supported."));
     }
 
     turn_on_i2s();
@@ -308,49 +311,6 @@ static void setup_dma(audiobusio_pdmin_obj_t* self, uint32_t length,
     }
 }
 
-// a windowed sinc filter for 44 khz, 64 samples
-//
-// This filter is good enough to use for lower sample rates as
-// well. It does not increase the noise enough to be a problem.
-//
-// In the long run we could use a fast filter like this to do the
-// decimation and initial filtering in real time, filtering to a
-// higher sample rate than specified.  Then after the audio is
-// recorded, a more expensive filter non-real-time filter could be
-// used to down-sample and low-pass.
-uint16_t sinc_filter [OVERSAMPLING] = {
-    0, 2, 9, 21, 39, 63, 94, 132,
-    179, 236, 302, 379, 467, 565, 674, 792,
-    920, 1055, 1196, 1341, 1487, 1633, 1776, 1913,
-    2042, 2159, 2263, 2352, 2422, 2474, 2506, 2516,
-    2506, 2474, 2422, 2352, 2263, 2159, 2042, 1913,
-    1776, 1633, 1487, 1341, 1196, 1055, 920, 792,
-    674, 565, 467, 379, 302, 236, 179, 132,
-    94, 63, 39, 21, 9, 2, 0, 0
-};
-
-#define REPEAT_16_TIMES(X) X X X X X X X X X X X X X X X X
-
-static uint16_t filter_sample(uint32_t pdm_samples[4]) {
-    uint16_t running_sum = 0;
-    const uint16_t *filter_ptr = sinc_filter;
-    for (uint8_t i = 0; i < OVERSAMPLING/16; i++) {
-        // The sample is 16-bits right channel in the upper two bytes and 16-bits left channel
-        // in the lower two bytes.
-        // We just ignore the upper bits
-        uint32_t pdm_sample = pdm_samples[i];
-        REPEAT_16_TIMES( {
-                if (pdm_sample & 0x8000) {
-                    running_sum += *filter_ptr;
-                }
-                filter_ptr++;
-                pdm_sample <<= 1;
-            }
-            )
-    }
-    return running_sum;
-}
-
 // output_buffer may be a byte buffer or a halfword buffer.
 // output_buffer_length is the number of slots, not the number of bytes.
 uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* self,
@@ -369,6 +329,9 @@ uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* se
     uint32_t first_buffer[words_per_buffer];
     uint32_t second_buffer[words_per_buffer];
 
+    int16_t samples[SAMPLES_PER_BUFFER];
+    pdm_decimator_reset(&self->decimator);
+
     turn_on_event_system();
 
     COMPILER_ALIGNED(16) DmacDescriptor second_descriptor;
@@ -425,9 +388,16 @@ uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* se
         uint32_t samples_gathered = descriptor->BTCNT.reg / words_per_sample;
         // Don't run off the end of output buffer. Process only as many as needed.
         uint32_t samples_to_process = min(remaining_samples_needed, samples_gathered);
+        // Each word has 16 bits of the left channel in the lower two bytes and a phantom right
+        // channel in the upper two bytes. Pack pairs of left channel halves into whole words.
+        uint32_t words_to_process = samples_to_process * words_per_sample / 2;
+        for (uint32_t i = 0; i < words_to_process; i++) {
+            buffer[i] = (buffer[2 * i] << 16) | (buffer[2 * i + 1] & 0xffff);
+        }
+        pdm_decimator_process(&self->decimator, buffer, words_to_process, samples);
         for (uint32_t i = 0; i < samples_to_process; i++) {
-            // Call filter_sample just one place so it can be inlined.
-            uint16_t value = filter_sample(buffer + i * words_per_sample);
+            // The output is unsigned.
+            uint16_t value = samples[i] + 0x8000;
             if (self->bit_depth == 8) {
                 // Truncate to 8 bits.
                 ((uint8_t*) output_buffer)[values_output] = value >> 8;
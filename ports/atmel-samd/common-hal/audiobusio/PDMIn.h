@@ -31,6 +31,7 @@
 
 #include "extmod/vfs_fat.h"
 #include "py/obj.h"
+#include "shared-module/audiobusio/PDMDecimator.h"
 
 typedef struct {
     mp_obj_base_t base;
@@ -42,6 +43,7 @@ typedef struct {
     uint8_t bytes_per_sample;
     uint8_t bit_depth;
     uint8_t gclk;
+    pdm_decimator_t decimator;
 } audiobusio_pdmin_obj_t;
 
 void pdmin_reset(void);
@@ -42,6 +42,10 @@
 #define MICROPY_PY_IO                               (0)
 #define MICROPY_PY_UJSON                            (0)
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS          (0)
+// 32kiB of RAM is too little to spare 4kiB each on caching filesystem sectors and on staging
+// USB mass storage transfers.
+#define MICROPY_FATFS_SECTOR_CACHE                  (0)
+#define CIRCUITPY_USB_MSC_STAGING_BLOCKS            (0)
 #define MICROPY_PY_UERRNO_LIST \
     X(EPERM) \
     X(ENOENT) \
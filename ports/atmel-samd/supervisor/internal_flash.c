@@ -79,6 +79,15 @@ void supervisor_flash_flush(void) {
 void supervisor_flash_release_cache(void) {
 }
 
+void supervisor_flash_trim_blocks(uint32_t block_num, uint32_t num_blocks) {
+}
+
+void supervisor_flash_commit_trimmed_blocks(void) {
+}
+
+void supervisor_flash_background(void) {
+}
+
 void flash_flush(void) {
     supervisor_flash_flush();
 }
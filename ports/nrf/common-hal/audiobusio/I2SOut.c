@@ -314,6 +314,10 @@ void i2s_background(void) {
             NRF_I2S->TASKS_STOP = 1;
         }
     }
+    // Let the sample read ahead while the I2S peripheral plays the filled buffer.
+    if (instance && !instance->stopping && instance->sample != NULL) {
+        audiosample_background(instance->sample);
+    }
 }
 
 void i2s_reset(void) {
@@ -144,6 +144,10 @@ STATIC void audiopwmout_background_obj(audiopwmio_pwmaudioout_obj_t *self) {
     } else if (!self->paused && !self->single_buffer) {
         if (self->pwm->EVENTS_SEQSTARTED[0]) fill_buffers(self, 1);
         if (self->pwm->EVENTS_SEQSTARTED[1]) fill_buffers(self, 0);
+        // Let the sample read ahead while the PWM plays the filled buffers.
+        if (self->sample != NULL) {
+            audiosample_background(self->sample);
+        }
     }
 }
 
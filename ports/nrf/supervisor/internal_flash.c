@@ -121,3 +121,12 @@ mp_uint_t supervisor_flash_write_blocks(const uint8_t *src, uint32_t lba, uint32
 void supervisor_flash_release_cache(void) {
 }
 
+void supervisor_flash_trim_blocks(uint32_t block_num, uint32_t num_blocks) {
+}
+
+void supervisor_flash_commit_trimmed_blocks(void) {
+}
+
+void supervisor_flash_background(void) {
+}
+
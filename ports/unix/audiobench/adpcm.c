@@ -0,0 +1,308 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+// Decodes IMA ADPCM wave files with audiocore.WaveFile from a RAM disk. The output is checked
+// against a separate reference decoder and the time per frame is compared with reading the same
+// audio as 16 bit PCM.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "extmod/vfs_fat.h"
+#include "shared-bindings/audiocore/WaveFile.h"
+#include "shared-module/audiocore/WaveFile.h"
+
+#include "audiobench.h"
+
+#define SAMPLE_RATE (44100)
+// Ends with a partial block of 833 frames, a whole number of 8 sample groups after the header.
+#define FRAMES (5 * SAMPLE_RATE + 5)
+#define BLOCK_ALIGN_PER_CHANNEL (512)
+#define BUFFER_SIZE (4096)
+
+static const uint16_t step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66,
+    73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+    449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767
+};
+
+static const int8_t index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+typedef struct {
+    int32_t predictor;
+    int32_t index;
+} ima_state_t;
+
+// Straight from the IMA ADPCM reference. The shifts truncate separately so this isn't the same as
+// multiplying by the nibble.
+static int16_t reference_decode(ima_state_t* state, uint8_t nibble) {
+    int32_t step = step_table[state->index];
+    int32_t diff = step >> 3;
+    for (uint8_t bit = 4, shift = 0; bit > 0; bit >>= 1, shift++) {
+        if (nibble & bit) {
+            diff += step >> shift;
+        }
+    }
+    state->predictor += (nibble & 8) ? -diff : diff;
+    state->predictor = MIN(MAX(state->predictor, -32768), 32767);
+    state->index = MIN(MAX(state->index + index_table[nibble], 0), 88);
+    return state->predictor;
+}
+
+static uint8_t encode(ima_state_t* state, int16_t sample) {
+    int32_t step = step_table[state->index];
+    int32_t diff = sample - state->predictor;
+    uint8_t nibble = 0;
+    if (diff < 0) {
+        nibble = 8;
+        diff = -diff;
+    }
+    for (uint8_t bit = 4; bit > 0; bit >>= 1) {
+        if (diff >= step) {
+            nibble |= bit;
+            diff -= step;
+        }
+        step >>= 1;
+    }
+    reference_decode(state, nibble);
+    return nibble;
+}
+
+static int16_t source_sample(uint32_t frame, uint8_t channel) {
+    float t = (float) frame / SAMPLE_RATE;
+    // A sweep from 200Hz to 2200Hz, a steady tone and a little noise, different on each channel.
+    float sweep = sinf(2 * M_PI * (200 + 200 * t) * t + channel);
+    float tone = sinf(2 * M_PI * (440 + 110 * channel) * t);
+    float noise = ((int32_t) (next_random() & 0xfff) - 0x800) / 2048.0f;
+    return 12000 * sweep + 8000 * tone + 500 * noise;
+}
+
+static void put_u16(uint8_t** p, uint16_t value) {
+    (*p)[0] = value;
+    (*p)[1] = value >> 8;
+    *p += 2;
+}
+
+static void put_u32(uint8_t** p, uint32_t value) {
+    put_u16(p, value);
+    put_u16(p, value >> 16);
+}
+
+static void put_tag(uint8_t** p, const char* tag) {
+    memcpy(*p, tag, 4);
+    *p += 4;
+}
+
+// Frames in a whole block. The header holds the first one and each data byte two more. Channels
+// each get BLOCK_ALIGN_PER_CHANNEL bytes so this is the same for mono and stereo.
+static uint32_t block_frames(void) {
+    return 1 + (BLOCK_ALIGN_PER_CHANNEL - 4) * 2;
+}
+
+// Writes a wave header for data_len bytes of data and returns where the data goes.
+static uint8_t* put_header(uint8_t* p, bool adpcm, uint8_t channel_count, uint32_t data_len) {
+    uint16_t block_align = adpcm ? BLOCK_ALIGN_PER_CHANNEL * channel_count : 2 * channel_count;
+    uint32_t frames_per_block = adpcm ? block_frames() : 1;
+    uint32_t fmt_len = adpcm ? 20 : 16;
+    put_tag(&p, "RIFF");
+    put_u32(&p, 4 + 8 + fmt_len + (adpcm ? 12 : 0) + 8 + data_len);
+    put_tag(&p, "WAVE");
+    put_tag(&p, "fmt ");
+    put_u32(&p, fmt_len);
+    put_u16(&p, adpcm ? 0x0011 : 0x0001);
+    put_u16(&p, channel_count);
+    put_u32(&p, SAMPLE_RATE);
+    put_u32(&p, SAMPLE_RATE * block_align / frames_per_block);
+    put_u16(&p, block_align);
+    put_u16(&p, adpcm ? 4 : 16);
+    if (adpcm) {
+        put_u16(&p, 2);
+        put_u16(&p, frames_per_block);
+        put_tag(&p, "fact");
+        put_u32(&p, 4);
+        put_u32(&p, FRAMES);
+    }
+    put_tag(&p, "data");
+    put_u32(&p, data_len);
+    return p;
+}
+
+// Encodes the frames into blocks. Returns the number of data bytes.
+static uint32_t encode_blocks(const int16_t* pcm, uint8_t channel_count, uint8_t* out) {
+    uint32_t frames_per_block = block_frames();
+    uint8_t* start = out;
+    ima_state_t state[2] = {{0, 0}, {0, 0}};
+    for (uint32_t frame = 0; frame < FRAMES; frame += frames_per_block) {
+        uint32_t frames = MIN(frames_per_block, FRAMES - frame);
+        for (uint8_t c = 0; c < channel_count; c++) {
+            state[c].predictor = pcm[frame * channel_count + c];
+            put_u16(&out, state[c].predictor);
+            *out++ = state[c].index;
+            *out++ = 0;
+        }
+        // Each channel takes a turn with 8 samples in 4 bytes. The last group is padded.
+        for (uint32_t group = 1; group < frames; group += 8) {
+            for (uint8_t c = 0; c < channel_count; c++) {
+                for (uint8_t i = 0; i < 8; i += 2) {
+                    uint8_t nibbles[2] = {0, 0};
+                    for (uint8_t j = 0; j < 2; j++) {
+                        uint32_t f = group + i + j;
+                        if (f < frames) {
+                            nibbles[j] = encode(&state[c], pcm[(frame + f) * channel_count + c]);
+                        }
+                    }
+                    *out++ = nibbles[0] | nibbles[1] << 4;
+                }
+            }
+        }
+    }
+    return out - start;
+}
+
+// Decodes the blocks written by encode_blocks.
+static void reference_decode_blocks(const uint8_t* data, uint32_t len, uint8_t channel_count, int16_t* out) {
+    uint32_t block_align = BLOCK_ALIGN_PER_CHANNEL * channel_count;
+    for (uint32_t offset = 0; offset < len; offset += block_align) {
+        uint32_t block_len = MIN(block_align, len - offset);
+        const uint8_t* block = data + offset;
+        ima_state_t state[2];
+        for (uint8_t c = 0; c < channel_count; c++) {
+            state[c].predictor = (int16_t) (block[4 * c] | block[4 * c + 1] << 8);
+            state[c].index = block[4 * c + 2];
+            *out++ = state[c].predictor;
+        }
+        uint32_t frames = 1 + (block_len - 4 * channel_count) / channel_count * 2;
+        for (uint32_t f = 1; f < frames; f++) {
+            uint32_t group = (f - 1) / 8;
+            uint32_t k = (f - 1) % 8;
+            for (uint8_t c = 0; c < channel_count; c++) {
+                uint8_t byte = block[4 * channel_count * (1 + group) + 4 * c + k / 2];
+                *out++ = reference_decode(&state[c], (k & 1) ? byte >> 4 : byte & 0xf);
+            }
+        }
+    }
+}
+
+// Reads every buffer of the file through WaveFile. Returns the bytes read or -1 on an error.
+static int32_t read_wave(const char* path, uint8_t* out, uint64_t* elapsed_ns) {
+    pyb_file_obj_t file;
+    if (f_open(ramdisk_mount(), &file.fp, path, FA_READ) != FR_OK) {
+        return -1;
+    }
+    static uint8_t buffer[BUFFER_SIZE];
+    audioio_wavefile_obj_t wave;
+    uint64_t start = now_ns();
+    common_hal_audioio_wavefile_construct(&wave, &file, buffer, sizeof(buffer), 2);
+    // Players reset the sample before they start.
+    audioio_wavefile_reset_buffer(&wave, false, 0);
+    uint32_t total = 0;
+    audioio_get_buffer_result_t result = GET_BUFFER_MORE_DATA;
+    while (result == GET_BUFFER_MORE_DATA) {
+        uint8_t* data;
+        uint32_t len;
+        result = audioio_wavefile_get_buffer(&wave, false, 0, &data, &len);
+        if (result == GET_BUFFER_ERROR) {
+            return -1;
+        }
+        if (out != NULL) {
+            memcpy(out + total, data, len);
+        }
+        total += len;
+    }
+    *elapsed_ns = now_ns() - start;
+    common_hal_audioio_wavefile_deinit(&wave);
+    f_close(&file.fp);
+    return total;
+}
+
+static void bench_channels(uint8_t channel_count) {
+    uint32_t pcm_len = FRAMES * channel_count * sizeof(int16_t);
+    int16_t* pcm = malloc(pcm_len);
+    for (uint32_t i = 0; i < FRAMES * channel_count; i++) {
+        pcm[i] = source_sample(i / channel_count, i % channel_count);
+    }
+    // Room for the header and one more buffer of padding.
+    uint8_t* file = malloc(pcm_len + 128 + BUFFER_SIZE);
+    int16_t* expected = malloc(pcm_len + BUFFER_SIZE);
+    int16_t* decoded = malloc(pcm_len + BUFFER_SIZE);
+    char what[80];
+
+    // ADPCM
+    uint8_t* data = put_header(file, true, channel_count, 0);
+    uint32_t data_len = encode_blocks(pcm, channel_count, data);
+    put_header(file, true, channel_count, data_len);
+    reference_decode_blocks(data, data_len, channel_count, expected);
+    bool written = ramdisk_write_file("/adpcm.wav", file, data - file + data_len);
+    uint64_t adpcm_ns = 0;
+    int32_t len = written ? read_wave("/adpcm.wav", (uint8_t*) decoded, &adpcm_ns) : -1;
+    snprintf(what, sizeof(what), "%d channel ADPCM decodes every frame", channel_count);
+    check(len == (int32_t) pcm_len, what);
+    snprintf(what, sizeof(what), "%d channel ADPCM matches the reference decoder", channel_count);
+    check(len == (int32_t) pcm_len && memcmp(decoded, expected, pcm_len) == 0, what);
+
+    double signal = 0;
+    double error = 0;
+    for (uint32_t i = 0; i < FRAMES * channel_count; i++) {
+        signal += (double) pcm[i] * pcm[i];
+        error += (double) (pcm[i] - decoded[i]) * (pcm[i] - decoded[i]);
+    }
+    double snr = 10 * log10(signal / MAX(error, 1));
+    snprintf(what, sizeof(what), "%d channel ADPCM signal to noise ratio %.1f dB", channel_count, snr);
+    check(snr > 20, what);
+
+    // The same audio as PCM for comparison.
+    data = put_header(file, false, channel_count, pcm_len);
+    memcpy(data, pcm, pcm_len);
+    written = ramdisk_write_file("/pcm.wav", file, data - file + pcm_len);
+    uint64_t pcm_ns = 0;
+    len = written ? read_wave("/pcm.wav", (uint8_t*) decoded, &pcm_ns) : -1;
+    // The last buffer is padded to a whole word.
+    snprintf(what, sizeof(what), "%d channel PCM reads every frame", channel_count);
+    check(len >= (int32_t) pcm_len && memcmp(decoded, pcm, pcm_len) == 0, what);
+
+    snprintf(what, sizeof(what), "%d channel ADPCM WaveFile", channel_count);
+    report_time(what, adpcm_ns, FRAMES, "frame");
+    snprintf(what, sizeof(what), "%d channel PCM WaveFile", channel_count);
+    report_time(what, pcm_ns, FRAMES, "frame");
+
+    free(pcm);
+    free(file);
+    free(expected);
+    free(decoded);
+}
+
+void adpcm_bench(void) {
+    bench_channels(1);
+    bench_channels(2);
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+// Checks the audio sample code against plain reference implementations and times it on the host:
+//
+//   audiobench
+//
+// Prints each check and timing and exits non-zero if any check fails. The timings are only useful
+// relative to each other, the host is much faster than any microcontroller.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "audiobench.h"
+
+static bool failed = false;
+
+void check(bool ok, const char* what) {
+    printf("%-60s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) {
+        failed = true;
+    }
+}
+
+uint64_t now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+void report_time(const char* what, uint64_t elapsed_ns, uint32_t count, const char* unit) {
+    double ns = (double) elapsed_ns / count;
+    printf("%-60s %8.2f ns/%s\n", what, ns, unit);
+}
+
+static uint32_t random_state = 0x12345678;
+
+uint32_t next_random(void) {
+    // xorshift32
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+int main(int argc, char** argv) {
+    mixer_bench();
+    adpcm_bench();
+    pdm_bench();
+    synth_bench();
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
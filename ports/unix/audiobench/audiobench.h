@@ -0,0 +1,59 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_UNIX_AUDIOBENCH_AUDIOBENCH_H
+#define MICROPY_INCLUDED_UNIX_AUDIOBENCH_AUDIOBENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lib/oofatfs/ff.h"
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+// Records the result of one check. Failures make audiobench exit non-zero.
+void check(bool ok, const char* what);
+
+// Prints how long each of count operations of some kind took.
+void report_time(const char* what, uint64_t elapsed_ns, uint32_t count, const char* unit);
+
+uint64_t now_ns(void);
+
+// Small deterministic generator so runs are repeatable.
+uint32_t next_random(void);
+
+// A FAT filesystem in RAM, created on first use.
+FATFS* ramdisk_mount(void);
+bool ramdisk_write_file(const char* path, const uint8_t* data, uint32_t len);
+
+// One function per area. Each runs its checks and timings.
+void mixer_bench(void);
+void adpcm_bench(void);
+void pdm_bench(void);
+void synth_bench(void);
+
+#endif // MICROPY_INCLUDED_UNIX_AUDIOBENCH_AUDIOBENCH_H
@@ -0,0 +1,218 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+// Checks audiomixer's word at a time mixing kernels. Cortex-M4 builds use SIMD instructions
+// instead so the references follow what those instructions do to each lane.
+
+#include <stdio.h>
+
+#include "shared-module/audiomixer/kernels.h"
+
+#include "audiobench.h"
+
+#define RANDOM_WORDS (1000000)
+
+static int32_t lane8(uint32_t word, uint8_t lane, bool is_signed) {
+    uint8_t value = word >> (lane * 8);
+    return is_signed ? (int8_t) value : value;
+}
+
+static int32_t lane16(uint32_t word, uint8_t lane, bool is_signed) {
+    uint16_t value = word >> (lane * 16);
+    return is_signed ? (int16_t) value : value;
+}
+
+// SHADD8, UHADD8, SHADD16 and UHADD16: the lane sum shifted right by one.
+static uint32_t ref_add(uint32_t a, uint32_t b, uint8_t bits, bool is_signed) {
+    uint32_t result = 0;
+    uint32_t mask = (1 << bits) - 1;
+    for (uint8_t lane = 0; lane < 32 / bits; lane++) {
+        int32_t sum;
+        if (bits == 8) {
+            sum = lane8(a, lane, is_signed) + lane8(b, lane, is_signed);
+        } else {
+            sum = lane16(a, lane, is_signed) + lane16(b, lane, is_signed);
+        }
+        result |= ((uint32_t) (sum >> 1) & mask) << (lane * bits);
+    }
+    return result;
+}
+
+// 8 bit lanes are scaled around their midpoint by gain / 256, rounding down.
+static uint32_t ref_mult8(uint32_t val, uint32_t gain, bool is_signed) {
+    uint32_t result = 0;
+    for (uint8_t lane = 0; lane < 4; lane++) {
+        int32_t sample = lane8(val, lane, is_signed);
+        if (!is_signed) {
+            sample -= 128;
+        }
+        int32_t scaled = (sample * (int32_t) gain) >> 8;
+        if (!is_signed) {
+            scaled += 128;
+        }
+        result |= ((uint32_t) scaled & 0xff) << (lane * 8);
+    }
+    return result;
+}
+
+// SMULWB/SMULWT with a doubled Q15 level followed by SSAT to 16 bits.
+static uint32_t ref_mult16(uint32_t val, int32_t mul, bool is_signed) {
+    uint32_t result = 0;
+    for (uint8_t lane = 0; lane < 2; lane++) {
+        int32_t sample = lane16(val, lane, is_signed);
+        if (!is_signed) {
+            sample -= 32768;
+        }
+        int64_t scaled = ((int64_t) sample * (mul * 2)) >> 16;
+        if (scaled > INT16_MAX) {
+            scaled = INT16_MAX;
+        } else if (scaled < INT16_MIN) {
+            scaled = INT16_MIN;
+        }
+        if (!is_signed) {
+            scaled += 32768;
+        }
+        result |= ((uint32_t) scaled & 0xffff) << (lane * 16);
+    }
+    return result;
+}
+
+// Puts one lane value in every lane, each rotated so all lanes see all values.
+static uint32_t spread8(uint32_t value) {
+    return (value & 0xff) | ((value + 85) & 0xff) << 8 | ((value + 170) & 0xff) << 16 |
+        ((value + 255) & 0xff) << 24;
+}
+
+static void check_adds(void) {
+    bool ok8s = true;
+    bool ok8u = true;
+    // Every pair of 8 bit values in every lane.
+    for (uint32_t a = 0; a < 256; a++) {
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t wa = spread8(a);
+            uint32_t wb = spread8(b * 7 + 3);
+            ok8s = ok8s && add8signed(wa, wb) == ref_add(wa, wb, 8, true);
+            ok8u = ok8u && add8unsigned(wa, wb) == ref_add(wa, wb, 8, false);
+        }
+    }
+    check(ok8s, "add8signed matches SHADD8 for all lane pairs");
+    check(ok8u, "add8unsigned matches UHADD8 for all lane pairs");
+
+    bool ok16s = true;
+    bool ok16u = true;
+    const uint16_t edges[] = {0x0000, 0x0001, 0x7ffe, 0x7fff, 0x8000, 0x8001, 0xfffe, 0xffff};
+    for (uint8_t i = 0; i < ARRAY_SIZE(edges); i++) {
+        for (uint8_t j = 0; j < ARRAY_SIZE(edges); j++) {
+            uint32_t a = edges[i] | (uint32_t) edges[j] << 16;
+            uint32_t b = edges[j] | (uint32_t) edges[i] << 16;
+            ok16s = ok16s && add16signed(a, b) == ref_add(a, b, 16, true);
+            ok16u = ok16u && add16unsigned(a, b) == ref_add(a, b, 16, false);
+        }
+    }
+    for (uint32_t i = 0; i < RANDOM_WORDS; i++) {
+        uint32_t a = next_random();
+        uint32_t b = next_random();
+        ok16s = ok16s && add16signed(a, b) == ref_add(a, b, 16, true);
+        ok16u = ok16u && add16unsigned(a, b) == ref_add(a, b, 16, false);
+    }
+    check(ok16s, "add16signed matches SHADD16");
+    check(ok16u, "add16unsigned matches UHADD16");
+}
+
+static void check_gains(void) {
+    check(gain8(0) == 0 && gain8(INT16_MAX) == 256, "gain8 maps levels 0 and 1 to 0 and 256");
+    bool ok_gain8 = true;
+    for (int32_t level = 1; level <= INT16_MAX; level++) {
+        ok_gain8 = ok_gain8 && gain8(level) >= gain8(level - 1) && gain8(level) <= 256;
+    }
+    check(ok_gain8, "gain8 never decreases and stays within 256");
+
+    bool ok8s = true;
+    bool ok8u = true;
+    // Every 8 bit value with every gain.
+    for (uint32_t gain = 0; gain <= 256; gain++) {
+        for (uint32_t value = 0; value < 256; value++) {
+            uint32_t word = spread8(value);
+            ok8s = ok8s && mult8signed(word, gain) == ref_mult8(word, gain, true);
+            ok8u = ok8u && mult8unsigned(word, gain) == ref_mult8(word, gain, false);
+        }
+    }
+    check(ok8s, "mult8signed matches the reference for all values and gains");
+    check(ok8u, "mult8unsigned matches the reference for all values and gains");
+    check(mult8unsigned(0xff00ff00, 256) == 0xff00ff00, "mult8unsigned leaves samples at full gain");
+
+    bool ok16s = true;
+    bool ok16u = true;
+    // Every 16 bit value in both lanes with a spread of levels, including the extremes.
+    for (int32_t level = 0; level <= INT16_MAX; level += (level < 64 || level > INT16_MAX - 64) ? 1 : 257) {
+        for (uint32_t value = 0; value < 65536; value += 3) {
+            uint32_t word = value | (0xffff - value) << 16;
+            ok16s = ok16s && mult16signed(word, level) == ref_mult16(word, level, true);
+            ok16u = ok16u && mult16unsigned(word, level) == ref_mult16(word, level, false);
+        }
+    }
+    check(ok16s, "mult16signed matches SMULW and SSAT");
+    check(ok16u, "mult16unsigned matches SMULW and SSAT");
+}
+
+static void time_kernels(void) {
+    static uint32_t words[1024];
+    for (uint16_t i = 0; i < ARRAY_SIZE(words); i++) {
+        words[i] = next_random();
+    }
+    // Summed into a volatile so the loops aren't optimized away.
+    volatile uint32_t sink = 0;
+    const uint32_t rounds = 2000;
+    uint32_t count = rounds * ARRAY_SIZE(words);
+
+    uint64_t start = now_ns();
+    for (uint32_t r = 0; r < rounds; r++) {
+        uint32_t acc = r;
+        for (uint16_t i = 0; i < ARRAY_SIZE(words); i++) {
+            acc = add16signed(acc, mult16signed(words[i], 20000));
+        }
+        sink += acc;
+    }
+    report_time("16 bit signed gain and mix", now_ns() - start, count, "word");
+
+    start = now_ns();
+    for (uint32_t r = 0; r < rounds; r++) {
+        uint32_t acc = r;
+        for (uint16_t i = 0; i < ARRAY_SIZE(words); i++) {
+            acc = add8unsigned(acc, mult8unsigned(words[i], 160));
+        }
+        sink += acc;
+    }
+    report_time("8 bit unsigned gain and mix", now_ns() - start, count, "word");
+    (void) sink;
+}
+
+void mixer_bench(void) {
+    check_adds();
+    check_gains();
+    time_kernels();
+}
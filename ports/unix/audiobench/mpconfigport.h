@@ -0,0 +1,51 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+// Just enough configuration to compile the audio sample sources and FatFs without the rest of the
+// VM. Sources are built with NO_QSTR so no qstr headers need to be generated.
+
+#include <alloca.h>
+#include <stdint.h>
+
+typedef intptr_t mp_int_t;
+typedef uintptr_t mp_uint_t;
+typedef long mp_off_t;
+
+#define MICROPY_ENABLE_GC           (1)
+#define MICROPY_FLOAT_IMPL          (MICROPY_FLOAT_IMPL_FLOAT)
+#define MICROPY_VFS                 (1)
+#define MICROPY_VFS_FAT             (1)
+// The same FatFs options as py/circuitpy_mpconfig.h.
+#define MICROPY_FATFS_ENABLE_LFN    (1)
+#define MICROPY_FATFS_LFN_CODE_PAGE (437)
+#define MICROPY_FATFS_USE_LABEL     (1)
+#define MICROPY_FATFS_RPATH         (2)
+
+#define MICROPY_HW_BOARD_NAME "audiobench"
+#define MICROPY_HW_MCU_NAME "host"
+
+#define MP_STATE_PORT MP_STATE_VM
@@ -0,0 +1,242 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+// Decimates a PDM stream from a second order sigma-delta modulator with the shared PDM decimator.
+// The output is checked against golden PCM and against a bit-level reference of the same filters.
+// The input is made with integer math only so the golden output is the same on every host.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "py/misc.h"
+#include "shared-module/audiobusio/PDMDecimator.h"
+
+#include "audiobench.h"
+
+#define OUTPUT_SAMPLES (4096)
+// The decimator starts from silence rather than the stream so skip the first few samples.
+#define SETTLE_SAMPLES (16)
+#define GOLDEN_SAMPLES (16)
+#define FULL_SCALE ((int64_t) 1 << 30)
+
+// Taps of the compensating FIR, the same as in PDMDecimator.c.
+static const int16_t fir_taps[PDM_DECIMATOR_TAPS / 2] = {
+    0, -1, 2, 17, -26, -96, 124, 320,
+    -377, -824, 909, 1876, -1943, -4419, 4048, 16774
+};
+
+typedef struct {
+    uint16_t oversample;
+    // Output samples GOLDEN_SAMPLES on from SETTLE_SAMPLES.
+    int16_t samples[GOLDEN_SAMPLES];
+    // FNV-1a of all OUTPUT_SAMPLES samples.
+    uint32_t hash;
+} golden_t;
+
+// Output of the decimator when it was checked against the reference. Update these only when the
+// filter is changed on purpose.
+static const golden_t golden[] = {
+    {32, {
+        -16295, -15899, -14717, -13050, -10847, -8283, -5339, -2204,
+        967, 4172, 7162, 9905, 12281, 14113, 15511, 16209
+    }, 0x62609f5c},
+    {48, {
+        -10558, -6473, -1815, 2976, 7529, 11433, 14337, 16026,
+        16333, 15217, 12812, 9286, 4976, 239, -4541, -8905
+    }, 0x75739c7f},
+    {64, {
+        1787, 7884, 12780, 15728, 16292, 14365, 10257, 4592,
+        -1774, -7877, -12768, -15726, -16291, -14378, -10274, -4608
+    }, 0xfa4e34ec},
+    {80, {
+        13026, 16174, 15504, 11169, 4206, -3757, -10829, -15345,
+        -16243, -13308, -7227, 554, 8210, 13919, 16355, 14918
+    }, 0x0e328ef0},
+    {96, {
+        16183, 12021, 3817, -5681, -13257, -16374, -13974, -6866,
+        2555, 11113, 15929, 15377, 9646, 665, -8540, -14870
+    }, 0x6a2b9a9d},
+    {112, {
+        9291, -1376, -11419, -16280, -13761, -4992, 6038, 14328,
+        16118, 10593, 263, -10187, -16017, -14579, -6527, 4484
+    }, 0x3be52d7e},
+    {128, {
+        -3363, -13715, -16039, -8975, 3346, 13705, 16041, 8985,
+        -3332, -13699, -16047, -9000, 3314, 13688, 16049, 9011
+    }, 0xd7c594f3},
+};
+
+// Writes word_count words of PDM encoding a half scale sine. A magic circle oscillator makes the
+// sine and a second order sigma-delta modulator turns it into bits, oldest bit first.
+static void make_pdm(uint32_t* words, uint32_t word_count) {
+    int64_t x = 0;
+    int64_t y = FULL_SCALE / 2;
+    int64_t s1 = 0;
+    int64_t s2 = 0;
+    int64_t feedback = 0;
+    for (uint32_t w = 0; w < word_count; w++) {
+        uint32_t word = 0;
+        for (uint8_t b = 0; b < 32; b++) {
+            // About 1kHz at a 1MHz PDM clock.
+            x -= (y * 402) >> 16;
+            y += (x * 402) >> 16;
+            s1 += x - feedback;
+            s2 += s1 - feedback;
+            bool bit = s2 >= 0;
+            feedback = bit ? FULL_SCALE : -FULL_SCALE;
+            word = (word << 1) | bit;
+        }
+        words[w] = word;
+    }
+}
+
+static uint32_t hash_samples(const int16_t* samples, uint32_t count) {
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < count; i++) {
+        hash = (hash ^ (uint8_t) samples[i]) * 16777619u;
+        hash = (hash ^ (uint8_t) (samples[i] >> 8)) * 16777619u;
+    }
+    return hash;
+}
+
+// Runs the same CIC as one bit-level fourth order filter decimating by oversample / 2 and then the
+// FIR, both in floating point. Writes the largest difference from output after it settles.
+static int32_t reference_difference(const uint32_t* words, uint32_t word_count, uint16_t oversample,
+                                    const int16_t* output) {
+    uint32_t decimation = oversample / 2;
+    uint32_t kernel_len = 4 * decimation - 3;
+    int64_t* kernel = calloc(kernel_len, sizeof(int64_t));
+    int64_t* scratch = calloc(kernel_len, sizeof(int64_t));
+    // A box of decimation ones convolved with itself four times.
+    for (uint32_t i = 0; i < decimation; i++) {
+        kernel[i] = 1;
+    }
+    uint32_t len = decimation;
+    for (uint8_t order = 1; order < PDM_DECIMATOR_CIC_ORDER; order++) {
+        memset(scratch, 0, kernel_len * sizeof(int64_t));
+        for (uint32_t i = 0; i < len; i++) {
+            for (uint32_t j = 0; j < decimation; j++) {
+                scratch[i + j] += kernel[i];
+            }
+        }
+        len += decimation - 1;
+        memcpy(kernel, scratch, kernel_len * sizeof(int64_t));
+    }
+    double gain = pow(decimation, PDM_DECIMATOR_CIC_ORDER);
+
+    uint32_t bit_count = word_count * 32;
+    uint32_t cic_count = bit_count / decimation;
+    double* cic = calloc(cic_count, sizeof(double));
+    for (uint32_t c = 0; c < cic_count; c++) {
+        int64_t sum = 0;
+        int64_t newest = (int64_t) (c + 1) * decimation - 1;
+        for (uint32_t k = 0; k < kernel_len && newest - (int64_t) k >= 0; k++) {
+            uint32_t bit = newest - k;
+            sum += (words[bit / 32] >> (31 - bit % 32)) & 1 ? kernel[k] : -kernel[k];
+        }
+        // One at full scale going into the FIR.
+        cic[c] = sum / gain;
+    }
+
+    int32_t worst = 0;
+    for (uint32_t s = SETTLE_SAMPLES; s < cic_count / 2; s++) {
+        // Each output uses the PDM_DECIMATOR_TAPS CIC values ending at 2 * s + 1.
+        int64_t newest = 2 * (int64_t) s + 1;
+        double filtered = 0;
+        for (uint8_t i = 0; i < PDM_DECIMATOR_TAPS / 2; i++) {
+            filtered += fir_taps[i] * (cic[newest - i] + cic[newest - (PDM_DECIMATOR_TAPS - 1 - i)]);
+        }
+        double expected = MIN(MAX(filtered, INT16_MIN), INT16_MAX);
+        int32_t difference = abs(output[s] - (int32_t) lround(expected));
+        worst = MAX(worst, difference);
+    }
+    free(kernel);
+    free(scratch);
+    free(cic);
+    return worst;
+}
+
+static void bench_oversample(const golden_t* expected) {
+    uint16_t oversample = expected->oversample;
+    uint32_t word_count = OUTPUT_SAMPLES * oversample / 32;
+    uint32_t* words = malloc(word_count * sizeof(uint32_t));
+    make_pdm(words, word_count);
+    int16_t* output = malloc(OUTPUT_SAMPLES * sizeof(int16_t));
+    int16_t* chunked = malloc(OUTPUT_SAMPLES * sizeof(int16_t));
+    char what[80];
+
+    pdm_decimator_t decimator;
+    snprintf(what, sizeof(what), "%dx PDM oversample is accepted", oversample);
+    check(pdm_decimator_init(&decimator, oversample), what);
+    uint64_t start = now_ns();
+    uint32_t count = pdm_decimator_process(&decimator, words, word_count, output);
+    uint64_t elapsed_ns = now_ns() - start;
+    snprintf(what, sizeof(what), "%dx PDM makes one sample per %d bits", oversample, oversample);
+    check(count == OUTPUT_SAMPLES, what);
+
+    snprintf(what, sizeof(what), "%dx PDM matches the golden PCM", oversample);
+    check(memcmp(output + SETTLE_SAMPLES, expected->samples, sizeof(expected->samples)) == 0 &&
+          hash_samples(output, OUTPUT_SAMPLES) == expected->hash, what);
+
+    int32_t difference = reference_difference(words, word_count, oversample, output);
+    snprintf(what, sizeof(what), "%dx PDM is within %d LSB of the bit-level reference", oversample, difference);
+    check(difference <= 3, what);
+
+    int16_t peak = 0;
+    for (uint32_t s = SETTLE_SAMPLES; s < OUTPUT_SAMPLES; s++) {
+        peak = MAX(peak, abs(output[s]));
+    }
+    snprintf(what, sizeof(what), "%dx PDM half scale sine peaks at %d", oversample, peak);
+    check(peak > 15000 && peak < 17500, what);
+
+    // Odd sized pieces carry state over between calls.
+    pdm_decimator_reset(&decimator);
+    uint32_t samples = 0;
+    for (uint32_t w = 0; w < word_count; w += 7) {
+        samples += pdm_decimator_process(&decimator, words + w, MIN(7, word_count - w), chunked + samples);
+    }
+    snprintf(what, sizeof(what), "%dx PDM in pieces matches one call", oversample);
+    check(samples == OUTPUT_SAMPLES && memcmp(output, chunked, OUTPUT_SAMPLES * sizeof(int16_t)) == 0, what);
+
+    snprintf(what, sizeof(what), "%dx PDM decimation", oversample);
+    report_time(what, elapsed_ns, OUTPUT_SAMPLES, "sample");
+
+    free(words);
+    free(output);
+    free(chunked);
+}
+
+void pdm_bench(void) {
+    pdm_decimator_t decimator;
+    check(!pdm_decimator_init(&decimator, 16) && !pdm_decimator_init(&decimator, 72) &&
+          !pdm_decimator_init(&decimator, 144), "Unsupported PDM oversample is rejected");
+    for (uint8_t i = 0; i < ARRAY_SIZE(golden); i++) {
+        bench_oversample(&golden[i]);
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+// The runtime functions the audio sources call, and a FAT filesystem in RAM for WaveFile to read.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lib/oofatfs/ff.h"
+#include "lib/oofatfs/diskio.h"
+#include "py/runtime.h"
+
+#include "audiobench.h"
+
+#define RAMDISK_SECTORS (8192)
+
+static uint8_t ramdisk[RAMDISK_SECTORS][_MIN_SS];
+static FATFS fatfs;
+
+void *m_malloc(size_t num_bytes, bool long_lived) {
+    return malloc(num_bytes);
+}
+
+void *m_malloc_maybe(size_t num_bytes, bool long_lived) {
+    return malloc(num_bytes);
+}
+
+void m_free(void *ptr) {
+    free(ptr);
+}
+
+const compressed_string_t* translate(const char* c) {
+    return (const compressed_string_t*) c;
+}
+
+// Nothing here expects an error so report it and stop.
+NORETURN static void raise(const char* kind, const compressed_string_t *msg) {
+    printf("%s: %s\n", kind, msg == NULL ? "" : (const char*) msg);
+    abort();
+}
+
+NORETURN void mp_raise_ValueError(const compressed_string_t *msg) {
+    raise("ValueError", msg);
+}
+
+NORETURN void mp_raise_OSError(int errno_) {
+    raise("OSError", NULL);
+}
+
+NORETURN void mp_raise_msg(const mp_obj_type_t *exc_type, const compressed_string_t *msg) {
+    raise("Exception", msg);
+}
+
+const mp_obj_type_t mp_type_MemoryError;
+
+typedef struct _mp_obj_none_t {
+    mp_obj_base_t base;
+} mp_obj_none_t;
+const mp_obj_none_t mp_const_none_obj;
+
+DRESULT disk_read(void *drv, BYTE *buff, DWORD sector, UINT count) {
+    if (sector + count > RAMDISK_SECTORS) {
+        return RES_PARERR;
+    }
+    memcpy(buff, ramdisk[sector], count * _MIN_SS);
+    return RES_OK;
+}
+
+DRESULT disk_write(void *drv, const BYTE *buff, DWORD sector, UINT count) {
+    if (sector + count > RAMDISK_SECTORS) {
+        return RES_PARERR;
+    }
+    memcpy(ramdisk[sector], buff, count * _MIN_SS);
+    return RES_OK;
+}
+
+DRESULT disk_ioctl(void *drv, BYTE cmd, void *buff) {
+    switch (cmd) {
+        case CTRL_SYNC:
+            return RES_OK;
+        case GET_SECTOR_COUNT:
+            *((DWORD*) buff) = RAMDISK_SECTORS;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *((WORD*) buff) = _MIN_SS;
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *((DWORD*) buff) = 1;
+            return RES_OK;
+        case IOCTL_INIT:
+        case IOCTL_STATUS:
+            *((DSTATUS*) buff) = 0;
+            return RES_OK;
+        default:
+            return RES_PARERR;
+    }
+}
+
+FATFS* ramdisk_mount(void) {
+    if (fatfs.fs_type != 0) {
+        return &fatfs;
+    }
+    static uint8_t working_buf[_MAX_SS];
+    if (f_mkfs(&fatfs, FM_FAT, 0, working_buf, sizeof(working_buf)) != FR_OK ||
+        f_mount(&fatfs) != FR_OK) {
+        printf("Couldn't create the RAM disk\n");
+        abort();
+    }
+    return &fatfs;
+}
+
+bool ramdisk_write_file(const char* path, const uint8_t* data, uint32_t len) {
+    FIL fp;
+    UINT written;
+    if (f_open(ramdisk_mount(), &fp, path, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) {
+        return false;
+    }
+    bool ok = f_write(&fp, data, len, &written) == FR_OK && written == len;
+    return f_close(&fp) == FR_OK && ok;
+}
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+// Renders synthio voices on the host. Checks that note changes and waveform arrays that change
+// size are handled and reports how many voices fit in one percent of the CPU.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "shared-bindings/synthio/Synthesizer.h"
+#include "shared-bindings/synthio/Voice.h"
+
+#include "audiobench.h"
+
+#define SAMPLE_RATE (22050)
+#define BUFFER_SIZE (1024)
+#define MAX_VOICES (16)
+#define BENCH_SECONDS (20)
+
+// Waveform "arrays" are mp_buffer_info_t structs here so tests can resize them.
+bool mp_get_buffer(mp_obj_t obj, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    *bufinfo = *((mp_buffer_info_t*) MP_OBJ_TO_PTR(obj));
+    return true;
+}
+
+static synthio_synthesizer_obj_t* new_synthesizer(uint8_t voice_count) {
+    synthio_synthesizer_obj_t* self = malloc(sizeof(synthio_synthesizer_obj_t) + voice_count * sizeof(mp_obj_t));
+    memset(self, 0, sizeof(synthio_synthesizer_obj_t));
+    common_hal_synthio_synthesizer_construct(self, voice_count, BUFFER_SIZE, SAMPLE_RATE);
+    for (uint8_t v = 0; v < voice_count; v++) {
+        synthio_voice_obj_t* voice = malloc(sizeof(synthio_voice_obj_t));
+        common_hal_synthio_voice_construct(voice);
+        common_hal_synthio_voice_set_parent(voice, self);
+        self->voice[v] = MP_OBJ_FROM_PTR(voice);
+    }
+    return self;
+}
+
+static void free_synthesizer(synthio_synthesizer_obj_t* self) {
+    for (uint8_t v = 0; v < self->voice_count; v++) {
+        free(MP_OBJ_TO_PTR(self->voice[v]));
+    }
+    free(self);
+}
+
+static synthio_voice_obj_t* voice(synthio_synthesizer_obj_t* self, uint8_t v) {
+    return MP_OBJ_TO_PTR(self->voice[v]);
+}
+
+// Renders one buffer and returns its samples. The length is in samples.
+static int16_t* render(synthio_synthesizer_obj_t* self, uint32_t* length) {
+    uint8_t* buffer;
+    uint32_t buffer_length;
+    synthio_synthesizer_get_buffer(self, false, 0, &buffer, &buffer_length);
+    *length = buffer_length / sizeof(int16_t);
+    return (int16_t*) buffer;
+}
+
+static int32_t peak(const int16_t* samples, uint32_t length) {
+    int32_t result = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        result = MAX(result, abs(samples[i]));
+    }
+    return result;
+}
+
+static void check_notes(void) {
+    synthio_synthesizer_obj_t* synth = new_synthesizer(2);
+    uint32_t length;
+    int16_t* samples = render(synth, &length);
+    check(peak(samples, length) == 0, "synthio is silent with no notes");
+
+    common_hal_synthio_voice_note_on(voice(synth, 0), 441, 0.5);
+    render(synth, &length);
+    samples = render(synth, &length);
+    int32_t level = peak(samples, length);
+    check(level > 16000 && level <= 16384, "synthio half amplitude sine peaks at half scale");
+
+    common_hal_synthio_voice_note_off(voice(synth, 0));
+    samples = render(synth, &length);
+    // The release ramps down across one buffer rather than stopping at once.
+    check(abs(samples[0]) > 0 || abs(samples[1]) > 0, "synthio note off ramps down");
+    samples = render(synth, &length);
+    check(peak(samples, length) == 0 && !common_hal_synthio_synthesizer_get_playing(synth),
+        "synthio note off ends in silence");
+    free_synthesizer(synth);
+}
+
+static void check_waveform_resize(void) {
+    synthio_synthesizer_obj_t* synth = new_synthesizer(1);
+    int16_t* square = malloc(4 * sizeof(int16_t));
+    square[0] = square[1] = 8000;
+    square[2] = square[3] = -8000;
+    mp_buffer_info_t array = { .buf = square, .len = 4 * sizeof(int16_t), .typecode = 'h' };
+    common_hal_synthio_voice_set_waveform(voice(synth, 0), MP_OBJ_FROM_PTR(&array));
+    common_hal_synthio_voice_note_on(voice(synth, 0), 441, 1);
+    uint32_t length;
+    render(synth, &length);
+    int32_t level = peak(render(synth, &length), length);
+    check(level > 7900 && level <= 8000, "synthio plays a voice's own waveform");
+
+    // Growing an array moves it. The old memory is freed so a stale pointer would be caught by
+    // the address sanitizer, and the new samples must be heard.
+    int16_t* bigger = malloc(8 * sizeof(int16_t));
+    for (uint8_t i = 0; i < 8; i++) {
+        bigger[i] = i < 4 ? 20000 : -20000;
+    }
+    free(square);
+    array.buf = bigger;
+    array.len = 8 * sizeof(int16_t);
+    level = peak(render(synth, &length), length);
+    check(level > 19900 && level <= 20000, "synthio follows a waveform array that moved");
+
+    array.len = sizeof(int16_t);
+    check(peak(render(synth, &length), length) == 0, "synthio is silent with a 1 sample waveform");
+    free(bigger);
+    free_synthesizer(synth);
+}
+
+// Renders BENCH_SECONDS of audio with voice_count notes and returns the percent of the CPU used.
+static double cpu_percent(uint8_t voice_count) {
+    synthio_synthesizer_obj_t* synth = new_synthesizer(voice_count);
+    for (uint8_t v = 0; v < voice_count; v++) {
+        common_hal_synthio_voice_note_on(voice(synth, v), 110 * (v + 1), 1.0f / voice_count);
+    }
+    uint32_t length;
+    render(synth, &length);
+    uint32_t buffers = BENCH_SECONDS * SAMPLE_RATE / length;
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < buffers; i++) {
+        render(synth, &length);
+    }
+    uint64_t elapsed = now_ns() - start;
+    free_synthesizer(synth);
+    double audio_ns = (double) buffers * length * 1e9 / SAMPLE_RATE;
+    return elapsed * 100 / audio_ns;
+}
+
+static void bench_voices(void) {
+    char what[80];
+    for (uint8_t voice_count = 1; voice_count <= MAX_VOICES; voice_count *= 2) {
+        double percent = cpu_percent(voice_count);
+        snprintf(what, sizeof(what), "synthio %2d voices at %dHz", voice_count, SAMPLE_RATE);
+        printf("%-60s %8.4f %% CPU, %.0f voices per %% CPU\n", what, percent, voice_count / percent);
+    }
+}
+
+void synth_bench(void) {
+    check_notes();
+    check_waveform_resize();
+    bench_voices();
+}
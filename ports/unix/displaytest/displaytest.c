@@ -0,0 +1,381 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+// Checks the TileGrid change tracking, the terminal and text rendering that draw into it and the
+// RLE bitmap decoder on the host:
+//
+//   displaytest
+//
+// Prints each check and exits non-zero if any of them fail.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/displayio/RLEBitmap.h"
+#include "shared-bindings/displayio/TileGrid.h"
+#include "shared-module/displayio/area.h"
+#include "shared-bindings/fontio/__init__.h"
+#include "shared-bindings/fontio/BinaryFont.h"
+#include "shared-bindings/fontio/BuiltinFont.h"
+#include "shared-bindings/terminalio/Terminal.h"
+
+// Stands in for the bitmap and pixel shader. It isn't any of the types TileGrid knows how to draw
+// so only the change tracking is exercised.
+static const mp_obj_type_t placeholder_type;
+static const mp_obj_base_t placeholder = { &placeholder_type };
+
+// The GC hands out cleared blocks and Bitmap relies on that.
+void *m_malloc(size_t num_bytes, bool long_lived) {
+    return calloc(1, num_bytes);
+}
+
+const compressed_string_t* translate(const char* c) {
+    return (const compressed_string_t*) c;
+}
+
+void mp_raise_ValueError(const compressed_string_t *msg) {
+    printf("ValueError: %s\n", (const char*) msg);
+    abort();
+}
+
+void mp_raise_NotImplementedError(const compressed_string_t *msg) {
+    printf("NotImplementedError: %s\n", (const char*) msg);
+    abort();
+}
+
+void mp_raise_RuntimeError(const compressed_string_t *msg) {
+    printf("RuntimeError: %s\n", (const char*) msg);
+    abort();
+}
+
+// A buffer whose storage can be moved, like a bytearray that is resized.
+typedef struct {
+    mp_obj_base_t base;
+    uint8_t* data;
+    size_t len;
+} movable_buffer_t;
+
+static const mp_obj_type_t movable_buffer_type;
+
+bool mp_get_buffer(mp_obj_t obj, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    movable_buffer_t* buffer = MP_OBJ_TO_PTR(obj);
+    if (buffer->base.type != &movable_buffer_type) {
+        return false;
+    }
+    bufinfo->buf = buffer->data;
+    bufinfo->len = buffer->len;
+    bufinfo->typecode = 'B';
+    return true;
+}
+
+void mp_get_buffer_raise(mp_obj_t obj, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    if (!mp_get_buffer(obj, bufinfo, flags)) {
+        abort();
+    }
+}
+
+// Moves the buffer's data as a bytearray resize would and wipes the old copy before freeing it.
+static void move_buffer(movable_buffer_t* buffer) {
+    uint8_t* moved = malloc(buffer->len + 16);
+    memcpy(moved, buffer->data, buffer->len);
+    memset(buffer->data, 0, buffer->len);
+    free(buffer->data);
+    buffer->data = moved;
+}
+
+// ASCII only, like the built in terminal font without its extra glyphs.
+uint8_t fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_uint_t codepoint) {
+    if (codepoint >= 0x20 && codepoint <= 0x7e) {
+        return codepoint - 0x20;
+    }
+    return 0xff;
+}
+
+static bool failed = false;
+
+static void check(bool ok, const char* what) {
+    printf("%-60s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) {
+        failed = true;
+    }
+}
+
+static const displayio_buffer_transform_t identity = {
+    .x = 0, .y = 0, .dx = 1, .dy = 1, .scale = 1, .width = 80, .height = 48,
+};
+
+// A 10x6 grid of 8x8 tiles that has been drawn once.
+static void new_tilegrid(displayio_tilegrid_t* grid) {
+    memset(grid, 0, sizeof(*grid));
+    common_hal_displayio_tilegrid_construct(grid, MP_OBJ_FROM_PTR(&placeholder), 16, 8,
+        MP_OBJ_FROM_PTR(&placeholder), 10, 6, 8, 8, 0, 0, 0);
+    displayio_tilegrid_update_transform(grid, &identity);
+    displayio_tilegrid_get_refresh_areas(grid, NULL);
+    displayio_tilegrid_finish_refresh(grid);
+}
+
+static bool area_contains(const displayio_area_t* outer, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    return outer != NULL && outer->x1 <= x1 && outer->y1 <= y1 && outer->x2 >= x2 && outer->y2 >= y2;
+}
+
+static void test_scroll_and_back(void) {
+    displayio_tilegrid_t grid;
+    new_tilegrid(&grid);
+    // Tile (3, 0) is drawn at pixels (24, 0) to (32, 8).
+    common_hal_displayio_tilegrid_set_tile(&grid, 3, 0, 1);
+    common_hal_displayio_tilegrid_set_top_left(&grid, 0, 2);
+    common_hal_displayio_tilegrid_set_top_left(&grid, 0, 0);
+    displayio_area_t* area = displayio_tilegrid_get_refresh_areas(&grid, NULL);
+    check(!grid.full_change, "scroll down and back is not a full redraw");
+    check(area_contains(area, 24, 0, 32, 8), "scroll down and back keeps the changed tile dirty");
+    displayio_tilegrid_finish_refresh(&grid);
+
+    common_hal_displayio_tilegrid_set_tile(&grid, 5, 5, 1);
+    common_hal_displayio_tilegrid_set_top_left(&grid, 0, 4);
+    common_hal_displayio_tilegrid_set_top_left(&grid, 0, 0);
+    area = displayio_tilegrid_get_refresh_areas(&grid, NULL);
+    check(area_contains(area, 40, 40, 48, 48), "scroll up and back keeps the changed tile dirty");
+    displayio_tilegrid_finish_refresh(&grid);
+}
+
+static void test_scroll_moves_dirty_area(void) {
+    displayio_tilegrid_t grid;
+    new_tilegrid(&grid);
+    common_hal_displayio_tilegrid_set_tile(&grid, 2, 4, 1);
+    common_hal_displayio_tilegrid_set_top_left(&grid, 0, 1);
+    // Row 4 is now shown as the fourth row.
+    check(area_contains(&grid.dirty_area, 16, 24, 24, 32), "scroll moves the dirty area with the content");
+    displayio_tilegrid_finish_refresh(&grid);
+}
+
+static const fontio_builtinfont_t font;
+
+static bool row_is(displayio_tilegrid_t* grid, uint16_t row, const char* text) {
+    for (uint16_t x = 0; x < grid->width_in_tiles; x++) {
+        uint8_t expected = 0;
+        if (*text != '\0') {
+            expected = *text++ - 0x20;
+        }
+        if (common_hal_displayio_tilegrid_get_tile(grid, x, row) != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_terminal_wide_rows(void) {
+    // Wider than the terminal's glyph buffer so rows are written in several runs.
+    displayio_tilegrid_t grid;
+    memset(&grid, 0, sizeof(grid));
+    common_hal_displayio_tilegrid_construct(&grid, MP_OBJ_FROM_PTR(&placeholder), 16, 8,
+        MP_OBJ_FROM_PTR(&placeholder), 100, 4, 6, 12, 0, 0, 0);
+    terminalio_terminal_obj_t terminal;
+    common_hal_terminalio_terminal_construct(&terminal, &grid, &font);
+
+    char line[131];
+    for (int i = 0; i < 130; i++) {
+        line[i] = 'A' + i % 26;
+    }
+    line[130] = '\0';
+    int errcode;
+    common_hal_terminalio_terminal_write(&terminal, (const byte*) line, 130, &errcode);
+    check(row_is(&grid, 0, line), "terminal writes a full 100 column row");
+    check(row_is(&grid, 1, line + 100), "terminal wraps the rest onto the next row");
+    check(terminal.cursor_x == 30 && terminal.cursor_y == 1, "terminal cursor follows the wrap");
+
+    const char* edit = "\r\n0123456789\b\b\b\x1b[Kxy";
+    common_hal_terminalio_terminal_write(&terminal, (const byte*) edit, strlen(edit), &errcode);
+    check(row_is(&grid, 2, "0123456xy"), "terminal backspace and clear to end of line");
+}
+
+static void test_render_wide_tilegrid(void) {
+    // Wider than the renderer's tile buffer so the line is written in several runs.
+    displayio_tilegrid_t grid;
+    memset(&grid, 0, sizeof(grid));
+    common_hal_displayio_tilegrid_construct(&grid, MP_OBJ_FROM_PTR(&placeholder), 16, 8,
+        MP_OBJ_FROM_PTR(&placeholder), 100, 2, 6, 12, 0, 0, 0);
+    grid.base.type = &displayio_tilegrid_type;
+    fontio_builtinfont_t tile_font = { .base = { &fontio_builtinfont_type }, .width = 6, .height = 12 };
+
+    char line[101];
+    for (int i = 0; i < 100; i++) {
+        line[i] = 'a' + i % 26;
+    }
+    line[100] = '\0';
+    uint16_t width;
+    uint16_t height;
+    common_hal_fontio_render_text((const uint8_t*) line, 100, MP_OBJ_FROM_PTR(&tile_font),
+        MP_OBJ_FROM_PTR(&grid), 0, 0, 0, 1, &width, &height);
+    check(row_is(&grid, 0, line), "render_text writes a full 100 column row");
+    check(width == 100 && height == 1, "render_text measures the row in tiles");
+
+    // Text that starts off the left edge only writes the visible part.
+    common_hal_fontio_render_text((const uint8_t*) line, 100, MP_OBJ_FROM_PTR(&tile_font),
+        MP_OBJ_FROM_PTR(&grid), -40, 1, 0, 1, &width, &height);
+    check(row_is(&grid, 1, line + 40), "render_text clips a row that starts off the grid");
+}
+
+// One glyph for 'A', 8 pixels wide and 2 high, with a full top row and the ends of the bottom row.
+static const uint8_t font_data[] = {
+    'B', 'F', 'N', 'T', 2, 2, 8, 0, 1, 0, 0, 0,
+    'A', 0, 8, 2, 0, 0, 8, 0, 0, 0, 0, 0,
+    0xff, 0x81,
+};
+
+static void test_binary_font_moved_buffer(void) {
+    movable_buffer_t buffer = { .base = { &movable_buffer_type }, .len = sizeof(font_data) };
+    buffer.data = malloc(sizeof(font_data));
+    memcpy(buffer.data, font_data, sizeof(font_data));
+    fontio_binaryfont_t binary_font = { .base = { &fontio_binaryfont_type } };
+    common_hal_fontio_binaryfont_construct(&binary_font, MP_OBJ_FROM_PTR(&buffer), buffer.data,
+        buffer.len);
+
+    move_buffer(&buffer);
+
+    displayio_bitmap_t bitmap;
+    memset(&bitmap, 0, sizeof(bitmap));
+    bitmap.base.type = &displayio_bitmap_type;
+    // Packed pixels assume a 32 bit size_t so use a byte per pixel on the host.
+    common_hal_displayio_bitmap_construct(&bitmap, 16, 4, 8);
+    uint16_t width;
+    uint16_t height;
+    common_hal_fontio_render_text((const uint8_t*) "A", 1, MP_OBJ_FROM_PTR(&binary_font),
+        MP_OBJ_FROM_PTR(&bitmap), 4, 1, 0, 1, &width, &height);
+    bool ok = width == 8 && height == 2;
+    for (int16_t y = 0; y < 4; y++) {
+        for (int16_t x = 0; x < 16; x++) {
+            bool inside = x >= 4 && x < 12;
+            bool expected = (y == 1 && inside) || (y == 2 && (x == 4 || x == 11));
+            ok = ok && common_hal_displayio_bitmap_get_pixel(&bitmap, x, y) == (expected ? 1 : 0);
+        }
+    }
+    check(ok, "BinaryFont renders from a buffer that moved");
+    free(buffer.data);
+}
+
+// Wraps RLE data in a BMP header and returns a buffer object for it.
+static movable_buffer_t rle_bmp(uint16_t width, uint16_t height, bool rle4, const uint8_t* rle, size_t rle_len) {
+    size_t len = 54 + rle_len;
+    uint8_t* bmp = calloc(1, len);
+    memcpy(bmp, "BM", 2);
+    bmp[10] = 54;
+    bmp[14] = 40;
+    bmp[18] = width & 0xff;
+    bmp[19] = width >> 8;
+    bmp[22] = height & 0xff;
+    bmp[23] = height >> 8;
+    bmp[26] = 1;
+    bmp[28] = rle4 ? 4 : 8;
+    bmp[30] = rle4 ? 2 : 1;
+    memcpy(bmp + 54, rle, rle_len);
+    movable_buffer_t buffer = { .base = { &movable_buffer_type }, .data = bmp, .len = len };
+    return buffer;
+}
+
+static bool rle_rows_are(displayio_rlebitmap_t* bitmap, const uint8_t* expected) {
+    for (int16_t y = 0; y < bitmap->height; y++) {
+        for (int16_t x = 0; x < bitmap->width; x++) {
+            if (common_hal_displayio_rlebitmap_get_pixel(bitmap, x, y) != *expected++) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static displayio_rlebitmap_t* new_rlebitmap(movable_buffer_t* buffer) {
+    displayio_rlebitmap_t* bitmap = calloc(1, sizeof(displayio_rlebitmap_t));
+    common_hal_displayio_rlebitmap_construct(bitmap, NULL, MP_OBJ_FROM_PTR(buffer), buffer->data, buffer->len);
+    return bitmap;
+}
+
+static void test_rle8(void) {
+    // Rows are stored bottom up.
+    static const uint8_t rle[] = {
+        1, 5, 0, 3, 6, 7, 8, 0, 0, 0, // encoded run then a padded absolute run of three
+        0, 2, 1, 0, 3, 9, 0, 0,       // skip one pixel then an encoded run
+        0, 4, 1, 2, 3, 4, 0, 0,       // absolute run of four
+        0, 1,
+    };
+    static const uint8_t expected[] = {
+        1, 2, 3, 4,
+        0, 9, 9, 9,
+        5, 6, 7, 8,
+    };
+    movable_buffer_t buffer = rle_bmp(4, 3, false, rle, sizeof(rle));
+    displayio_rlebitmap_t* bitmap = new_rlebitmap(&buffer);
+    check(rle_rows_are(bitmap, expected), "RLE8 runs, absolute runs and deltas");
+
+    // Decoded rows are cached so start over with a fresh bitmap after the move.
+    bitmap = new_rlebitmap(&buffer);
+    move_buffer(&buffer);
+    check(rle_rows_are(bitmap, expected), "RLE8 decodes from a buffer that moved");
+}
+
+static void test_rle4(void) {
+    static const uint8_t rle[] = {
+        4, 0x34, 0, 0,               // encoded run alternating nibbles
+        0, 3, 0x56, 0x70, 0, 2, 0, 1, // absolute run of three then a delta down a row
+        1, 0xa0, 0, 0,               // continues at the delta's x
+        0, 1,
+    };
+    static const uint8_t expected[] = {
+        0, 0, 0, 10,
+        5, 6, 7, 0,
+        3, 4, 3, 4,
+    };
+    movable_buffer_t buffer = rle_bmp(4, 3, true, rle, sizeof(rle));
+    check(rle_rows_are(new_rlebitmap(&buffer), expected), "RLE4 runs, absolute runs and deltas");
+}
+
+static void test_rle_truncated(void) {
+    // The absolute run is cut off after two of its four pixels and the top row is missing.
+    static const uint8_t rle[] = {
+        2, 6, 0, 4, 1, 2,
+    };
+    static const uint8_t expected[] = {
+        0, 0, 0, 0,
+        6, 6, 1, 2,
+    };
+    movable_buffer_t buffer = rle_bmp(4, 2, false, rle, sizeof(rle));
+    check(rle_rows_are(new_rlebitmap(&buffer), expected), "truncated RLE data decodes as zeros");
+}
+
+int main(void) {
+    test_scroll_and_back();
+    test_scroll_moves_dirty_area();
+    test_terminal_wide_rows();
+    test_render_wide_tilegrid();
+    test_binary_font_moved_buffer();
+    test_rle8();
+    test_rle4();
+    test_rle_truncated();
+    return failed ? 1 : 0;
+}
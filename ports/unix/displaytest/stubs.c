@@ -0,0 +1,63 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+// Everything TileGrid links against for drawing. The tests never draw so the types are never
+// matched and the functions are never called.
+
+#include <stdlib.h>
+
+#include "py/obj.h"
+
+const mp_obj_type_t displayio_bitmap_type;
+const mp_obj_type_t displayio_colorconverter_type;
+const mp_obj_type_t displayio_ondiskbitmap_type;
+const mp_obj_type_t displayio_palette_type;
+const mp_obj_type_t displayio_rlebitmap_type;
+const mp_obj_type_t displayio_shape_type;
+const mp_obj_type_t displayio_tilegrid_type;
+const mp_obj_type_t fontio_binaryfont_type;
+const mp_obj_type_t fontio_builtinfont_type;
+typedef struct _mp_obj_none_t {
+    mp_obj_base_t base;
+} mp_obj_none_t;
+const mp_obj_none_t mp_const_none_obj;
+
+#define UNUSED_STUB(name) void name(void); void name(void) { abort(); }
+UNUSED_STUB(common_hal_displayio_ondiskbitmap_get_pixel)
+UNUSED_STUB(common_hal_displayio_shape_get_pixel)
+UNUSED_STUB(displayio_colorconverter_convert)
+UNUSED_STUB(displayio_colorconverter_finish_refresh)
+UNUSED_STUB(displayio_colorconverter_needs_refresh)
+UNUSED_STUB(displayio_palette_finish_refresh)
+UNUSED_STUB(displayio_palette_get_color)
+UNUSED_STUB(displayio_palette_needs_refresh)
+UNUSED_STUB(f_lseek)
+UNUSED_STUB(f_read)
+
+mp_obj_t mp_obj_new_tuple(size_t n, const mp_obj_t *items) {
+    abort();
+}
@@ -0,0 +1,370 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Runs a FAT workload against supervisor/shared/external_flash on top of a simulated SPI flash
+// chip and reports how much flash work each phase caused. Use it to compare cache and wear
+// changes without hardware:
+//
+//   flashbench [-s supervisor_bytes] [-H] [-i image_file]
+//
+// -s sets how much supervisor memory the flash cache may use, -H stops it from falling back to
+// the heap and -i keeps the flash image in a file between runs.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lib/oofatfs/ff.h"
+#include "lib/oofatfs/diskio.h"
+#include "py/mpstate.h"
+#include "supervisor/flash.h"
+#include "supervisor/memory.h"
+#include "supervisor/port.h"
+#include "supervisor/shared/external_flash/external_flash.h"
+
+#include "spi_flash_sim.h"
+
+// Typical NOR timings used to estimate how long each phase keeps the flash busy.
+#define SECTOR_ERASE_US     (45000)
+#define PAGE_PROGRAM_US     (700)
+#define READ_BYTE_NS        (1000) // 8MHz SPI
+
+#define LIBRARY_FILES       (40)
+#define LOG_LINES           (1000)
+#define CODE_EDITS          (30)
+#define CODE_SIZE           (3000)
+
+mp_state_ctx_t mp_state_ctx;
+
+extern const external_flash_device possible_devices[];
+
+static uint32_t* supervisor_pool;
+static uint32_t supervisor_pool_size;
+static bool heap_enabled = true;
+
+// Supervisor memory normally lives between the stack limit and top.
+uint32_t *port_stack_get_limit(void) {
+    return supervisor_pool;
+}
+
+uint32_t *port_stack_get_top(void) {
+    return supervisor_pool + supervisor_pool_size / sizeof(uint32_t);
+}
+
+void supervisor_display_move_memory(void) {
+}
+
+void *m_malloc_maybe(size_t num_bytes, bool long_lived) {
+    if (!heap_enabled) {
+        return NULL;
+    }
+    return malloc(num_bytes);
+}
+
+void m_free(void *ptr) {
+    free(ptr);
+}
+
+void temp_status_color(uint32_t rgb) {
+}
+
+void clear_temp_status(void) {
+}
+
+void common_hal_mcu_delay_us(uint32_t delay) {
+}
+
+DRESULT disk_read(void *drv, BYTE *buff, DWORD sector, UINT count) {
+    return supervisor_flash_read_blocks(buff, sector, count) == 0 ? RES_OK : RES_ERROR;
+}
+
+DRESULT disk_write(void *drv, const BYTE *buff, DWORD sector, UINT count) {
+    return supervisor_flash_write_blocks(buff, sector, count) == 0 ? RES_OK : RES_ERROR;
+}
+
+DRESULT disk_ioctl(void *drv, BYTE cmd, void *buff) {
+    switch (cmd) {
+        case CTRL_SYNC:
+            supervisor_flash_flush();
+            supervisor_flash_commit_trimmed_blocks();
+            return RES_OK;
+        case GET_SECTOR_COUNT:
+            *((DWORD*) buff) = supervisor_flash_get_block_count();
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *((WORD*) buff) = supervisor_flash_get_block_size();
+            return RES_OK;
+        case CTRL_TRIM: {
+            DWORD *range = buff;
+            supervisor_flash_trim_blocks(range[0], range[1] - range[0] + 1);
+            return RES_OK;
+        }
+        case GET_BLOCK_SIZE:
+            *((DWORD*) buff) = 1;
+            return RES_OK;
+        case IOCTL_INIT:
+        case IOCTL_STATUS:
+            *((DSTATUS*) buff) = 0;
+            return RES_OK;
+        default:
+            return RES_PARERR;
+    }
+}
+
+static FATFS fatfs;
+static bool failed = false;
+static uint32_t background_erases;
+
+// What the supervisor does between VM steps: flush the cache and then do background flash work.
+// Erases started here don't hold up the workload so they are counted separately.
+static void idle(void) {
+    supervisor_flash_flush();
+    uint32_t erases = spi_flash_sim_stats.erases;
+    for (uint8_t i = 0; i < SPI_FLASH_TRIMMED_SECTORS; i++) {
+        supervisor_flash_background();
+    }
+    background_erases += spi_flash_sim_stats.erases - erases;
+    spi_flash_sim_stats.erases = erases;
+}
+
+static void check(FRESULT res, const char* what) {
+    if (res != FR_OK) {
+        printf("%s failed: %d\n", what, res);
+        failed = true;
+    }
+}
+
+// File contents are generated from the file number so they can be checked later.
+static void fill(uint8_t* buffer, size_t length, uint32_t seed, size_t offset) {
+    for (size_t i = 0; i < length; i++) {
+        uint32_t x = (offset + i) * 2654435761u ^ seed * 40503u;
+        buffer[i] = x >> 24;
+    }
+}
+
+static uint32_t library_file_size(uint32_t i) {
+    return 1000 + (i * 7919) % 15000;
+}
+
+static void write_file(const char* path, uint32_t seed, uint32_t size, uint32_t chunk) {
+    FIL fp;
+    uint8_t buffer[FILESYSTEM_BLOCK_SIZE];
+    check(f_open(&fatfs, &fp, path, FA_WRITE | FA_CREATE_ALWAYS), path);
+    for (uint32_t offset = 0; offset < size; offset += chunk) {
+        uint32_t length = size - offset < chunk ? size - offset : chunk;
+        fill(buffer, length, seed, offset);
+        UINT written;
+        check(f_write(&fp, buffer, length, &written), path);
+    }
+    check(f_close(&fp), path);
+}
+
+static bool file_matches(const char* path, uint32_t seed, uint32_t size) {
+    FIL fp;
+    uint8_t buffer[FILESYSTEM_BLOCK_SIZE];
+    uint8_t expected[FILESYSTEM_BLOCK_SIZE];
+    if (f_open(&fatfs, &fp, path, FA_READ) != FR_OK) {
+        return false;
+    }
+    bool ok = f_size(&fp) == size;
+    for (uint32_t offset = 0; ok && offset < size; offset += sizeof(buffer)) {
+        UINT length;
+        ok = f_read(&fp, buffer, sizeof(buffer), &length) == FR_OK;
+        fill(expected, length, seed, offset);
+        ok = ok && memcmp(buffer, expected, length) == 0;
+    }
+    f_close(&fp);
+    return ok;
+}
+
+static void report(const char* phase) {
+    static uint32_t last_flush_count = 0;
+    uint32_t flush_count = external_flash_get_flush_count();
+    spi_flash_sim_stats_t* stats = &spi_flash_sim_stats;
+    uint64_t busy_us = (uint64_t) stats->erases * SECTOR_ERASE_US +
+        (uint64_t) stats->page_programs * PAGE_PROGRAM_US +
+        stats->bytes_read * READ_BYTE_NS / 1000;
+    printf("%-10s %7u %8u %9u %9llu %9llu %8u %9u %9llu\n", phase,
+        stats->erases,
+        background_erases,
+        stats->page_programs,
+        (unsigned long long) stats->bytes_programmed / 1024,
+        (unsigned long long) stats->bytes_read / 1024,
+        spi_flash_sim_max_sector_erases(),
+        flush_count - last_flush_count,
+        (unsigned long long) busy_us / 1000);
+    if (stats->protocol_errors > 0) {
+        printf("%u protocol errors\n", stats->protocol_errors);
+        failed = true;
+    }
+    last_flush_count = flush_count;
+    background_erases = 0;
+    spi_flash_sim_reset_stats();
+}
+
+// Like filesystem_init() creating CIRCUITPY.
+static void format(void) {
+    uint8_t working_buf[_MAX_SS];
+    check(f_mkfs(&fatfs, FM_FAT, 0, working_buf, sizeof(working_buf)), "mkfs");
+    supervisor_flash_flush();
+    check(f_setlabel(&fatfs, "CIRCUITPY"), "setlabel");
+    check(f_mkdir(&fatfs, "/lib"), "mkdir");
+    supervisor_flash_flush();
+}
+
+// A library bundle copied over USB. The host writes whole blocks and syncs at the end.
+static void copy_library(void) {
+    char path[32];
+    for (uint32_t i = 0; i < LIBRARY_FILES; i++) {
+        snprintf(path, sizeof(path), "/lib/module%u.mpy", i);
+        write_file(path, i, library_file_size(i), FILESYSTEM_BLOCK_SIZE);
+    }
+    idle();
+}
+
+// Short lines appended and synced one at a time by user code, with the idle flush in between.
+static void data_log(void) {
+    FIL fp;
+    char line[48];
+    check(f_open(&fatfs, &fp, "/log.txt", FA_WRITE | FA_OPEN_APPEND), "log");
+    for (uint32_t i = 0; i < LOG_LINES; i++) {
+        UINT written;
+        int length = snprintf(line, sizeof(line), "%u,%u,%u\n", i, (i * 37) % 1000, (i * 91) % 4096);
+        check(f_write(&fp, line, length, &written), "log");
+        check(f_sync(&fp), "log");
+        if (i % 25 == 24) {
+            idle();
+        }
+    }
+    check(f_close(&fp), "log");
+    idle();
+}
+
+// code.py saved over and over by an editor, written in small chunks.
+static void edit_code(void) {
+    for (uint32_t i = 0; i < CODE_EDITS; i++) {
+        write_file("/code.py", 1000 + i, CODE_SIZE + i * 10, 64);
+        idle();
+    }
+}
+
+static void delete_files(void) {
+    char path[32];
+    for (uint32_t i = 0; i < LIBRARY_FILES; i += 2) {
+        snprintf(path, sizeof(path), "/lib/module%u.mpy", i);
+        check(f_unlink(&fatfs, path), path);
+    }
+    idle();
+}
+
+// New versions of the deleted files, landing in the space the deletes freed.
+static void refill_files(void) {
+    char path[32];
+    for (uint32_t i = 0; i < LIBRARY_FILES; i += 2) {
+        snprintf(path, sizeof(path), "/lib/module%u.mpy", i);
+        write_file(path, LIBRARY_FILES + i, library_file_size(i), FILESYSTEM_BLOCK_SIZE);
+    }
+    idle();
+}
+
+// Remount from the flash alone and check everything that should still be there.
+static void verify(void) {
+    supervisor_flash_release_cache();
+    check(f_mount(&fatfs), "mount");
+    char path[32];
+    for (uint32_t i = 0; i < LIBRARY_FILES; i++) {
+        snprintf(path, sizeof(path), "/lib/module%u.mpy", i);
+        uint32_t seed = i % 2 == 0 ? LIBRARY_FILES + i : i;
+        if (!file_matches(path, seed, library_file_size(i))) {
+            printf("%s doesn't match\n", path);
+            failed = true;
+        }
+    }
+    if (!file_matches("/code.py", 1000 + CODE_EDITS - 1, CODE_SIZE + (CODE_EDITS - 1) * 10)) {
+        printf("/code.py doesn't match\n");
+        failed = true;
+    }
+    FILINFO info;
+    if (f_stat(&fatfs, "/log.txt", &info) != FR_OK || info.fsize == 0) {
+        printf("/log.txt is missing\n");
+        failed = true;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* image_path = NULL;
+    supervisor_pool_size = SPI_FLASH_CACHE_SECTORS * (SPI_FLASH_ERASE_SIZE + 64);
+    int opt;
+    while ((opt = getopt(argc, argv, "s:Hi:")) != -1) {
+        switch (opt) {
+            case 's':
+                supervisor_pool_size = strtoul(optarg, NULL, 0) & ~3;
+                break;
+            case 'H':
+                heap_enabled = false;
+                break;
+            case 'i':
+                image_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-s supervisor_bytes] [-H] [-i image_file]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    supervisor_pool = malloc(supervisor_pool_size + sizeof(uint32_t));
+    if (supervisor_pool == NULL || !spi_flash_sim_init(&possible_devices[0], image_path)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    memory_init();
+    supervisor_flash_init();
+
+    printf("%u bytes of supervisor memory, heap %s\n", supervisor_pool_size, heap_enabled ? "on" : "off");
+    printf("phase       erases bg-erase  programs  KiB-prog  KiB-read max-wear   flushes   busy-ms\n");
+    format();
+    report("format");
+    copy_library();
+    report("library");
+    data_log();
+    report("log");
+    edit_code();
+    report("code.py");
+    delete_files();
+    report("delete");
+    refill_files();
+    report("refill");
+    verify();
+    report("verify");
+
+    if (!spi_flash_sim_save()) {
+        printf("couldn't save %s\n", image_path);
+        failed = true;
+    }
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed ? 1 : 0;
+}
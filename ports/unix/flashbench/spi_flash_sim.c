@@ -0,0 +1,195 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Implements the SPI flash API on a RAM image with NOR semantics: erases set a whole sector to
+// 0xff, programs can only clear bits and wrap within a page, and both need write enable first.
+// Operations finish instantly so the busy bit is never set.
+
+#include "spi_flash_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "supervisor/spi_flash_api.h"
+#include "supervisor/shared/external_flash/common_commands.h"
+#include "supervisor/shared/external_flash/external_flash.h"
+
+spi_flash_sim_stats_t spi_flash_sim_stats;
+
+static const external_flash_device* sim_device;
+static const char* sim_image_path;
+static uint8_t* image;
+static uint32_t* sector_erases;
+static bool write_enabled;
+
+bool spi_flash_sim_init(const external_flash_device* device, const char* image_path) {
+    sim_device = device;
+    sim_image_path = image_path;
+    image = malloc(device->total_size);
+    sector_erases = calloc(device->total_size / SPI_FLASH_ERASE_SIZE, sizeof(uint32_t));
+    if (image == NULL || sector_erases == NULL) {
+        return false;
+    }
+    // New chips come erased.
+    memset(image, 0xff, device->total_size);
+    if (image_path != NULL) {
+        FILE* f = fopen(image_path, "rb");
+        if (f != NULL) {
+            size_t length = fread(image, 1, device->total_size, f);
+            fclose(f);
+            if (length != device->total_size) {
+                return false;
+            }
+        }
+    }
+    spi_flash_sim_reset_stats();
+    return true;
+}
+
+bool spi_flash_sim_save(void) {
+    if (sim_image_path == NULL) {
+        return true;
+    }
+    FILE* f = fopen(sim_image_path, "wb");
+    if (f == NULL) {
+        return false;
+    }
+    size_t length = fwrite(image, 1, sim_device->total_size, f);
+    return fclose(f) == 0 && length == sim_device->total_size;
+}
+
+void spi_flash_sim_reset_stats(void) {
+    memset(&spi_flash_sim_stats, 0, sizeof(spi_flash_sim_stats));
+    memset(sector_erases, 0, sim_device->total_size / SPI_FLASH_ERASE_SIZE * sizeof(uint32_t));
+}
+
+uint32_t spi_flash_sim_max_sector_erases(void) {
+    uint32_t max = 0;
+    for (uint32_t i = 0; i < sim_device->total_size / SPI_FLASH_ERASE_SIZE; i++) {
+        if (sector_erases[i] > max) {
+            max = sector_erases[i];
+        }
+    }
+    return max;
+}
+
+// Returns true when the write enable latch was set and clears it like the chip does at the start
+// of every program, erase and status write.
+static bool take_write_enable(void) {
+    if (!write_enabled) {
+        spi_flash_sim_stats.protocol_errors++;
+        return false;
+    }
+    write_enabled = false;
+    return true;
+}
+
+static bool in_range(uint32_t address, uint32_t data_length) {
+    if (address > sim_device->total_size || data_length > sim_device->total_size - address) {
+        spi_flash_sim_stats.protocol_errors++;
+        return false;
+    }
+    return true;
+}
+
+bool spi_flash_command(uint8_t command) {
+    if (command == CMD_ENABLE_WRITE) {
+        write_enabled = true;
+    } else if (command == CMD_DISABLE_WRITE || command == CMD_RESET) {
+        write_enabled = false;
+    }
+    return true;
+}
+
+bool spi_flash_read_command(uint8_t command, uint8_t* response, uint32_t length) {
+    memset(response, 0, length);
+    if (command == CMD_READ_JEDEC_ID && length >= 3) {
+        response[0] = sim_device->manufacturer_id;
+        response[1] = sim_device->memory_type;
+        response[2] = sim_device->capacity;
+    } else if (command == CMD_READ_STATUS && length >= 1) {
+        // Only the write enable latch. Nothing is ever in progress.
+        response[0] = write_enabled ? 0x02 : 0x00;
+    }
+    return true;
+}
+
+bool spi_flash_write_command(uint8_t command, uint8_t* data, uint32_t length) {
+    // Status registers are accepted and ignored.
+    return take_write_enable();
+}
+
+bool spi_flash_sector_command(uint8_t command, uint32_t address) {
+    if (command != CMD_SECTOR_ERASE) {
+        spi_flash_sim_stats.protocol_errors++;
+        return false;
+    }
+    if (!take_write_enable()) {
+        return false;
+    }
+    address &= ~(SPI_FLASH_ERASE_SIZE - 1);
+    if (!in_range(address, SPI_FLASH_ERASE_SIZE)) {
+        return false;
+    }
+    memset(image + address, 0xff, SPI_FLASH_ERASE_SIZE);
+    spi_flash_sim_stats.erases++;
+    sector_erases[address / SPI_FLASH_ERASE_SIZE]++;
+    return true;
+}
+
+bool spi_flash_write_data(uint32_t address, uint8_t* data, uint32_t data_length) {
+    if (!take_write_enable() || !in_range(address, data_length)) {
+        return false;
+    }
+    if ((address % SPI_FLASH_PAGE_SIZE) + data_length > SPI_FLASH_PAGE_SIZE) {
+        // The chip wraps around to the start of the page instead.
+        spi_flash_sim_stats.protocol_errors++;
+    }
+    uint32_t page = address & ~(SPI_FLASH_PAGE_SIZE - 1);
+    for (uint32_t i = 0; i < data_length; i++) {
+        image[page + (address + i) % SPI_FLASH_PAGE_SIZE] &= data[i];
+    }
+    spi_flash_sim_stats.page_programs++;
+    spi_flash_sim_stats.bytes_programmed += data_length;
+    return true;
+}
+
+bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t data_length) {
+    if (!in_range(address, data_length)) {
+        return false;
+    }
+    memcpy(data, image + address, data_length);
+    spi_flash_sim_stats.reads++;
+    spi_flash_sim_stats.bytes_read += data_length;
+    return true;
+}
+
+void spi_flash_init(void) {
+}
+
+void spi_flash_init_device(const external_flash_device* device) {
+}
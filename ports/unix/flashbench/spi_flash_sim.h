@@ -0,0 +1,57 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_UNIX_FLASHBENCH_SPI_FLASH_SIM_H
+#define MICROPY_INCLUDED_UNIX_FLASHBENCH_SPI_FLASH_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "supervisor/shared/external_flash/devices.h"
+
+// Everything the simulated chip has been asked to do since the last reset.
+typedef struct {
+    uint32_t erases;
+    uint32_t page_programs;
+    uint64_t bytes_programmed;
+    uint32_t reads;
+    uint64_t bytes_read;
+    // Commands a real chip would ignore or mangle, such as programming without write enable or
+    // past the end of a page.
+    uint32_t protocol_errors;
+} spi_flash_sim_stats_t;
+
+extern spi_flash_sim_stats_t spi_flash_sim_stats;
+
+// Starts out fully erased or with the contents of image_path when it exists. image_path may be
+// NULL to only keep the image in RAM.
+bool spi_flash_sim_init(const external_flash_device* device, const char* image_path);
+bool spi_flash_sim_save(void);
+void spi_flash_sim_reset_stats(void);
+// The most times any single sector has been erased since the last reset.
+uint32_t spi_flash_sim_max_sector_erases(void);
+
+#endif  // MICROPY_INCLUDED_UNIX_FLASHBENCH_SPI_FLASH_SIM_H
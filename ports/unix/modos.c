@@ -106,6 +106,123 @@ STATIC mp_obj_t mod_os_statvfs(mp_obj_t path_in) {
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_os_statvfs_obj, mod_os_statvfs);
 #endif
 
+#if MICROPY_PY_OS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+
+// A read-only mapping of a whole file. It only offers the buffer protocol, so wrap it in a
+// memoryview to slice it or hand it to functions that take buffers without copying the data.
+// Memoryviews only point at the mapped memory and don't keep this object alive, and there is
+// no way to tell when they go away. So once the buffer has been handed out close() only stops
+// new uses and the mapping stays until the process exits, even after this object is collected.
+typedef struct _mp_obj_mmap_t {
+    mp_obj_base_t base;
+    void *addr;
+    size_t len;
+    bool exported;
+    bool closed;
+} mp_obj_mmap_t;
+
+STATIC const mp_obj_type_t mp_type_mmap;
+
+STATIC mp_obj_t mod_os_mmap(mp_obj_t path_in) {
+    const char *path = mp_obj_str_get_str(path_in);
+    mp_obj_mmap_t *o = m_new_obj_with_finaliser(mp_obj_mmap_t);
+    o->base.type = &mp_type_mmap;
+    o->addr = NULL;
+    o->len = 0;
+    o->exported = false;
+    o->closed = false;
+
+    int fd = open(path, O_RDONLY);
+    RAISE_ERRNO(fd, errno);
+    struct stat sb;
+    int err = 0;
+    if (fstat(fd, &sb) != 0) {
+        err = errno;
+    } else if (sb.st_size > 0) {
+        // Empty files can't be mapped so they stay an empty buffer.
+        void *addr = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            err = errno;
+        } else {
+            o->addr = addr;
+            o->len = sb.st_size;
+        }
+    }
+    close(fd);
+    if (err != 0) {
+        mp_raise_OSError(err);
+    }
+    return MP_OBJ_FROM_PTR(o);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_os_mmap_obj, mod_os_mmap);
+
+STATIC mp_obj_t mmap_close(mp_obj_t self_in) {
+    mp_obj_mmap_t *self = MP_OBJ_TO_PTR(self_in);
+    self->closed = true;
+    if (self->addr != NULL && !self->exported) {
+        munmap(self->addr, self->len);
+        self->addr = NULL;
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mmap_close_obj, mmap_close);
+
+STATIC mp_obj_t mmap___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return mmap_close(args[0]);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mmap___exit___obj, 4, 4, mmap___exit__);
+
+STATIC mp_obj_t mmap___del__(mp_obj_t self_in) {
+    mp_obj_mmap_t *self = MP_OBJ_TO_PTR(self_in);
+    // A memoryview may outlive this object so exported mappings are left in place.
+    if (self->addr != NULL && !self->exported) {
+        munmap(self->addr, self->len);
+        self->addr = NULL;
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mmap___del___obj, mmap___del__);
+
+STATIC mp_obj_t mmap_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    mp_obj_mmap_t *self = MP_OBJ_TO_PTR(self_in);
+    switch (op) {
+        case MP_UNARY_OP_LEN: return MP_OBJ_NEW_SMALL_INT(self->closed ? 0 : self->len);
+        default: return MP_OBJ_NULL; // op not supported
+    }
+}
+
+STATIC mp_int_t mmap_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    mp_obj_mmap_t *self = MP_OBJ_TO_PTR(self_in);
+    if ((flags & MP_BUFFER_WRITE) || self->closed) {
+        return 1;
+    }
+    self->exported = true;
+    bufinfo->buf = self->addr;
+    bufinfo->len = self->len;
+    bufinfo->typecode = 'B';
+    return 0;
+}
+
+STATIC const mp_rom_map_elem_t mmap_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mmap_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&mmap___del___obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&mp_identity_obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&mmap___exit___obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(mmap_locals_dict, mmap_locals_dict_table);
+
+STATIC const mp_obj_type_t mp_type_mmap = {
+    { &mp_type_type },
+    .name = MP_QSTR_mmap,
+    .unary_op = mmap_unary_op,
+    .buffer_p = { .get_buffer = mmap_get_buffer },
+    .locals_dict = (mp_obj_dict_t*)&mmap_locals_dict,
+};
+#endif
+
 STATIC mp_obj_t mod_os_unlink(mp_obj_t path_in) {
     const char *path = mp_obj_str_get_str(path_in);
 
@@ -216,6 +333,9 @@ STATIC const mp_rom_map_elem_t mp_module_os_globals_table[] = {
     #if MICROPY_PY_OS_STATVFS
     { MP_ROM_QSTR(MP_QSTR_statvfs), MP_ROM_PTR(&mod_os_statvfs_obj) },
     #endif
+    #if MICROPY_PY_OS_MMAP
+    { MP_ROM_QSTR(MP_QSTR_mmap), MP_ROM_PTR(&mod_os_mmap_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_system), MP_ROM_PTR(&mod_os_system_obj) },
     { MP_ROM_QSTR(MP_QSTR_unlink), MP_ROM_PTR(&mod_os_unlink_obj) },
     { MP_ROM_QSTR(MP_QSTR_getenv), MP_ROM_PTR(&mod_os_getenv_obj) },
@@ -56,6 +56,7 @@
 // check stdout a chance to pass, etc.
 #define MICROPY_DEBUG_PRINTER_DEST  mp_stderr_print
 #define MICROPY_READER_POSIX        (1)
+#define MICROPY_READER_POSIX_MMAP   (1)
 #define MICROPY_USE_READLINE_HISTORY (1)
 #define MICROPY_HELPER_REPL         (1)
 #define MICROPY_REPL_EMACS_KEYS     (1)
@@ -115,6 +116,7 @@
 #endif
 
 #define MICROPY_PY_OS_STATVFS       (1)
+#define MICROPY_PY_OS_MMAP          (1)
 #define MICROPY_PY_UTIME            (1)
 #define MICROPY_PY_UTIME_MP_HAL     (1)
 #define MICROPY_PY_UERRNO           (1)
@@ -215,6 +217,45 @@ extern const struct _mp_obj_module_t mp_module_jni;
 #else
 #define MICROPY_PY_USELECT_DEF
 #endif
+#if CIRCUITPY_AUDIOSINK
+extern const struct _mp_obj_module_t audiocore_module;
+extern const struct _mp_obj_module_t audiofx_module;
+extern const struct _mp_obj_module_t audiomixer_module;
+extern const struct _mp_obj_module_t audiosink_module;
+extern const struct _mp_obj_module_t synthio_module;
+#define CIRCUITPY_AUDIOSINK_DEF \
+    { MP_ROM_QSTR(MP_QSTR_audiocore), MP_ROM_PTR(&audiocore_module) }, \
+    { MP_ROM_QSTR(MP_QSTR_audiofx), MP_ROM_PTR(&audiofx_module) }, \
+    { MP_ROM_QSTR(MP_QSTR_audiomixer), MP_ROM_PTR(&audiomixer_module) }, \
+    { MP_ROM_QSTR(MP_QSTR_audiosink), MP_ROM_PTR(&audiosink_module) }, \
+    { MP_ROM_QSTR(MP_QSTR_synthio), MP_ROM_PTR(&synthio_module) },
+#else
+#define CIRCUITPY_AUDIOSINK_DEF
+#endif
+#if CIRCUITPY_PIXELBUF
+extern const struct _mp_obj_module_t pixelbuf_module;
+#define CIRCUITPY_PIXELBUF_DEF { MP_ROM_QSTR(MP_QSTR__pixelbuf), MP_ROM_PTR(&pixelbuf_module) },
+#else
+#define CIRCUITPY_PIXELBUF_DEF
+#endif
+#if CIRCUITPY_RANDOM
+extern const struct _mp_obj_module_t random_module;
+#define CIRCUITPY_RANDOM_DEF { MP_ROM_QSTR(MP_QSTR_random), MP_ROM_PTR(&random_module) },
+#else
+#define CIRCUITPY_RANDOM_DEF
+#endif
+#if CIRCUITPY_STORAGE
+#define FILESYSTEM_BLOCK_SIZE (512)
+// Nothing runs in the background on the host.
+#define RUN_BACKGROUND_TASKS ((void) 0)
+extern const struct _mp_obj_module_t os_module;
+extern const struct _mp_obj_module_t storage_module;
+#define CIRCUITPY_STORAGE_DEF \
+    { MP_ROM_QSTR(MP_QSTR_os), MP_ROM_PTR(&os_module) }, \
+    { MP_ROM_QSTR(MP_QSTR_storage), MP_ROM_PTR(&storage_module) },
+#else
+#define CIRCUITPY_STORAGE_DEF
+#endif
 
 #define MICROPY_PORT_BUILTIN_MODULES \
     MICROPY_PY_FFI_DEF \
@@ -225,6 +266,10 @@ extern const struct _mp_obj_module_t mp_module_jni;
     MICROPY_PY_UOS_DEF \
     MICROPY_PY_USELECT_DEF \
     MICROPY_PY_TERMIOS_DEF \
+    CIRCUITPY_AUDIOSINK_DEF \
+    CIRCUITPY_PIXELBUF_DEF \
+    CIRCUITPY_RANDOM_DEF \
+    CIRCUITPY_STORAGE_DEF \
 
 // type definitions for the specific machine
 
@@ -37,6 +37,16 @@ MICROPY_SSL_MBEDTLS = 0
 # jni module requires JVM/JNI
 MICROPY_PY_JNI = 0
 
+# audiosink module to play audiocore, audiomixer, audiofx and synthio samples
+# without audio hardware
+CIRCUITPY_AUDIOSINK = 1
+
+# _pixelbuf module to check pixel buffer output without LEDs
+CIRCUITPY_PIXELBUF = 1
+
+# random module with Random generators, seeded from /dev/urandom
+CIRCUITPY_RANDOM = 1
+
 # Avoid using system libraries, use copies bundled with MicroPython
 # as submodules (currently affects only libffi).
 MICROPY_STANDALONE = 0
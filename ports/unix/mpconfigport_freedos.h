@@ -34,6 +34,12 @@
 #undef MICROPY_PY_SYS_PLATFORM
 #define MICROPY_PY_SYS_PLATFORM "freedos"
 
+// djgpp has no mmap
+#undef MICROPY_READER_POSIX_MMAP
+#define MICROPY_READER_POSIX_MMAP (0)
+#undef MICROPY_PY_OS_MMAP
+#define MICROPY_PY_OS_MMAP (0)
+
 // djgpp dirent struct does not have d_ino field
 #undef _DIRENT_HAVE_D_INO
 
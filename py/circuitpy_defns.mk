@@ -114,9 +114,15 @@ endif
 ifeq ($(CIRCUITPY_AUDIOCORE),1)
 SRC_PATTERNS += audiocore/%
 endif
+ifeq ($(CIRCUITPY_AUDIOFX),1)
+SRC_PATTERNS += audiofx/%
+endif
 ifeq ($(CIRCUITPY_AUDIOMIXER),1)
 SRC_PATTERNS += audiomixer/%
 endif
+ifeq ($(CIRCUITPY_AUDIOSINK),1)
+SRC_PATTERNS += audiosink/%
+endif
 ifeq ($(CIRCUITPY_BITBANGIO),1)
 SRC_PATTERNS += bitbangio/%
 endif
@@ -202,6 +208,9 @@ endif
 ifeq ($(CIRCUITPY_SUPERVISOR),1)
 SRC_PATTERNS += supervisor/%
 endif
+ifeq ($(CIRCUITPY_SYNTHIO),1)
+SRC_PATTERNS += synthio/%
+endif
 ifeq ($(CIRCUITPY_TIME),1)
 SRC_PATTERNS += time/%
 endif
@@ -317,9 +326,15 @@ SRC_SHARED_MODULE_ALL = \
 	audiocore/__init__.c \
 	audiocore/RawSample.c \
 	audiocore/WaveFile.c \
+	audiofx/__init__.c \
+	audiofx/Biquad.c \
+	audiofx/Envelope.c \
+	audiofx/Gain.c \
 	audiomixer/__init__.c \
 	audiomixer/Mixer.c \
 	audiomixer/MixerVoice.c \
+	audiosink/__init__.c \
+	audiosink/AudioSink.c \
 	bitbangio/I2C.c \
 	bitbangio/OneWire.c \
 	bitbangio/SPI.c \
@@ -335,21 +350,29 @@ SRC_SHARED_MODULE_ALL = \
 	displayio/I2CDisplay.c \
 	displayio/OnDiskBitmap.c \
 	displayio/Palette.c \
+	displayio/RLEBitmap.c \
 	displayio/Shape.c \
 	displayio/TileGrid.c \
 	displayio/__init__.c \
+	fontio/BinaryFont.c \
 	fontio/BuiltinFont.c \
 	fontio/__init__.c \
 	gamepad/GamePad.c \
 	gamepad/__init__.c \
 	gamepadshift/GamePadShift.c \
 	gamepadshift/__init__.c \
+	os/DirEntry.c \
 	os/__init__.c \
 	random/__init__.c \
+	random/Random.c \
 	socket/__init__.c \
 	network/__init__.c \
 	storage/__init__.c \
+	storage/RAMBlockDevice.c \
 	struct/__init__.c \
+	synthio/__init__.c \
+	synthio/Synthesizer.c \
+	synthio/Voice.c \
 	terminalio/Terminal.c \
 	terminalio/__init__.c \
 	uheap/__init__.c \
@@ -376,6 +399,8 @@ endif
 # All possible sources are listed here, and are filtered by SRC_PATTERNS.
 SRC_SHARED_MODULE_INTERNAL = \
 $(filter $(SRC_PATTERNS), \
+	audiobusio/PDMDecimator.c \
+	displayio/area.c \
 	displayio/display_core.c \
 )
 
@@ -127,14 +127,30 @@
 #define MICROPY_FATFS_ENABLE_LFN      (1)
 #define MICROPY_FATFS_LFN_CODE_PAGE   (437)
 #define MICROPY_FATFS_USE_LABEL       (1)
+#define MICROPY_FATFS_USE_TRIM        (1)
 #define MICROPY_FATFS_RPATH           (2)
 #define MICROPY_FATFS_MULTI_PARTITION (1)
+// Full builds give each open file its own sector buffer and cache FAT and directory sectors so
+// that several open files don't keep reloading the one shared window.
+#define MICROPY_FATFS_TINY            (!CIRCUITPY_FULL_BUILD)
+#ifndef MICROPY_FATFS_SECTOR_CACHE
+#define MICROPY_FATFS_SECTOR_CACHE    (CIRCUITPY_FULL_BUILD ? 8 : 0)
+#endif
+#ifndef MICROPY_FATFS_READ_AHEAD
+#define MICROPY_FATFS_READ_AHEAD      (3)
+#endif
 
 // Only enable this if you really need it. It allocates a byte cache of this size.
 // #define MICROPY_FATFS_MAX_SS           (4096)
 
 #define FILESYSTEM_BLOCK_SIZE       (512)
 
+// Blocks of sequential USB mass storage traffic gathered into one disk write or read. Eight
+// blocks make up one erase sector of external flash.
+#ifndef CIRCUITPY_USB_MSC_STAGING_BLOCKS
+#define CIRCUITPY_USB_MSC_STAGING_BLOCKS (CIRCUITPY_FULL_BUILD ? 8 : 0)
+#endif
+
 #define MICROPY_VFS                 (1)
 #define MICROPY_VFS_FAT             (MICROPY_VFS)
 #define MICROPY_READER_VFS          (MICROPY_VFS)
@@ -237,6 +253,13 @@ extern const struct _mp_obj_module_t audiocore_module;
 #define AUDIOCORE_MODULE
 #endif
 
+#if CIRCUITPY_AUDIOFX
+#define AUDIOFX_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_audiofx), (mp_obj_t)&audiofx_module },
+extern const struct _mp_obj_module_t audiofx_module;
+#else
+#define AUDIOFX_MODULE
+#endif
+
 #if CIRCUITPY_AUDIOIO
 #define AUDIOIO_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_audioio), (mp_obj_t)&audioio_module },
 extern const struct _mp_obj_module_t audioio_module;
@@ -258,6 +281,13 @@ extern const struct _mp_obj_module_t audiopwmio_module;
 #define AUDIOPWMIO_MODULE
 #endif
 
+#if CIRCUITPY_AUDIOSINK
+#define AUDIOSINK_MODULE       { MP_OBJ_NEW_QSTR(MP_QSTR_audiosink), (mp_obj_t)&audiosink_module },
+extern const struct _mp_obj_module_t audiosink_module;
+#else
+#define AUDIOSINK_MODULE
+#endif
+
 #if CIRCUITPY_BITBANGIO
 #define BITBANGIO_MODULE       { MP_OBJ_NEW_QSTR(MP_QSTR_bitbangio), (mp_obj_t)&bitbangio_module },
 extern const struct _mp_obj_module_t bitbangio_module;
@@ -494,6 +524,13 @@ extern const struct _mp_obj_module_t supervisor_module;
 #define SUPERVISOR_MODULE
 #endif
 
+#if CIRCUITPY_SYNTHIO
+#define SYNTHIO_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_synthio), (mp_obj_t)&synthio_module },
+extern const struct _mp_obj_module_t synthio_module;
+#else
+#define SYNTHIO_MODULE
+#endif
+
 #if CIRCUITPY_TIME
 extern const struct _mp_obj_module_t time_module;
 #define TIME_MODULE            { MP_OBJ_NEW_QSTR(MP_QSTR_time), (mp_obj_t)&time_module },
@@ -579,9 +616,11 @@ extern const struct _mp_obj_module_t ustack_module;
     ANALOGIO_MODULE \
     AUDIOBUSIO_MODULE \
     AUDIOCORE_MODULE \
+    AUDIOFX_MODULE \
     AUDIOIO_MODULE \
     AUDIOMIXER_MODULE \
     AUDIOPWMIO_MODULE \
+    AUDIOSINK_MODULE \
     BITBANGIO_MODULE \
     BLEIO_MODULE \
     BOARD_MODULE \
@@ -615,6 +654,7 @@ extern const struct _mp_obj_module_t ustack_module;
     STORAGE_MODULE \
     STRUCT_MODULE \
     SUPERVISOR_MODULE \
+    SYNTHIO_MODULE \
     TOUCHIO_MODULE \
     UHEAP_MODULE \
     USB_HID_MODULE \
@@ -104,6 +104,22 @@ CIRCUITPY_AUDIOMIXER = $(CIRCUITPY_AUDIOIO)
 endif
 CFLAGS += -DCIRCUITPY_AUDIOMIXER=$(CIRCUITPY_AUDIOMIXER)
 
+# Audio output without hardware. Only useful on hosts where samples are tested and benchmarked.
+ifndef CIRCUITPY_AUDIOSINK
+CIRCUITPY_AUDIOSINK = 0
+endif
+CFLAGS += -DCIRCUITPY_AUDIOSINK=$(CIRCUITPY_AUDIOSINK)
+
+ifndef CIRCUITPY_AUDIOFX
+CIRCUITPY_AUDIOFX = $(CIRCUITPY_AUDIOMIXER)
+endif
+CFLAGS += -DCIRCUITPY_AUDIOFX=$(CIRCUITPY_AUDIOFX)
+
+ifndef CIRCUITPY_SYNTHIO
+CIRCUITPY_SYNTHIO = $(CIRCUITPY_AUDIOMIXER)
+endif
+CFLAGS += -DCIRCUITPY_SYNTHIO=$(CIRCUITPY_SYNTHIO)
+
 ifndef CIRCUITPY_BITBANGIO
 CIRCUITPY_BITBANGIO = $(CIRCUITPY_FULL_BUILD)
 endif
@@ -207,6 +223,13 @@ CIRCUITPY_RANDOM = $(CIRCUITPY_DEFAULT_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_RANDOM=$(CIRCUITPY_RANDOM)
 
+# Use xoshiro128++ instead of yasmarang as the random generator. It is faster and
+# statistically better but needs 16 bytes of state per generator instead of 8.
+ifndef CIRCUITPY_RANDOM_XOSHIRO
+CIRCUITPY_RANDOM_XOSHIRO = $(CIRCUITPY_RANDOM)
+endif
+CFLAGS += -DCIRCUITPY_RANDOM_XOSHIRO=$(CIRCUITPY_RANDOM_XOSHIRO)
+
 ifndef CIRCUITPY_ROTARYIO
 CIRCUITPY_ROTARYIO = $(CIRCUITPY_DEFAULT_BUILD)
 endif
@@ -428,6 +428,12 @@
 #define MICROPY_READER_POSIX (0)
 #endif
 
+// Whether the POSIX reader maps regular files into memory instead of reading
+// them a few bytes at a time (needs mmap(2))
+#ifndef MICROPY_READER_POSIX_MMAP
+#define MICROPY_READER_POSIX_MMAP (0)
+#endif
+
 // Whether to use the VFS reader for importing files
 #ifndef MICROPY_READER_VFS
 #define MICROPY_READER_VFS (0)
@@ -438,6 +444,17 @@
 #define MICROPY_FATFS_NUM_PERSISTENT (0)
 #endif
 
+// Number of sectors the FAT disk I/O layer caches between FatFs and the block
+// devices, shared by all mounts. 0 passes every read and write straight through.
+#ifndef MICROPY_FATFS_SECTOR_CACHE
+#define MICROPY_FATFS_SECTOR_CACHE (0)
+#endif
+
+// Extra sectors fetched into the sector cache when single sector reads are sequential.
+#ifndef MICROPY_FATFS_READ_AHEAD
+#define MICROPY_FATFS_READ_AHEAD (1)
+#endif
+
 // Hook for the VM at the start of the opcode loop (can contain variable
 // definitions usable by the other hook functions)
 #ifndef MICROPY_VM_HOOK_INIT
@@ -71,6 +71,9 @@ void mp_reader_new_mem(mp_reader_t *reader, const byte *buf, size_t len, size_t
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#if MICROPY_READER_POSIX_MMAP
+#include <sys/mman.h>
+#endif
 
 typedef struct _mp_reader_posix_t {
     bool close_fd;
@@ -106,7 +109,58 @@ STATIC void mp_reader_posix_close(void *data) {
     m_del_obj(mp_reader_posix_t, reader);
 }
 
+#if MICROPY_READER_POSIX_MMAP
+// A regular file mapped into memory, read with the memory reader.
+typedef struct _mp_reader_mmap_t {
+    mp_reader_mem_t mem;
+    void *addr;
+    size_t len;
+} mp_reader_mmap_t;
+
+STATIC void mp_reader_mmap_close(void *data) {
+    mp_reader_mmap_t *reader = (mp_reader_mmap_t*)data;
+    munmap(reader->addr, reader->len);
+    m_del_obj(mp_reader_mmap_t, reader);
+}
+
+// Returns false, leaving fd untouched, when it can't be mapped (pipes, ttys, empty files).
+STATIC bool mp_reader_new_mmap_from_fd(mp_reader_t *reader, int fd, bool close_fd) {
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode) || sb.st_size == 0) {
+        return false;
+    }
+    off_t pos = lseek(fd, 0, SEEK_CUR);
+    if (pos < 0 || pos > sb.st_size) {
+        return false;
+    }
+    mp_reader_mmap_t *rm = m_new_obj(mp_reader_mmap_t);
+    rm->len = sb.st_size;
+    rm->addr = mmap(NULL, rm->len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (rm->addr == MAP_FAILED) {
+        m_del_obj(mp_reader_mmap_t, rm);
+        return false;
+    }
+    // The mapping outlives the descriptor.
+    if (close_fd) {
+        close(fd);
+    }
+    rm->mem.free_len = 0;
+    rm->mem.beg = rm->addr;
+    rm->mem.cur = rm->mem.beg + pos;
+    rm->mem.end = rm->mem.beg + rm->len;
+    reader->data = rm;
+    reader->readbyte = mp_reader_mem_readbyte;
+    reader->close = mp_reader_mmap_close;
+    return true;
+}
+#endif
+
 void mp_reader_new_file_from_fd(mp_reader_t *reader, int fd, bool close_fd) {
+    #if MICROPY_READER_POSIX_MMAP
+    if (mp_reader_new_mmap_from_fd(reader, fd, close_fd)) {
+        return;
+    }
+    #endif
     mp_reader_posix_t *rp = m_new_obj(mp_reader_posix_t);
     rp->close_fd = close_fd;
     rp->fd = fd;
@@ -33,17 +33,45 @@
 #include "py/runtime.h"
 #include "py/gc.h"
 
+#include <math.h>
 #include <string.h>
 
 #include "PixelBuf.h"
 #include "shared-bindings/_pixelbuf/types.h"
 #include "../../shared-module/_pixelbuf/PixelBuf.h"
-#include "shared-bindings/digitalio/DigitalInOut.h"
 
 extern const pixelbuf_byteorder_obj_t byteorder_BGR;
 extern const mp_obj_type_t pixelbuf_byteorder_type;
 extern const int32_t colorwheel(float pos);
 
+STATIC mp_float_t pixelbuf_validate_gamma(mp_obj_t gamma_obj) {
+    mp_float_t gamma = mp_obj_get_float(gamma_obj);
+    if (!(gamma > 0) || isinf(gamma)) {
+        mp_raise_ValueError(translate("gamma must be positive"));
+    }
+    return gamma;
+}
+
+STATIC void pixelbuf_update_lut(pixelbuf_pixelbuf_obj_t *self) {
+    if (self->brightness == 1 && self->gamma == 1) {
+        self->lut = NULL;
+        return;
+    }
+    if (self->lut == NULL) {
+        self->lut = m_new(uint8_t, 256);
+    }
+    pixelbuf_build_lut(self->lut, self->brightness, self->gamma);
+}
+
+// With two buffers, pixels are written raw and show() applies the lookup table.
+STATIC uint8_t *pixelbuf_target(pixelbuf_pixelbuf_obj_t *self) {
+    return self->two_buffers ? self->rawbuf : self->buf;
+}
+
+STATIC const uint8_t *pixelbuf_target_lut(pixelbuf_pixelbuf_obj_t *self) {
+    return self->two_buffers ? NULL : self->lut;
+}
+
 //| .. currentmodule:: pixelbuf
 //|
 //| :class:`PixelBuf` -- A fast RGB[W] pixel buffer for LED and similar devices
@@ -51,14 +79,14 @@ extern const int32_t colorwheel(float pos);
 //|
 //| :class:`~_pixelbuf.PixelBuf` implements an RGB[W] bytearray abstraction.
 //|
-//| .. class:: PixelBuf(size, buf, byteorder=BGR, brightness=0, rawbuf=None, offset=0, dotstar=False, auto_write=False, write_function=None, write_args=None)
+//| .. class:: PixelBuf(size, buf, byteorder=BGR, brightness=0, rawbuf=None, offset=0, dotstar=False, auto_write=False, write_function=None, write_args=None, gamma=1.0)
 //|
 //|   Create a PixelBuf object of the specified size, byteorder, and bits per pixel.
 //|
-//|   When given a second bytearray (``rawbuf``), changing brightness adjusts the
-//|   brightness of all members of ``buf``.
+//|   When given a second bytearray (``rawbuf``), pixel assignments only change ``rawbuf``.
+//|   ``brightness`` and ``gamma`` are applied to all of it to update ``buf`` once per `show()`.
 //|
-//|   When only given ``buf``, ``brightness`` applies to the next pixel assignment.
+//|   When only given ``buf``, ``brightness`` and ``gamma`` apply to the next pixel assignment.
 //|
 //|   When ``dotstar`` is True, and ``bpp`` is 4, the 4th value in a tuple/list
 //|   is the individual pixel brightness (0-1).  Not compatible with RGBW Byteorders.
@@ -75,11 +103,13 @@ extern const int32_t colorwheel(float pos);
 //|   :param ~callable write_function: (optional) Callable to use to send pixels
 //|   :param ~list write_args: (optional) Tuple or list of args to pass to ``write_function``.  The
 //|          PixelBuf instance is appended after these args.
+//|   :param ~float gamma: Gamma correction exponent applied to each color value (default 1.0)
 //|
 STATIC mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
     mp_arg_check_num(n_args, kw_args, 2, MP_OBJ_FUN_ARGS_MAX, true);
     enum { ARG_size, ARG_buf, ARG_byteorder, ARG_brightness, ARG_rawbuf, ARG_offset, ARG_dotstar,
-           ARG_auto_write, ARG_write_function, ARG_write_args };
+           ARG_auto_write, ARG_write_function, ARG_write_args, ARG_gamma };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_size, MP_ARG_REQUIRED | MP_ARG_INT },
         { MP_QSTR_buf, MP_ARG_REQUIRED | MP_ARG_OBJ },
@@ -91,6 +121,7 @@ STATIC mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_a
         { MP_QSTR_auto_write, MP_ARG_BOOL, {.u_bool = false} },
         { MP_QSTR_write_function, MP_ARG_OBJ, {.u_obj = mp_const_none} },
         { MP_QSTR_write_args, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_gamma, MP_ARG_OBJ, {.u_obj = mp_const_none} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -187,6 +218,13 @@ STATIC mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_a
             self->brightness = 1;
     }
 
+    self->gamma = 1.0;
+    if (args[ARG_gamma].u_obj != mp_const_none) {
+        self->gamma = pixelbuf_validate_gamma(args[ARG_gamma].u_obj);
+    }
+    self->lut = NULL;
+    pixelbuf_update_lut(self);
+
     if (self->dotstar_mode) {
         // Initialize the buffer with the dotstar start bytes.
         // Header and end must be setup by caller
@@ -224,10 +262,10 @@ const mp_obj_property_t pixelbuf_pixelbuf_bpp_obj = {
 //|
 //|     Float value between 0 and 1.  Output brightness.
 //|     If the PixelBuf was allocated with two both a buf and a rawbuf,
-//|     setting this value causes a recomputation of the values in buf.
+//|     the values in buf are recomputed on the next `show()`.
 //|     If only a buf was provided, then the brightness only applies to
 //|     future pixel changes.
-//|     In DotStar mode
+//|     In DotStar mode the per-pixel brightness is not scaled.
 //|
 STATIC mp_obj_t pixelbuf_pixelbuf_obj_get_brightness(mp_obj_t self_in) {
     mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
@@ -245,8 +283,7 @@ STATIC mp_obj_t pixelbuf_pixelbuf_obj_set_brightness(mp_obj_t self_in, mp_obj_t
         self->brightness = 1;
     else if (self->brightness < 0)
         self->brightness = 0;
-    if (self->two_buffers)
-        pixelbuf_recalculate_brightness(self);
+    pixelbuf_update_lut(self);
     if (self->auto_write)
         call_write_function(self);
     return mp_const_none;
@@ -260,15 +297,39 @@ const mp_obj_property_t pixelbuf_pixelbuf_brightness_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: gamma
+//|
+//|     Float gamma correction exponent applied to each color value along with `brightness`.
+//|     1.0 leaves values unchanged.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_obj_get_gamma(mp_obj_t self_in) {
+    mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_float(self->gamma);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(pixelbuf_pixelbuf_get_gamma_obj, pixelbuf_pixelbuf_obj_get_gamma);
+
+
+STATIC mp_obj_t pixelbuf_pixelbuf_obj_set_gamma(mp_obj_t self_in, mp_obj_t value) {
+    mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    self->gamma = pixelbuf_validate_gamma(value);
+    pixelbuf_update_lut(self);
+    if (self->auto_write)
+        call_write_function(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_set_gamma_obj, pixelbuf_pixelbuf_obj_set_gamma);
+
+const mp_obj_property_t pixelbuf_pixelbuf_gamma_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&pixelbuf_pixelbuf_get_gamma_obj,
+              (mp_obj_t)&pixelbuf_pixelbuf_set_gamma_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 void pixelbuf_recalculate_brightness(pixelbuf_pixelbuf_obj_t *self) {
-    uint8_t *buf = (uint8_t *)self->buf;
-    uint8_t *rawbuf = (uint8_t *)self->rawbuf;
-    // Compensate for shifted buffer (bpp=3 dotstar)
-    for (uint i = 0; i < self->bytes; i++) {
-        // Don't adjust per-pixel luminance bytes in dotstar mode
-        if (!self->dotstar_mode || (i % 4 != 0))
-            buf[i] = rawbuf[i] * self->brightness;
-    }
+    pixelbuf_apply_lut(self->buf, self->rawbuf, self->lut, self->bytes, self->dotstar_mode);
 }
 
 //|   .. attribute:: auto_write
@@ -303,11 +364,15 @@ const mp_obj_property_t pixelbuf_pixelbuf_auto_write_obj = {
 //|
 //|     (read-only) bytearray of pixel data after brightness adjustment.  If an offset was provided
 //|     then this bytearray is the subset of the bytearray passed in that represents the
-//|     actual pixels.
+//|     actual pixels. With two buffers, it is recomputed from ``rawbuf`` when read.
 //|
 STATIC mp_obj_t pixelbuf_pixelbuf_obj_get_buf(mp_obj_t self_in) {
     mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
     pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    // buf is normally only brought up to date by show().
+    if (self->two_buffers) {
+        pixelbuf_recalculate_brightness(self);
+    }
     return mp_obj_new_bytearray_by_ref(self->bytes, self->buf);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(pixelbuf_pixelbuf_get_buf_obj, pixelbuf_pixelbuf_obj_get_buf);
@@ -349,7 +414,8 @@ STATIC mp_obj_t pixelbuf_pixelbuf_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
 
 //|   .. method:: show()
 //|
-//|     Call the associated write function to display the pixels.
+//|     Call the associated write function to display the pixels. With two buffers, ``buf``
+//|     is updated from ``rawbuf`` first.
 //|
 
 STATIC mp_obj_t pixelbuf_pixelbuf_show(mp_obj_t self_in) {
@@ -360,7 +426,80 @@ STATIC mp_obj_t pixelbuf_pixelbuf_show(mp_obj_t self_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(pixelbuf_pixelbuf_show_obj, pixelbuf_pixelbuf_show);
 
+STATIC void pixelbuf_check_range(pixelbuf_pixelbuf_obj_t *self, mp_int_t start, mp_int_t stop) {
+    if (start < 0 || stop < start || (size_t) stop > self->pixels) {
+        mp_raise_IndexError(translate("Range out of bounds"));
+    }
+}
+
+STATIC void pixelbuf_fill(pixelbuf_pixelbuf_obj_t *self, size_t start, size_t stop, mp_obj_t color_obj) {
+    pixelbuf_color_t color;
+    pixelbuf_get_color(color_obj, &self->byteorder, self->dotstar_mode, &color);
+    uint8_t *target = pixelbuf_target(self);
+    const uint8_t *lut = pixelbuf_target_lut(self);
+    for (size_t i = start; i < stop; i++) {
+        pixelbuf_set_color(target + i * self->pixel_step, lut, &color, &self->byteorder, self->dotstar_mode);
+    }
+    if (self->auto_write)
+        call_write_function(self);
+}
+
+//|   .. method:: fill(color)
+//|
+//|     Sets every pixel to the given color.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_fill(mp_obj_t self_in, mp_obj_t color) {
+    mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    pixelbuf_fill(self, 0, self->pixels, color);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_fill_obj, pixelbuf_pixelbuf_fill);
+
+//|   .. method:: fill_range(start, stop, color)
+//|
+//|     Sets the pixels from ``start`` up to but not including ``stop`` to the given color.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_fill_range(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    mp_check_self(MP_OBJ_IS_TYPE(args[0], &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t start = mp_obj_get_int(args[1]);
+    mp_int_t stop = mp_obj_get_int(args[2]);
+    pixelbuf_check_range(self, start, stop);
+    pixelbuf_fill(self, start, stop, args[3]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pixelbuf_pixelbuf_fill_range_obj, 4, 4, pixelbuf_pixelbuf_fill_range);
+
+//|   .. method:: gradient(start, stop, start_color, end_color)
+//|
+//|     Blends the pixels from ``start`` up to but not including ``stop`` linearly from
+//|     ``start_color`` to ``end_color``.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_gradient(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    mp_check_self(MP_OBJ_IS_TYPE(args[0], &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t start = mp_obj_get_int(args[1]);
+    mp_int_t stop = mp_obj_get_int(args[2]);
+    pixelbuf_check_range(self, start, stop);
+    pixelbuf_color_t start_color;
+    pixelbuf_color_t end_color;
+    pixelbuf_get_color(args[3], &self->byteorder, self->dotstar_mode, &start_color);
+    pixelbuf_get_color(args[4], &self->byteorder, self->dotstar_mode, &end_color);
+    pixelbuf_set_gradient(pixelbuf_target(self) + start * self->pixel_step, pixelbuf_target_lut(self),
+        stop - start, self->pixel_step, &start_color, &end_color, &self->byteorder, self->dotstar_mode);
+    if (self->auto_write)
+        call_write_function(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pixelbuf_pixelbuf_gradient_obj, 5, 5, pixelbuf_pixelbuf_gradient);
+
 void call_write_function(pixelbuf_pixelbuf_obj_t *self) {
+    if (self->two_buffers) {
+        pixelbuf_recalculate_brightness(self);
+    }
     // execute function if it's set
     if (self->write_function != mp_const_none) {
         mp_call_function_n_kw(self->write_function, self->write_function_args->len, 0, self->write_function_args->items);
@@ -373,7 +512,8 @@ void call_write_function(pixelbuf_pixelbuf_obj_t *self) {
 //|
 //|   .. method:: __setitem__(index, value)
 //|
-//|     Sets the pixel value at the given index.
+//|     Sets the pixel value at the given index. A slice may also be set from a bytes-like
+//|     object of packed RGB values, or RGBW when the byteorder has 4 bytes per pixel.
 //|
 STATIC mp_obj_t pixelbuf_pixelbuf_subscr(mp_obj_t self_in, mp_obj_t index_in, mp_obj_t value) {
     mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
@@ -390,44 +530,44 @@ STATIC mp_obj_t pixelbuf_pixelbuf_subscr(mp_obj_t self_in, mp_obj_t index_in, mp
     } else if (MP_OBJ_IS_TYPE(index_in, &mp_type_slice)) {
         mp_bound_slice_t slice;
 
-        if (!mp_seq_get_fast_slice_indexes(self->bytes, index_in, &slice))
+        if (!mp_seq_get_fast_slice_indexes(self->pixels, index_in, &slice))
             mp_raise_NotImplementedError(translate("Only slices with step=1 (aka None) are supported"));
-        if ((slice.stop * self->pixel_step) > self->bytes)
-            mp_raise_IndexError(translate("Range out of bounds"));
 
         if (value == MP_OBJ_SENTINEL) { // Get
             size_t len = slice.stop - slice.start;
-            return pixelbuf_get_pixel_array((uint8_t *) self->buf + slice.start, len, &self->byteorder, self->pixel_step, self->dotstar_mode);
+            return pixelbuf_get_pixel_array(pixelbuf_target(self) + slice.start * self->pixel_step, len, &self->byteorder, self->pixel_step, self->dotstar_mode);
         } else { // Set
             #if MICROPY_PY_ARRAY_SLICE_ASSIGN
 
-            if (!(MP_OBJ_IS_TYPE(value, &mp_type_list) || MP_OBJ_IS_TYPE(value, &mp_type_tuple)))
-                mp_raise_ValueError(translate("tuple/list required on RHS"));
-
             size_t dst_len = slice.stop - slice.start;
-
-            mp_obj_t *src_objs;
-            size_t num_items;
-            if (MP_OBJ_IS_TYPE(value, &mp_type_list)) {
-                mp_obj_list_t *t = MP_OBJ_TO_PTR(value);
-                num_items = t->len;
-                src_objs = t->items;
+            uint8_t *target = pixelbuf_target(self) + slice.start * self->pixel_step;
+            const uint8_t *lut = pixelbuf_target_lut(self);
+
+            if (MP_OBJ_IS_TYPE(value, &mp_type_list) || MP_OBJ_IS_TYPE(value, &mp_type_tuple)) {
+                mp_obj_t *src_objs;
+                size_t num_items;
+                mp_obj_get_array(value, &num_items, &src_objs);
+                if (num_items != dst_len)
+                    mp_raise_ValueError_varg(translate("Unmatched number of items on RHS (expected %d, got %d)."),
+                                                       dst_len, num_items);
+
+                for (size_t i = 0; i < dst_len; i++) {
+                    pixelbuf_set_pixel(target + i * self->pixel_step, lut, src_objs[i],
+                        &self->byteorder, self->dotstar_mode);
+                }
             } else {
-                mp_obj_tuple_t *l = MP_OBJ_TO_PTR(value);
-                num_items = l->len;
-                src_objs = l->items;
-            }
-            if (num_items != dst_len)
-                mp_raise_ValueError_varg(translate("Unmatched number of items on RHS (expected %d, got %d)."),
-                                                   dst_len, num_items);
-
-            for (size_t i = slice.start; i < slice.stop; i++) {
-                mp_obj_t *item = src_objs[i-slice.start];
-                if (MP_OBJ_IS_TYPE(value, &mp_type_list) || MP_OBJ_IS_TYPE(value, &mp_type_tuple) || MP_OBJ_IS_INT(value)) {
-                    pixelbuf_set_pixel(self->buf + (i * self->pixel_step),
-                        self->two_buffers ? self->rawbuf + (i * self->pixel_step) : NULL,
-                        self->brightness, item, &self->byteorder, self->dotstar_mode);
+                mp_buffer_info_t bufinfo;
+                if (!mp_get_buffer(value, &bufinfo, MP_BUFFER_READ))
+                    mp_raise_ValueError(translate("tuple/list required on RHS"));
+                uint8_t src_bpp = 3;
+                if (self->byteorder.bpp == 4 && !self->dotstar_mode && bufinfo.len == dst_len * 4) {
+                    src_bpp = 4;
                 }
+                if (bufinfo.len != dst_len * src_bpp)
+                    mp_raise_ValueError_varg(translate("Unmatched number of items on RHS (expected %d, got %d)."),
+                                                       dst_len * src_bpp, bufinfo.len);
+                pixelbuf_set_pixels_from_buffer(target, lut, bufinfo.buf, dst_len, src_bpp,
+                    self->pixel_step, &self->byteorder, self->dotstar_mode);
             }
             if (self->auto_write)
                 call_write_function(self);
@@ -444,11 +584,11 @@ STATIC mp_obj_t pixelbuf_pixelbuf_subscr(mp_obj_t self_in, mp_obj_t index_in, mp
             mp_raise_IndexError(translate("Pixel beyond bounds of buffer"));
 
         if (value == MP_OBJ_SENTINEL) { // Get
-            uint8_t *pixelstart = (uint8_t *)(self->two_buffers ? self->rawbuf : self->buf) + offset;
+            uint8_t *pixelstart = pixelbuf_target(self) + offset;
             return pixelbuf_get_pixel(pixelstart, &self->byteorder, self->dotstar_mode);
         } else { // Store
-            pixelbuf_set_pixel(self->buf + offset, self->two_buffers ? self->rawbuf + offset : NULL,
-                self->brightness, value, &self->byteorder, self->dotstar_mode);
+            pixelbuf_set_pixel(pixelbuf_target(self) + offset, pixelbuf_target_lut(self), value,
+                &self->byteorder, self->dotstar_mode);
             if (self->auto_write)
                 call_write_function(self);
             return mp_const_none;
@@ -462,6 +602,10 @@ STATIC const mp_rom_map_elem_t pixelbuf_pixelbuf_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&pixelbuf_pixelbuf_brightness_obj)},
     { MP_ROM_QSTR(MP_QSTR_buf), MP_ROM_PTR(&pixelbuf_pixelbuf_buf_obj)},
     { MP_ROM_QSTR(MP_QSTR_byteorder), MP_ROM_PTR(&pixelbuf_pixelbuf_byteorder_obj)},
+    { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&pixelbuf_pixelbuf_fill_obj)},
+    { MP_ROM_QSTR(MP_QSTR_fill_range), MP_ROM_PTR(&pixelbuf_pixelbuf_fill_range_obj)},
+    { MP_ROM_QSTR(MP_QSTR_gamma), MP_ROM_PTR(&pixelbuf_pixelbuf_gamma_obj)},
+    { MP_ROM_QSTR(MP_QSTR_gradient), MP_ROM_PTR(&pixelbuf_pixelbuf_gradient_obj)},
     { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&pixelbuf_pixelbuf_show_obj)},
 };
 
@@ -29,7 +29,7 @@
 
 #include "shared-bindings/_pixelbuf/types.h"
 
-const mp_obj_type_t pixelbuf_pixelbuf_type;
+extern const mp_obj_type_t pixelbuf_pixelbuf_type;
 
 typedef struct {
     mp_obj_base_t base;
@@ -40,6 +40,8 @@ typedef struct {
     mp_obj_t bytearray;
     mp_obj_t rawbytearray;
     mp_float_t brightness;
+    mp_float_t gamma;
+    uint8_t *lut; // NULL when brightness and gamma are both 1
     bool two_buffers;
     size_t offset;
     bool dotstar_mode;
@@ -315,6 +315,7 @@ STATIC const mp_rom_map_elem_t pixelbuf_module_globals_table[] = {
 STATIC MP_DEFINE_CONST_DICT(pixelbuf_module_globals, pixelbuf_module_globals_table);
 
 STATIC void pixelbuf_byteorder_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
     pixelbuf_byteorder_obj_t *self = MP_OBJ_TO_PTR(self_in);
     mp_printf(print, "%q.%q", MP_QSTR__pixelbuf, self->name);
     return;
@@ -33,21 +33,24 @@
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
 
+#if MICROPY_VFS_FAT
+
 //| .. currentmodule:: audiocore
 //|
 //| :class:`WaveFile` -- Load a wave file for audio playback
 //| ========================================================
 //|
 //| A .wav file prepped for audio playback. Only mono and stereo files are supported. Samples must
-//| be 8 bit unsigned or 16 bit signed. If a buffer is provided, it will be used instead of allocating
-//| an internal buffer.
+//| be 8 bit unsigned or 16 bit signed, or 4 bit IMA ADPCM which is decoded to 16 bit signed as it
+//| plays. If a buffer is provided, it will be used instead of allocating an internal buffer.
 //|
-//| .. class:: WaveFile(file[, buffer])
+//| .. class:: WaveFile(file[, buffer], *, buffer_count=2)
 //|
 //|   Load a .wav file for playback with `audioio.AudioOut` or `audiobusio.I2SOut`.
 //|
 //|   :param typing.BinaryIO file: Already opened wave file
-//|   :param bytearray buffer: Optional pre-allocated buffer, that will be split in half and used for double-buffering of the data. If not provided, two 512 byte buffers are allocated internally.
+//|   :param bytearray buffer: Optional pre-allocated buffer, that will be split into ``buffer_count`` parts and used for buffering of the data. If not provided, two 256 byte buffers, or ``buffer_count`` 512 byte buffers when reading ahead, are allocated internally.
+//|   :param int buffer_count: Number of buffers, from 2 to 8. More than two lets the file be read ahead in the background in whole sectors, which smooths over slow storage.
 //|
 //|
 //|   Playing a wave file from flash::
@@ -71,24 +74,37 @@
 //|       pass
 //|     print("stopped")
 //|
-STATIC mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    mp_arg_check_num(n_args, kw_args, 1, 2, false);
-
-    audioio_wavefile_obj_t *self = m_new_obj(audioio_wavefile_obj_t);
-    self->base.type = &audioio_wavefile_type;
-    if (!MP_OBJ_IS_TYPE(args[0], &mp_type_fileio)) {
+STATIC mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_file, ARG_buffer, ARG_buffer_count };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_buffer, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_buffer_count, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 2} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (!MP_OBJ_IS_TYPE(args[ARG_file].u_obj, &mp_type_vfs_fat_fileio)) {
         mp_raise_TypeError(translate("file must be a file opened in byte mode"));
     }
+    mp_int_t buffer_count = args[ARG_buffer_count].u_int;
+    if (buffer_count < 2 || buffer_count > WAVEFILE_MAX_BUFFER_COUNT) {
+        mp_raise_ValueError(translate("buffer_count must be between 2 and 8"));
+    }
     uint8_t *buffer = NULL;
     size_t buffer_size = 0;
-    if (n_args >= 2) {
+    if (args[ARG_buffer].u_obj != mp_const_none) {
         mp_buffer_info_t bufinfo;
-        mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+        mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_WRITE);
         buffer = bufinfo.buf;
         buffer_size = bufinfo.len;
     }
-    common_hal_audioio_wavefile_construct(self, MP_OBJ_TO_PTR(args[0]),
-                                          buffer, buffer_size);
+
+    audioio_wavefile_obj_t *self = m_new_obj(audioio_wavefile_obj_t);
+    self->base.type = &audioio_wavefile_type;
+    common_hal_audioio_wavefile_construct(self, MP_OBJ_TO_PTR(args[ARG_file].u_obj),
+                                          buffer, buffer_size, buffer_count);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -192,6 +208,24 @@ const mp_obj_property_t audioio_wavefile_channel_count_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: underruns
+//|
+//|     Number of times playback caught up with reading ahead and had to wait for the file to be
+//|     read. Always 0 with the default two buffers. (read only)
+//|
+STATIC mp_obj_t audioio_wavefile_obj_get_underruns(mp_obj_t self_in) {
+    audioio_wavefile_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_audioio_wavefile_get_underruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_wavefile_get_underruns_obj, audioio_wavefile_obj_get_underruns);
+
+const mp_obj_property_t audioio_wavefile_underruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_wavefile_get_underruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
 
 STATIC const mp_rom_map_elem_t audioio_wavefile_locals_dict_table[] = {
     // Methods
@@ -203,6 +237,7 @@ STATIC const mp_rom_map_elem_t audioio_wavefile_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audioio_wavefile_sample_rate_obj) },
     { MP_ROM_QSTR(MP_QSTR_bits_per_sample), MP_ROM_PTR(&audioio_wavefile_bits_per_sample_obj) },
     { MP_ROM_QSTR(MP_QSTR_channel_count), MP_ROM_PTR(&audioio_wavefile_channel_count_obj) },
+    { MP_ROM_QSTR(MP_QSTR_underruns), MP_ROM_PTR(&audioio_wavefile_underruns_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(audioio_wavefile_locals_dict, audioio_wavefile_locals_dict_table);
 
@@ -212,3 +247,5 @@ const mp_obj_type_t audioio_wavefile_type = {
     .make_new = audioio_wavefile_make_new,
     .locals_dict = (mp_obj_dict_t*)&audioio_wavefile_locals_dict,
 };
+
+#endif // MICROPY_VFS_FAT
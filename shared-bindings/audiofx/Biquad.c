@@ -0,0 +1,356 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audiofx/Biquad.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audiofx
+//|
+//| :class:`Biquad` -- Filters a sample
+//| ========================================================
+//|
+//| A second order IIR filter section with fixed point math. Chain several to make steeper filters.
+//|
+//| .. class:: Biquad(sample, kind, frequency, *, q=0.7071, gain=0.0, buffer_size=1024)
+//|
+//|   Create a filter that processes ``sample`` as it plays. Coefficients come from the Audio EQ
+//|   Cookbook.
+//|
+//|   :param sample: The sample to filter. Must be 8 or 16 bit with 1 or 2 channels.
+//|   :param int kind: The filter response, one of the constants below
+//|   :param float frequency: The cutoff or center frequency in Hertz. Must be less than half the sample rate.
+//|   :param float q: The filter's quality factor. Higher values make a narrower band or a sharper corner.
+//|   :param float gain: Boost or cut in dB from -24 to 24. Only used by `PEAKING`, `LOW_SHELF` and `HIGH_SHELF`.
+//|   :param int buffer_size: The total size in bytes of the two buffers to process into
+//|
+//|   Removing the highs from a wave file::
+//|
+//|     import audiocore
+//|     import audiofx
+//|     import audioio
+//|     import board
+//|
+//|     wave = audiocore.WaveFile(open("cplay-5.1-16bit-16khz.wav", "rb"))
+//|     muffled = audiofx.Biquad(wave, audiofx.Biquad.LOW_PASS, 800)
+//|     a = audioio.AudioOut(board.A0)
+//|     a.play(muffled)
+//|
+// The checks below are written so that NaN fails them too.
+
+STATIC void validate_frequency(mp_float_t frequency, uint32_t sample_rate) {
+    if (!(frequency > 0 && frequency < sample_rate / 2)) {
+        mp_raise_ValueError(translate("frequency must be greater than 0 and less than half the sample rate"));
+    }
+}
+
+STATIC void validate_q(mp_float_t q) {
+    if (!(q > 0 && isfinite(q))) {
+        mp_raise_ValueError(translate("q must be greater than 0"));
+    }
+}
+
+STATIC void validate_gain(mp_float_t gain) {
+    if (!(gain >= -24 && gain <= 24)) {
+        mp_raise_ValueError(translate("gain must be between -24 and 24"));
+    }
+}
+
+STATIC audiofx_biquad_kind_t validate_kind(mp_int_t kind) {
+    if (kind < AUDIOFX_BIQUAD_LOW_PASS || kind > AUDIOFX_BIQUAD_HIGH_SHELF) {
+        mp_raise_ValueError(translate("Invalid filter kind"));
+    }
+    return kind;
+}
+
+STATIC mp_obj_t audiofx_biquad_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_sample, ARG_kind, ARG_frequency, ARG_q, ARG_gain, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_kind, MP_ARG_INT | MP_ARG_REQUIRED },
+        { MP_QSTR_frequency, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_q, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_gain, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1024} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t sample = args[ARG_sample].u_obj;
+    audiofx_biquad_kind_t kind = validate_kind(args[ARG_kind].u_int);
+    mp_float_t frequency = mp_obj_get_float(args[ARG_frequency].u_obj);
+    validate_frequency(frequency, audiosample_sample_rate(sample));
+    mp_float_t q = MICROPY_FLOAT_CONST(0.7071);
+    if (args[ARG_q].u_obj != MP_OBJ_NULL) {
+        q = mp_obj_get_float(args[ARG_q].u_obj);
+        validate_q(q);
+    }
+    mp_float_t gain = 0;
+    if (args[ARG_gain].u_obj != MP_OBJ_NULL) {
+        gain = mp_obj_get_float(args[ARG_gain].u_obj);
+        validate_gain(gain);
+    }
+
+    mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 8) {
+        mp_raise_ValueError(translate("Buffer too small"));
+    }
+    audiofx_biquad_obj_t *self = m_new_obj(audiofx_biquad_obj_t);
+    self->effect.base.type = &audiofx_biquad_type;
+    common_hal_audiofx_biquad_construct(self, sample, kind, frequency, q, gain, buffer_size);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the Biquad and releases its buffers.
+//|
+STATIC mp_obj_t audiofx_biquad_deinit(mp_obj_t self_in) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audiofx_biquad_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audiofx_biquad_deinit_obj, audiofx_biquad_deinit);
+
+STATIC void check_for_deinit(audiofx_biquad_obj_t *self) {
+    if (common_hal_audiofx_biquad_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audiofx_biquad_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audiofx_biquad_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audiofx_biquad___exit___obj, 4, 4, audiofx_biquad_obj___exit__);
+
+//|   .. attribute:: sample_rate
+//|
+//|     The sample rate of the source in Hertz. (read-only)
+//|
+STATIC mp_obj_t audiofx_biquad_obj_get_sample_rate(mp_obj_t self_in) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audiofx_biquad_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_biquad_get_sample_rate_obj, audiofx_biquad_obj_get_sample_rate);
+
+const mp_obj_property_t audiofx_biquad_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_biquad_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: kind
+//|
+//|     The filter response.
+//|
+STATIC mp_obj_t audiofx_biquad_obj_get_kind(mp_obj_t self_in) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audiofx_biquad_get_kind(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_biquad_get_kind_obj, audiofx_biquad_obj_get_kind);
+
+STATIC mp_obj_t audiofx_biquad_obj_set_kind(mp_obj_t self_in, mp_obj_t kind) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiofx_biquad_set_kind(self, validate_kind(mp_obj_get_int(kind)));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiofx_biquad_set_kind_obj, audiofx_biquad_obj_set_kind);
+
+const mp_obj_property_t audiofx_biquad_kind_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_biquad_get_kind_obj,
+              (mp_obj_t)&audiofx_biquad_set_kind_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: frequency
+//|
+//|     The cutoff or center frequency in Hertz.
+//|
+STATIC mp_obj_t audiofx_biquad_obj_get_frequency(mp_obj_t self_in) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiofx_biquad_get_frequency(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_biquad_get_frequency_obj, audiofx_biquad_obj_get_frequency);
+
+STATIC mp_obj_t audiofx_biquad_obj_set_frequency(mp_obj_t self_in, mp_obj_t frequency_in) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    mp_float_t frequency = mp_obj_get_float(frequency_in);
+    validate_frequency(frequency, common_hal_audiofx_biquad_get_sample_rate(self));
+    common_hal_audiofx_biquad_set_frequency(self, frequency);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiofx_biquad_set_frequency_obj, audiofx_biquad_obj_set_frequency);
+
+const mp_obj_property_t audiofx_biquad_frequency_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_biquad_get_frequency_obj,
+              (mp_obj_t)&audiofx_biquad_set_frequency_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: q
+//|
+//|     The filter's quality factor.
+//|
+STATIC mp_obj_t audiofx_biquad_obj_get_q(mp_obj_t self_in) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiofx_biquad_get_q(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_biquad_get_q_obj, audiofx_biquad_obj_get_q);
+
+STATIC mp_obj_t audiofx_biquad_obj_set_q(mp_obj_t self_in, mp_obj_t q_in) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    mp_float_t q = mp_obj_get_float(q_in);
+    validate_q(q);
+    common_hal_audiofx_biquad_set_q(self, q);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiofx_biquad_set_q_obj, audiofx_biquad_obj_set_q);
+
+const mp_obj_property_t audiofx_biquad_q_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_biquad_get_q_obj,
+              (mp_obj_t)&audiofx_biquad_set_q_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: gain
+//|
+//|     The boost or cut in dB of peaking and shelf filters.
+//|
+STATIC mp_obj_t audiofx_biquad_obj_get_gain(mp_obj_t self_in) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiofx_biquad_get_gain(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_biquad_get_gain_obj, audiofx_biquad_obj_get_gain);
+
+STATIC mp_obj_t audiofx_biquad_obj_set_gain(mp_obj_t self_in, mp_obj_t gain_in) {
+    audiofx_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    mp_float_t gain = mp_obj_get_float(gain_in);
+    validate_gain(gain);
+    common_hal_audiofx_biquad_set_gain(self, gain);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiofx_biquad_set_gain_obj, audiofx_biquad_obj_set_gain);
+
+const mp_obj_property_t audiofx_biquad_gain_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_biquad_get_gain_obj,
+              (mp_obj_t)&audiofx_biquad_set_gain_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. data:: LOW_PASS
+//|
+//|     Passes frequencies below `frequency`.
+//|
+//|   .. data:: HIGH_PASS
+//|
+//|     Passes frequencies above `frequency`.
+//|
+//|   .. data:: BAND_PASS
+//|
+//|     Passes frequencies around `frequency`. Higher `q` makes the band narrower.
+//|
+//|   .. data:: NOTCH
+//|
+//|     Removes frequencies around `frequency`.
+//|
+//|   .. data:: PEAKING
+//|
+//|     Boosts or cuts frequencies around `frequency` by `gain`.
+//|
+//|   .. data:: LOW_SHELF
+//|
+//|     Boosts or cuts frequencies below `frequency` by `gain`.
+//|
+//|   .. data:: HIGH_SHELF
+//|
+//|     Boosts or cuts frequencies above `frequency` by `gain`.
+//|
+STATIC const mp_rom_map_elem_t audiofx_biquad_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audiofx_biquad_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audiofx_biquad___exit___obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audiofx_biquad_sample_rate_obj) },
+    { MP_ROM_QSTR(MP_QSTR_kind), MP_ROM_PTR(&audiofx_biquad_kind_obj) },
+    { MP_ROM_QSTR(MP_QSTR_frequency), MP_ROM_PTR(&audiofx_biquad_frequency_obj) },
+    { MP_ROM_QSTR(MP_QSTR_q), MP_ROM_PTR(&audiofx_biquad_q_obj) },
+    { MP_ROM_QSTR(MP_QSTR_gain), MP_ROM_PTR(&audiofx_biquad_gain_obj) },
+
+    // Constants
+    { MP_ROM_QSTR(MP_QSTR_LOW_PASS), MP_ROM_INT(AUDIOFX_BIQUAD_LOW_PASS) },
+    { MP_ROM_QSTR(MP_QSTR_HIGH_PASS), MP_ROM_INT(AUDIOFX_BIQUAD_HIGH_PASS) },
+    { MP_ROM_QSTR(MP_QSTR_BAND_PASS), MP_ROM_INT(AUDIOFX_BIQUAD_BAND_PASS) },
+    { MP_ROM_QSTR(MP_QSTR_NOTCH), MP_ROM_INT(AUDIOFX_BIQUAD_NOTCH) },
+    { MP_ROM_QSTR(MP_QSTR_PEAKING), MP_ROM_INT(AUDIOFX_BIQUAD_PEAKING) },
+    { MP_ROM_QSTR(MP_QSTR_LOW_SHELF), MP_ROM_INT(AUDIOFX_BIQUAD_LOW_SHELF) },
+    { MP_ROM_QSTR(MP_QSTR_HIGH_SHELF), MP_ROM_INT(AUDIOFX_BIQUAD_HIGH_SHELF) },
+};
+STATIC MP_DEFINE_CONST_DICT(audiofx_biquad_locals_dict, audiofx_biquad_locals_dict_table);
+
+const mp_obj_type_t audiofx_biquad_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Biquad,
+    .make_new = audiofx_biquad_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audiofx_biquad_locals_dict,
+};
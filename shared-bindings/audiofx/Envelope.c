@@ -0,0 +1,379 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audiofx/Envelope.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audiofx
+//|
+//| :class:`Envelope` -- Shapes the volume of a sample over time
+//| =============================================================
+//|
+//| An attack, decay, sustain and release envelope. The sample is silent until `press` is called.
+//| The level then rises linearly to full over the attack time and falls exponentially to the
+//| sustain level over the decay time. After `release` it falls exponentially to silence over the
+//| release time. Changes to the times and sustain level take effect at the next stage.
+//|
+//| .. class:: Envelope(sample, *, attack_time=0.0, decay_time=0.0, sustain_level=1.0, release_time=0.0, buffer_size=1024)
+//|
+//|   Create an envelope that processes ``sample`` as it plays.
+//|
+//|   :param sample: The sample to shape. Must be 8 or 16 bit with 1 or 2 channels.
+//|   :param float attack_time: Seconds to rise from silence to full level
+//|   :param float decay_time: Seconds to fall from full level to the sustain level
+//|   :param float sustain_level: The level held while pressed, from 0 to 1
+//|   :param float release_time: Seconds to fall to silence once released
+//|   :param int buffer_size: The total size in bytes of the two buffers to process into
+//|
+//|   Playing a plucked note::
+//|
+//|     import audiocore
+//|     import audiofx
+//|     import audioio
+//|     import board
+//|     import time
+//|
+//|     tone = audiocore.WaveFile(open("saw.wav", "rb"))
+//|     env = audiofx.Envelope(tone, attack_time=0.01, decay_time=0.3, sustain_level=0.5, release_time=0.5)
+//|     a = audioio.AudioOut(board.A0)
+//|     a.play(env, loop=True)
+//|     env.press()
+//|     time.sleep(1)
+//|     env.release()
+//|
+STATIC mp_float_t validate_time(mp_obj_t time_in) {
+    mp_float_t time = mp_obj_get_float(time_in);
+    if (!isfinite(time)) {
+        mp_raise_ValueError(translate("duration must be finite"));
+    }
+    if (time < 0) {
+        mp_raise_ValueError(translate("duration must not be negative"));
+    }
+    return time;
+}
+
+STATIC mp_float_t validate_level(mp_obj_t level_in) {
+    mp_float_t level = mp_obj_get_float(level_in);
+    // Written so that NaN fails too.
+    if (!(level >= 0 && level <= 1)) {
+        mp_raise_ValueError(translate("level must be between 0 and 1"));
+    }
+    return level;
+}
+
+STATIC mp_obj_t audiofx_envelope_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_sample, ARG_attack_time, ARG_decay_time, ARG_sustain_level, ARG_release_time, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_attack_time, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_decay_time, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_sustain_level, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_release_time, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1024} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t attack_time = 0;
+    if (args[ARG_attack_time].u_obj != MP_OBJ_NULL) {
+        attack_time = validate_time(args[ARG_attack_time].u_obj);
+    }
+    mp_float_t decay_time = 0;
+    if (args[ARG_decay_time].u_obj != MP_OBJ_NULL) {
+        decay_time = validate_time(args[ARG_decay_time].u_obj);
+    }
+    mp_float_t sustain_level = 1;
+    if (args[ARG_sustain_level].u_obj != MP_OBJ_NULL) {
+        sustain_level = validate_level(args[ARG_sustain_level].u_obj);
+    }
+    mp_float_t release_time = 0;
+    if (args[ARG_release_time].u_obj != MP_OBJ_NULL) {
+        release_time = validate_time(args[ARG_release_time].u_obj);
+    }
+
+    mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 8) {
+        mp_raise_ValueError(translate("Buffer too small"));
+    }
+    audiofx_envelope_obj_t *self = m_new_obj(audiofx_envelope_obj_t);
+    self->effect.base.type = &audiofx_envelope_type;
+    common_hal_audiofx_envelope_construct(self, args[ARG_sample].u_obj, attack_time, decay_time,
+                                          sustain_level, release_time, buffer_size);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the Envelope and releases its buffers.
+//|
+STATIC mp_obj_t audiofx_envelope_deinit(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audiofx_envelope_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_deinit_obj, audiofx_envelope_deinit);
+
+STATIC void check_for_deinit(audiofx_envelope_obj_t *self) {
+    if (common_hal_audiofx_envelope_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audiofx_envelope_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audiofx_envelope_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audiofx_envelope___exit___obj, 4, 4, audiofx_envelope_obj___exit__);
+
+//|   .. method:: press()
+//|
+//|     Starts the attack from the current level.
+//|
+STATIC mp_obj_t audiofx_envelope_obj_press(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiofx_envelope_press(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_press_obj, audiofx_envelope_obj_press);
+
+//|   .. method:: release()
+//|
+//|     Starts the release from the current level.
+//|
+STATIC mp_obj_t audiofx_envelope_obj_release(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiofx_envelope_release(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_release_obj, audiofx_envelope_obj_release);
+
+//|   .. attribute:: level
+//|
+//|     The current level of the envelope, from 0 to 1. (read-only)
+//|
+STATIC mp_obj_t audiofx_envelope_obj_get_level(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiofx_envelope_get_level(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_get_level_obj, audiofx_envelope_obj_get_level);
+
+const mp_obj_property_t audiofx_envelope_level_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_envelope_get_level_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: active
+//|
+//|     True from `press` until the release has finished. (read-only)
+//|
+STATIC mp_obj_t audiofx_envelope_obj_get_active(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_audiofx_envelope_get_active(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_get_active_obj, audiofx_envelope_obj_get_active);
+
+const mp_obj_property_t audiofx_envelope_active_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_envelope_get_active_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     The sample rate of the source in Hertz. (read-only)
+//|
+STATIC mp_obj_t audiofx_envelope_obj_get_sample_rate(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audiofx_envelope_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_get_sample_rate_obj, audiofx_envelope_obj_get_sample_rate);
+
+const mp_obj_property_t audiofx_envelope_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_envelope_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: attack_time
+//|
+//|     Seconds to rise from silence to full level.
+//|
+STATIC mp_obj_t audiofx_envelope_obj_get_attack_time(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiofx_envelope_get_attack_time(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_get_attack_time_obj, audiofx_envelope_obj_get_attack_time);
+
+STATIC mp_obj_t audiofx_envelope_obj_set_attack_time(mp_obj_t self_in, mp_obj_t attack_time) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiofx_envelope_set_attack_time(self, validate_time(attack_time));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiofx_envelope_set_attack_time_obj, audiofx_envelope_obj_set_attack_time);
+
+const mp_obj_property_t audiofx_envelope_attack_time_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_envelope_get_attack_time_obj,
+              (mp_obj_t)&audiofx_envelope_set_attack_time_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: decay_time
+//|
+//|     Seconds to fall from full level to `sustain_level`.
+//|
+STATIC mp_obj_t audiofx_envelope_obj_get_decay_time(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiofx_envelope_get_decay_time(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_get_decay_time_obj, audiofx_envelope_obj_get_decay_time);
+
+STATIC mp_obj_t audiofx_envelope_obj_set_decay_time(mp_obj_t self_in, mp_obj_t decay_time) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiofx_envelope_set_decay_time(self, validate_time(decay_time));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiofx_envelope_set_decay_time_obj, audiofx_envelope_obj_set_decay_time);
+
+const mp_obj_property_t audiofx_envelope_decay_time_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_envelope_get_decay_time_obj,
+              (mp_obj_t)&audiofx_envelope_set_decay_time_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sustain_level
+//|
+//|     The level held after the decay, from 0 to 1.
+//|
+STATIC mp_obj_t audiofx_envelope_obj_get_sustain_level(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiofx_envelope_get_sustain_level(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_get_sustain_level_obj, audiofx_envelope_obj_get_sustain_level);
+
+STATIC mp_obj_t audiofx_envelope_obj_set_sustain_level(mp_obj_t self_in, mp_obj_t sustain_level) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiofx_envelope_set_sustain_level(self, validate_level(sustain_level));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiofx_envelope_set_sustain_level_obj, audiofx_envelope_obj_set_sustain_level);
+
+const mp_obj_property_t audiofx_envelope_sustain_level_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_envelope_get_sustain_level_obj,
+              (mp_obj_t)&audiofx_envelope_set_sustain_level_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: release_time
+//|
+//|     Seconds to fall to silence after `release`.
+//|
+STATIC mp_obj_t audiofx_envelope_obj_get_release_time(mp_obj_t self_in) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiofx_envelope_get_release_time(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_envelope_get_release_time_obj, audiofx_envelope_obj_get_release_time);
+
+STATIC mp_obj_t audiofx_envelope_obj_set_release_time(mp_obj_t self_in, mp_obj_t release_time) {
+    audiofx_envelope_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiofx_envelope_set_release_time(self, validate_time(release_time));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiofx_envelope_set_release_time_obj, audiofx_envelope_obj_set_release_time);
+
+const mp_obj_property_t audiofx_envelope_release_time_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_envelope_get_release_time_obj,
+              (mp_obj_t)&audiofx_envelope_set_release_time_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t audiofx_envelope_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audiofx_envelope_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audiofx_envelope___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_press), MP_ROM_PTR(&audiofx_envelope_press_obj) },
+    { MP_ROM_QSTR(MP_QSTR_release), MP_ROM_PTR(&audiofx_envelope_release_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_level), MP_ROM_PTR(&audiofx_envelope_level_obj) },
+    { MP_ROM_QSTR(MP_QSTR_active), MP_ROM_PTR(&audiofx_envelope_active_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audiofx_envelope_sample_rate_obj) },
+    { MP_ROM_QSTR(MP_QSTR_attack_time), MP_ROM_PTR(&audiofx_envelope_attack_time_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decay_time), MP_ROM_PTR(&audiofx_envelope_decay_time_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sustain_level), MP_ROM_PTR(&audiofx_envelope_sustain_level_obj) },
+    { MP_ROM_QSTR(MP_QSTR_release_time), MP_ROM_PTR(&audiofx_envelope_release_time_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audiofx_envelope_locals_dict, audiofx_envelope_locals_dict_table);
+
+const mp_obj_type_t audiofx_envelope_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Envelope,
+    .make_new = audiofx_envelope_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audiofx_envelope_locals_dict,
+};
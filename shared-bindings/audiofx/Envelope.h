@@ -0,0 +1,55 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOFX_ENVELOPE_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOFX_ENVELOPE_H
+
+#include "shared-module/audiofx/Envelope.h"
+
+extern const mp_obj_type_t audiofx_envelope_type;
+
+void common_hal_audiofx_envelope_construct(audiofx_envelope_obj_t* self, mp_obj_t sample,
+                                           mp_float_t attack_time, mp_float_t decay_time,
+                                           mp_float_t sustain_level, mp_float_t release_time,
+                                           uint32_t buffer_size);
+
+void common_hal_audiofx_envelope_deinit(audiofx_envelope_obj_t* self);
+bool common_hal_audiofx_envelope_deinited(audiofx_envelope_obj_t* self);
+uint32_t common_hal_audiofx_envelope_get_sample_rate(audiofx_envelope_obj_t* self);
+void common_hal_audiofx_envelope_press(audiofx_envelope_obj_t* self);
+void common_hal_audiofx_envelope_release(audiofx_envelope_obj_t* self);
+mp_float_t common_hal_audiofx_envelope_get_level(audiofx_envelope_obj_t* self);
+bool common_hal_audiofx_envelope_get_active(audiofx_envelope_obj_t* self);
+mp_float_t common_hal_audiofx_envelope_get_attack_time(audiofx_envelope_obj_t* self);
+void common_hal_audiofx_envelope_set_attack_time(audiofx_envelope_obj_t* self, mp_float_t attack_time);
+mp_float_t common_hal_audiofx_envelope_get_decay_time(audiofx_envelope_obj_t* self);
+void common_hal_audiofx_envelope_set_decay_time(audiofx_envelope_obj_t* self, mp_float_t decay_time);
+mp_float_t common_hal_audiofx_envelope_get_sustain_level(audiofx_envelope_obj_t* self);
+void common_hal_audiofx_envelope_set_sustain_level(audiofx_envelope_obj_t* self, mp_float_t sustain_level);
+mp_float_t common_hal_audiofx_envelope_get_release_time(audiofx_envelope_obj_t* self);
+void common_hal_audiofx_envelope_set_release_time(audiofx_envelope_obj_t* self, mp_float_t release_time);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOFX_ENVELOPE_H
@@ -0,0 +1,251 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audiofx/Gain.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audiofx
+//|
+//| :class:`Gain` -- Changes the volume of a sample
+//| ========================================================
+//|
+//| Scales a sample by a level that can ramp smoothly to a new value, for fades and ducking.
+//|
+//| .. class:: Gain(sample, level=1.0, *, buffer_size=1024)
+//|
+//|   Create a gain stage that processes ``sample`` as it plays.
+//|
+//|   :param sample: The sample to scale. Must be 8 or 16 bit with 1 or 2 channels.
+//|   :param float level: The starting level, from 0 to 1
+//|   :param int buffer_size: The total size in bytes of the two buffers to process into
+//|
+//|   Fading out a wave file over two seconds::
+//|
+//|     import audiocore
+//|     import audiofx
+//|     import audioio
+//|     import board
+//|     import time
+//|
+//|     wave = audiocore.WaveFile(open("cplay-5.1-16bit-16khz.wav", "rb"))
+//|     fader = audiofx.Gain(wave)
+//|     a = audioio.AudioOut(board.A0)
+//|     a.play(fader)
+//|     time.sleep(1)
+//|     fader.ramp(0, 2)
+//|
+STATIC mp_float_t validate_level(mp_obj_t level_in) {
+    mp_float_t level = mp_obj_get_float(level_in);
+    // Written so that NaN fails too.
+    if (!(level >= 0 && level <= 1)) {
+        mp_raise_ValueError(translate("level must be between 0 and 1"));
+    }
+    return level;
+}
+
+STATIC mp_obj_t audiofx_gain_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_sample, ARG_level, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_level, MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1024} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t level = 1;
+    if (args[ARG_level].u_obj != MP_OBJ_NULL) {
+        level = validate_level(args[ARG_level].u_obj);
+    }
+
+    mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 8) {
+        mp_raise_ValueError(translate("Buffer too small"));
+    }
+    audiofx_gain_obj_t *self = m_new_obj(audiofx_gain_obj_t);
+    self->effect.base.type = &audiofx_gain_type;
+    common_hal_audiofx_gain_construct(self, args[ARG_sample].u_obj, level, buffer_size);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the Gain and releases its buffers.
+//|
+STATIC mp_obj_t audiofx_gain_deinit(mp_obj_t self_in) {
+    audiofx_gain_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audiofx_gain_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audiofx_gain_deinit_obj, audiofx_gain_deinit);
+
+STATIC void check_for_deinit(audiofx_gain_obj_t *self) {
+    if (common_hal_audiofx_gain_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audiofx_gain_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audiofx_gain_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audiofx_gain___exit___obj, 4, 4, audiofx_gain_obj___exit__);
+
+//|   .. method:: ramp(level, duration, *, exponential=False)
+//|
+//|     Moves smoothly from the current level to ``level`` over ``duration`` seconds. Does not
+//|     block. Exponential ramps change by the same number of dB every step which sounds more even
+//|     for long fades. They fade to about -80dB before going silent.
+//|
+STATIC mp_obj_t audiofx_gain_obj_ramp(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_level, ARG_duration, ARG_exponential };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_level, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_duration, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_exponential, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+    };
+    audiofx_gain_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t level = validate_level(args[ARG_level].u_obj);
+    mp_float_t duration = mp_obj_get_float(args[ARG_duration].u_obj);
+    if (!isfinite(duration)) {
+        mp_raise_ValueError(translate("duration must be finite"));
+    }
+    if (duration < 0) {
+        mp_raise_ValueError(translate("duration must not be negative"));
+    }
+    common_hal_audiofx_gain_ramp(self, level, duration, args[ARG_exponential].u_bool);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audiofx_gain_ramp_obj, 1, audiofx_gain_obj_ramp);
+
+//|   .. attribute:: level
+//|
+//|     The current level, as a floating point number between 0 and 1. Setting it stops any ramp.
+//|
+STATIC mp_obj_t audiofx_gain_obj_get_level(mp_obj_t self_in) {
+    audiofx_gain_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiofx_gain_get_level(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_gain_get_level_obj, audiofx_gain_obj_get_level);
+
+STATIC mp_obj_t audiofx_gain_obj_set_level(mp_obj_t self_in, mp_obj_t level) {
+    audiofx_gain_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiofx_gain_set_level(self, validate_level(level));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiofx_gain_set_level_obj, audiofx_gain_obj_set_level);
+
+const mp_obj_property_t audiofx_gain_level_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_gain_get_level_obj,
+              (mp_obj_t)&audiofx_gain_set_level_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: ramping
+//|
+//|     True while a ramp is in progress. (read-only)
+//|
+STATIC mp_obj_t audiofx_gain_obj_get_ramping(mp_obj_t self_in) {
+    audiofx_gain_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_audiofx_gain_get_ramping(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_gain_get_ramping_obj, audiofx_gain_obj_get_ramping);
+
+const mp_obj_property_t audiofx_gain_ramping_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_gain_get_ramping_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     The sample rate of the source in Hertz. (read-only)
+//|
+STATIC mp_obj_t audiofx_gain_obj_get_sample_rate(mp_obj_t self_in) {
+    audiofx_gain_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audiofx_gain_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiofx_gain_get_sample_rate_obj, audiofx_gain_obj_get_sample_rate);
+
+const mp_obj_property_t audiofx_gain_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiofx_gain_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t audiofx_gain_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audiofx_gain_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audiofx_gain___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_ramp), MP_ROM_PTR(&audiofx_gain_ramp_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_level), MP_ROM_PTR(&audiofx_gain_level_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ramping), MP_ROM_PTR(&audiofx_gain_ramping_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audiofx_gain_sample_rate_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audiofx_gain_locals_dict, audiofx_gain_locals_dict_table);
+
+const mp_obj_type_t audiofx_gain_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Gain,
+    .make_new = audiofx_gain_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audiofx_gain_locals_dict,
+};
@@ -0,0 +1,69 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/audiofx/Biquad.h"
+#include "shared-bindings/audiofx/Envelope.h"
+#include "shared-bindings/audiofx/Gain.h"
+
+//| :mod:`audiofx` --- Support for audio effects
+//| ========================================================
+//|
+//| .. module:: audiofx
+//|   :synopsis: Support for audio effects
+//|
+//| The `audiofx` module contains classes that process the output of another audio sample as it
+//| plays. Each effect is itself a sample, so effects can be chained and played by any audio output
+//| or `audiomixer.Mixer` voice. Effects output 16 bit signed samples with the same sample rate and
+//| channel count as their source.
+//|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     Biquad
+//|     Envelope
+//|     Gain
+//|
+
+STATIC const mp_rom_map_elem_t audiofx_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_audiofx) },
+    { MP_ROM_QSTR(MP_QSTR_Biquad), MP_ROM_PTR(&audiofx_biquad_type) },
+    { MP_ROM_QSTR(MP_QSTR_Envelope), MP_ROM_PTR(&audiofx_envelope_type) },
+    { MP_ROM_QSTR(MP_QSTR_Gain), MP_ROM_PTR(&audiofx_gain_type) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(audiofx_module_globals, audiofx_module_globals_table);
+
+const mp_obj_module_t audiofx_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&audiofx_module_globals,
+};
@@ -33,7 +33,6 @@
 #include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
-#include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/audiocore/RawSample.h"
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
@@ -47,15 +46,16 @@
 //|
 //| .. class:: Mixer(voice_count=2, buffer_size=1024, channel_count=2, bits_per_sample=16, samples_signed=True, sample_rate=8000)
 //|
-//|   Create a Mixer object that can mix multiple channels with the same sample rate.
+//|   Create a Mixer object that can mix multiple channels into one output format.
 //|   Samples are accessed and controlled with the mixer's `audiomixer.MixerVoice` objects.
+//|   Samples in other formats are converted to the mixer's format as they play.
 //|
 //|   :param int voice_count: The maximum number of voices to mix
 //|   :param int buffer_size: The total size in bytes of the buffers to mix into
-//|   :param int channel_count: The number of channels the source samples contain. 1 = mono; 2 = stereo.
-//|   :param int bits_per_sample: The bits per sample of the samples being played
-//|   :param bool samples_signed: Samples are signed (True) or unsigned (False)
-//|   :param int sample_rate: The sample rate to be used for all samples
+//|   :param int channel_count: The number of channels the mixer outputs. 1 = mono; 2 = stereo.
+//|   :param int bits_per_sample: The bits per sample the mixer outputs
+//|   :param bool samples_signed: Output samples are signed (True) or unsigned (False)
+//|   :param int sample_rate: The sample rate the mixer outputs
 //|
 //|   Playing a wave file from flash::
 //|
@@ -83,6 +83,7 @@
 //|     print("stopped")
 //|
 STATIC mp_obj_t audiomixer_mixer_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
     enum { ARG_voice_count, ARG_buffer_size, ARG_channel_count, ARG_bits_per_sample, ARG_samples_signed, ARG_sample_rate };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_voice_count, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 2} },
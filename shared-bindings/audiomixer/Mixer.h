@@ -27,7 +27,6 @@
 #ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOMIXER_MIXER_H
 #define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOMIXER_MIXER_H
 
-#include "common-hal/microcontroller/Pin.h"
 #include "shared-module/audiomixer/Mixer.h"
 #include "shared-bindings/audiocore/RawSample.h"
 
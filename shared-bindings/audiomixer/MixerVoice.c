@@ -32,7 +32,6 @@
 #include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
-#include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/audiocore/RawSample.h"
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
@@ -50,6 +49,10 @@
 //|
 // TODO: support mono or stereo voices
 STATIC mp_obj_t audiomixer_mixervoice_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    (void)n_args;
+    (void)pos_args;
+    (void)kw_args;
     audiomixer_mixervoice_obj_t *self = m_new_obj(audiomixer_mixervoice_obj_t);
     self->base.type = &audiomixer_mixervoice_type;
 
@@ -65,7 +68,9 @@ STATIC mp_obj_t audiomixer_mixervoice_make_new(const mp_obj_type_t *type, size_t
 //|
 //|     Sample must be an `audiocore.WaveFile`, `audiomixer.Mixer` or `audiocore.RawSample`.
 //|
-//|     The sample must match the `audiomixer.Mixer`'s encoding settings given in the constructor.
+//|     Samples with a different sample rate, bits per sample, signedness or channel count than the
+//|     `audiomixer.Mixer` are converted as they play. Samples that match the mixer are copied
+//|     directly, which is faster.
 //|
 STATIC mp_obj_t audiomixer_mixervoice_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_sample, ARG_loop };
@@ -104,7 +109,8 @@ MP_DEFINE_CONST_FUN_OBJ_KW(audiomixer_mixervoice_stop_obj, 1, audiomixer_mixervo
 
 //|   .. attribute:: level()
 //|
-//|     The volume level of a voice, as a floating point number between 0 and 1.
+//|     The volume level of a voice, as a floating point number between 0 and 1. Changes while
+//|     playing ramp smoothly over the next mixer buffer to avoid clicks.
 //|
 STATIC mp_obj_t audiomixer_mixervoice_obj_get_level(mp_obj_t self_in) {
     return mp_obj_new_float(common_hal_audiomixer_mixervoice_get_level(self_in));
@@ -139,6 +145,38 @@ const mp_obj_property_t audiomixer_mixervoice_level_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: playback_rate
+//|
+//|     The speed the sample plays at relative to its own sample rate, as a floating point number
+//|     greater than 0 and at most 8. Values other than 1 also shift the pitch. Sample rate
+//|     conversion is done by linear interpolation.
+//|
+STATIC mp_obj_t audiomixer_mixervoice_obj_get_playback_rate(mp_obj_t self_in) {
+    return mp_obj_new_float(common_hal_audiomixer_mixervoice_get_playback_rate(self_in));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiomixer_mixervoice_get_playback_rate_obj, audiomixer_mixervoice_obj_get_playback_rate);
+
+STATIC mp_obj_t audiomixer_mixervoice_obj_set_playback_rate(mp_obj_t self_in, mp_obj_t playback_rate_in) {
+    audiomixer_mixervoice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_float_t playback_rate = mp_obj_get_float(playback_rate_in);
+
+    if (playback_rate > 8 || playback_rate <= 0) {
+        mp_raise_ValueError(translate("playback_rate must be greater than 0 and at most 8"));
+    }
+
+    common_hal_audiomixer_mixervoice_set_playback_rate(self, playback_rate);
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiomixer_mixervoice_set_playback_rate_obj, audiomixer_mixervoice_obj_set_playback_rate);
+
+const mp_obj_property_t audiomixer_mixervoice_playback_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiomixer_mixervoice_get_playback_rate_obj,
+              (mp_obj_t)&audiomixer_mixervoice_set_playback_rate_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 //|  .. attribute:: playing
 //|
 //|     True when this voice is being output. (read-only)
@@ -167,6 +205,7 @@ STATIC const mp_rom_map_elem_t audiomixer_mixervoice_locals_dict_table[] = {
     // Properties
     { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audiomixer_mixervoice_playing_obj) },
     { MP_ROM_QSTR(MP_QSTR_level), MP_ROM_PTR(&audiomixer_mixervoice_level_obj) },
+    { MP_ROM_QSTR(MP_QSTR_playback_rate), MP_ROM_PTR(&audiomixer_mixervoice_playback_rate_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(audiomixer_mixervoice_locals_dict, audiomixer_mixervoice_locals_dict_table);
 
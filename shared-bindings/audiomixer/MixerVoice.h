@@ -26,7 +26,6 @@
 #ifndef SHARED_BINDINGS_AUDIOMIXER_MIXERVOICE_H_
 #define SHARED_BINDINGS_AUDIOMIXER_MIXERVOICE_H_
 
-#include "common-hal/microcontroller/Pin.h"
 #include "shared-bindings/audiocore/RawSample.h"
 
 #include "shared-module/audiomixer/MixerVoice.h"
@@ -41,6 +40,8 @@ void common_hal_audiomixer_mixervoice_play(audiomixer_mixervoice_obj_t* self, mp
 void common_hal_audiomixer_mixervoice_stop(audiomixer_mixervoice_obj_t* self);
 float common_hal_audiomixer_mixervoice_get_level(audiomixer_mixervoice_obj_t* self);
 void common_hal_audiomixer_mixervoice_set_level(audiomixer_mixervoice_obj_t* self, float gain);
+float common_hal_audiomixer_mixervoice_get_playback_rate(audiomixer_mixervoice_obj_t* self);
+void common_hal_audiomixer_mixervoice_set_playback_rate(audiomixer_mixervoice_obj_t* self, float playback_rate);
 
 bool common_hal_audiomixer_mixervoice_get_playing(audiomixer_mixervoice_obj_t* self);
 
@@ -0,0 +1,330 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "shared-bindings/audiosink/AudioSink.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audiosink
+//|
+//| :class:`AudioSink` -- Plays samples without audio hardware
+//| ===========================================================
+//|
+//| AudioSink pulls buffers from a sample the same way the audio outputs do. Nothing is played in
+//| the background, instead `run` generates audio as fast as the sample can provide it. Time spent
+//| in the sample is measured and compared with how long each buffer would take to play.
+//|
+//| .. class:: AudioSink(file=None)
+//|
+//|   Create an AudioSink object.
+//|
+//|   :param typing.BinaryIO file: Already opened file that a wave file is written to, or None to
+//|     discard the audio. The file should be seekable so the lengths can be filled in when
+//|     playback stops.
+//|
+//|   Benchmarking a mixer::
+//|
+//|     import audiosink
+//|     import synthio
+//|
+//|     synth = synthio.Synthesizer(voice_count=8, sample_rate=44100)
+//|     for i, voice in enumerate(synth.voice):
+//|         voice.note_on(220 * (i + 1), amplitude=0.1)
+//|     with open("out.wav", "wb") as f:
+//|         with audiosink.AudioSink(f) as sink:
+//|             sink.play(synth)
+//|             sink.run(10)
+//|             sink.stop()
+//|             print(sink.cpu_time / 10 * 100, "% CPU,", sink.underruns, "underruns")
+//|
+STATIC mp_obj_t audiosink_audiosink_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_file };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t file = args[ARG_file].u_obj;
+    if (file == mp_const_none) {
+        file = MP_OBJ_NULL;
+    } else {
+        mp_get_stream_raise(file, MP_STREAM_OP_WRITE);
+    }
+
+    audiosink_audiosink_obj_t *self = m_new_obj(audiosink_audiosink_obj_t);
+    self->base.type = &audiosink_audiosink_type;
+    common_hal_audiosink_audiosink_construct(self, file);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Stops playback and finishes the wave file.
+//|
+STATIC mp_obj_t audiosink_audiosink_deinit(mp_obj_t self_in) {
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audiosink_audiosink_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audiosink_audiosink_deinit_obj, audiosink_audiosink_deinit);
+
+STATIC void check_for_deinit(audiosink_audiosink_obj_t *self) {
+    if (common_hal_audiosink_audiosink_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audiosink_audiosink_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audiosink_audiosink_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audiosink_audiosink___exit___obj, 4, 4, audiosink_audiosink_obj___exit__);
+
+//|   .. method:: play(sample, *, loop=False)
+//|
+//|     Starts playing the sample once when loop=False and continuously when loop=True. Audio is
+//|     only generated by `run`. Any sample already playing is stopped first and the statistics
+//|     are reset.
+//|
+//|     Sample must be an `audiocore.WaveFile`, `audiocore.RawSample`, `audiomixer.Mixer` or any
+//|     other audio sample.
+//|
+STATIC mp_obj_t audiosink_audiosink_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_sample, ARG_loop };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample,    MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_loop,      MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+    };
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    common_hal_audiosink_audiosink_play(self, args[ARG_sample].u_obj, args[ARG_loop].u_bool);
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audiosink_audiosink_play_obj, 1, audiosink_audiosink_obj_play);
+
+//|   .. method:: run(duration=None)
+//|
+//|     Generates ``duration`` seconds of audio, or all of it when None. Playback stops when a
+//|     sample that isn't looping ends. Returns the number of frames generated, which may be more
+//|     than requested because whole buffers are pulled from the sample.
+//|
+STATIC mp_obj_t audiosink_audiosink_obj_run(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_duration };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_duration, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t duration = -1;
+    if (args[ARG_duration].u_obj != mp_const_none) {
+        duration = mp_obj_get_float(args[ARG_duration].u_obj);
+        if (duration < 0) {
+            mp_raise_ValueError(translate("duration must be positive"));
+        }
+    } else if (self->loop) {
+        mp_raise_ValueError(translate("duration is required when looping"));
+    }
+
+    return mp_obj_new_int_from_uint(common_hal_audiosink_audiosink_run(self, duration));
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audiosink_audiosink_run_obj, 1, audiosink_audiosink_obj_run);
+
+//|   .. method:: stop()
+//|
+//|     Stops playback and fills in the lengths of the wave file.
+//|
+STATIC mp_obj_t audiosink_audiosink_obj_stop(mp_obj_t self_in) {
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_audiosink_audiosink_stop(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosink_audiosink_stop_obj, audiosink_audiosink_obj_stop);
+
+//|   .. attribute:: playing
+//|
+//|     True when a sample is playing. (read-only)
+//|
+STATIC mp_obj_t audiosink_audiosink_obj_get_playing(mp_obj_t self_in) {
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_audiosink_audiosink_get_playing(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosink_audiosink_get_playing_obj, audiosink_audiosink_obj_get_playing);
+
+const mp_obj_property_t audiosink_audiosink_playing_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiosink_audiosink_get_playing_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: buffers
+//|
+//|     The number of buffers pulled from the sample since `play` was called. (read-only)
+//|
+STATIC mp_obj_t audiosink_audiosink_obj_get_buffers(mp_obj_t self_in) {
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_audiosink_audiosink_get_buffer_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosink_audiosink_get_buffers_obj, audiosink_audiosink_obj_get_buffers);
+
+const mp_obj_property_t audiosink_audiosink_buffers_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiosink_audiosink_get_buffers_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: frames
+//|
+//|     The number of frames generated since `play` was called. (read-only)
+//|
+STATIC mp_obj_t audiosink_audiosink_obj_get_frames(mp_obj_t self_in) {
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_ull(common_hal_audiosink_audiosink_get_frame_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosink_audiosink_get_frames_obj, audiosink_audiosink_obj_get_frames);
+
+const mp_obj_property_t audiosink_audiosink_frames_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiosink_audiosink_get_frames_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: underruns
+//|
+//|     The number of buffers that took longer to generate than the previous buffer takes to play.
+//|     A hardware output would have run out of audio for each one. (read-only)
+//|
+STATIC mp_obj_t audiosink_audiosink_obj_get_underruns(mp_obj_t self_in) {
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_audiosink_audiosink_get_underrun_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosink_audiosink_get_underruns_obj, audiosink_audiosink_obj_get_underruns);
+
+const mp_obj_property_t audiosink_audiosink_underruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiosink_audiosink_get_underruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: cpu_time
+//|
+//|     Total time in seconds spent generating buffers since `play` was called. Writing the wave
+//|     file is not included. (read-only)
+//|
+STATIC mp_obj_t audiosink_audiosink_obj_get_cpu_time(mp_obj_t self_in) {
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiosink_audiosink_get_cpu_time(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosink_audiosink_get_cpu_time_obj, audiosink_audiosink_obj_get_cpu_time);
+
+const mp_obj_property_t audiosink_audiosink_cpu_time_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiosink_audiosink_get_cpu_time_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: max_cpu_time
+//|
+//|     The longest time in seconds spent generating a single buffer since `play` was called.
+//|     (read-only)
+//|
+STATIC mp_obj_t audiosink_audiosink_obj_get_max_cpu_time(mp_obj_t self_in) {
+    audiosink_audiosink_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_float(common_hal_audiosink_audiosink_get_max_cpu_time(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiosink_audiosink_get_max_cpu_time_obj, audiosink_audiosink_obj_get_max_cpu_time);
+
+const mp_obj_property_t audiosink_audiosink_max_cpu_time_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiosink_audiosink_get_max_cpu_time_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t audiosink_audiosink_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audiosink_audiosink_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audiosink_audiosink___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_play), MP_ROM_PTR(&audiosink_audiosink_play_obj) },
+    { MP_ROM_QSTR(MP_QSTR_run), MP_ROM_PTR(&audiosink_audiosink_run_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&audiosink_audiosink_stop_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audiosink_audiosink_playing_obj) },
+    { MP_ROM_QSTR(MP_QSTR_buffers), MP_ROM_PTR(&audiosink_audiosink_buffers_obj) },
+    { MP_ROM_QSTR(MP_QSTR_frames), MP_ROM_PTR(&audiosink_audiosink_frames_obj) },
+    { MP_ROM_QSTR(MP_QSTR_underruns), MP_ROM_PTR(&audiosink_audiosink_underruns_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cpu_time), MP_ROM_PTR(&audiosink_audiosink_cpu_time_obj) },
+    { MP_ROM_QSTR(MP_QSTR_max_cpu_time), MP_ROM_PTR(&audiosink_audiosink_max_cpu_time_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audiosink_audiosink_locals_dict, audiosink_audiosink_locals_dict_table);
+
+const mp_obj_type_t audiosink_audiosink_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_AudioSink,
+    .make_new = audiosink_audiosink_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audiosink_audiosink_locals_dict,
+};
@@ -0,0 +1,49 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOSINK_AUDIOSINK_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOSINK_AUDIOSINK_H
+
+#include "shared-module/audiosink/AudioSink.h"
+
+extern const mp_obj_type_t audiosink_audiosink_type;
+
+void common_hal_audiosink_audiosink_construct(audiosink_audiosink_obj_t* self, mp_obj_t file);
+void common_hal_audiosink_audiosink_deinit(audiosink_audiosink_obj_t* self);
+bool common_hal_audiosink_audiosink_deinited(audiosink_audiosink_obj_t* self);
+void common_hal_audiosink_audiosink_play(audiosink_audiosink_obj_t* self, mp_obj_t sample, bool loop);
+void common_hal_audiosink_audiosink_stop(audiosink_audiosink_obj_t* self);
+bool common_hal_audiosink_audiosink_get_playing(audiosink_audiosink_obj_t* self);
+// Pulls duration seconds of audio from the sample, or until it ends when duration is negative.
+uint32_t common_hal_audiosink_audiosink_run(audiosink_audiosink_obj_t* self, mp_float_t duration);
+
+uint32_t common_hal_audiosink_audiosink_get_buffer_count(audiosink_audiosink_obj_t* self);
+uint64_t common_hal_audiosink_audiosink_get_frame_count(audiosink_audiosink_obj_t* self);
+uint32_t common_hal_audiosink_audiosink_get_underrun_count(audiosink_audiosink_obj_t* self);
+mp_float_t common_hal_audiosink_audiosink_get_cpu_time(audiosink_audiosink_obj_t* self);
+mp_float_t common_hal_audiosink_audiosink_get_max_cpu_time(audiosink_audiosink_obj_t* self);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOSINK_AUDIOSINK_H
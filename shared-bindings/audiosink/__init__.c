@@ -0,0 +1,62 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/audiosink/AudioSink.h"
+
+//| :mod:`audiosink` --- Support for audio output without hardware
+//| ================================================================
+//|
+//| .. module:: audiosink
+//|   :synopsis: Support for audio output without hardware
+//|
+//| The `audiosink` module plays audio samples without an audio peripheral. Samples are pulled
+//| as fast as they can be generated and are written to a wave file or discarded. This makes it
+//| possible to test and benchmark samples, mixers and effects on a host computer.
+//|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     AudioSink
+//|
+
+STATIC const mp_rom_map_elem_t audiosink_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_audiosink) },
+    { MP_ROM_QSTR(MP_QSTR_AudioSink), MP_ROM_PTR(&audiosink_audiosink_type) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(audiosink_module_globals, audiosink_module_globals_table);
+
+const mp_obj_module_t audiosink_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&audiosink_module_globals,
+};
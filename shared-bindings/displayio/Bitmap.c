@@ -27,6 +27,7 @@
 #include "shared-bindings/displayio/Bitmap.h"
 
 #include <stdint.h>
+#include <math.h>
 
 #include "lib/utils/context_manager_helpers.h"
 #include "py/binary.h"
@@ -178,8 +179,117 @@ STATIC mp_obj_t bitmap_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t val
     return mp_const_none;
 }
 
+//|   .. method:: rotozoom(source, *, x=None, y=None, source_x=None, source_y=None, angle=0.0, scale=1.0, clip=None, skip_index=None)
+//|
+//|     Draws ``source`` into this bitmap rotated by ``angle`` and scaled by ``scale``. The point
+//|     ``(source_x, source_y)`` of the source lands on ``(x, y)`` in this bitmap and the image is
+//|     rotated around it. Both default to the center of their bitmap. Pixel values are copied
+//|     unchanged.
+//|
+//|     :param displayio.Bitmap source: The bitmap to draw. Must not be this bitmap and must be at
+//|       most 8192 pixels wide and tall
+//|     :param int x: Destination x of the pivot point
+//|     :param int y: Destination y of the pivot point
+//|     :param int source_x: Source x of the pivot point
+//|     :param int source_y: Source y of the pivot point
+//|     :param float angle: Clockwise rotation in radians
+//|     :param float scale: Scale factor. Must be between 1/256 and 256
+//|     :param tuple clip: ``(x1, y1, x2, y2)`` region of this bitmap that may be drawn to. Defaults
+//|       to the whole bitmap
+//|     :param int skip_index: Source value that is left undrawn, such as a transparent background
+//|
+STATIC mp_obj_t displayio_bitmap_obj_rotozoom(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_source, ARG_x, ARG_y, ARG_source_x, ARG_source_y, ARG_angle, ARG_scale, ARG_clip, ARG_skip_index };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_source, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_x, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_y, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_source_x, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_source_y, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_angle, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_scale, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_clip, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_skip_index, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+
+    if (!MP_OBJ_IS_TYPE(args[ARG_source].u_obj, &displayio_bitmap_type)) {
+        mp_raise_TypeError(translate("source must be a Bitmap"));
+    }
+    displayio_bitmap_t *source = MP_OBJ_TO_PTR(args[ARG_source].u_obj);
+    if (source == self) {
+        mp_raise_ValueError(translate("source must not be the destination"));
+    }
+    if (self->read_only) {
+        mp_raise_RuntimeError(translate("Read-only object"));
+    }
+    // The source is walked in 16.16 fixed point so its coordinates, including the margin around
+    // the rotated source, must stay well below 32768.
+    if (common_hal_displayio_bitmap_get_width(source) > 8192 ||
+        common_hal_displayio_bitmap_get_height(source) > 8192) {
+        mp_raise_ValueError(translate("source must be at most 8192x8192"));
+    }
+
+    int16_t x = common_hal_displayio_bitmap_get_width(self) / 2;
+    if (args[ARG_x].u_obj != mp_const_none) {
+        x = mp_obj_get_int(args[ARG_x].u_obj);
+    }
+    int16_t y = common_hal_displayio_bitmap_get_height(self) / 2;
+    if (args[ARG_y].u_obj != mp_const_none) {
+        y = mp_obj_get_int(args[ARG_y].u_obj);
+    }
+    int16_t source_x = common_hal_displayio_bitmap_get_width(source) / 2;
+    if (args[ARG_source_x].u_obj != mp_const_none) {
+        source_x = mp_obj_get_int(args[ARG_source_x].u_obj);
+    }
+    int16_t source_y = common_hal_displayio_bitmap_get_height(source) / 2;
+    if (args[ARG_source_y].u_obj != mp_const_none) {
+        source_y = mp_obj_get_int(args[ARG_source_y].u_obj);
+    }
+    mp_float_t angle = 0;
+    if (args[ARG_angle].u_obj != mp_const_none) {
+        angle = mp_obj_get_float(args[ARG_angle].u_obj);
+    }
+    mp_float_t scale = 1;
+    if (args[ARG_scale].u_obj != mp_const_none) {
+        scale = mp_obj_get_float(args[ARG_scale].u_obj);
+    }
+    if (!isfinite(angle)) {
+        mp_raise_ValueError(translate("angle must be finite"));
+    }
+    // Written so that NaN fails too.
+    if (!(scale >= MICROPY_FLOAT_CONST(1.0) / 256 && scale <= 256)) {
+        mp_raise_ValueError(translate("scale must be between 1/256 and 256"));
+    }
+
+    displayio_area_t clip = {0, 0, common_hal_displayio_bitmap_get_width(self),
+                             common_hal_displayio_bitmap_get_height(self), NULL};
+    if (args[ARG_clip].u_obj != mp_const_none) {
+        mp_obj_t* items;
+        mp_obj_get_array_fixed_n(args[ARG_clip].u_obj, 4, &items);
+        clip.x1 = mp_obj_get_int(items[0]);
+        clip.y1 = mp_obj_get_int(items[1]);
+        clip.x2 = mp_obj_get_int(items[2]);
+        clip.y2 = mp_obj_get_int(items[3]);
+    }
+
+    uint32_t skip_index = 0;
+    bool skip_index_none = args[ARG_skip_index].u_obj == mp_const_none;
+    if (!skip_index_none) {
+        skip_index = mp_obj_get_int(args[ARG_skip_index].u_obj);
+    }
+
+    common_hal_displayio_bitmap_rotozoom(self, source, x, y, source_x, source_y, angle, scale,
+        &clip, skip_index, skip_index_none);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(displayio_bitmap_rotozoom_obj, 2, displayio_bitmap_obj_rotozoom);
+
 STATIC const mp_rom_map_elem_t displayio_bitmap_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&displayio_bitmap_height_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rotozoom), MP_ROM_PTR(&displayio_bitmap_rotozoom_obj) },
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_bitmap_width_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(displayio_bitmap_locals_dict, displayio_bitmap_locals_dict_table);
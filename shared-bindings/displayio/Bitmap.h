@@ -41,5 +41,8 @@ uint16_t common_hal_displayio_bitmap_get_width(displayio_bitmap_t *self);
 uint32_t common_hal_displayio_bitmap_get_bits_per_value(displayio_bitmap_t *self);
 void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *bitmap, int16_t x, int16_t y, uint32_t value);
 uint32_t common_hal_displayio_bitmap_get_pixel(displayio_bitmap_t *bitmap, int16_t x, int16_t y);
+void common_hal_displayio_bitmap_rotozoom(displayio_bitmap_t *self, displayio_bitmap_t *source,
+    int16_t ox, int16_t oy, int16_t px, int16_t py, mp_float_t angle, mp_float_t scale,
+    const displayio_area_t* clip, uint32_t skip_index, bool skip_index_none);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_BITMAP_H
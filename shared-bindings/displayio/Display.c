@@ -95,7 +95,7 @@
 //|   :param int set_column_command: Command used to set the start and end columns to update
 //|   :param int set_row_command: Command used so set the start and end rows to update
 //|   :param int write_ram_command: Command used to write pixels values into the update region. Ignored if data_as_commands is set.
-//|   :param int set_vertical_scroll: Command used to set the first row to show
+//|   :param int set_vertical_scroll: Command used to set the first row to show. Only used when `hardware_scroll` is True.
 //|   :param microcontroller.Pin backlight_pin: Pin connected to the display's backlight
 //|   :param int brightness_command: Command to set display brightness. Usually available in OLED controllers.
 //|   :param bool brightness: Initial display brightness. This value is ignored if auto_brightness is True.
@@ -279,6 +279,34 @@ const mp_obj_property_t displayio_display_auto_refresh_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: hardware_scroll
+//|
+//|     True when the display may use ``set_vertical_scroll`` to move a scrolling TileGrid, such as
+//|     the terminal, instead of redrawing it. Only enable it when rotation is 0 or 180, rowstart is
+//|     0 and the display's height covers all of the panel's rows. Defaults to False.
+//|
+STATIC mp_obj_t displayio_display_obj_get_hardware_scroll(mp_obj_t self_in) {
+    displayio_display_obj_t *self = native_display(self_in);
+    return mp_obj_new_bool(common_hal_displayio_display_get_hardware_scroll(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_display_get_hardware_scroll_obj, displayio_display_obj_get_hardware_scroll);
+
+STATIC mp_obj_t displayio_display_obj_set_hardware_scroll(mp_obj_t self_in, mp_obj_t hardware_scroll) {
+    displayio_display_obj_t *self = native_display(self_in);
+
+    common_hal_displayio_display_set_hardware_scroll(self, mp_obj_is_true(hardware_scroll));
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(displayio_display_set_hardware_scroll_obj, displayio_display_obj_set_hardware_scroll);
+
+const mp_obj_property_t displayio_display_hardware_scroll_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_display_get_hardware_scroll_obj,
+              (mp_obj_t)&displayio_display_set_hardware_scroll_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 //|   .. attribute:: brightness
 //|
 //|     The brightness of the display as a float. 0.0 is off and 1.0 is full brightness. When
@@ -487,6 +515,7 @@ STATIC const mp_rom_map_elem_t displayio_display_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_fill_row), MP_ROM_PTR(&displayio_display_fill_row_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_auto_refresh), MP_ROM_PTR(&displayio_display_auto_refresh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_hardware_scroll), MP_ROM_PTR(&displayio_display_hardware_scroll_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&displayio_display_brightness_obj) },
     { MP_ROM_QSTR(MP_QSTR_auto_brightness), MP_ROM_PTR(&displayio_display_auto_brightness_obj) },
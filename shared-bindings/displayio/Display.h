@@ -55,6 +55,9 @@ bool common_hal_displayio_display_refresh(displayio_display_obj_t* self, uint32_
 bool common_hal_displayio_display_get_auto_refresh(displayio_display_obj_t* self);
 void common_hal_displayio_display_set_auto_refresh(displayio_display_obj_t* self, bool auto_refresh);
 
+bool common_hal_displayio_display_get_hardware_scroll(displayio_display_obj_t* self);
+void common_hal_displayio_display_set_hardware_scroll(displayio_display_obj_t* self, bool hardware_scroll);
+
 uint16_t common_hal_displayio_display_get_width(displayio_display_obj_t* self);
 uint16_t common_hal_displayio_display_get_height(displayio_display_obj_t* self);
 uint16_t common_hal_displayio_display_get_rotation(displayio_display_obj_t* self);
@@ -0,0 +1,127 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "shared-bindings/displayio/RLEBitmap.h"
+
+#include <stdint.h>
+
+#include "py/runtime.h"
+#include "py/objproperty.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: displayio
+//|
+//| :class:`RLEBitmap` -- Decodes run length encoded pixels as they are drawn
+//| ==========================================================================
+//|
+//| A read-only bitmap backed by a run length encoded BMP that stays compressed. Rows are decoded
+//| when they are drawn so large images and sprite sheets only need RAM for a small row index
+//| and a few decoded rows. The BMP can be in a buffer, such as a ``bytes`` object frozen into
+//| flash, or in a file.
+//|
+//| Pixels are read a row at a time, also when the TileGrid or display is rotated, so each row
+//| is decoded once per refresh. Reading with `TileGrid` tiles that come from many different
+//| rows of the source at once decodes rows again and is slower, especially from a file.
+//|
+//| RLE4 and RLE8 BMPs are supported. Pixel values are the color indices, so use a
+//| `displayio.Palette` as the TileGrid's ``pixel_shader``. This also allows index 0 to be made
+//| transparent for sprites.
+//|
+//| .. class:: RLEBitmap(source)
+//|
+//|   Create an RLEBitmap from the given BMP data.
+//|
+//|   :param source: A file opened in byte mode or a buffer with the BMP data
+//|
+STATIC mp_obj_t displayio_rlebitmap_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 1, 1, false);
+
+    displayio_rlebitmap_t *self = m_new_obj(displayio_rlebitmap_t);
+    self->base.type = &displayio_rlebitmap_type;
+    if (MP_OBJ_IS_TYPE(pos_args[0], &mp_type_fileio)) {
+        common_hal_displayio_rlebitmap_construct(self, MP_OBJ_TO_PTR(pos_args[0]), mp_const_none, NULL, 0);
+    } else {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(pos_args[0], &bufinfo, MP_BUFFER_READ);
+        common_hal_displayio_rlebitmap_construct(self, NULL, pos_args[0], bufinfo.buf, bufinfo.len);
+    }
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. attribute:: width
+//|
+//|      Width of the bitmap. (read only)
+//|
+STATIC mp_obj_t displayio_rlebitmap_obj_get_width(mp_obj_t self_in) {
+    displayio_rlebitmap_t *self = MP_OBJ_TO_PTR(self_in);
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_rlebitmap_get_width(self));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_rlebitmap_get_width_obj, displayio_rlebitmap_obj_get_width);
+
+const mp_obj_property_t displayio_rlebitmap_width_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_rlebitmap_get_width_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+
+};
+
+//|   .. attribute:: height
+//|
+//|      Height of the bitmap. (read only)
+//|
+STATIC mp_obj_t displayio_rlebitmap_obj_get_height(mp_obj_t self_in) {
+    displayio_rlebitmap_t *self = MP_OBJ_TO_PTR(self_in);
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_rlebitmap_get_height(self));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_rlebitmap_get_height_obj, displayio_rlebitmap_obj_get_height);
+
+const mp_obj_property_t displayio_rlebitmap_height_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_rlebitmap_get_height_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+
+};
+
+STATIC const mp_rom_map_elem_t displayio_rlebitmap_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&displayio_rlebitmap_height_obj) },
+    { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_rlebitmap_width_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(displayio_rlebitmap_locals_dict, displayio_rlebitmap_locals_dict_table);
+
+const mp_obj_type_t displayio_rlebitmap_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_RLEBitmap,
+    .make_new = displayio_rlebitmap_make_new,
+    .locals_dict = (mp_obj_dict_t*)&displayio_rlebitmap_locals_dict,
+};
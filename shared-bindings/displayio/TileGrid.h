@@ -58,6 +58,10 @@ uint16_t common_hal_displayio_tilegrid_get_height(displayio_tilegrid_t *self);
 
 uint8_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y);
 void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index);
+// Sets count tiles in row y starting at x and marks them changed once.
+void common_hal_displayio_tilegrid_set_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, const uint8_t* tile_indices, uint16_t count);
+// Sets every tile from (x1, y1) up to but not including (x2, y2) to tile_index.
+void common_hal_displayio_tilegrid_fill_region(displayio_tilegrid_t *self, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t tile_index);
 
 // Private API for scrolling the TileGrid.
 void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint16_t x, uint16_t y);
@@ -0,0 +1,104 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "shared-bindings/fontio/BinaryFont.h"
+
+#include <stdint.h>
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: fontio
+//|
+//| :class:`BinaryFont` -- A compact bitmap font stored in a buffer
+//| =========================================================================================
+//|
+//| A one bit per pixel font with proportional widths and kerning that is used in place. It can be
+//| rendered with `fontio.render_text`. Fonts are converted from BDF or PCF files with
+//| ``tools/gen_binary_font.py``.
+//|
+//| .. class:: BinaryFont(buffer)
+//|
+//|   Create a BinaryFont that reads its glyphs from the given buffer. The buffer is not copied so
+//|   font data in flash, such as a frozen ``bytes`` object, doesn't use any RAM.
+//|
+//|   :param bytes buffer: The font data
+//|
+STATIC mp_obj_t fontio_binaryfont_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 1, 1, false);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(pos_args[0], &bufinfo, MP_BUFFER_READ);
+
+    fontio_binaryfont_t *self = m_new_obj(fontio_binaryfont_t);
+    self->base.type = &fontio_binaryfont_type;
+    common_hal_fontio_binaryfont_construct(self, pos_args[0], bufinfo.buf, bufinfo.len);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. attribute:: line_height
+//|
+//|     Distance in pixels from the top of one line of text to the next.
+//|
+STATIC mp_obj_t fontio_binaryfont_obj_get_line_height(mp_obj_t self_in) {
+    fontio_binaryfont_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_fontio_binaryfont_get_line_height(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(fontio_binaryfont_get_line_height_obj, fontio_binaryfont_obj_get_line_height);
+
+const mp_obj_property_t fontio_binaryfont_line_height_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&fontio_binaryfont_get_line_height_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. method:: get_bounding_box()
+//|
+//|     Returns the maximum bounds of all glyphs in the font in a tuple of two values: width, height.
+//|
+STATIC mp_obj_t fontio_binaryfont_obj_get_bounding_box(mp_obj_t self_in) {
+    fontio_binaryfont_t *self = MP_OBJ_TO_PTR(self_in);
+
+    return common_hal_fontio_binaryfont_get_bounding_box(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(fontio_binaryfont_get_bounding_box_obj, fontio_binaryfont_obj_get_bounding_box);
+
+STATIC const mp_rom_map_elem_t fontio_binaryfont_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_line_height), MP_ROM_PTR(&fontio_binaryfont_line_height_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_bounding_box), MP_ROM_PTR(&fontio_binaryfont_get_bounding_box_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(fontio_binaryfont_locals_dict, fontio_binaryfont_locals_dict_table);
+
+const mp_obj_type_t fontio_binaryfont_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_BinaryFont,
+    .make_new = fontio_binaryfont_make_new,
+    .locals_dict = (mp_obj_dict_t*)&fontio_binaryfont_locals_dict,
+};
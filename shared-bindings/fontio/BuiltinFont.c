@@ -96,10 +96,28 @@ STATIC mp_obj_t fontio_builtinfont_obj_get_glyph(mp_obj_t self_in, mp_obj_t code
 }
 MP_DEFINE_CONST_FUN_OBJ_2(fontio_builtinfont_get_glyph_obj, fontio_builtinfont_obj_get_glyph);
 
+//|   .. method:: get_glyph_index(codepoint)
+//|
+//|     Returns the index of the codepoint's tile in `bitmap` or None if no glyph is available.
+//|     Unlike `get_glyph` it doesn't allocate so it is suited to setting `displayio.TileGrid` tiles
+//|     for each character of a string.
+//|
+STATIC mp_obj_t fontio_builtinfont_obj_get_glyph_index(mp_obj_t self_in, mp_obj_t codepoint_obj) {
+    fontio_builtinfont_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_int_t codepoint;
+    if (!mp_obj_get_int_maybe(codepoint_obj, &codepoint)) {
+        mp_raise_ValueError_varg(translate("%q should be an int"), MP_QSTR_codepoint);
+    }
+    return common_hal_fontio_builtinfont_get_glyph_index(self, codepoint);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(fontio_builtinfont_get_glyph_index_obj, fontio_builtinfont_obj_get_glyph_index);
+
 STATIC const mp_rom_map_elem_t fontio_builtinfont_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_bitmap), MP_ROM_PTR(&fontio_builtinfont_bitmap_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_bounding_box), MP_ROM_PTR(&fontio_builtinfont_get_bounding_box_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_glyph), MP_ROM_PTR(&fontio_builtinfont_get_glyph_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_glyph_index), MP_ROM_PTR(&fontio_builtinfont_get_glyph_index_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(fontio_builtinfont_locals_dict, fontio_builtinfont_locals_dict_table);
 
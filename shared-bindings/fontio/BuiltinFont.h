@@ -34,5 +34,6 @@ extern const mp_obj_type_t fontio_builtinfont_type;
 mp_obj_t common_hal_fontio_builtinfont_get_bitmap(const fontio_builtinfont_t *self);
 mp_obj_t common_hal_fontio_builtinfont_get_bounding_box(const fontio_builtinfont_t *self);
 mp_obj_t common_hal_fontio_builtinfont_get_glyph(const fontio_builtinfont_t *self, mp_uint_t codepoint);
+mp_obj_t common_hal_fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_uint_t codepoint);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_FONTIO_BUILTINFONT_H
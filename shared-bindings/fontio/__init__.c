@@ -28,8 +28,12 @@
 
 #include "py/obj.h"
 #include "py/runtime.h"
+#include "supervisor/shared/translate.h"
 
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/displayio/TileGrid.h"
 #include "shared-bindings/fontio/__init__.h"
+#include "shared-bindings/fontio/BinaryFont.h"
 #include "shared-bindings/fontio/BuiltinFont.h"
 #include "shared-bindings/fontio/Glyph.h"
 
@@ -47,14 +51,94 @@
 //| .. toctree::
 //|     :maxdepth: 3
 //|
+//|     BinaryFont
 //|     BuiltinFont
 //|     Glyph
 //|
 
+//| .. function:: render_text(text, font, target, *, x=0, y=0, max_width=0, color=1)
+//|
+//|   Draws text into a `displayio.Bitmap` or `displayio.TileGrid` in one call. Glyph lookup,
+//|   kerning and line wrapping are done natively and the target is marked dirty once. Lines wrap at
+//|   spaces, or mid-word when a word is wider than ``max_width``, and ``\n`` starts a new line.
+//|   Characters missing from the font are skipped. Only the glyphs' pixels or tiles are written so
+//|   clear the area first when replacing text.
+//|
+//|   Positions are in pixels for a Bitmap and in tiles for a TileGrid. A TileGrid target must use
+//|   the `BuiltinFont`'s bitmap.
+//|
+//|   :param str text: The text to draw
+//|   :param font: The `BuiltinFont` or `BinaryFont` to draw with
+//|   :param target: The `displayio.Bitmap` or `displayio.TileGrid` to draw into
+//|   :param int x: Left edge of the text
+//|   :param int y: Top edge of the first line
+//|   :param int max_width: Width to wrap lines at or 0 to only break at newlines
+//|   :param int color: Bitmap value for set glyph pixels. Unused for a TileGrid.
+//|   :return: the width and height of the text as a tuple
+//|
+STATIC mp_obj_t fontio_render_text(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_text, ARG_font, ARG_target, ARG_x, ARG_y, ARG_max_width, ARG_color };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_text, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_font, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_target, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_x, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+        { MP_QSTR_y, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+        { MP_QSTR_max_width, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+        { MP_QSTR_color, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    size_t len;
+    const char* text = mp_obj_str_get_data(args[ARG_text].u_obj, &len);
+
+    mp_obj_t font = args[ARG_font].u_obj;
+    bool builtin_font = MP_OBJ_IS_TYPE(font, &fontio_builtinfont_type);
+    if (!builtin_font && !MP_OBJ_IS_TYPE(font, &fontio_binaryfont_type)) {
+        mp_raise_TypeError(translate("font must be a BuiltinFont or BinaryFont"));
+    }
+
+    mp_obj_t target = args[ARG_target].u_obj;
+    if (MP_OBJ_IS_TYPE(target, &displayio_tilegrid_type)) {
+        displayio_tilegrid_t* tilegrid = MP_OBJ_TO_PTR(target);
+        fontio_builtinfont_t* font_obj = MP_OBJ_TO_PTR(font);
+        if (!builtin_font || tilegrid->bitmap != MP_OBJ_FROM_PTR(font_obj->bitmap)) {
+            mp_raise_ValueError(translate("TileGrid must use the font's bitmap"));
+        }
+    } else if (MP_OBJ_IS_TYPE(target, &displayio_bitmap_type)) {
+        displayio_bitmap_t* bitmap = MP_OBJ_TO_PTR(target);
+        if (bitmap->read_only) {
+            mp_raise_RuntimeError(translate("Read-only object"));
+        }
+        if ((args[ARG_color].u_int & ~bitmap->bitmask) != 0) {
+            mp_raise_ValueError(translate("pixel value requires too many bits"));
+        }
+    } else {
+        mp_raise_TypeError(translate("target must be a Bitmap or TileGrid"));
+    }
+
+    mp_int_t max_width = args[ARG_max_width].u_int;
+    if (max_width < 0) {
+        mp_raise_ValueError(translate("max_width must be >= 0"));
+    }
+
+    uint16_t width;
+    uint16_t height;
+    common_hal_fontio_render_text((const uint8_t*) text, len, font, target,
+        args[ARG_x].u_int, args[ARG_y].u_int, max_width, args[ARG_color].u_int, &width, &height);
+
+    mp_obj_t items[2] = { MP_OBJ_NEW_SMALL_INT(width), MP_OBJ_NEW_SMALL_INT(height) };
+    return mp_obj_new_tuple(2, items);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(fontio_render_text_obj, 3, fontio_render_text);
+
 STATIC const mp_rom_map_elem_t fontio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_fontio) },
+    { MP_ROM_QSTR(MP_QSTR_BinaryFont), MP_ROM_PTR(&fontio_binaryfont_type) },
     { MP_ROM_QSTR(MP_QSTR_BuiltinFont), MP_ROM_PTR(&fontio_builtinfont_type) },
     { MP_ROM_QSTR(MP_QSTR_Glyph), MP_ROM_PTR(&fontio_glyph_type) },
+    { MP_ROM_QSTR(MP_QSTR_render_text), MP_ROM_PTR(&fontio_render_text_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(fontio_module_globals, fontio_module_globals_table);
@@ -27,5 +27,14 @@
 #ifndef MICROPY_INCLUDED_SHARED_BINDINGS_FONTIO___INIT___H
 #define MICROPY_INCLUDED_SHARED_BINDINGS_FONTIO___INIT___H
 
+#include <stdint.h>
+
+#include "py/obj.h"
+
+// font must be a BuiltinFont or BinaryFont and target a Bitmap or TileGrid. TileGrid targets need
+// a BuiltinFont that shares the TileGrid's bitmap. width and height are set to the size of the
+// rendered text in the target's units.
+void common_hal_fontio_render_text(const uint8_t* text, size_t len, mp_obj_t font, mp_obj_t target,
+    int16_t x, int16_t y, uint16_t max_width, uint32_t color, uint16_t* width, uint16_t* height);
 
 #endif  // MICROPY_INCLUDED_SHARED_BINDINGS_FONTIO___INIT___H
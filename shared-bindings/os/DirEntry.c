@@ -0,0 +1,125 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "py/obj.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/os/DirEntry.h"
+
+//| .. currentmodule:: os
+//|
+//| :class:`DirEntry` -- Entry in a directory listing
+//| =================================================
+//|
+//| Returned by `os.scandir`. The type, size and modification time are read along with the
+//| name, so checking them doesn't search the directory again. A `DirEntry` doesn't update
+//| when the file changes after it was listed.
+//|
+//| .. class:: DirEntry()
+//|
+//|   Cannot be instantiated directly. Use `os.scandir`.
+//|
+
+//|   .. attribute:: name
+//|
+//|     The entry's file name, relative to the directory that was scanned. (read-only)
+//|
+STATIC mp_obj_t os_direntry_obj_get_name(mp_obj_t self_in) {
+    os_direntry_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_os_direntry_get_name(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(os_direntry_get_name_obj, os_direntry_obj_get_name);
+
+const mp_obj_property_t os_direntry_name_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&os_direntry_get_name_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: path
+//|
+//|     The path given to `os.scandir` joined with `name`. (read-only)
+//|
+STATIC mp_obj_t os_direntry_obj_get_path(mp_obj_t self_in) {
+    os_direntry_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_os_direntry_get_path(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(os_direntry_get_path_obj, os_direntry_obj_get_path);
+
+const mp_obj_property_t os_direntry_path_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&os_direntry_get_path_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. method:: is_dir()
+//|
+//|     Returns True if the entry is a directory.
+//|
+STATIC mp_obj_t os_direntry_is_dir(mp_obj_t self_in) {
+    os_direntry_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_os_direntry_is_dir(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(os_direntry_is_dir_obj, os_direntry_is_dir);
+
+//|   .. method:: is_file()
+//|
+//|     Returns True if the entry is a regular file.
+//|
+STATIC mp_obj_t os_direntry_is_file(mp_obj_t self_in) {
+    os_direntry_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_os_direntry_is_file(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(os_direntry_is_file_obj, os_direntry_is_file);
+
+//|   .. method:: stat()
+//|
+//|     Returns the same tuple as `os.stat` for the entry. On FAT filesystems it is built
+//|     from the directory listing; elsewhere it falls back to `os.stat`.
+//|
+STATIC mp_obj_t os_direntry_stat(mp_obj_t self_in) {
+    os_direntry_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_os_direntry_stat(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(os_direntry_stat_obj, os_direntry_stat);
+
+STATIC const mp_rom_map_elem_t os_direntry_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_name), MP_ROM_PTR(&os_direntry_name_obj) },
+    { MP_ROM_QSTR(MP_QSTR_path), MP_ROM_PTR(&os_direntry_path_obj) },
+    { MP_ROM_QSTR(MP_QSTR_is_dir), MP_ROM_PTR(&os_direntry_is_dir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_is_file), MP_ROM_PTR(&os_direntry_is_file_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stat), MP_ROM_PTR(&os_direntry_stat_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(os_direntry_locals_dict, os_direntry_locals_dict_table);
+
+const mp_obj_type_t os_direntry_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_DirEntry,
+    .locals_dict = (mp_obj_dict_t*)&os_direntry_locals_dict,
+};
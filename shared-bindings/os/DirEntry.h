@@ -0,0 +1,46 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_OS_DIRENTRY_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_OS_DIRENTRY_H
+
+#include <stdbool.h>
+
+#include "shared-module/os/DirEntry.h"
+
+extern const mp_obj_type_t os_direntry_type;
+
+// entry is a tuple from ilistdir: name, type, inode and optionally size and mtime. path is
+// the entry's full path.
+void common_hal_os_direntry_construct(os_direntry_obj_t* self, mp_obj_t path, mp_obj_t entry);
+mp_obj_t common_hal_os_direntry_get_name(os_direntry_obj_t* self);
+mp_obj_t common_hal_os_direntry_get_path(os_direntry_obj_t* self);
+bool common_hal_os_direntry_is_dir(os_direntry_obj_t* self);
+bool common_hal_os_direntry_is_file(os_direntry_obj_t* self);
+mp_obj_t common_hal_os_direntry_stat(os_direntry_obj_t* self);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_OS_DIRENTRY_H
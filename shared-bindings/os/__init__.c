@@ -35,6 +35,7 @@
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "shared-bindings/os/__init__.h"
+#include "shared-bindings/os/DirEntry.h"
 
 //| :mod:`os` --- functions that an OS normally provides
 //| ========================================================
@@ -47,6 +48,13 @@
 //| code written in CircuitPython will work in CPython but not necessarily the
 //| other way around.
 //|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     DirEntry
+//|
 
 //| .. function:: uname()
 //|
@@ -62,7 +70,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_0(os_uname_obj, os_uname);
 //|
 //|   Change current directory.
 //|
-mp_obj_t os_chdir(mp_obj_t path_in) {
+STATIC mp_obj_t os_chdir(mp_obj_t path_in) {
     const char *path = mp_obj_str_get_str(path_in);
     common_hal_os_chdir(path);
     return mp_const_none;
@@ -73,7 +81,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(os_chdir_obj, os_chdir);
 //|
 //|   Get the current directory.
 //|
-mp_obj_t os_getcwd(void) {
+STATIC mp_obj_t os_getcwd(void) {
     return common_hal_os_getcwd();
 }
 MP_DEFINE_CONST_FUN_OBJ_0(os_getcwd_obj, os_getcwd);
@@ -82,7 +90,7 @@ MP_DEFINE_CONST_FUN_OBJ_0(os_getcwd_obj, os_getcwd);
 //|
 //|   With no argument, list the current directory.  Otherwise list the given directory.
 //|
-mp_obj_t os_listdir(size_t n_args, const mp_obj_t *args) {
+STATIC mp_obj_t os_listdir(size_t n_args, const mp_obj_t *args) {
     const char* path;
     if (n_args == 1) {
         path = mp_obj_str_get_str(args[0]);
@@ -93,11 +101,42 @@ mp_obj_t os_listdir(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(os_listdir_obj, 0, 1, os_listdir);
 
+//| .. function:: scandir(path='.')
+//|
+//|   Returns an iterator of `DirEntry` objects for the entries in the given directory. Unlike
+//|   calling `stat` on each name from `listdir`, checking an entry's type, size or
+//|   modification time doesn't search the directory again.
+//|
+STATIC mp_obj_t os_scandir(size_t n_args, const mp_obj_t *args) {
+    mp_obj_t path;
+    if (n_args == 1) {
+        path = args[0];
+        mp_obj_str_get_str(path);
+    } else {
+        path = MP_OBJ_NEW_QSTR(MP_QSTR__dot_);
+    }
+    return common_hal_os_scandir(path);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(os_scandir_obj, 0, 1, os_scandir);
+
+//| .. function:: walk(top)
+//|
+//|   Walk the directory tree rooted at *top*, top-down. Yields a ``(dirpath, dirnames,
+//|   filenames)`` tuple for each directory. Each directory is listed once. Removing names from
+//|   ``dirnames`` before asking for the next tuple skips those subdirectories. Directories that
+//|   can't be listed are skipped.
+//|
+STATIC mp_obj_t os_walk(mp_obj_t top) {
+    mp_obj_str_get_str(top);
+    return common_hal_os_walk(top);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(os_walk_obj, os_walk);
+
 //| .. function:: mkdir(path)
 //|
 //|   Create a new directory.
 //|
-mp_obj_t os_mkdir(mp_obj_t path_in) {
+STATIC mp_obj_t os_mkdir(mp_obj_t path_in) {
     const char *path = mp_obj_str_get_str(path_in);
     common_hal_os_mkdir(path);
     return mp_const_none;
@@ -108,7 +147,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(os_mkdir_obj, os_mkdir);
 //|
 //|   Remove a file.
 //|
-mp_obj_t os_remove(mp_obj_t path_in) {
+STATIC mp_obj_t os_remove(mp_obj_t path_in) {
     const char *path = mp_obj_str_get_str(path_in);
     common_hal_os_remove(path);
     return mp_const_none;
@@ -119,7 +158,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(os_remove_obj, os_remove);
 //|
 //|   Remove a directory.
 //|
-mp_obj_t os_rename(mp_obj_t old_path_in, mp_obj_t new_path_in) {
+STATIC mp_obj_t os_rename(mp_obj_t old_path_in, mp_obj_t new_path_in) {
     const char *old_path = mp_obj_str_get_str(old_path_in);
     const char *new_path = mp_obj_str_get_str(new_path_in);
     common_hal_os_rename(old_path, new_path);
@@ -131,7 +170,7 @@ MP_DEFINE_CONST_FUN_OBJ_2(os_rename_obj, os_rename);
 //|
 //|   Rename a file.
 //|
-mp_obj_t os_rmdir(mp_obj_t path_in) {
+STATIC mp_obj_t os_rmdir(mp_obj_t path_in) {
     const char *path = mp_obj_str_get_str(path_in);
     common_hal_os_rmdir(path);
     return mp_const_none;
@@ -142,7 +181,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(os_rmdir_obj, os_rmdir);
 //|
 //|   Get the status of a file or directory.
 //|
-mp_obj_t os_stat(mp_obj_t path_in) {
+STATIC mp_obj_t os_stat(mp_obj_t path_in) {
     const char *path = mp_obj_str_get_str(path_in);
     return common_hal_os_stat(path);
 }
@@ -169,7 +208,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(os_stat_obj, os_stat);
 //|   and the ``f_flags`` parameter may return ``0`` as they can be unavailable
 //|   in a port-specific implementation.
 //|
-mp_obj_t os_statvfs(mp_obj_t path_in) {
+STATIC mp_obj_t os_statvfs(mp_obj_t path_in) {
     const char *path = mp_obj_str_get_str(path_in);
     return common_hal_os_statvfs(path);
 }
@@ -215,9 +254,13 @@ STATIC const mp_rom_map_elem_t os_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_remove), MP_ROM_PTR(&os_remove_obj) },
     { MP_ROM_QSTR(MP_QSTR_rename), MP_ROM_PTR(&os_rename_obj) },
     { MP_ROM_QSTR(MP_QSTR_rmdir), MP_ROM_PTR(&os_rmdir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_scandir), MP_ROM_PTR(&os_scandir_obj) },
     { MP_ROM_QSTR(MP_QSTR_stat), MP_ROM_PTR(&os_stat_obj) },
     { MP_ROM_QSTR(MP_QSTR_statvfs), MP_ROM_PTR(&os_statvfs_obj) },
     { MP_ROM_QSTR(MP_QSTR_unlink), MP_ROM_PTR(&os_remove_obj) }, // unlink aliases to remove
+    { MP_ROM_QSTR(MP_QSTR_walk), MP_ROM_PTR(&os_walk_obj) },
+
+    { MP_ROM_QSTR(MP_QSTR_DirEntry), MP_ROM_PTR(&os_direntry_type) },
 
     { MP_ROM_QSTR(MP_QSTR_sync), MP_ROM_PTR(&os_sync_obj) },
 
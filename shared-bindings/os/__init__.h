@@ -32,12 +32,14 @@
 
 #include "py/objtuple.h"
 
-const mp_rom_obj_tuple_t common_hal_os_uname_info_obj;
+extern const mp_rom_obj_tuple_t common_hal_os_uname_info_obj;
 
 mp_obj_t common_hal_os_uname(void);
 void common_hal_os_chdir(const char* path);
 mp_obj_t common_hal_os_getcwd(void);
 mp_obj_t common_hal_os_listdir(const char* path);
+mp_obj_t common_hal_os_scandir(mp_obj_t path);
+mp_obj_t common_hal_os_walk(mp_obj_t top);
 void common_hal_os_mkdir(const char* path);
 void common_hal_os_remove(const char* path);
 void common_hal_os_rename(const char* old_path, const char* new_path);
@@ -0,0 +1,309 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "py/binary.h"
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "shared-bindings/random/Random.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: random
+//|
+//| :class:`Random` -- Independent random number generator
+//| ======================================================
+//|
+//| A generator with its own state. Its methods match the functions of the `random` module,
+//| which share a single global generator.
+//|
+//| .. class:: Random(seed=None)
+//|
+//|   Create a new generator. It is deterministic when a seed is given, and seeds itself like
+//|   the `random` module on first use otherwise.
+//|
+//|   :param int seed: The starting seed
+//|
+STATIC mp_obj_t random_random_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_seed };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_seed, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    random_random_obj_t *self = m_new_obj(random_random_obj_t);
+    self->base.type = &random_random_type;
+    common_hal_random_random_construct(self);
+    if (args[ARG_seed].u_obj != mp_const_none) {
+        random_random_seed(self, args[ARG_seed].u_obj);
+    }
+    return MP_OBJ_FROM_PTR(self);
+}
+
+mp_obj_t random_random_seed(random_random_obj_t* self, mp_obj_t seed_in) {
+    mp_uint_t seed = mp_obj_get_int_truncated(seed_in);
+    common_hal_random_random_seed(self, seed);
+    return mp_const_none;
+}
+
+mp_obj_t random_random_getrandbits(random_random_obj_t* self, mp_obj_t num_in) {
+    int n = mp_obj_get_int(num_in);
+    if (n > 32 || n == 0) {
+        mp_raise_ValueError(NULL);
+    }
+    return mp_obj_new_int_from_uint(common_hal_random_random_getrandbits(self, (uint8_t) n));
+}
+
+mp_obj_t random_random_randrange(random_random_obj_t* self, size_t n_args, const mp_obj_t *args) {
+    mp_int_t start = 0;
+    mp_int_t stop = mp_obj_get_int(args[0]);
+    mp_int_t step = 1;
+    if (n_args == 1) {
+        // range(stop)
+        if (stop <= 0) {
+            mp_raise_ValueError(translate("stop not reachable from start"));
+        }
+    } else {
+        start = stop;
+        stop = mp_obj_get_int(args[1]);
+        if (n_args == 2) {
+            // range(start, stop)
+            if (start >= stop) {
+                mp_raise_ValueError(translate("stop not reachable from start"));
+            }
+        } else {
+            // range(start, stop, step)
+            step = mp_obj_get_int(args[2]);
+            mp_int_t n;
+            if (step > 0) {
+                n = (stop - start + step - 1) / step;
+            } else if (step < 0) {
+                n = (stop - start + step + 1) / step;
+            } else {
+                mp_raise_ValueError(translate("step must be non-zero"));
+            }
+            if (n <= 0) {
+                mp_raise_ValueError(translate("invalid step"));
+            }
+        }
+    }
+
+    return mp_obj_new_int(common_hal_random_random_randrange(self, start, stop, step));
+}
+
+mp_obj_t random_random_randint(random_random_obj_t* self, mp_obj_t a_in, mp_obj_t b_in) {
+    mp_int_t a = mp_obj_get_int(a_in);
+    mp_int_t b = mp_obj_get_int(b_in);
+    if (a > b) {
+        mp_raise_ValueError(NULL);
+    }
+    return mp_obj_new_int(common_hal_random_random_randrange(self, a, b + 1, 1));
+}
+
+mp_obj_t random_random_choice(random_random_obj_t* self, mp_obj_t seq) {
+    mp_int_t len = mp_obj_get_int(mp_obj_len(seq));
+    if (len == 0) {
+        mp_raise_IndexError(translate("empty sequence"));
+    }
+    return mp_obj_subscr(seq, mp_obj_new_int(common_hal_random_random_randrange(self, 0, len, 1)), MP_OBJ_SENTINEL);
+}
+
+mp_obj_t random_random_random(random_random_obj_t* self) {
+    return mp_obj_new_float(common_hal_random_random_random(self));
+}
+
+mp_obj_t random_random_uniform(random_random_obj_t* self, mp_obj_t a_in, mp_obj_t b_in) {
+    mp_float_t a = mp_obj_get_float(a_in);
+    mp_float_t b = mp_obj_get_float(b_in);
+    return mp_obj_new_float(common_hal_random_random_uniform(self, a, b));
+}
+
+mp_obj_t random_random_fill_bytes(random_random_obj_t* self, mp_obj_t buffer) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
+    common_hal_random_random_fill_bytes(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+
+mp_obj_t random_random_fill_randrange(random_random_obj_t* self, mp_obj_t buffer, mp_obj_t start_in, mp_obj_t stop_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
+    char typecode = bufinfo.typecode;
+    if (typecode != BYTEARRAY_TYPECODE && strchr("bBhHiIlLqQ", typecode) == NULL) {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    mp_int_t start = mp_obj_get_int(start_in);
+    mp_int_t stop = mp_obj_get_int(stop_in);
+    if (start >= stop) {
+        mp_raise_ValueError(translate("stop not reachable from start"));
+    }
+    // Values are drawn 32 bits at a time.
+    if ((mp_uint_t) stop - (mp_uint_t) start > 0xffffffff) {
+        mp_raise_ValueError(translate("Range out of bounds"));
+    }
+    size_t size = mp_binary_get_size('@', typecode, NULL);
+    if (size < sizeof(mp_int_t)) {
+        bool is_signed = typecode >= 'a';
+        mp_int_t min = is_signed ? -((mp_int_t) 1 << (size * 8 - 1)) : 0;
+        mp_int_t max = is_signed ? ((mp_int_t) 1 << (size * 8 - 1)) - 1 : ((mp_int_t) 1 << (size * 8)) - 1;
+        if (start < min || stop - 1 > max) {
+            mp_raise_ValueError_varg(translate("value must fit in %d byte(s)"), size);
+        }
+    }
+    common_hal_random_random_fill_randrange(self, typecode, bufinfo.buf, bufinfo.len / size, start, stop);
+    return mp_const_none;
+}
+
+mp_obj_t random_random_fill_uniform(random_random_obj_t* self, mp_obj_t buffer, mp_obj_t a_in, mp_obj_t b_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.typecode != 'f' && bufinfo.typecode != 'd') {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    mp_float_t a = mp_obj_get_float(a_in);
+    mp_float_t b = mp_obj_get_float(b_in);
+    size_t size = bufinfo.typecode == 'f' ? sizeof(float) : sizeof(double);
+    common_hal_random_random_fill_uniform(self, bufinfo.typecode, bufinfo.buf, bufinfo.len / size, a, b);
+    return mp_const_none;
+}
+
+//|   .. method:: seed(seed)
+//|
+//|     Sets the starting seed of this generator.
+//|
+STATIC mp_obj_t random_random_obj_seed(mp_obj_t self_in, mp_obj_t seed_in) {
+    return random_random_seed(MP_OBJ_TO_PTR(self_in), seed_in);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(random_random_seed_obj, random_random_obj_seed);
+
+//|   .. method:: getrandbits(k)
+//|
+//|     Returns an integer with *k* random bits.
+//|
+STATIC mp_obj_t random_random_obj_getrandbits(mp_obj_t self_in, mp_obj_t num_in) {
+    return random_random_getrandbits(MP_OBJ_TO_PTR(self_in), num_in);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(random_random_getrandbits_obj, random_random_obj_getrandbits);
+
+//|   .. method:: randrange(stop)
+//|               randrange(start, stop, step=1)
+//|
+//|     Returns a randomly selected integer from ``range(start, stop, step)``.
+//|
+STATIC mp_obj_t random_random_obj_randrange(size_t n_args, const mp_obj_t *args) {
+    return random_random_randrange(MP_OBJ_TO_PTR(args[0]), n_args - 1, args + 1);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(random_random_randrange_obj, 2, 4, random_random_obj_randrange);
+
+//|   .. method:: randint(a, b)
+//|
+//|     Returns a randomly selected integer between a and b inclusive.
+//|
+STATIC mp_obj_t random_random_obj_randint(mp_obj_t self_in, mp_obj_t a_in, mp_obj_t b_in) {
+    return random_random_randint(MP_OBJ_TO_PTR(self_in), a_in, b_in);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(random_random_randint_obj, random_random_obj_randint);
+
+//|   .. method:: choice(seq)
+//|
+//|     Returns a randomly selected element from the given sequence.
+//|
+STATIC mp_obj_t random_random_obj_choice(mp_obj_t self_in, mp_obj_t seq) {
+    return random_random_choice(MP_OBJ_TO_PTR(self_in), seq);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(random_random_choice_obj, random_random_obj_choice);
+
+//|   .. method:: random()
+//|
+//|     Returns a random float between 0 and 1.0.
+//|
+STATIC mp_obj_t random_random_obj_random(mp_obj_t self_in) {
+    return random_random_random(MP_OBJ_TO_PTR(self_in));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_random_random_obj, random_random_obj_random);
+
+//|   .. method:: uniform(a, b)
+//|
+//|     Returns a random float between a and b.
+//|
+STATIC mp_obj_t random_random_obj_uniform(mp_obj_t self_in, mp_obj_t a_in, mp_obj_t b_in) {
+    return random_random_uniform(MP_OBJ_TO_PTR(self_in), a_in, b_in);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(random_random_uniform_obj, random_random_obj_uniform);
+
+//|   .. method:: fill_bytes(buffer)
+//|
+//|     Fills every byte of the buffer with random bits.
+//|
+STATIC mp_obj_t random_random_obj_fill_bytes(mp_obj_t self_in, mp_obj_t buffer) {
+    return random_random_fill_bytes(MP_OBJ_TO_PTR(self_in), buffer);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(random_random_fill_bytes_obj, random_random_obj_fill_bytes);
+
+//|   .. method:: fill_randrange(buffer, start, stop)
+//|
+//|     Fills every element of an integer array or bytearray with a randomly selected integer
+//|     from ``range(start, stop)``.
+//|
+STATIC mp_obj_t random_random_obj_fill_randrange(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return random_random_fill_randrange(MP_OBJ_TO_PTR(args[0]), args[1], args[2], args[3]);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(random_random_fill_randrange_obj, 4, 4, random_random_obj_fill_randrange);
+
+//|   .. method:: fill_uniform(buffer, a, b)
+//|
+//|     Fills every element of a float array (typecode ``'f'`` or ``'d'``) with a random float
+//|     between a and b.
+//|
+STATIC mp_obj_t random_random_obj_fill_uniform(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return random_random_fill_uniform(MP_OBJ_TO_PTR(args[0]), args[1], args[2], args[3]);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(random_random_fill_uniform_obj, 4, 4, random_random_obj_fill_uniform);
+
+STATIC const mp_rom_map_elem_t random_random_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_seed), MP_ROM_PTR(&random_random_seed_obj) },
+    { MP_ROM_QSTR(MP_QSTR_getrandbits), MP_ROM_PTR(&random_random_getrandbits_obj) },
+    { MP_ROM_QSTR(MP_QSTR_randrange), MP_ROM_PTR(&random_random_randrange_obj) },
+    { MP_ROM_QSTR(MP_QSTR_randint), MP_ROM_PTR(&random_random_randint_obj) },
+    { MP_ROM_QSTR(MP_QSTR_choice), MP_ROM_PTR(&random_random_choice_obj) },
+    { MP_ROM_QSTR(MP_QSTR_random), MP_ROM_PTR(&random_random_random_obj) },
+    { MP_ROM_QSTR(MP_QSTR_uniform), MP_ROM_PTR(&random_random_uniform_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_bytes), MP_ROM_PTR(&random_random_fill_bytes_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_randrange), MP_ROM_PTR(&random_random_fill_randrange_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_uniform), MP_ROM_PTR(&random_random_fill_uniform_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(random_random_locals_dict, random_random_locals_dict_table);
+
+const mp_obj_type_t random_random_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Random,
+    .make_new = random_random_make_new,
+    .locals_dict = (mp_obj_dict_t*)&random_random_locals_dict,
+};
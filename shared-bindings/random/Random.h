@@ -0,0 +1,59 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_RANDOM_RANDOM_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_RANDOM_RANDOM_H
+
+#include "shared-module/random/Random.h"
+
+extern const mp_obj_type_t random_random_type;
+
+void common_hal_random_random_construct(random_random_obj_t* self);
+void common_hal_random_random_seed(random_random_obj_t* self, mp_uint_t seed);
+uint32_t common_hal_random_random_getrandbits(random_random_obj_t* self, uint8_t n);
+mp_int_t common_hal_random_random_randrange(random_random_obj_t* self, mp_int_t start, mp_int_t stop, mp_int_t step);
+mp_float_t common_hal_random_random_random(random_random_obj_t* self);
+mp_float_t common_hal_random_random_uniform(random_random_obj_t* self, mp_float_t a, mp_float_t b);
+void common_hal_random_random_fill_bytes(random_random_obj_t* self, uint8_t* buffer, size_t len);
+// typecode is one of the integer typecodes from the array module. The range must fit in it.
+void common_hal_random_random_fill_randrange(random_random_obj_t* self, char typecode, void* buffer, size_t count, mp_int_t start, mp_int_t stop);
+// typecode is 'f' or 'd'.
+void common_hal_random_random_fill_uniform(random_random_obj_t* self, char typecode, void* buffer, size_t count, mp_float_t a, mp_float_t b);
+
+// Argument checking shared by the Random methods and the module functions that use the global
+// generator.
+mp_obj_t random_random_seed(random_random_obj_t* self, mp_obj_t seed_in);
+mp_obj_t random_random_getrandbits(random_random_obj_t* self, mp_obj_t num_in);
+mp_obj_t random_random_randrange(random_random_obj_t* self, size_t n_args, const mp_obj_t *args);
+mp_obj_t random_random_randint(random_random_obj_t* self, mp_obj_t a_in, mp_obj_t b_in);
+mp_obj_t random_random_choice(random_random_obj_t* self, mp_obj_t seq);
+mp_obj_t random_random_random(random_random_obj_t* self);
+mp_obj_t random_random_uniform(random_random_obj_t* self, mp_obj_t a_in, mp_obj_t b_in);
+mp_obj_t random_random_fill_bytes(random_random_obj_t* self, mp_obj_t buffer);
+mp_obj_t random_random_fill_randrange(random_random_obj_t* self, mp_obj_t buffer, mp_obj_t start_in, mp_obj_t stop_in);
+mp_obj_t random_random_fill_uniform(random_random_obj_t* self, mp_obj_t buffer, mp_obj_t a_in, mp_obj_t b_in);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_RANDOM_RANDOM_H
@@ -25,13 +25,10 @@
  * THE SOFTWARE.
  */
 
-#include <assert.h>
-#include <string.h>
-
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "shared-bindings/random/__init__.h"
-#include "supervisor/shared/translate.h"
+#include "shared-bindings/random/Random.h"
 
 //| :mod:`random` --- psuedo-random numbers and choices
 //| ========================================================
@@ -51,6 +48,13 @@
 //| .. warning:: Numbers from this module are not cryptographically strong! Use
 //|   bytes from `os.urandom` directly for true randomness.
 //|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     Random
+//|
 
 //| .. function:: seed(seed)
 //|
@@ -58,9 +62,7 @@
 //|   `random` will return deterministic results afterwards.
 //|
 STATIC mp_obj_t random_seed(mp_obj_t seed_in) {
-    mp_uint_t seed = mp_obj_get_int_truncated(seed_in);
-    shared_modules_random_seed(seed);
-    return mp_const_none;
+    return random_random_seed(&shared_modules_random_state, seed_in);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_seed_obj, random_seed);
 
@@ -69,11 +71,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_seed_obj, random_seed);
 //|   Returns an integer with *k* random bits.
 //|
 STATIC mp_obj_t random_getrandbits(mp_obj_t num_in) {
-    int n = mp_obj_get_int(num_in);
-    if (n > 32 || n == 0) {
-        mp_raise_ValueError(NULL);
-    }
-    return mp_obj_new_int_from_uint(shared_modules_random_getrandbits((uint8_t) n));
+    return random_random_getrandbits(&shared_modules_random_state, num_in);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_getrandbits_obj, random_getrandbits);
 
@@ -83,40 +81,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_getrandbits_obj, random_getrandbits);
 //|   Returns a randomly selected integer from ``range(start, stop, step)``.
 //|
 STATIC mp_obj_t random_randrange(size_t n_args, const mp_obj_t *args) {
-    mp_int_t start = 0;
-    mp_int_t stop = mp_obj_get_int(args[0]);
-    mp_int_t step = 1;
-    if (n_args == 1) {
-        // range(stop)
-        if (stop <= 0) {
-            mp_raise_ValueError(translate("stop not reachable from start"));
-        }
-    } else {
-        start = stop;
-        stop = mp_obj_get_int(args[1]);
-        if (n_args == 2) {
-            // range(start, stop)
-            if (start >= stop) {
-                mp_raise_ValueError(translate("stop not reachable from start"));
-            }
-        } else {
-            // range(start, stop, step)
-            step = mp_obj_get_int(args[2]);
-            mp_int_t n;
-            if (step > 0) {
-                n = (stop - start + step - 1) / step;
-            } else if (step < 0) {
-                n = (stop - start + step + 1) / step;
-            } else {
-                mp_raise_ValueError(translate("step must be non-zero"));
-            }
-            if (n <= 0) {
-                mp_raise_ValueError(translate("invalid step"));
-            }
-        }
-    }
-
-    return mp_obj_new_int(shared_modules_random_randrange(start, stop, step));
+    return random_random_randrange(&shared_modules_random_state, n_args, args);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(random_randrange_obj, 1, 3, random_randrange);
 
@@ -126,12 +91,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(random_randrange_obj, 1, 3, random_ra
 //|   to ``randrange(a, b + 1, 1)``
 //|
 STATIC mp_obj_t random_randint(mp_obj_t a_in, mp_obj_t b_in) {
-    mp_int_t a = mp_obj_get_int(a_in);
-    mp_int_t b = mp_obj_get_int(b_in);
-    if (a > b) {
-        mp_raise_ValueError(NULL);
-    }
-    return mp_obj_new_int(shared_modules_random_randrange(a, b + 1, 1));
+    return random_random_randint(&shared_modules_random_state, a_in, b_in);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(random_randint_obj, random_randint);
 
@@ -141,11 +101,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_2(random_randint_obj, random_randint);
 //|   IndexError when the sequence is empty.
 //|
 STATIC mp_obj_t random_choice(mp_obj_t seq) {
-    mp_int_t len = mp_obj_get_int(mp_obj_len(seq));
-    if (len == 0) {
-        mp_raise_IndexError(translate("empty sequence"));
-    }
-    return mp_obj_subscr(seq, mp_obj_new_int(shared_modules_random_randrange(0, len, 1)), MP_OBJ_SENTINEL);
+    return random_random_choice(&shared_modules_random_state, seq);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_choice_obj, random_choice);
 
@@ -154,7 +110,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_choice_obj, random_choice);
 //|   Returns a random float between 0 and 1.0.
 //|
 STATIC mp_obj_t random_random(void) {
-    return mp_obj_new_float(shared_modules_random_random());
+    return random_random_random(&shared_modules_random_state);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(random_random_obj, random_random);
 
@@ -164,12 +120,41 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_0(random_random_obj, random_random);
 //|   depending on float rounding.
 //|
 STATIC mp_obj_t random_uniform(mp_obj_t a_in, mp_obj_t b_in) {
-    mp_float_t a = mp_obj_get_float(a_in);
-    mp_float_t b = mp_obj_get_float(b_in);
-    return mp_obj_new_float(shared_modules_random_uniform(a, b));
+    return random_random_uniform(&shared_modules_random_state, a_in, b_in);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(random_uniform_obj, random_uniform);
 
+//| .. function:: fill_bytes(buffer)
+//|
+//|   Fills every byte of the buffer with random bits. This is much faster than
+//|   calling `getrandbits` once per byte.
+//|
+STATIC mp_obj_t random_fill_bytes(mp_obj_t buffer) {
+    return random_random_fill_bytes(&shared_modules_random_state, buffer);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_fill_bytes_obj, random_fill_bytes);
+
+//| .. function:: fill_randrange(buffer, start, stop)
+//|
+//|   Fills every element of an integer ``array.array`` or a ``bytearray`` with a
+//|   randomly selected integer from ``range(start, stop)``. The range must fit in
+//|   the element type.
+//|
+STATIC mp_obj_t random_fill_randrange(mp_obj_t buffer, mp_obj_t start_in, mp_obj_t stop_in) {
+    return random_random_fill_randrange(&shared_modules_random_state, buffer, start_in, stop_in);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(random_fill_randrange_obj, random_fill_randrange);
+
+//| .. function:: fill_uniform(buffer, a, b)
+//|
+//|   Fills every element of a float ``array.array`` (typecode ``'f'`` or ``'d'``)
+//|   with a random float between a and b.
+//|
+STATIC mp_obj_t random_fill_uniform(mp_obj_t buffer, mp_obj_t a_in, mp_obj_t b_in) {
+    return random_random_fill_uniform(&shared_modules_random_state, buffer, a_in, b_in);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(random_fill_uniform_obj, random_fill_uniform);
+
 STATIC const mp_rom_map_elem_t mp_module_random_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_random) },
     { MP_ROM_QSTR(MP_QSTR_seed), MP_ROM_PTR(&random_seed_obj) },
@@ -179,6 +164,10 @@ STATIC const mp_rom_map_elem_t mp_module_random_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_choice), MP_ROM_PTR(&random_choice_obj) },
     { MP_ROM_QSTR(MP_QSTR_random), MP_ROM_PTR(&random_random_obj) },
     { MP_ROM_QSTR(MP_QSTR_uniform), MP_ROM_PTR(&random_uniform_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_bytes), MP_ROM_PTR(&random_fill_bytes_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_randrange), MP_ROM_PTR(&random_fill_randrange_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_uniform), MP_ROM_PTR(&random_fill_uniform_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Random), MP_ROM_PTR(&random_random_type) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_random_globals, mp_module_random_globals_table);
@@ -31,6 +31,10 @@
 // agnostic. The random module only depends on the common_hal_os_urandom or
 // common_hal_time_monotonic to seed it initially.
 
+#include "shared-module/random/Random.h"
+
+extern random_random_obj_t shared_modules_random_state;
+
 void shared_modules_random_seed(mp_uint_t seed);
 mp_uint_t shared_modules_random_getrandbits(uint8_t n);
 mp_int_t shared_modules_random_randrange(mp_int_t start, mp_int_t stop, mp_int_t step);
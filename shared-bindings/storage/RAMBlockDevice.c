@@ -0,0 +1,145 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "extmod/vfs.h"
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "shared-bindings/storage/RAMBlockDevice.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: storage
+//|
+//| :class:`RAMBlockDevice` -- Block device held in RAM
+//| ===================================================
+//|
+//| A block device whose blocks live in a buffer on the heap. Mount a `VfsFat` on it for
+//| temporary files that are as fast as memory and don't wear out the flash. Its contents are
+//| lost when it is collected and when the VM restarts.
+//|
+//| Usage::
+//|
+//|    import storage
+//|
+//|    ram = storage.RAMBlockDevice(128)
+//|    storage.VfsFat.mkfs(ram)
+//|    storage.mount(storage.VfsFat(ram), "/tmp")
+//|
+//| .. class:: RAMBlockDevice(block_count)
+//|
+//|   Allocate a device of ``block_count`` 512 byte blocks. A FAT filesystem needs at least
+//|   about 64 of them.
+//|
+//|   :param int block_count: Number of blocks
+//|
+STATIC mp_obj_t storage_ramblockdevice_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_block_count };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_block_count, MP_ARG_REQUIRED | MP_ARG_INT },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t block_count = args[ARG_block_count].u_int;
+    if (block_count < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_block_count);
+    }
+    // The size in bytes must fit in a size_t and block numbers in 32 bits.
+    if ((size_t) block_count > SIZE_MAX / FILESYSTEM_BLOCK_SIZE || (uint64_t) block_count > UINT32_MAX) {
+        mp_raise_ValueError_varg(translate("%q too large"), MP_QSTR_block_count);
+    }
+
+    storage_ramblockdevice_obj_t *self = m_new_obj(storage_ramblockdevice_obj_t);
+    self->base.type = &storage_ramblockdevice_type;
+    common_hal_storage_ramblockdevice_construct(self, block_count);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: readblocks(block_num, buf)
+//|
+//|     Read ``len(buf) // 512`` blocks starting at ``block_num`` into ``buf``. Returns 0 on
+//|     success and 1 when the blocks run past the end of the device.
+//|
+STATIC mp_obj_t storage_ramblockdevice_readblocks(mp_obj_t self_in, mp_obj_t block_num, mp_obj_t buf) {
+    storage_ramblockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_WRITE);
+    bool ok = common_hal_storage_ramblockdevice_readblocks(self, mp_obj_get_int(block_num), bufinfo.buf, bufinfo.len / FILESYSTEM_BLOCK_SIZE);
+    return MP_OBJ_NEW_SMALL_INT(ok ? 0 : 1);
+}
+MP_DEFINE_CONST_FUN_OBJ_3(storage_ramblockdevice_readblocks_obj, storage_ramblockdevice_readblocks);
+
+//|   .. method:: writeblocks(block_num, buf)
+//|
+//|     Write ``len(buf) // 512`` blocks from ``buf`` starting at ``block_num``. Returns 0 on
+//|     success and 1 when the blocks run past the end of the device.
+//|
+STATIC mp_obj_t storage_ramblockdevice_writeblocks(mp_obj_t self_in, mp_obj_t block_num, mp_obj_t buf) {
+    storage_ramblockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_READ);
+    bool ok = common_hal_storage_ramblockdevice_writeblocks(self, mp_obj_get_int(block_num), bufinfo.buf, bufinfo.len / FILESYSTEM_BLOCK_SIZE);
+    return MP_OBJ_NEW_SMALL_INT(ok ? 0 : 1);
+}
+MP_DEFINE_CONST_FUN_OBJ_3(storage_ramblockdevice_writeblocks_obj, storage_ramblockdevice_writeblocks);
+
+//|   .. method:: ioctl(op, arg)
+//|
+//|     Answer the block device control operations `VfsFat` uses.
+//|
+STATIC mp_obj_t storage_ramblockdevice_ioctl(mp_obj_t self_in, mp_obj_t cmd_in, mp_obj_t arg_in) {
+    (void)arg_in;
+    storage_ramblockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    switch (mp_obj_get_int(cmd_in)) {
+        case BP_IOCTL_INIT:
+        case BP_IOCTL_DEINIT:
+        case BP_IOCTL_SYNC:
+        case BP_IOCTL_TRIM:
+            return MP_OBJ_NEW_SMALL_INT(0);
+        case BP_IOCTL_SEC_COUNT:
+            return MP_OBJ_NEW_SMALL_INT(common_hal_storage_ramblockdevice_get_block_count(self));
+        case BP_IOCTL_SEC_SIZE:
+            return MP_OBJ_NEW_SMALL_INT(FILESYSTEM_BLOCK_SIZE);
+        default:
+            return mp_const_none;
+    }
+}
+MP_DEFINE_CONST_FUN_OBJ_3(storage_ramblockdevice_ioctl_obj, storage_ramblockdevice_ioctl);
+
+STATIC const mp_rom_map_elem_t storage_ramblockdevice_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&storage_ramblockdevice_readblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writeblocks), MP_ROM_PTR(&storage_ramblockdevice_writeblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ioctl), MP_ROM_PTR(&storage_ramblockdevice_ioctl_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(storage_ramblockdevice_locals_dict, storage_ramblockdevice_locals_dict_table);
+
+const mp_obj_type_t storage_ramblockdevice_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_RAMBlockDevice,
+    .make_new = storage_ramblockdevice_make_new,
+    .locals_dict = (mp_obj_dict_t*)&storage_ramblockdevice_locals_dict,
+};
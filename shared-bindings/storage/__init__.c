@@ -33,6 +33,7 @@
 #include "py/objnamedtuple.h"
 #include "py/runtime.h"
 #include "shared-bindings/storage/__init__.h"
+#include "shared-bindings/storage/RAMBlockDevice.h"
 #include "supervisor/shared/translate.h"
 
 //| :mod:`storage` --- storage management
@@ -47,6 +48,13 @@
 //| CircuitPython does not have an OS, so this module provides this functionality
 //| directly.
 //|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     RAMBlockDevice
+//|
 
 //| .. function:: mount(filesystem, mount_path, *, readonly=False)
 //|
@@ -56,7 +64,7 @@
 //|
 //|   :param bool readonly: True when the filesystem should be readonly to CircuitPython.
 //|
-mp_obj_t storage_mount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+STATIC mp_obj_t storage_mount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_readonly };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_readonly, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
@@ -92,7 +100,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(storage_mount_obj, 2, storage_mount);
 //|
 //|   This is the CircuitPython analog to the UNIX ``umount`` command.
 //|
-mp_obj_t storage_umount(mp_obj_t mnt_in) {
+STATIC mp_obj_t storage_umount(mp_obj_t mnt_in) {
     if (MP_OBJ_IS_STR(mnt_in)) {
         common_hal_storage_umount_path(mp_obj_str_get_str(mnt_in));
     } else {
@@ -113,7 +121,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(storage_umount_obj, storage_umount);
 //|     allows CircuitPython and a host to write to the same filesystem with the risk that the
 //|     filesystem will be corrupted.
 //|
-mp_obj_t storage_remount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+STATIC mp_obj_t storage_remount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_readonly, ARG_disable_concurrent_write_protection };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_readonly, MP_ARG_BOOL, {.u_bool = false} },
@@ -137,7 +145,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(storage_remount_obj, 1, storage_remount);
 //|
 //|   Retrieves the mount object associated with the mount path
 //|
-mp_obj_t storage_getmount(const mp_obj_t mnt_in) {
+STATIC mp_obj_t storage_getmount(const mp_obj_t mnt_in) {
     return common_hal_storage_getmount(mp_obj_str_get_str(mnt_in));
 }
 MP_DEFINE_CONST_FUN_OBJ_1(storage_getmount_obj, storage_getmount);
@@ -156,7 +164,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(storage_getmount_obj, storage_getmount);
 //|   .. warning:: All the data on ``CIRCUITPY`` will be lost, and
 //|        CircuitPython will restart on certain boards.
 
-mp_obj_t storage_erase_filesystem(void) {
+STATIC mp_obj_t storage_erase_filesystem(void) {
     common_hal_storage_erase_filesystem();
     return mp_const_none;
 }
@@ -221,6 +229,7 @@ STATIC const mp_rom_map_elem_t storage_module_globals_table[] = {
     //|     Don't call this directly, call `storage.umount`.
     //|
     { MP_ROM_QSTR(MP_QSTR_VfsFat), MP_ROM_PTR(&mp_fat_vfs_type) },
+    { MP_ROM_QSTR(MP_QSTR_RAMBlockDevice), MP_ROM_PTR(&storage_ramblockdevice_type) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(storage_module_globals, storage_module_globals_table);
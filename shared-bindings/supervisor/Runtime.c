@@ -28,6 +28,10 @@
 #include "py/objproperty.h"
 #include "shared-bindings/supervisor/Runtime.h"
 
+#ifdef EXTERNAL_FLASH_DEVICES
+#include "supervisor/shared/external_flash/external_flash.h"
+#endif
+
 //TODO: add USB, REPL to description once they're operational
 //| .. currentmodule:: supervisor
 //|
@@ -101,10 +105,51 @@ const mp_obj_property_t supervisor_serial_bytes_available_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+#ifdef EXTERNAL_FLASH_DEVICES
+//|     .. attribute:: runtime.flash_flush_count
+//|
+//|         Returns the number of cached sectors written back to the external flash since
+//|         power on. Only available on boards with external flash. (read-only)
+//|
+STATIC mp_obj_t supervisor_get_flash_flush_count(mp_obj_t self){
+    return mp_obj_new_int_from_uint(external_flash_get_flush_count());
+}
+MP_DEFINE_CONST_FUN_OBJ_1(supervisor_get_flash_flush_count_obj, supervisor_get_flash_flush_count);
+
+const mp_obj_property_t supervisor_flash_flush_count_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&supervisor_get_flash_flush_count_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+
+//|     .. attribute:: runtime.flash_erase_count
+//|
+//|         Returns the number of external flash sectors erased since power on. Only available
+//|         on boards with external flash. (read-only)
+//|
+STATIC mp_obj_t supervisor_get_flash_erase_count(mp_obj_t self){
+    return mp_obj_new_int_from_uint(external_flash_get_erase_count());
+}
+MP_DEFINE_CONST_FUN_OBJ_1(supervisor_get_flash_erase_count_obj, supervisor_get_flash_erase_count);
+
+const mp_obj_property_t supervisor_flash_erase_count_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&supervisor_get_flash_erase_count_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+#endif
+
 
 STATIC const mp_rom_map_elem_t supervisor_runtime_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_serial_connected), MP_ROM_PTR(&supervisor_serial_connected_obj) },
     { MP_ROM_QSTR(MP_QSTR_serial_bytes_available), MP_ROM_PTR(&supervisor_serial_bytes_available_obj) },
+    #ifdef EXTERNAL_FLASH_DEVICES
+    { MP_ROM_QSTR(MP_QSTR_flash_flush_count), MP_ROM_PTR(&supervisor_flash_flush_count_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flash_erase_count), MP_ROM_PTR(&supervisor_flash_erase_count_obj) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(supervisor_runtime_locals_dict, supervisor_runtime_locals_dict_table);
@@ -0,0 +1,261 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/synthio/__init__.h"
+#include "shared-bindings/synthio/Synthesizer.h"
+#include "shared-bindings/synthio/Voice.h"
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: synthio
+//|
+//| :class:`Synthesizer` -- Generates audio from single cycle waveforms
+//| ====================================================================
+//|
+//| Synthesizer plays notes on a fixed number of voices. Each voice repeats a single cycle
+//| waveform at the note's frequency and the voices are added together into one mono, 16 bit
+//| signed output.
+//|
+//| .. class:: Synthesizer(*, voice_count=4, buffer_size=1024, sample_rate=22050, waveform=None)
+//|
+//|   Create a Synthesizer object. Notes are started and stopped with the synthesizer's
+//|   `synthio.Voice` objects.
+//|
+//|   :param int voice_count: The number of notes that can play at once
+//|   :param int buffer_size: The total size in bytes of the buffers to generate into
+//|   :param int sample_rate: The sample rate of the output
+//|   :param array.array waveform: One cycle of the default waveform, as signed 16 bit samples
+//|     (type 'h'). Voices use it unless they are given their own. A sine wave is used when
+//|     it is None.
+//|
+//|   Playing a chord::
+//|
+//|     import array
+//|     import time
+//|     import board
+//|     import audioio
+//|     import synthio
+//|
+//|     a = audioio.AudioOut(board.A0)
+//|     saw = array.array("h", range(-32768, 32767, 256))
+//|     synth = synthio.Synthesizer(voice_count=3, waveform=saw)
+//|     a.play(synth)
+//|     for voice, frequency in zip(synth.voice, (261.63, 329.63, 392.00)):
+//|         voice.note_on(frequency, amplitude=0.3)
+//|     time.sleep(1)
+//|     for voice in synth.voice:
+//|         voice.note_off()
+//|
+STATIC mp_obj_t synthio_synthesizer_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    (void)type;
+    enum { ARG_voice_count, ARG_buffer_size, ARG_sample_rate, ARG_waveform };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_voice_count, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 4} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1024} },
+        { MP_QSTR_sample_rate, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 22050} },
+        { MP_QSTR_waveform, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t voice_count = args[ARG_voice_count].u_int;
+    if (voice_count < 1 || voice_count > 255) {
+        mp_raise_ValueError(translate("Invalid voice count"));
+    }
+    mp_int_t sample_rate = args[ARG_sample_rate].u_int;
+    if (sample_rate < 1) {
+        mp_raise_ValueError(translate("Sample rate must be positive"));
+    }
+    mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 8) {
+        mp_raise_ValueError(translate("Buffer too small"));
+    }
+    synthio_synthesizer_obj_t *self = m_new_obj_var(synthio_synthesizer_obj_t, mp_obj_t, voice_count);
+    self->base.type = &synthio_synthesizer_type;
+    common_hal_synthio_synthesizer_construct(self, voice_count, buffer_size, sample_rate);
+    if (args[ARG_waveform].u_obj != mp_const_none) {
+        synthio_validate_waveform(args[ARG_waveform].u_obj);
+        common_hal_synthio_synthesizer_set_waveform(self, args[ARG_waveform].u_obj);
+    }
+
+    for (int v = 0; v < voice_count; v++) {
+        synthio_voice_obj_t *voice = m_new_obj(synthio_voice_obj_t);
+        voice->base.type = &synthio_voice_type;
+        common_hal_synthio_voice_construct(voice);
+        common_hal_synthio_voice_set_parent(voice, self);
+        self->voice[v] = MP_OBJ_FROM_PTR(voice);
+    }
+    self->voice_tuple = mp_obj_new_tuple(self->voice_count, self->voice);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the Synthesizer and releases any hardware resources for reuse.
+//|
+STATIC mp_obj_t synthio_synthesizer_deinit(mp_obj_t self_in) {
+    synthio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_synthio_synthesizer_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(synthio_synthesizer_deinit_obj, synthio_synthesizer_deinit);
+
+STATIC void check_for_deinit(synthio_synthesizer_obj_t *self) {
+    if (common_hal_synthio_synthesizer_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t synthio_synthesizer_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_synthio_synthesizer_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(synthio_synthesizer___exit___obj, 4, 4, synthio_synthesizer_obj___exit__);
+
+//|   .. attribute:: playing
+//|
+//|     True when any voice is sounding, including notes that are fading out. (read-only)
+//|
+STATIC mp_obj_t synthio_synthesizer_obj_get_playing(mp_obj_t self_in) {
+    synthio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_synthio_synthesizer_get_playing(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_synthesizer_get_playing_obj, synthio_synthesizer_obj_get_playing);
+
+const mp_obj_property_t synthio_synthesizer_playing_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&synthio_synthesizer_get_playing_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     32 bit value that dictates how quickly samples are played in Hertz (cycles per second).
+//|
+STATIC mp_obj_t synthio_synthesizer_obj_get_sample_rate(mp_obj_t self_in) {
+    synthio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_synthio_synthesizer_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_synthesizer_get_sample_rate_obj, synthio_synthesizer_obj_get_sample_rate);
+
+const mp_obj_property_t synthio_synthesizer_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&synthio_synthesizer_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: waveform
+//|
+//|     The default single cycle waveform of the voices, or None for a sine wave.
+//|
+STATIC mp_obj_t synthio_synthesizer_obj_get_waveform(mp_obj_t self_in) {
+    synthio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return common_hal_synthio_synthesizer_get_waveform(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_synthesizer_get_waveform_obj, synthio_synthesizer_obj_get_waveform);
+
+STATIC mp_obj_t synthio_synthesizer_obj_set_waveform(mp_obj_t self_in, mp_obj_t waveform_obj) {
+    synthio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    if (waveform_obj == mp_const_none) {
+        waveform_obj = MP_OBJ_NULL;
+    } else {
+        synthio_validate_waveform(waveform_obj);
+    }
+    common_hal_synthio_synthesizer_set_waveform(self, waveform_obj);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(synthio_synthesizer_set_waveform_obj, synthio_synthesizer_obj_set_waveform);
+
+const mp_obj_property_t synthio_synthesizer_waveform_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&synthio_synthesizer_get_waveform_obj,
+              (mp_obj_t)&synthio_synthesizer_set_waveform_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: voice
+//|
+//|     A tuple of the synthesizer's `synthio.Voice` object(s).
+//|
+STATIC mp_obj_t synthio_synthesizer_obj_get_voice(mp_obj_t self_in) {
+    synthio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return self->voice_tuple;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_synthesizer_get_voice_obj, synthio_synthesizer_obj_get_voice);
+
+const mp_obj_property_t synthio_synthesizer_voice_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&synthio_synthesizer_get_voice_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t synthio_synthesizer_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&synthio_synthesizer_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&synthio_synthesizer___exit___obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&synthio_synthesizer_playing_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&synthio_synthesizer_sample_rate_obj) },
+    { MP_ROM_QSTR(MP_QSTR_waveform), MP_ROM_PTR(&synthio_synthesizer_waveform_obj) },
+    { MP_ROM_QSTR(MP_QSTR_voice), MP_ROM_PTR(&synthio_synthesizer_voice_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(synthio_synthesizer_locals_dict, synthio_synthesizer_locals_dict_table);
+
+const mp_obj_type_t synthio_synthesizer_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Synthesizer,
+    .make_new = synthio_synthesizer_make_new,
+    .locals_dict = (mp_obj_dict_t*)&synthio_synthesizer_locals_dict,
+};
@@ -0,0 +1,210 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/synthio/__init__.h"
+#include "shared-bindings/synthio/Voice.h"
+
+#include <stdint.h>
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: synthio
+//|
+//| :class:`Voice` -- Voice objects used with Synthesizer
+//| ======================================================
+//|
+//| Used to play notes with `synthio.Synthesizer`.
+//|
+//| .. class:: Voice()
+//|
+//|   Voice instance object(s) created by `synthio.Synthesizer`.
+//|
+
+STATIC mp_float_t validate_frequency(synthio_voice_obj_t *self, mp_obj_t frequency_obj) {
+    mp_float_t frequency = mp_obj_get_float(frequency_obj);
+    // Written so that NaN fails too.
+    if (!(frequency > 0 && frequency < self->parent->sample_rate / 2)) {
+        mp_raise_ValueError(translate("frequency must be greater than 0 and less than half the sample rate"));
+    }
+    return frequency;
+}
+
+STATIC mp_float_t validate_amplitude(mp_obj_t amplitude_obj) {
+    mp_float_t amplitude = mp_obj_get_float(amplitude_obj);
+    if (!(amplitude >= 0 && amplitude <= 1)) {
+        mp_raise_ValueError(translate("amplitude must be between 0 and 1"));
+    }
+    return amplitude;
+}
+
+//|   .. method:: note_on(frequency, *, amplitude=None)
+//|
+//|     Starts playing a note at the given frequency in Hertz. The waveform continues from where
+//|     it is so a voice can be retriggered without a click. The amplitude is left as is when it
+//|     is None.
+//|
+STATIC mp_obj_t synthio_voice_obj_note_on(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_frequency, ARG_amplitude };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_frequency, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_amplitude, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+    };
+    synthio_voice_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t frequency = validate_frequency(self, args[ARG_frequency].u_obj);
+    mp_float_t amplitude = common_hal_synthio_voice_get_amplitude(self);
+    if (args[ARG_amplitude].u_obj != mp_const_none) {
+        amplitude = validate_amplitude(args[ARG_amplitude].u_obj);
+    }
+    common_hal_synthio_voice_note_on(self, frequency, amplitude);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(synthio_voice_note_on_obj, 1, synthio_voice_obj_note_on);
+
+//|   .. method:: note_off()
+//|
+//|     Stops the note. It fades out over the next synthesizer buffer.
+//|
+STATIC mp_obj_t synthio_voice_obj_note_off(mp_obj_t self_in) {
+    common_hal_synthio_voice_note_off(MP_OBJ_TO_PTR(self_in));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_voice_note_off_obj, synthio_voice_obj_note_off);
+
+//|   .. attribute:: frequency
+//|
+//|     The frequency of the note in Hertz. Changes take effect immediately without restarting
+//|     the waveform so they can be used for vibrato and slides.
+//|
+STATIC mp_obj_t synthio_voice_obj_get_frequency(mp_obj_t self_in) {
+    return mp_obj_new_float(common_hal_synthio_voice_get_frequency(MP_OBJ_TO_PTR(self_in)));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_voice_get_frequency_obj, synthio_voice_obj_get_frequency);
+
+STATIC mp_obj_t synthio_voice_obj_set_frequency(mp_obj_t self_in, mp_obj_t frequency_obj) {
+    synthio_voice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_synthio_voice_set_frequency(self, validate_frequency(self, frequency_obj));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(synthio_voice_set_frequency_obj, synthio_voice_obj_set_frequency);
+
+const mp_obj_property_t synthio_voice_frequency_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&synthio_voice_get_frequency_obj,
+              (mp_obj_t)&synthio_voice_set_frequency_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: amplitude
+//|
+//|     The volume of the note, as a floating point number between 0 and 1. Changes ramp smoothly
+//|     over the next synthesizer buffer to avoid clicks.
+//|
+STATIC mp_obj_t synthio_voice_obj_get_amplitude(mp_obj_t self_in) {
+    return mp_obj_new_float(common_hal_synthio_voice_get_amplitude(MP_OBJ_TO_PTR(self_in)));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_voice_get_amplitude_obj, synthio_voice_obj_get_amplitude);
+
+STATIC mp_obj_t synthio_voice_obj_set_amplitude(mp_obj_t self_in, mp_obj_t amplitude_obj) {
+    common_hal_synthio_voice_set_amplitude(MP_OBJ_TO_PTR(self_in), validate_amplitude(amplitude_obj));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(synthio_voice_set_amplitude_obj, synthio_voice_obj_set_amplitude);
+
+const mp_obj_property_t synthio_voice_amplitude_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&synthio_voice_get_amplitude_obj,
+              (mp_obj_t)&synthio_voice_set_amplitude_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: waveform
+//|
+//|     One cycle of the voice's waveform as an array of signed 16 bit samples (type 'h'), or None
+//|     to use the synthesizer's. The array is used in place so changes to it are heard, including
+//|     changes to its length. An array shortened to less than 2 samples is silent.
+//|
+STATIC mp_obj_t synthio_voice_obj_get_waveform(mp_obj_t self_in) {
+    return common_hal_synthio_voice_get_waveform(MP_OBJ_TO_PTR(self_in));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_voice_get_waveform_obj, synthio_voice_obj_get_waveform);
+
+STATIC mp_obj_t synthio_voice_obj_set_waveform(mp_obj_t self_in, mp_obj_t waveform_obj) {
+    if (waveform_obj == mp_const_none) {
+        waveform_obj = MP_OBJ_NULL;
+    } else {
+        synthio_validate_waveform(waveform_obj);
+    }
+    common_hal_synthio_voice_set_waveform(MP_OBJ_TO_PTR(self_in), waveform_obj);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(synthio_voice_set_waveform_obj, synthio_voice_obj_set_waveform);
+
+const mp_obj_property_t synthio_voice_waveform_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&synthio_voice_get_waveform_obj,
+              (mp_obj_t)&synthio_voice_set_waveform_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: playing
+//|
+//|     True when the note is on or still fading out. (read-only)
+//|
+STATIC mp_obj_t synthio_voice_obj_get_playing(mp_obj_t self_in) {
+    return mp_obj_new_bool(common_hal_synthio_voice_get_playing(MP_OBJ_TO_PTR(self_in)));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_voice_get_playing_obj, synthio_voice_obj_get_playing);
+
+const mp_obj_property_t synthio_voice_playing_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&synthio_voice_get_playing_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t synthio_voice_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_note_on), MP_ROM_PTR(&synthio_voice_note_on_obj) },
+    { MP_ROM_QSTR(MP_QSTR_note_off), MP_ROM_PTR(&synthio_voice_note_off_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_frequency), MP_ROM_PTR(&synthio_voice_frequency_obj) },
+    { MP_ROM_QSTR(MP_QSTR_amplitude), MP_ROM_PTR(&synthio_voice_amplitude_obj) },
+    { MP_ROM_QSTR(MP_QSTR_waveform), MP_ROM_PTR(&synthio_voice_waveform_obj) },
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&synthio_voice_playing_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(synthio_voice_locals_dict, synthio_voice_locals_dict_table);
+
+const mp_obj_type_t synthio_voice_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Voice,
+    .locals_dict = (mp_obj_dict_t*)&synthio_voice_locals_dict,
+};
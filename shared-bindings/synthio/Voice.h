@@ -0,0 +1,47 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_SYNTHIO_VOICE_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_SYNTHIO_VOICE_H
+
+#include "shared-module/synthio/Synthesizer.h"
+#include "shared-module/synthio/Voice.h"
+
+extern const mp_obj_type_t synthio_voice_type;
+
+void common_hal_synthio_voice_construct(synthio_voice_obj_t* self);
+void common_hal_synthio_voice_set_parent(synthio_voice_obj_t* self, synthio_synthesizer_obj_t* parent);
+void common_hal_synthio_voice_note_on(synthio_voice_obj_t* self, mp_float_t frequency, mp_float_t amplitude);
+void common_hal_synthio_voice_note_off(synthio_voice_obj_t* self);
+bool common_hal_synthio_voice_get_playing(synthio_voice_obj_t* self);
+mp_float_t common_hal_synthio_voice_get_frequency(synthio_voice_obj_t* self);
+void common_hal_synthio_voice_set_frequency(synthio_voice_obj_t* self, mp_float_t frequency);
+mp_float_t common_hal_synthio_voice_get_amplitude(synthio_voice_obj_t* self);
+void common_hal_synthio_voice_set_amplitude(synthio_voice_obj_t* self, mp_float_t amplitude);
+mp_obj_t common_hal_synthio_voice_get_waveform(synthio_voice_obj_t* self);
+void common_hal_synthio_voice_set_waveform(synthio_voice_obj_t* self, mp_obj_t waveform_obj);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_SYNTHIO_VOICE_H
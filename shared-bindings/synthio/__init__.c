@@ -0,0 +1,76 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/synthio/__init__.h"
+#include "shared-bindings/synthio/Synthesizer.h"
+#include "shared-bindings/synthio/Voice.h"
+#include "supervisor/shared/translate.h"
+
+//| :mod:`synthio` --- Support for wavetable synthesis
+//| ===================================================
+//|
+//| .. module:: synthio
+//|   :synopsis: Support for wavetable synthesis
+//|
+//| The `synthio` module contains classes that generate audio from single cycle waveforms. The
+//| output can be played directly or mixed with other samples by `audiomixer.Mixer`.
+//|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     Synthesizer
+//|     Voice
+//|
+
+void synthio_validate_waveform(mp_obj_t waveform_obj) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(waveform_obj, &bufinfo, MP_BUFFER_READ);
+    if (bufinfo.typecode != 'h') {
+        mp_raise_TypeError(translate("waveform must be an array of type 'h'"));
+    }
+    if (bufinfo.len / sizeof(int16_t) < 2) {
+        mp_raise_ValueError(translate("waveform must have at least 2 samples"));
+    }
+}
+
+STATIC const mp_rom_map_elem_t synthio_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_synthio) },
+    { MP_ROM_QSTR(MP_QSTR_Synthesizer), MP_ROM_PTR(&synthio_synthesizer_type) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(synthio_module_globals, synthio_module_globals_table);
+
+const mp_obj_module_t synthio_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&synthio_module_globals,
+};
@@ -29,67 +29,147 @@
 #include "py/objarray.h"
 #include "py/runtime.h"
 #include "PixelBuf.h"
+#include <math.h>
 #include <string.h>
 
-void pixelbuf_set_pixel_int(uint8_t *buf, mp_int_t value, pixelbuf_byteorder_obj_t *byteorder) {
-    buf[byteorder->byteorder.r] = value >> 16 & 0xff;
-    buf[byteorder->byteorder.g] = (value >> 8) & 0xff;
-    buf[byteorder->byteorder.b] = value & 0xff;
-    if (byteorder->bpp == 4 && byteorder->has_white && 
-            (buf[byteorder->byteorder.r] == buf[byteorder->byteorder.g] && 
-                buf[byteorder->byteorder.r] == buf[byteorder->byteorder.b])) {
-        buf[byteorder->byteorder.w] = buf[byteorder->byteorder.r];
-        buf[byteorder->byteorder.r] = buf[byteorder->byteorder.g] = buf[byteorder->byteorder.b] = 0;
+void pixelbuf_get_color(mp_obj_t item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar, pixelbuf_color_t *color) {
+    color->has_w = dotstar;
+    color->w = DOTSTAR_LED_START_FULL_BRIGHT;
+    if (MP_OBJ_IS_INT(item)) {
+        mp_int_t value = mp_obj_get_int_truncated(item);
+        color->r = value >> 16 & 0xff;
+        color->g = (value >> 8) & 0xff;
+        color->b = value & 0xff;
+        if (byteorder->bpp == 4 && byteorder->has_white) {
+            // Grays go to the white LED and other colors turn it off.
+            color->has_w = true;
+            color->w = 0;
+            if (color->r == color->g && color->r == color->b) {
+                color->w = color->r;
+                color->r = color->g = color->b = 0;
+            }
+        }
+        return;
     }
-}
+    mp_obj_t *items;
+    size_t len;
+    mp_obj_get_array(item, &len, &items);
+    if (len != byteorder->bpp && !dotstar)
+        mp_raise_ValueError_varg(translate("Expected tuple of length %d, got %d"), byteorder->bpp, len);
 
-void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_t *item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar) {
-    if (MP_OBJ_IS_INT(item)) {
-        uint8_t *target = rawbuf ? rawbuf : buf;
-        pixelbuf_set_pixel_int(target, mp_obj_get_int_truncated(item), byteorder);
-         if (dotstar) {
-            buf[0] = DOTSTAR_LED_START_FULL_BRIGHT;
-            if (rawbuf) 
-                rawbuf[0] = DOTSTAR_LED_START_FULL_BRIGHT;
-         }
-        if (rawbuf) {
-            buf[byteorder->byteorder.r] = rawbuf[byteorder->byteorder.r] * brightness;
-            buf[byteorder->byteorder.g] = rawbuf[byteorder->byteorder.g] * brightness;
-            buf[byteorder->byteorder.b] = rawbuf[byteorder->byteorder.b] * brightness;
+    color->r = mp_obj_get_int_truncated(items[PIXEL_R]);
+    color->g = mp_obj_get_int_truncated(items[PIXEL_G]);
+    color->b = mp_obj_get_int_truncated(items[PIXEL_B]);
+    if (len > 3) {
+        color->has_w = true;
+        if (dotstar) {
+            color->w = DOTSTAR_LED_START | DOTSTAR_BRIGHTNESS(mp_obj_get_float(items[PIXEL_W]));
         } else {
-            buf[byteorder->byteorder.r] *= brightness;
-            buf[byteorder->byteorder.g] *= brightness;
-            buf[byteorder->byteorder.b] *= brightness;
+            color->w = mp_obj_get_int_truncated(items[PIXEL_W]);
         }
+    }
+}
+
+void pixelbuf_set_color(uint8_t *buf, const uint8_t *lut, const pixelbuf_color_t *color, pixelbuf_byteorder_obj_t *byteorder, bool dotstar) {
+    if (lut) {
+        buf[byteorder->byteorder.r] = lut[color->r];
+        buf[byteorder->byteorder.g] = lut[color->g];
+        buf[byteorder->byteorder.b] = lut[color->b];
     } else {
-        mp_obj_t *items;
-        size_t len;
-        mp_obj_get_array(item, &len, &items);
-        if (len != byteorder->bpp && !dotstar) 
-            mp_raise_ValueError_varg(translate("Expected tuple of length %d, got %d"), byteorder->bpp, len);
+        buf[byteorder->byteorder.r] = color->r;
+        buf[byteorder->byteorder.g] = color->g;
+        buf[byteorder->byteorder.b] = color->b;
+    }
+    if (color->has_w) {
+        // The DotStar brightness byte is never scaled.
+        buf[byteorder->byteorder.w] = lut && !dotstar ? lut[color->w] : color->w;
+    }
+}
+
+void pixelbuf_set_pixel(uint8_t *buf, const uint8_t *lut, mp_obj_t item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar) {
+    pixelbuf_color_t color;
+    pixelbuf_get_color(item, byteorder, dotstar, &color);
+    pixelbuf_set_color(buf, lut, &color, byteorder, dotstar);
+}
 
-        buf[byteorder->byteorder.r] = mp_obj_get_int_truncated(items[PIXEL_R]) * brightness;
-        buf[byteorder->byteorder.g] = mp_obj_get_int_truncated(items[PIXEL_G]) * brightness;
-        buf[byteorder->byteorder.b] = mp_obj_get_int_truncated(items[PIXEL_B]) * brightness;
-        if (rawbuf) {
-            rawbuf[byteorder->byteorder.r] = mp_obj_get_int_truncated(items[PIXEL_R]);
-            rawbuf[byteorder->byteorder.g] = mp_obj_get_int_truncated(items[PIXEL_G]);
-            rawbuf[byteorder->byteorder.b] = mp_obj_get_int_truncated(items[PIXEL_B]);
+void pixelbuf_set_pixels_from_buffer(uint8_t *buf, const uint8_t *lut, const uint8_t *src, size_t count, uint8_t src_bpp, uint8_t step, pixelbuf_byteorder_obj_t *byteorder, bool dotstar) {
+    if (lut == NULL && !dotstar && src_bpp == step && byteorder->byteorder.r == PIXEL_R &&
+        byteorder->byteorder.g == PIXEL_G && byteorder->byteorder.b == PIXEL_B &&
+        (step == 3 || byteorder->byteorder.w == PIXEL_W)) {
+        memcpy(buf, src, count * step);
+        return;
+    }
+    pixelbuf_color_t color;
+    color.has_w = src_bpp == 4 || dotstar;
+    color.w = DOTSTAR_LED_START_FULL_BRIGHT;
+    for (size_t i = 0; i < count; i++) {
+        color.r = src[PIXEL_R];
+        color.g = src[PIXEL_G];
+        color.b = src[PIXEL_B];
+        if (src_bpp == 4) {
+            color.w = src[PIXEL_W];
         }
-        if (len > 3) {
-            if (dotstar) {
-                buf[byteorder->byteorder.w] = DOTSTAR_LED_START | DOTSTAR_BRIGHTNESS(mp_obj_get_float(items[PIXEL_W]));
-                if (rawbuf)
-                    rawbuf[byteorder->byteorder.w] = buf[byteorder->byteorder.w];
-            } else {
-                buf[byteorder->byteorder.w] = mp_obj_get_int_truncated(items[PIXEL_W]) * brightness;
-                if (rawbuf)
-                    rawbuf[byteorder->byteorder.w] = mp_obj_get_int_truncated(items[PIXEL_W]);
-            }
-        } else if (dotstar) {
-            buf[byteorder->byteorder.w] = DOTSTAR_LED_START_FULL_BRIGHT;
-            if (rawbuf)
-                rawbuf[byteorder->byteorder.w] = DOTSTAR_LED_START_FULL_BRIGHT;
+        pixelbuf_set_color(buf, lut, &color, byteorder, dotstar);
+        src += src_bpp;
+        buf += step;
+    }
+}
+
+void pixelbuf_set_gradient(uint8_t *buf, const uint8_t *lut, size_t count, uint8_t step, const pixelbuf_color_t *start, const pixelbuf_color_t *end, pixelbuf_byteorder_obj_t *byteorder, bool dotstar) {
+    if (count == 0) {
+        return;
+    }
+    // Step each channel in 16.16 fixed point. DotStars blend only the 5 bit brightness.
+    uint8_t w_mask = dotstar ? 0x1f : 0xff;
+    const uint8_t from[4] = {start->r, start->g, start->b, start->w & w_mask};
+    const uint8_t to[4] = {end->r, end->g, end->b, end->w & w_mask};
+    int32_t value[4];
+    int32_t delta[4];
+    for (uint8_t c = 0; c < 4; c++) {
+        value[c] = (from[c] << 16) + 0x8000;
+        delta[c] = count > 1 ? (to[c] - from[c]) * 65536 / (int32_t) (count - 1) : 0;
+    }
+    pixelbuf_color_t color;
+    color.has_w = start->has_w || end->has_w;
+    for (size_t i = 0; i < count; i++) {
+        color.r = value[PIXEL_R] >> 16;
+        color.g = value[PIXEL_G] >> 16;
+        color.b = value[PIXEL_B] >> 16;
+        color.w = value[PIXEL_W] >> 16;
+        if (dotstar) {
+            color.w |= DOTSTAR_LED_START;
+        }
+        pixelbuf_set_color(buf, lut, &color, byteorder, dotstar);
+        for (uint8_t c = 0; c < 4; c++) {
+            value[c] += delta[c];
+        }
+        buf += step;
+    }
+}
+
+void pixelbuf_build_lut(uint8_t *lut, mp_float_t brightness, mp_float_t gamma) {
+    // Brightness is 16.16 fixed point so 1.0 leaves values unchanged.
+    uint32_t scale = brightness * 65536 + MICROPY_FLOAT_CONST(0.5);
+    for (uint16_t i = 0; i < 256; i++) {
+        uint32_t value = i;
+        if (gamma != 1) {
+            value = MICROPY_FLOAT_C_FUN(pow)(i / MICROPY_FLOAT_CONST(255.0), gamma) * 255 + MICROPY_FLOAT_CONST(0.5);
+        }
+        lut[i] = (value * scale) >> 16;
+    }
+}
+
+void pixelbuf_apply_lut(uint8_t *buf, const uint8_t *rawbuf, const uint8_t *lut, size_t bytes, bool dotstar) {
+    if (lut == NULL) {
+        memcpy(buf, rawbuf, bytes);
+        return;
+    }
+    for (size_t i = 0; i < bytes; i++) {
+        // Don't adjust per-pixel luminance bytes in dotstar mode
+        if (dotstar && i % 4 == 0) {
+            buf[i] = rawbuf[i];
+        } else {
+            buf[i] = lut[rawbuf[i]];
         }
     }
 }
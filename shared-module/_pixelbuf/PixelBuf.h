@@ -42,9 +42,23 @@
 #define DOTSTAR_GET_BRIGHTNESS(value) ((value & 0b00011111) / 31.0)
 #define DOTSTAR_LED_START_FULL_BRIGHT 0xFF
 
-void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_t *item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar);
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t w;
+    bool has_w;
+} pixelbuf_color_t;
+
+// lut is NULL when values are written unscaled.
+void pixelbuf_get_color(mp_obj_t item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar, pixelbuf_color_t *color);
+void pixelbuf_set_color(uint8_t *buf, const uint8_t *lut, const pixelbuf_color_t *color, pixelbuf_byteorder_obj_t *byteorder, bool dotstar);
+void pixelbuf_set_pixel(uint8_t *buf, const uint8_t *lut, mp_obj_t item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar);
+void pixelbuf_set_pixels_from_buffer(uint8_t *buf, const uint8_t *lut, const uint8_t *src, size_t count, uint8_t src_bpp, uint8_t step, pixelbuf_byteorder_obj_t *byteorder, bool dotstar);
+void pixelbuf_set_gradient(uint8_t *buf, const uint8_t *lut, size_t count, uint8_t step, const pixelbuf_color_t *start, const pixelbuf_color_t *end, pixelbuf_byteorder_obj_t *byteorder, bool dotstar);
 mp_obj_t *pixelbuf_get_pixel(uint8_t *buf, pixelbuf_byteorder_obj_t *byteorder, bool dotstar);
 mp_obj_t *pixelbuf_get_pixel_array(uint8_t *buf, uint len, pixelbuf_byteorder_obj_t *byteorder, uint8_t step, bool dotstar);
-void pixelbuf_set_pixel_int(uint8_t *buf, mp_int_t value, pixelbuf_byteorder_obj_t *byteorder);
+void pixelbuf_build_lut(uint8_t *lut, mp_float_t brightness, mp_float_t gamma);
+void pixelbuf_apply_lut(uint8_t *buf, const uint8_t *rawbuf, const uint8_t *lut, size_t bytes, bool dotstar);
 
 #endif
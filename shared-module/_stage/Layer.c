@@ -28,78 +28,99 @@
 #include "__init__.h"
 
 
-// Get the color of the pixel on the layer.
-uint16_t get_layer_pixel(layer_obj_t *layer, uint16_t x, uint16_t y) {
+// Fill in the still transparent pixels of row, which covers x0 to x1 on line
+// y, with the layer's pixels. Returns how many pixels became opaque.
+uint16_t get_layer_row(layer_obj_t *layer, uint16_t x0, uint16_t x1,
+        uint16_t y, uint16_t *row) {
 
-    // Shift by the layer's position offset.
-    x -= layer->x;
-    y -= layer->y;
-
-    // Bounds check.
-    if ((x < 0) || (x >= layer->width << 4) ||
-            (y < 0) || (y >= layer->height << 4)) {
-        return TRANSPARENT;
-    }
-
-    // Get the tile from the grid location or from sprite frame.
-    uint8_t frame = layer->frame;
-    if (layer->map) {
-        uint8_t tx = x >> 4;
-        uint8_t ty = y >> 4;
-
-        frame = layer->map[(ty * layer->width + tx) >> 1];
-        if (tx & 0x01) {
-            frame &= 0x0f;
-        } else {
-            frame >>= 4;
-        }
+    // Shift by the layer's position offset and bounds check.
+    int32_t ly = (int32_t)y - layer->y;
+    if ((ly < 0) || (ly >= layer->height << 4)) {
+        return 0;
     }
+    int32_t start = MAX((int32_t)x0, layer->x);
+    int32_t end = MIN((int32_t)x1, layer->x + (layer->width << 4));
 
-    // Get the position within the tile.
-    x &= 0x0f;
-    y &= 0x0f;
-
-    // Rotate the image.
-    uint8_t ty = y; // Temporary variable for swapping.
+    // Rotating the image makes the pixels along the row a straight line
+    // through the tile, so work out where it starts and how it steps once.
+    // Pixels are numbered (y << 4) + x within the tile.
+    uint8_t py = ly & 0x0f;
+    int16_t first;
+    int16_t step;
     switch (layer->rotation) {
         case 1: // 90 degrees clockwise
-            y = 15 - x;
-            x = ty;
+            first = (15 << 4) + py;
+            step = -16;
             break;
         case 2: // 180 degrees
-            y = 15 - ty;
-            x = 15 - x;
+            first = ((15 - py) << 4) + 15;
+            step = -1;
             break;
         case 3: // 90 degrees counter-clockwise
-            y = x;
-            x = 15 - ty;
+            first = 15 - py;
+            step = 16;
             break;
         case 4: // 0 degrees, mirrored
-            x = 15 - x;
+            first = (py << 4) + 15;
+            step = -1;
             break;
         case 5: // 90 degrees clockwise, mirrored
-            y = x;
-            x = ty;
+            first = py;
+            step = 16;
             break;
         case 6: // 180 degrees, mirrored
-            y = 15 - ty;
+            first = (15 - py) << 4;
+            step = 1;
             break;
         case 7: // 90 degrees counter-clockwise, mirrored
-            y = 15 - x;
-            x = 15 - ty;
+            first = (15 << 4) + 15 - py;
+            step = -16;
             break;
         default: // 0 degrees
+            first = py << 4;
+            step = 1;
             break;
     }
 
-    // Get the value of the pixel.
-    uint8_t pixel = layer->graphic[(frame << 7) + (y << 3) + (x >> 1)];
-    if (x & 0x01) {
-        pixel &= 0x0f;
-    } else {
-        pixel >>= 4;
-    }
+    uint16_t filled = 0;
+    uint8_t ty = ly >> 4;
+    int32_t x = start;
+    while (x < end) {
+        // Get the tile from the grid location or from sprite frame.
+        int32_t lx = x - layer->x;
+        uint8_t tx = lx >> 4;
+        uint8_t frame = layer->frame;
+        if (layer->map) {
+            frame = layer->map[(ty * layer->width + tx) >> 1];
+            if (tx & 0x01) {
+                frame &= 0x0f;
+            } else {
+                frame >>= 4;
+            }
+        }
+        uint8_t *graphic = layer->graphic + (frame << 7);
 
-    // Convert to 16-bit color using the palette.
-    return layer->palette[pixel << 1] | layer->palette[(pixel << 1) + 1] << 8;
+        // Draw the part of the row that falls on this tile.
+        int32_t tile_end = MIN(end, x + 16 - (lx & 0x0f));
+        int16_t index = first + step * (lx & 0x0f);
+        for (; x < tile_end; ++x, index += step) {
+            uint16_t *out = row + (x - x0);
+            if (*out != TRANSPARENT) {
+                continue;
+            }
+            uint8_t pixel = graphic[index >> 1];
+            if (index & 0x01) {
+                pixel &= 0x0f;
+            } else {
+                pixel >>= 4;
+            }
+            // Convert to 16-bit color using the palette.
+            *out = layer->palette[pixel << 1] |
+                   layer->palette[(pixel << 1) + 1] << 8;
+            if (*out != TRANSPARENT) {
+                filled += 1;
+            }
+        }
+    }
+    return filled;
 }
@@ -43,6 +43,7 @@ typedef struct {
     uint8_t rotation;
 } layer_obj_t;
 
-uint16_t get_layer_pixel(layer_obj_t *layer, uint16_t x, uint16_t y);
+uint16_t get_layer_row(layer_obj_t *layer, uint16_t x0, uint16_t x1,
+        uint16_t y, uint16_t *row);
 
 #endif  // MICROPY_INCLUDED_SHARED_MODULE__STAGE_LAYER
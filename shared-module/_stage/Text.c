@@ -28,40 +28,57 @@
 #include "__init__.h"
 
 
-// Get the color of the pixel on the text.
-uint16_t get_text_pixel(text_obj_t *text, uint16_t x, uint16_t y) {
+// Fill in the still transparent pixels of row, which covers x0 to x1 on line
+// y, with the text's pixels. Returns how many pixels became opaque.
+uint16_t get_text_row(text_obj_t *text, uint16_t x0, uint16_t x1,
+        uint16_t y, uint16_t *row) {
 
-    // Shift by the text's position offset.
-    x -= text->x;
-    y -= text->y;
-
-    // Bounds check.
-    if ((x < 0) || (x >= text->width << 3) ||
-            (y < 0) || (y >= text->height << 3)) {
-        return TRANSPARENT;
+    // Shift by the text's position offset and bounds check.
+    int32_t ly = (int32_t)y - text->y;
+    if ((ly < 0) || (ly >= text->height << 3)) {
+        return 0;
     }
+    int32_t start = MAX((int32_t)x0, text->x);
+    int32_t end = MIN((int32_t)x1, text->x + (text->width << 3));
 
-    // Get the tile from the grid location or from sprite frame.
-    uint8_t tx = x >> 3;
-    uint8_t ty = y >> 3;
-    uint8_t c = text->chars[ty * text->width + tx];
-    uint8_t color_offset = 0;
-    if (c & 0x80) {
-        color_offset = 4;
-    }
-    c &= 0x7f;
-    if (!c) {
-        return TRANSPARENT;
-    }
+    uint16_t filled = 0;
+    uint8_t *chars = text->chars + (ly >> 3) * text->width;
+    uint8_t py = ly & 0x07;
+    int32_t x = start;
+    while (x < end) {
+        int32_t lx = x - text->x;
+        int32_t char_end = MIN(end, x + 8 - (lx & 0x07));
 
-    // Get the position within the char.
-    x &= 0x07;
-    y &= 0x07;
+        // Get the char, empty ones are transparent.
+        uint8_t c = chars[lx >> 3];
+        uint8_t color_offset = 0;
+        if (c & 0x80) {
+            color_offset = 4;
+        }
+        c &= 0x7f;
+        if (!c) {
+            x = char_end;
+            continue;
+        }
 
-    // Get the value of the pixel.
-    uint8_t pixel = text->font[(c << 4) + (y << 1) + (x >> 2)];
-    pixel = ((pixel >> ((x & 0x03) << 1)) & 0x03) + color_offset;
+        // Draw the part of the row that falls on this char.
+        uint8_t *glyph = text->font + (c << 4) + (py << 1);
+        for (; x < char_end; ++x, ++lx) {
+            uint16_t *out = row + (x - x0);
+            if (*out != TRANSPARENT) {
+                continue;
+            }
+            uint8_t cx = lx & 0x07;
+            uint8_t pixel = glyph[cx >> 2];
+            pixel = ((pixel >> ((cx & 0x03) << 1)) & 0x03) + color_offset;
 
-    // Convert to 16-bit color using the palette.
-    return text->palette[pixel << 1] | text->palette[(pixel << 1) + 1] << 8;
+            // Convert to 16-bit color using the palette.
+            *out = text->palette[pixel << 1] |
+                   text->palette[(pixel << 1) + 1] << 8;
+            if (*out != TRANSPARENT) {
+                filled += 1;
+            }
+        }
+    }
+    return filled;
 }
@@ -36,6 +36,9 @@ void render_stage(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
         uint16_t *buffer, size_t buffer_size,
         displayio_display_obj_t *display, uint8_t scale) {
 
+    if (x1 <= x0 || y1 <= y0) {
+        return;
+    }
 
     displayio_area_t area;
     area.x1 = x0;
@@ -52,22 +55,29 @@ void render_stage(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
     display->core.send(display->core.bus, DISPLAY_COMMAND,
                       CHIP_SELECT_TOGGLE_EVERY_BYTE,
                       &display->write_ram_command, 1);
+    uint16_t width = x1 - x0;
+    uint16_t row[width];
     size_t index = 0;
     for (uint16_t y = y0; y < y1; ++y) {
+        // Render the whole row one layer at a time, top layer first. Each
+        // layer only fills in pixels that are still transparent, so we can
+        // stop as soon as the row is opaque.
+        for (uint16_t x = 0; x < width; ++x) {
+            row[x] = TRANSPARENT;
+        }
+        uint16_t remaining = width;
+        for (size_t layer = 0; layer < layers_size && remaining > 0; ++layer) {
+            layer_obj_t *obj = MP_OBJ_TO_PTR(layers[layer]);
+            if (obj->base.type == &mp_type_layer) {
+                remaining -= get_layer_row(obj, x0, x1, y, row);
+            } else if (obj->base.type == &mp_type_text) {
+                remaining -= get_text_row((text_obj_t *)obj, x0, x1, y, row);
+            }
+        }
+
         for (uint8_t yscale = 0; yscale < scale; ++yscale) {
-            for (uint16_t x = x0; x < x1; ++x) {
-                uint16_t c = TRANSPARENT;
-                for (size_t layer = 0; layer < layers_size; ++layer) {
-                    layer_obj_t *obj = MP_OBJ_TO_PTR(layers[layer]);
-                    if (obj->base.type == &mp_type_layer) {
-                        c = get_layer_pixel(obj, x, y);
-                    } else if (obj->base.type == &mp_type_text) {
-                        c = get_text_pixel((text_obj_t *)obj, x, y);
-                    }
-                    if (c != TRANSPARENT) {
-                        break;
-                    }
-                }
+            for (uint16_t x = 0; x < width; ++x) {
+                uint16_t c = row[x];
                 for (uint8_t xscale = 0; xscale < scale; ++xscale) {
                     buffer[index] = c;
                     index += 1;
@@ -0,0 +1,210 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-module/audiobusio/PDMDecimator.h"
+
+#include <string.h>
+
+// A fourth order CIC that decimates by 8 is the same as an FIR with a 29 tap kernel (1, 4, 10, 20,
+// ..., 344, ..., 4, 1) that sums to 4096. Padded with three leading zeros it spans four bytes of
+// PDM so each table holds the weighted sum of one byte's set bits for its place in the kernel,
+// oldest byte first.
+static const uint16_t byte_taps[4][256] = {
+    {
+        0, 35, 20, 55, 10, 45, 30, 65, 4, 39, 24, 59, 14, 49, 34, 69,
+        1, 36, 21, 56, 11, 46, 31, 66, 5, 40, 25, 60, 15, 50, 35, 70,
+        0, 35, 20, 55, 10, 45, 30, 65, 4, 39, 24, 59, 14, 49, 34, 69,
+        1, 36, 21, 56, 11, 46, 31, 66, 5, 40, 25, 60, 15, 50, 35, 70,
+        0, 35, 20, 55, 10, 45, 30, 65, 4, 39, 24, 59, 14, 49, 34, 69,
+        1, 36, 21, 56, 11, 46, 31, 66, 5, 40, 25, 60, 15, 50, 35, 70,
+        0, 35, 20, 55, 10, 45, 30, 65, 4, 39, 24, 59, 14, 49, 34, 69,
+        1, 36, 21, 56, 11, 46, 31, 66, 5, 40, 25, 60, 15, 50, 35, 70,
+        0, 35, 20, 55, 10, 45, 30, 65, 4, 39, 24, 59, 14, 49, 34, 69,
+        1, 36, 21, 56, 11, 46, 31, 66, 5, 40, 25, 60, 15, 50, 35, 70,
+        0, 35, 20, 55, 10, 45, 30, 65, 4, 39, 24, 59, 14, 49, 34, 69,
+        1, 36, 21, 56, 11, 46, 31, 66, 5, 40, 25, 60, 15, 50, 35, 70,
+        0, 35, 20, 55, 10, 45, 30, 65, 4, 39, 24, 59, 14, 49, 34, 69,
+        1, 36, 21, 56, 11, 46, 31, 66, 5, 40, 25, 60, 15, 50, 35, 70,
+        0, 35, 20, 55, 10, 45, 30, 65, 4, 39, 24, 59, 14, 49, 34, 69,
+        1, 36, 21, 56, 11, 46, 31, 66, 5, 40, 25, 60, 15, 50, 35, 70
+    },
+    {
+        0, 315, 284, 599, 246, 561, 530, 845, 204, 519, 488, 803, 450, 765, 734, 1049,
+        161, 476, 445, 760, 407, 722, 691, 1006, 365, 680, 649, 964, 611, 926, 895, 1210,
+        120, 435, 404, 719, 366, 681, 650, 965, 324, 639, 608, 923, 570, 885, 854, 1169,
+        281, 596, 565, 880, 527, 842, 811, 1126, 485, 800, 769, 1084, 731, 1046, 1015, 1330,
+        84, 399, 368, 683, 330, 645, 614, 929, 288, 603, 572, 887, 534, 849, 818, 1133,
+        245, 560, 529, 844, 491, 806, 775, 1090, 449, 764, 733, 1048, 695, 1010, 979, 1294,
+        204, 519, 488, 803, 450, 765, 734, 1049, 408, 723, 692, 1007, 654, 969, 938, 1253,
+        365, 680, 649, 964, 611, 926, 895, 1210, 569, 884, 853, 1168, 815, 1130, 1099, 1414,
+        56, 371, 340, 655, 302, 617, 586, 901, 260, 575, 544, 859, 506, 821, 790, 1105,
+        217, 532, 501, 816, 463, 778, 747, 1062, 421, 736, 705, 1020, 667, 982, 951, 1266,
+        176, 491, 460, 775, 422, 737, 706, 1021, 380, 695, 664, 979, 626, 941, 910, 1225,
+        337, 652, 621, 936, 583, 898, 867, 1182, 541, 856, 825, 1140, 787, 1102, 1071, 1386,
+        140, 455, 424, 739, 386, 701, 670, 985, 344, 659, 628, 943, 590, 905, 874, 1189,
+        301, 616, 585, 900, 547, 862, 831, 1146, 505, 820, 789, 1104, 751, 1066, 1035, 1350,
+        260, 575, 544, 859, 506, 821, 790, 1105, 464, 779, 748, 1063, 710, 1025, 994, 1309,
+        421, 736, 705, 1020, 667, 982, 951, 1266, 625, 940, 909, 1224, 871, 1186, 1155, 1470
+    },
+    {
+        0, 161, 204, 365, 246, 407, 450, 611, 284, 445, 488, 649, 530, 691, 734, 895,
+        315, 476, 519, 680, 561, 722, 765, 926, 599, 760, 803, 964, 845, 1006, 1049, 1210,
+        336, 497, 540, 701, 582, 743, 786, 947, 620, 781, 824, 985, 866, 1027, 1070, 1231,
+        651, 812, 855, 1016, 897, 1058, 1101, 1262, 935, 1096, 1139, 1300, 1181, 1342, 1385, 1546,
+        344, 505, 548, 709, 590, 751, 794, 955, 628, 789, 832, 993, 874, 1035, 1078, 1239,
+        659, 820, 863, 1024, 905, 1066, 1109, 1270, 943, 1104, 1147, 1308, 1189, 1350, 1393, 1554,
+        680, 841, 884, 1045, 926, 1087, 1130, 1291, 964, 1125, 1168, 1329, 1210, 1371, 1414, 1575,
+        995, 1156, 1199, 1360, 1241, 1402, 1445, 1606, 1279, 1440, 1483, 1644, 1525, 1686, 1729, 1890,
+        336, 497, 540, 701, 582, 743, 786, 947, 620, 781, 824, 985, 866, 1027, 1070, 1231,
+        651, 812, 855, 1016, 897, 1058, 1101, 1262, 935, 1096, 1139, 1300, 1181, 1342, 1385, 1546,
+        672, 833, 876, 1037, 918, 1079, 1122, 1283, 956, 1117, 1160, 1321, 1202, 1363, 1406, 1567,
+        987, 1148, 1191, 1352, 1233, 1394, 1437, 1598, 1271, 1432, 1475, 1636, 1517, 1678, 1721, 1882,
+        680, 841, 884, 1045, 926, 1087, 1130, 1291, 964, 1125, 1168, 1329, 1210, 1371, 1414, 1575,
+        995, 1156, 1199, 1360, 1241, 1402, 1445, 1606, 1279, 1440, 1483, 1644, 1525, 1686, 1729, 1890,
+        1016, 1177, 1220, 1381, 1262, 1423, 1466, 1627, 1300, 1461, 1504, 1665, 1546, 1707, 1750, 1911,
+        1331, 1492, 1535, 1696, 1577, 1738, 1781, 1942, 1615, 1776, 1819, 1980, 1861, 2022, 2065, 2226
+    },
+    {
+        0, 1, 4, 5, 10, 11, 14, 15, 20, 21, 24, 25, 30, 31, 34, 35,
+        35, 36, 39, 40, 45, 46, 49, 50, 55, 56, 59, 60, 65, 66, 69, 70,
+        56, 57, 60, 61, 66, 67, 70, 71, 76, 77, 80, 81, 86, 87, 90, 91,
+        91, 92, 95, 96, 101, 102, 105, 106, 111, 112, 115, 116, 121, 122, 125, 126,
+        84, 85, 88, 89, 94, 95, 98, 99, 104, 105, 108, 109, 114, 115, 118, 119,
+        119, 120, 123, 124, 129, 130, 133, 134, 139, 140, 143, 144, 149, 150, 153, 154,
+        140, 141, 144, 145, 150, 151, 154, 155, 160, 161, 164, 165, 170, 171, 174, 175,
+        175, 176, 179, 180, 185, 186, 189, 190, 195, 196, 199, 200, 205, 206, 209, 210,
+        120, 121, 124, 125, 130, 131, 134, 135, 140, 141, 144, 145, 150, 151, 154, 155,
+        155, 156, 159, 160, 165, 166, 169, 170, 175, 176, 179, 180, 185, 186, 189, 190,
+        176, 177, 180, 181, 186, 187, 190, 191, 196, 197, 200, 201, 206, 207, 210, 211,
+        211, 212, 215, 216, 221, 222, 225, 226, 231, 232, 235, 236, 241, 242, 245, 246,
+        204, 205, 208, 209, 214, 215, 218, 219, 224, 225, 228, 229, 234, 235, 238, 239,
+        239, 240, 243, 244, 249, 250, 253, 254, 259, 260, 263, 264, 269, 270, 273, 274,
+        260, 261, 264, 265, 270, 271, 274, 275, 280, 281, 284, 285, 290, 291, 294, 295,
+        295, 296, 299, 300, 305, 306, 309, 310, 315, 316, 319, 320, 325, 326, 329, 330
+    }
+};
+
+// First half of a symmetric low-pass that runs at twice the output rate. Together with the CIC
+// droop it is flat to 0.36 of the output rate and down 26dB at 0.6 of it. Coefficients sum to
+// 1 << 15 across both halves.
+static const int16_t fir_taps[PDM_DECIMATOR_TAPS / 2] = {
+    0, -1, 2, 17, -26, -96, 124, 320,
+    -377, -824, 909, 1876, -1943, -4419, 4048, 16774
+};
+
+bool pdm_decimator_init(pdm_decimator_t* self, uint16_t oversample) {
+    if (oversample < PDM_DECIMATOR_MIN_OVERSAMPLE || oversample > PDM_DECIMATOR_MAX_OVERSAMPLE ||
+        oversample % 16 != 0) {
+        return false;
+    }
+    // The byte tables decimate by 8 and the FIR by 2. The CIC does the rest.
+    self->decimation = oversample / 16;
+    // Scale the CIC output so a stream of all ones reaches 1 << 14 going into the FIR.
+    int32_t gain = 2048;
+    for (uint8_t i = 0; i < PDM_DECIMATOR_CIC_ORDER; i++) {
+        gain *= self->decimation;
+    }
+    self->scale = ((int64_t) 1 << 45) / gain;
+    pdm_decimator_reset(self);
+    return true;
+}
+
+void pdm_decimator_reset(pdm_decimator_t* self) {
+    // Alternating bits are silence so zero state settles immediately.
+    self->previous_word = 0xaaaaaaaa;
+    memset(self->integrator, 0, sizeof(self->integrator));
+    memset(self->comb, 0, sizeof(self->comb));
+    memset(self->history, 0, sizeof(self->history));
+    self->history_index = 0;
+    self->phase = 0;
+    self->odd = false;
+}
+
+uint32_t pdm_decimator_process(pdm_decimator_t* self, const uint32_t* words, uint32_t word_count,
+                               int16_t* output) {
+    uint32_t i0 = self->integrator[0];
+    uint32_t i1 = self->integrator[1];
+    uint32_t i2 = self->integrator[2];
+    uint32_t i3 = self->integrator[3];
+    uint32_t previous = self->previous_word;
+    uint8_t phase = self->phase;
+    uint32_t samples = 0;
+    for (uint32_t w = 0; w < word_count; w++) {
+        uint32_t word = words[w];
+        for (uint8_t shift = 8; shift <= 32; shift += 8) {
+            // The 32 most recent bits, ending at the byte that just arrived.
+            uint32_t bits = shift == 32 ? word : (previous << shift) | (word >> (32 - shift));
+            int32_t sum = byte_taps[0][bits >> 24] + byte_taps[1][(bits >> 16) & 0xff] +
+                          byte_taps[2][(bits >> 8) & 0xff] + byte_taps[3][bits & 0xff];
+            // The integrators wrap but the combs undo it because the output fits in 32 bits.
+            i0 += sum - 2048;
+            i1 += i0;
+            i2 += i1;
+            i3 += i2;
+            if (++phase < self->decimation) {
+                continue;
+            }
+            phase = 0;
+
+            uint32_t value = i3;
+            for (uint8_t i = 0; i < PDM_DECIMATOR_CIC_ORDER; i++) {
+                uint32_t delta = value - self->comb[i];
+                self->comb[i] = value;
+                value = delta;
+            }
+            int16_t sample = ((int64_t)(int32_t) value * self->scale) >> 31;
+            uint8_t index = self->history_index;
+            self->history[index] = sample;
+            self->history[index + PDM_DECIMATOR_TAPS] = sample;
+            self->history_index = (index + 1) % PDM_DECIMATOR_TAPS;
+
+            self->odd = !self->odd;
+            if (self->odd) {
+                continue;
+            }
+            const int16_t* window = self->history + self->history_index;
+            int32_t filtered = 1 << 13;
+            for (uint8_t i = 0; i < PDM_DECIMATOR_TAPS / 2; i++) {
+                filtered += fir_taps[i] * (window[i] + window[PDM_DECIMATOR_TAPS - 1 - i]);
+            }
+            filtered >>= 14;
+            if (filtered > INT16_MAX) {
+                filtered = INT16_MAX;
+            } else if (filtered < INT16_MIN) {
+                filtered = INT16_MIN;
+            }
+            output[samples++] = filtered;
+        }
+        previous = word;
+    }
+    self->integrator[0] = i0;
+    self->integrator[1] = i1;
+    self->integrator[2] = i2;
+    self->integrator[3] = i3;
+    self->previous_word = previous;
+    self->phase = phase;
+    return samples;
+}
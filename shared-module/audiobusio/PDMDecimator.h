@@ -0,0 +1,64 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOBUSIO_PDMDECIMATOR_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOBUSIO_PDMDECIMATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Converts a 1-bit PDM stream into signed 16-bit PCM. A fourth order CIC filter decimates to twice
+// the output rate, taking its first factor of 8 a byte at a time through lookup tables. A symmetric
+// FIR then flattens the CIC droop, low-passes and decimates by the final factor of two.
+#define PDM_DECIMATOR_MIN_OVERSAMPLE 32
+#define PDM_DECIMATOR_MAX_OVERSAMPLE 128
+#define PDM_DECIMATOR_CIC_ORDER 4
+#define PDM_DECIMATOR_TAPS 32
+
+typedef struct {
+    uint32_t previous_word;
+    uint32_t integrator[PDM_DECIMATOR_CIC_ORDER];
+    uint32_t comb[PDM_DECIMATOR_CIC_ORDER];
+    int32_t scale;
+    // Each value is stored twice so the FIR always sees the last PDM_DECIMATOR_TAPS values in order.
+    int16_t history[PDM_DECIMATOR_TAPS * 2];
+    uint8_t history_index;
+    uint8_t decimation; // PDM bytes per CIC output
+    uint8_t phase;
+    bool odd;
+} pdm_decimator_t;
+
+// Returns false when oversample isn't a multiple of 16 between the min and max above.
+bool pdm_decimator_init(pdm_decimator_t* self, uint16_t oversample);
+void pdm_decimator_reset(pdm_decimator_t* self);
+
+// Decimates word_count words of PDM bits, oldest bit in the most significant bit of each word.
+// Every oversample bits make one sample so output must hold word_count * 32 / oversample samples,
+// rounded up. Returns the number of samples written. State carries over between calls.
+uint32_t pdm_decimator_process(pdm_decimator_t* self, const uint32_t* words, uint32_t word_count,
+                               int16_t* output);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_AUDIOBUSIO_PDMDECIMATOR_H
@@ -35,6 +35,12 @@
 #include "shared-module/audiocore/WaveFile.h"
 #include "supervisor/shared/translate.h"
 
+// Wave files are read through FatFs.
+#if MICROPY_VFS_FAT
+
+// Enough for a file in seven fragments.
+#define WAVEFILE_CLUSTER_TABLE_SIZE (16)
+
 struct wave_format_chunk {
     uint16_t audio_format;
     uint16_t num_channels;
@@ -42,15 +48,41 @@ struct wave_format_chunk {
     uint32_t byte_rate;
     uint16_t block_align;
     uint16_t bits_per_sample;
-    uint16_t extra_params; // Assumed to be zero below.
+    uint16_t extra_params; // Zero for PCM and 2 for IMA ADPCM.
+    uint16_t samples_per_block; // Only present for IMA ADPCM.
+};
+
+#define WAVE_FORMAT_PCM (0x0001)
+#define WAVE_FORMAT_IMA_ADPCM (0x0011)
+
+static const uint16_t ima_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66,
+    73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+    449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767
+};
+
+static const int8_t ima_index_table[8] = {
+    -1, -1, -1, -1, 2, 4, 6, 8
 };
 
 void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
                                            pyb_file_obj_t* file,
                                            uint8_t *buffer,
-                                           size_t buffer_size) {
+                                           size_t buffer_size,
+                                           uint8_t buffer_count) {
     // Load the wave
     self->file = file;
+    self->cluster_table = NULL;
+    self->filled = 0;
+    self->started = false;
+    self->underruns = 0;
+    self->adpcm_block = NULL;
+    self->adpcm_block_align = 0;
+    self->adpcm_block_samples = 0;
+    self->adpcm_block_sample = 0;
     uint8_t chunk_header[16];
     f_rewind(&self->file->fp);
     UINT bytes_read;
@@ -77,9 +109,24 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
     if (bytes_read != format_size) {
     }
 
-    if (format.audio_format != 1 ||
+    if (format.audio_format == WAVE_FORMAT_IMA_ADPCM) {
+        // Blocks start with a header of one sample per channel followed by 4 bit deltas.
+        if (format_size != 20 ||
+            format.extra_params != 2 ||
+            format.num_channels < 1 ||
+            format.num_channels > 2 ||
+            format.bits_per_sample != 4 ||
+            format.block_align <= 4 * format.num_channels ||
+            (format.block_align % (4 * format.num_channels)) != 0) {
+            mp_raise_ValueError(translate("Unsupported format"));
+        }
+        self->adpcm_block_align = format.block_align;
+        // ADPCM is decoded to 16 bit samples.
+        format.bits_per_sample = 16;
+    } else if (format.audio_format != WAVE_FORMAT_PCM ||
         format.num_channels > 2 ||
         format.bits_per_sample > 16 ||
+        format_size > 18 ||
         (format_size == 18 &&
          format.extra_params != 0)) {
         mp_raise_ValueError(translate("Unsupported format"));
@@ -89,54 +136,79 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
     self->channel_count = format.num_channels;
     self->bits_per_sample = format.bits_per_sample;
 
-    // TODO(tannewt): Skip any extra chunks that occur before the data section.
-
-    uint8_t data_tag[4];
-    if (f_read(&self->file->fp, &data_tag, 4, &bytes_read) != FR_OK) {
-        mp_raise_OSError(MP_EIO);
-    }
-    if (bytes_read != 4 ||
-        memcmp((uint8_t *) data_tag, "data", 4) != 0) {
-        mp_raise_ValueError(translate("Data chunk must follow fmt chunk"));
-    }
-
+    // Skip any other chunks, such as the fact chunk of compressed files, until the data.
     uint32_t data_length;
-    if (f_read(&self->file->fp, &data_length, 4, &bytes_read) != FR_OK) {
-        mp_raise_OSError(MP_EIO);
-    }
-    if (bytes_read != 4) {
-        mp_raise_ValueError(translate("Invalid file"));
+    while (true) {
+        uint8_t chunk[8];
+        if (f_read(&self->file->fp, chunk, 8, &bytes_read) != FR_OK) {
+            mp_raise_OSError(MP_EIO);
+        }
+        if (bytes_read != 8) {
+            mp_raise_ValueError(translate("Invalid file"));
+        }
+        memcpy(&data_length, chunk + 4, 4);
+        if (memcmp(chunk, "data", 4) == 0) {
+            break;
+        }
+        // Chunks are padded to an even length.
+        if (f_lseek(&self->file->fp, self->file->fp.fptr + data_length + (data_length & 1)) != FR_OK) {
+            mp_raise_OSError(MP_EIO);
+        }
     }
     self->file_length = data_length;
     self->data_start = self->file->fp.fptr;
 
-    // Try to allocate two buffers, one will be loaded from file and the other
-    // DMAed to DAC.
+    // Split the buffers into a ring. One is loaded from file while another is DMAed to the DAC
+    // and any others are read ahead. Buffers of at least a sector are kept to whole sectors so that
+    // reads go straight from the disk into them.
+    self->buffer_count = buffer_count;
     if (buffer_size) {
-        self->len = buffer_size / 2;
+        self->len = buffer_size / buffer_count / sizeof(uint32_t) * sizeof(uint32_t);
+        if (self->len >= _MIN_SS) {
+            self->len = self->len / _MIN_SS * _MIN_SS;
+        }
         self->buffer = buffer;
-        self->second_buffer = buffer + self->len;
     } else {
-        self->len = 256;
-        self->buffer = m_malloc(self->len, false);
+        // Keep the original two small buffers unless read ahead was asked for.
+        self->len = buffer_count > 2 ? _MIN_SS : 256;
+        self->buffer = m_malloc(self->len * buffer_count, false);
         if (self->buffer == NULL) {
             common_hal_audioio_wavefile_deinit(self);
             mp_raise_msg(&mp_type_MemoryError,
-                         translate("Couldn't allocate first buffer"));
+                         translate("Couldn't allocate input buffer"));
         }
+    }
+    if (self->len == 0) {
+        mp_raise_ValueError(translate("Buffer too small"));
+    }
+    self->play_index = buffer_count - 1;
 
-        self->second_buffer = m_malloc(self->len, false);
-        if (self->second_buffer == NULL) {
-            common_hal_audioio_wavefile_deinit(self);
-            mp_raise_msg(&mp_type_MemoryError,
-                         translate("Couldn't allocate second buffer"));
+    if (self->adpcm_block_align != 0) {
+        self->adpcm_block = m_malloc(self->adpcm_block_align, false);
+    }
+
+    // Reading ahead is only worthwhile on slow storage, so use FatFs fast seek as well. It avoids
+    // walking the FAT to find clusters, both while reading and when seeking back to loop.
+    if (buffer_count > 2) {
+        self->cluster_table = m_malloc_maybe(WAVEFILE_CLUSTER_TABLE_SIZE * sizeof(DWORD), false);
+        if (self->cluster_table != NULL) {
+            self->cluster_table[0] = WAVEFILE_CLUSTER_TABLE_SIZE;
+            self->file->fp.cltbl = self->cluster_table;
+            if (f_lseek(&self->file->fp, CREATE_LINKMAP) != FR_OK) {
+                // Too fragmented to map in the table so read normally.
+                self->file->fp.cltbl = NULL;
+                self->cluster_table = NULL;
+            }
         }
     }
 }
 
 void common_hal_audioio_wavefile_deinit(audioio_wavefile_obj_t* self) {
+    if (self->cluster_table != NULL) {
+        self->file->fp.cltbl = NULL;
+        self->cluster_table = NULL;
+    }
     self->buffer = NULL;
-    self->second_buffer = NULL;
 }
 
 bool common_hal_audioio_wavefile_deinited(audioio_wavefile_obj_t* self) {
@@ -160,12 +232,16 @@ uint8_t common_hal_audioio_wavefile_get_channel_count(audioio_wavefile_obj_t* se
     return self->channel_count;
 }
 
+uint32_t common_hal_audioio_wavefile_get_underruns(audioio_wavefile_obj_t* self) {
+    return self->underruns;
+}
+
 bool audioio_wavefile_samples_signed(audioio_wavefile_obj_t* self) {
     return self->bits_per_sample > 8;
 }
 
 uint32_t audioio_wavefile_max_buffer_length(audioio_wavefile_obj_t* self) {
-    return 512;
+    return self->len;
 }
 
 void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t* self,
@@ -174,8 +250,12 @@ void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t* self,
     if (single_channel && channel == 1) {
         return;
     }
-    // We don't reset the buffer index in case we're looping and we have an odd number of buffer
-    // loads
+    // We don't reset the buffer index in case we're looping and the buffers handed out last are
+    // still being played. Anything read ahead is from the old position so drop it.
+    self->filled = 0;
+    self->started = false;
+    self->adpcm_block_sample = 0;
+    self->adpcm_block_samples = 0;
     self->bytes_remaining = self->file_length;
     f_lseek(&self->file->fp, self->data_start);
     self->read_count = 0;
@@ -183,6 +263,161 @@ void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t* self,
     self->right_read_count = 0;
 }
 
+static bool data_remaining(audioio_wavefile_obj_t* self) {
+    return self->bytes_remaining > 0 || self->adpcm_block_sample < self->adpcm_block_samples;
+}
+
+static inline int16_t decode_ima_nibble(audioio_wavefile_obj_t* self, uint8_t channel, uint8_t nibble) {
+    int32_t predictor = self->adpcm_predictor[channel];
+    uint8_t step_index = self->adpcm_step_index[channel];
+    int32_t step = ima_step_table[step_index];
+    int32_t diff = step >> 3;
+    if (nibble & 1) {
+        diff += step >> 2;
+    }
+    if (nibble & 2) {
+        diff += step >> 1;
+    }
+    if (nibble & 4) {
+        diff += step;
+    }
+    if (nibble & 8) {
+        predictor -= diff;
+        if (predictor < -32768) {
+            predictor = -32768;
+        }
+    } else {
+        predictor += diff;
+        if (predictor > 32767) {
+            predictor = 32767;
+        }
+    }
+    int8_t next_index = step_index + ima_index_table[nibble & 7];
+    if (next_index < 0) {
+        next_index = 0;
+    } else if (next_index > 88) {
+        next_index = 88;
+    }
+    self->adpcm_predictor[channel] = predictor;
+    self->adpcm_step_index[channel] = next_index;
+    return predictor;
+}
+
+// Decodes IMA ADPCM into a buffer of 16 bit frames, reading blocks from the file as they are used
+// up. Returns the number of bytes decoded, or -1 on a read error.
+static int32_t decode_ima_adpcm(audioio_wavefile_obj_t* self, int16_t* out, uint32_t frame_count) {
+    uint8_t channel_count = self->channel_count;
+    uint32_t frames = 0;
+    while (frames < frame_count) {
+        if (self->adpcm_block_sample >= self->adpcm_block_samples) {
+            if (self->bytes_remaining == 0) {
+                break;
+            }
+            uint32_t block_length = self->adpcm_block_align;
+            if (block_length > self->bytes_remaining) {
+                block_length = self->bytes_remaining;
+            }
+            UINT length_read;
+            if (f_read(&self->file->fp, self->adpcm_block, block_length, &length_read) != FR_OK || length_read != block_length) {
+                return -1;
+            }
+            self->bytes_remaining -= length_read;
+            if (length_read <= 4 * channel_count) {
+                // Too short to hold a sample.
+                self->adpcm_block_samples = 0;
+                continue;
+            }
+            // The header holds the first sample and every data byte holds two more per channel.
+            self->adpcm_block_samples = 1 + (length_read - 4 * channel_count) / channel_count * 2;
+            self->adpcm_block_sample = 0;
+        }
+
+        const uint8_t* block = self->adpcm_block;
+        if (self->adpcm_block_sample == 0) {
+            for (uint8_t c = 0; c < channel_count; c++) {
+                const uint8_t* header = block + 4 * c;
+                self->adpcm_predictor[c] = (int16_t) (header[0] | (header[1] << 8));
+                self->adpcm_step_index[c] = header[2] > 88 ? 88 : header[2];
+                *out++ = self->adpcm_predictor[c];
+            }
+            self->adpcm_block_sample = 1;
+            frames++;
+            continue;
+        }
+
+        // Channels take turns with four bytes, eight samples, of data each.
+        uint32_t remaining = MIN(frame_count - frames, self->adpcm_block_samples - self->adpcm_block_sample);
+        for (uint32_t i = 0; i < remaining; i++) {
+            uint32_t k = self->adpcm_block_sample - 1;
+            uint32_t offset = 4 * channel_count * (1 + k / 8) + (k % 8) / 2;
+            bool high = (k & 1) != 0;
+            for (uint8_t c = 0; c < channel_count; c++) {
+                uint8_t data = block[offset + 4 * c];
+                *out++ = decode_ima_nibble(self, c, high ? data >> 4 : data & 0xf);
+            }
+            self->adpcm_block_sample++;
+        }
+        frames += remaining;
+    }
+    return frames * channel_count * sizeof(int16_t);
+}
+
+// Reads the next chunk of the file into the buffer after the ones already read ahead.
+static bool load_next_buffer(audioio_wavefile_obj_t* self) {
+    uint8_t index = (self->play_index + 1 + self->filled) % self->buffer_count;
+    uint8_t* buffer = self->buffer + index * self->len;
+    if (self->adpcm_block != NULL) {
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wcast-align"
+        int32_t length = decode_ima_adpcm(self, (int16_t*) buffer, self->len / (self->channel_count * sizeof(int16_t)));
+        #pragma GCC diagnostic pop
+        if (length < 0) {
+            return false;
+        }
+        self->buffer_lengths[index] = length;
+        self->filled += 1;
+        return true;
+    }
+    uint32_t num_bytes_to_load = self->len;
+    // Line up the first read with a sector boundary so that later ones are whole sectors. Files
+    // whose data isn't word aligned are left alone so channels stay in place.
+    uint32_t misalignment = self->file->fp.fptr % _MIN_SS;
+    if (num_bytes_to_load >= _MIN_SS && misalignment % sizeof(uint32_t) == 0) {
+        num_bytes_to_load -= misalignment;
+    }
+    if (num_bytes_to_load > self->bytes_remaining) {
+        num_bytes_to_load = self->bytes_remaining;
+    }
+    UINT length_read;
+    if (f_read(&self->file->fp, buffer, num_bytes_to_load, &length_read) != FR_OK || length_read != num_bytes_to_load) {
+        return false;
+    }
+    self->bytes_remaining -= length_read;
+    // Pad the last buffer to word align it.
+    if (self->bytes_remaining == 0 && length_read % sizeof(uint32_t) != 0) {
+        uint32_t pad = sizeof(uint32_t) - length_read % sizeof(uint32_t);
+        if (self->bits_per_sample == 8) {
+            memset(buffer + length_read, 0x80, pad);
+        } else {
+            memset(buffer + length_read, 0, pad);
+        }
+        length_read += pad;
+    }
+    self->buffer_lengths[index] = length_read;
+    self->filled += 1;
+    return true;
+}
+
+void audioio_wavefile_background(audioio_wavefile_obj_t* self) {
+    // The last two buffers handed out may still be playing so leave them alone.
+    if (self->buffer == NULL || !data_remaining(self) || self->filled + 2 >= self->buffer_count) {
+        return;
+    }
+    // Only read one buffer at a time so other background tasks get a turn. A failed read is
+    // retried when playback catches up and reports the error.
+    load_next_buffer(self);
+}
+
 audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t* self,
                                                         bool single_channel,
                                                         uint8_t channel,
@@ -199,61 +434,33 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t*
 
     bool need_more_data = self->read_count == channel_read_count;
 
-    if (self->bytes_remaining == 0 && need_more_data) {
+    if (!data_remaining(self) && self->filled == 0 && need_more_data) {
         *buffer = NULL;
         *buffer_length = 0;
         return GET_BUFFER_DONE;
     }
 
     if (need_more_data) {
-        uint16_t num_bytes_to_load = self->len;
-        if (num_bytes_to_load > self->bytes_remaining) {
-            num_bytes_to_load = self->bytes_remaining;
-        }
-        UINT length_read;
-        if (self->buffer_index % 2 == 1) {
-            *buffer = self->second_buffer;
-        } else {
-            *buffer = self->buffer;
-        }
-        if (f_read(&self->file->fp, *buffer, num_bytes_to_load, &length_read) != FR_OK || length_read != num_bytes_to_load) {
-            return GET_BUFFER_ERROR;
-        }
-        self->bytes_remaining -= length_read;
-        // Pad the last buffer to word align it.
-        if (self->bytes_remaining == 0 && length_read % sizeof(uint32_t) != 0) {
-            uint32_t pad = length_read % sizeof(uint32_t);
-            length_read += pad;
-            if (self->bits_per_sample == 8) {
-                for (uint32_t i = 0; i < pad; i++) {
-                    ((uint8_t*) (*buffer))[length_read / sizeof(uint8_t) - i - 1] = 0x80;
-                }
-            } else if (self->bits_per_sample == 16) {
-                // We know the buffer is aligned because we allocated it onto the heap ourselves.
-                #pragma GCC diagnostic push
-                #pragma GCC diagnostic ignored "-Wcast-align"
-                ((int16_t*) (*buffer))[length_read / sizeof(int16_t) - 1] = 0;
-                #pragma GCC diagnostic pop
+        if (self->filled == 0) {
+            // Reading ahead didn't keep up so read now.
+            if (self->buffer_count > 2 && self->started) {
+                self->underruns += 1;
+            }
+            if (!load_next_buffer(self)) {
+                return GET_BUFFER_ERROR;
             }
         }
-        *buffer_length = length_read;
-        if (self->buffer_index % 2 == 1) {
-            self->second_buffer_length = length_read;
-        } else {
-            self->buffer_length = length_read;
-        }
-        self->buffer_index += 1;
+        self->play_index = (self->play_index + 1) % self->buffer_count;
+        self->filled -= 1;
+        self->started = true;
         self->read_count += 1;
     }
 
+    // The other channel may still be reading the buffer before this one.
     uint32_t buffers_back = self->read_count - 1 - channel_read_count;
-    if ((self->buffer_index - buffers_back) % 2 == 0) {
-        *buffer = self->second_buffer;
-        *buffer_length = self->second_buffer_length;
-    } else {
-        *buffer = self->buffer;
-        *buffer_length = self->buffer_length;
-    }
+    uint8_t index = (self->play_index + self->buffer_count - buffers_back) % self->buffer_count;
+    *buffer = self->buffer + index * self->len;
+    *buffer_length = self->buffer_lengths[index];
 
     if (channel == 0) {
         self->left_read_count += 1;
@@ -262,7 +469,7 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t*
         *buffer = *buffer + self->bits_per_sample / 8;
     }
 
-    return self->bytes_remaining == 0 ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
+    return !data_remaining(self) && self->filled == 0 ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
 }
 
 void audioio_wavefile_get_buffer_structure(audioio_wavefile_obj_t* self, bool single_channel,
@@ -270,10 +477,12 @@ void audioio_wavefile_get_buffer_structure(audioio_wavefile_obj_t* self, bool si
                                            uint32_t* max_buffer_length, uint8_t* spacing) {
     *single_buffer = false;
     *samples_signed = self->bits_per_sample > 8;
-    *max_buffer_length = 512;
+    *max_buffer_length = self->len;
     if (single_channel) {
         *spacing = self->channel_count;
     } else {
         *spacing = 1;
     }
 }
+
+#endif // MICROPY_VFS_FAT
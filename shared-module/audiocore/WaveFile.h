@@ -32,16 +32,22 @@
 
 #include "shared-module/audiocore/__init__.h"
 
+#define WAVEFILE_MAX_BUFFER_COUNT (8)
+
 typedef struct {
     mp_obj_base_t base;
+    // A ring of buffer_count buffers, each len bytes long. Buffers after play_index have been
+    // read ahead and are waiting to be played.
     uint8_t* buffer;
-    uint32_t buffer_length;
-    uint8_t* second_buffer;
-    uint32_t second_buffer_length;
+    uint32_t buffer_lengths[WAVEFILE_MAX_BUFFER_COUNT]; // Bytes of data in each buffer, up to len
+    uint8_t buffer_count;
+    uint8_t play_index; // The buffer most recently handed out
+    uint8_t filled; // Buffers read ahead of play_index
+    bool started; // A buffer has been handed out since the last reset
+    uint32_t underruns;
     uint32_t file_length; // In bytes
     uint16_t data_start; // Where the data values start
     uint8_t bits_per_sample;
-    uint16_t buffer_index;
     uint32_t bytes_remaining;
 
     uint8_t channel_count;
@@ -49,6 +55,15 @@ typedef struct {
 
     uint32_t len;
     pyb_file_obj_t* file;
+    DWORD* cluster_table; // FatFs fast seek table, or NULL when not used
+
+    // IMA ADPCM files are decoded a block at a time. adpcm_block is NULL for PCM files.
+    uint8_t* adpcm_block;
+    uint16_t adpcm_block_align; // Bytes per block
+    uint32_t adpcm_block_samples; // Samples per channel in the current block
+    uint32_t adpcm_block_sample; // Next sample to decode from the current block
+    int16_t adpcm_predictor[2];
+    uint8_t adpcm_step_index[2];
 
     uint32_t read_count;
     uint32_t left_read_count;
@@ -64,6 +79,9 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t*
                                                         uint8_t channel,
                                                         uint8_t** buffer,
                                                         uint32_t* buffer_length); // length in bytes
+void audioio_wavefile_background(audioio_wavefile_obj_t* self);
+bool audioio_wavefile_samples_signed(audioio_wavefile_obj_t* self);
+uint32_t audioio_wavefile_max_buffer_length(audioio_wavefile_obj_t* self);
 void audioio_wavefile_get_buffer_structure(audioio_wavefile_obj_t* self, bool single_channel,
                                            bool* single_buffer, bool* samples_signed,
                                            uint32_t* max_buffer_length, uint8_t* spacing);
@@ -35,18 +35,34 @@
 #include "shared-bindings/audiomixer/Mixer.h"
 #include "shared-module/audiomixer/Mixer.h"
 
+#include "shared-module/audiofx/__init__.h"
+
+#include "shared-bindings/synthio/Synthesizer.h"
+#include "shared-module/synthio/Synthesizer.h"
+
 uint32_t audiosample_sample_rate(mp_obj_t sample_obj) {
     if (MP_OBJ_IS_TYPE(sample_obj, &audioio_rawsample_type)) {
         audioio_rawsample_obj_t* sample = MP_OBJ_TO_PTR(sample_obj);
         return sample->sample_rate;
+    #if MICROPY_VFS_FAT
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_wavefile_type)) {
         audioio_wavefile_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         return file->sample_rate;
+    #endif
     #if CIRCUITPY_AUDIOMIXER
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audiomixer_mixer_type)) {
         audiomixer_mixer_obj_t* mixer = MP_OBJ_TO_PTR(sample_obj);
         return mixer->sample_rate;
     #endif
+    #if CIRCUITPY_AUDIOFX
+    } else if (audiofx_is_effect(sample_obj)) {
+        return audiofx_effect_get_sample_rate(MP_OBJ_TO_PTR(sample_obj));
+    #endif
+    #if CIRCUITPY_SYNTHIO
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &synthio_synthesizer_type)) {
+        synthio_synthesizer_obj_t* synth = MP_OBJ_TO_PTR(sample_obj);
+        return synth->sample_rate;
+    #endif
     }
     return 16000;
 }
@@ -55,14 +71,24 @@ uint8_t audiosample_bits_per_sample(mp_obj_t sample_obj) {
     if (MP_OBJ_IS_TYPE(sample_obj, &audioio_rawsample_type)) {
         audioio_rawsample_obj_t* sample = MP_OBJ_TO_PTR(sample_obj);
         return sample->bits_per_sample;
+    #if MICROPY_VFS_FAT
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_wavefile_type)) {
         audioio_wavefile_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         return file->bits_per_sample;
+    #endif
     #if CIRCUITPY_AUDIOMIXER
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audiomixer_mixer_type)) {
         audiomixer_mixer_obj_t* mixer = MP_OBJ_TO_PTR(sample_obj);
         return mixer->bits_per_sample;
     #endif
+    #if CIRCUITPY_AUDIOFX
+    } else if (audiofx_is_effect(sample_obj)) {
+        return 16;
+    #endif
+    #if CIRCUITPY_SYNTHIO
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &synthio_synthesizer_type)) {
+        return 16;
+    #endif
     }
     return 8;
 }
@@ -71,14 +97,25 @@ uint8_t audiosample_channel_count(mp_obj_t sample_obj) {
     if (MP_OBJ_IS_TYPE(sample_obj, &audioio_rawsample_type)) {
         audioio_rawsample_obj_t* sample = MP_OBJ_TO_PTR(sample_obj);
         return sample->channel_count;
+    #if MICROPY_VFS_FAT
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_wavefile_type)) {
         audioio_wavefile_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         return file->channel_count;
+    #endif
     #if CIRCUITPY_AUDIOMIXER
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audiomixer_mixer_type)) {
         audiomixer_mixer_obj_t* mixer = MP_OBJ_TO_PTR(sample_obj);
         return mixer->channel_count;
     #endif
+    #if CIRCUITPY_AUDIOFX
+    } else if (audiofx_is_effect(sample_obj)) {
+        audiofx_effect_obj_t* effect = MP_OBJ_TO_PTR(sample_obj);
+        return effect->channel_count;
+    #endif
+    #if CIRCUITPY_SYNTHIO
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &synthio_synthesizer_type)) {
+        return 1;
+    #endif
     }
     return 1;
 }
@@ -87,14 +124,24 @@ void audiosample_reset_buffer(mp_obj_t sample_obj, bool single_channel, uint8_t
     if (MP_OBJ_IS_TYPE(sample_obj, &audioio_rawsample_type)) {
         audioio_rawsample_obj_t* sample = MP_OBJ_TO_PTR(sample_obj);
         audioio_rawsample_reset_buffer(sample, single_channel, audio_channel);
+    #if MICROPY_VFS_FAT
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_wavefile_type)) {
         audioio_wavefile_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         audioio_wavefile_reset_buffer(file, single_channel, audio_channel);
+    #endif
     #if CIRCUITPY_AUDIOMIXER
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audiomixer_mixer_type)) {
         audiomixer_mixer_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         audiomixer_mixer_reset_buffer(file, single_channel, audio_channel);
     #endif
+    #if CIRCUITPY_AUDIOFX
+    } else if (audiofx_is_effect(sample_obj)) {
+        audiofx_effect_reset_buffer(MP_OBJ_TO_PTR(sample_obj), single_channel, audio_channel);
+    #endif
+    #if CIRCUITPY_SYNTHIO
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &synthio_synthesizer_type)) {
+        synthio_synthesizer_reset_buffer(MP_OBJ_TO_PTR(sample_obj), single_channel, audio_channel);
+    #endif
     }
 }
 
@@ -105,18 +152,48 @@ audioio_get_buffer_result_t audiosample_get_buffer(mp_obj_t sample_obj,
     if (MP_OBJ_IS_TYPE(sample_obj, &audioio_rawsample_type)) {
         audioio_rawsample_obj_t* sample = MP_OBJ_TO_PTR(sample_obj);
         return audioio_rawsample_get_buffer(sample, single_channel, channel, buffer, buffer_length);
+    #if MICROPY_VFS_FAT
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_wavefile_type)) {
         audioio_wavefile_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         return audioio_wavefile_get_buffer(file, single_channel, channel, buffer, buffer_length);
+    #endif
     #if CIRCUITPY_AUDIOMIXER
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audiomixer_mixer_type)) {
         audiomixer_mixer_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         return audiomixer_mixer_get_buffer(file, single_channel, channel, buffer, buffer_length);
     #endif
+    #if CIRCUITPY_AUDIOFX
+    } else if (audiofx_is_effect(sample_obj)) {
+        return audiofx_effect_get_buffer(MP_OBJ_TO_PTR(sample_obj), single_channel, channel, buffer, buffer_length);
+    #endif
+    #if CIRCUITPY_SYNTHIO
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &synthio_synthesizer_type)) {
+        return synthio_synthesizer_get_buffer(MP_OBJ_TO_PTR(sample_obj), single_channel, channel, buffer, buffer_length);
+    #endif
     }
     return GET_BUFFER_DONE;
 }
 
+void audiosample_background(mp_obj_t sample_obj) {
+    if (MP_OBJ_IS_TYPE(sample_obj, &audioio_rawsample_type)) {
+        // Raw samples are already in memory.
+    #if MICROPY_VFS_FAT
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_wavefile_type)) {
+        audioio_wavefile_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
+        audioio_wavefile_background(file);
+    #endif
+    #if CIRCUITPY_AUDIOMIXER
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audiomixer_mixer_type)) {
+        audiomixer_mixer_obj_t* mixer = MP_OBJ_TO_PTR(sample_obj);
+        audiomixer_mixer_background(mixer);
+    #endif
+    #if CIRCUITPY_AUDIOFX
+    } else if (audiofx_is_effect(sample_obj)) {
+        audiofx_effect_background(MP_OBJ_TO_PTR(sample_obj));
+    #endif
+    }
+}
+
 void audiosample_get_buffer_structure(mp_obj_t sample_obj, bool single_channel,
                                       bool* single_buffer, bool* samples_signed,
                                       uint32_t* max_buffer_length, uint8_t* spacing) {
@@ -124,15 +201,27 @@ void audiosample_get_buffer_structure(mp_obj_t sample_obj, bool single_channel,
         audioio_rawsample_obj_t* sample = MP_OBJ_TO_PTR(sample_obj);
         audioio_rawsample_get_buffer_structure(sample, single_channel, single_buffer,
                                                samples_signed, max_buffer_length, spacing);
+    #if MICROPY_VFS_FAT
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_wavefile_type)) {
         audioio_wavefile_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         audioio_wavefile_get_buffer_structure(file, single_channel, single_buffer, samples_signed,
                                               max_buffer_length, spacing);
+    #endif
     #if CIRCUITPY_AUDIOMIXER
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audiomixer_mixer_type)) {
         audiomixer_mixer_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         audiomixer_mixer_get_buffer_structure(file, single_channel, single_buffer, samples_signed,
                                               max_buffer_length, spacing);
     #endif
+    #if CIRCUITPY_AUDIOFX
+    } else if (audiofx_is_effect(sample_obj)) {
+        audiofx_effect_get_buffer_structure(MP_OBJ_TO_PTR(sample_obj), single_channel, single_buffer,
+                                            samples_signed, max_buffer_length, spacing);
+    #endif
+    #if CIRCUITPY_SYNTHIO
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &synthio_synthesizer_type)) {
+        synthio_synthesizer_get_buffer_structure(MP_OBJ_TO_PTR(sample_obj), single_channel, single_buffer,
+                                                 samples_signed, max_buffer_length, spacing);
+    #endif
     }
 }
@@ -46,6 +46,8 @@ audioio_get_buffer_result_t audiosample_get_buffer(mp_obj_t sample_obj,
                                                    bool single_channel,
                                                    uint8_t channel,
                                                    uint8_t** buffer, uint32_t* buffer_length);
+// Lets samples do slow work, such as reading ahead, after the output has been given its buffer.
+void audiosample_background(mp_obj_t sample_obj);
 void audiosample_get_buffer_structure(mp_obj_t sample_obj, bool single_channel,
                                       bool* single_buffer, bool* samples_signed,
                                       uint32_t* max_buffer_length, uint8_t* spacing);
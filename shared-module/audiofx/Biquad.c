@@ -0,0 +1,221 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audiofx/Biquad.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "py/runtime.h"
+
+// M_PI is not part of the math.h standard and may not be defined
+#define MP_PI MICROPY_FLOAT_CONST(3.14159265358979323846)
+
+#define COEFFICIENT_BITS 26
+
+static void biquad_process(audiofx_effect_obj_t* effect, int16_t* samples, uint32_t frame_count) {
+    audiofx_biquad_obj_t* self = (audiofx_biquad_obj_t*) effect;
+    uint8_t channel_count = effect->channel_count;
+    int32_t b0 = self->b0;
+    int32_t b1 = self->b1;
+    int32_t b2 = self->b2;
+    int32_t a1 = self->a1;
+    int32_t a2 = self->a2;
+    for (uint8_t c = 0; c < channel_count; c++) {
+        int32_t x1 = self->x1[c];
+        int32_t x2 = self->x2[c];
+        int32_t y1 = self->y1[c];
+        int32_t y2 = self->y2[c];
+        int64_t error = self->error[c];
+        int16_t* s = samples + c;
+        for (uint32_t i = 0; i < frame_count; i++) {
+            int32_t x0 = *s;
+            // Direct form I. Carrying the truncated fraction over to the next sample keeps low
+            // frequency filters from getting stuck or drifting.
+            int64_t acc = (int64_t) b0 * x0 + (int64_t) b1 * x1 + (int64_t) b2 * x2 -
+                (int64_t) a1 * y1 - (int64_t) a2 * y2 + error;
+            int32_t y0 = acc >> COEFFICIENT_BITS;
+            error = acc - ((int64_t) y0 << COEFFICIENT_BITS);
+            if (y0 > INT16_MAX) {
+                y0 = INT16_MAX;
+                error = 0;
+            } else if (y0 < INT16_MIN) {
+                y0 = INT16_MIN;
+                error = 0;
+            }
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            *s = y0;
+            s += channel_count;
+        }
+        self->x1[c] = x1;
+        self->x2[c] = x2;
+        self->y1[c] = y1;
+        self->y2[c] = y2;
+        self->error[c] = error;
+    }
+}
+
+// Computes the coefficients from the Audio EQ Cookbook by Robert Bristow-Johnson.
+static void update_coefficients(audiofx_biquad_obj_t* self) {
+    mp_float_t w0 = 2 * MP_PI * self->frequency / audiofx_effect_get_sample_rate(&self->effect);
+    mp_float_t cos_w0 = MICROPY_FLOAT_C_FUN(cos)(w0);
+    mp_float_t alpha = MICROPY_FLOAT_C_FUN(sin)(w0) / (2 * self->q);
+    mp_float_t a = MICROPY_FLOAT_C_FUN(pow)(10, self->gain / 40);
+    mp_float_t sqrt_a_alpha = 2 * MICROPY_FLOAT_C_FUN(sqrt)(a) * alpha;
+    mp_float_t b0, b1, b2, a0, a1, a2;
+    switch (self->kind) {
+        case AUDIOFX_BIQUAD_LOW_PASS:
+            b1 = 1 - cos_w0;
+            b0 = b1 / 2;
+            b2 = b0;
+            a0 = 1 + alpha;
+            a1 = -2 * cos_w0;
+            a2 = 1 - alpha;
+            break;
+        case AUDIOFX_BIQUAD_HIGH_PASS:
+            b1 = -(1 + cos_w0);
+            b0 = -b1 / 2;
+            b2 = b0;
+            a0 = 1 + alpha;
+            a1 = -2 * cos_w0;
+            a2 = 1 - alpha;
+            break;
+        case AUDIOFX_BIQUAD_BAND_PASS:
+            b0 = alpha;
+            b1 = 0;
+            b2 = -alpha;
+            a0 = 1 + alpha;
+            a1 = -2 * cos_w0;
+            a2 = 1 - alpha;
+            break;
+        case AUDIOFX_BIQUAD_NOTCH:
+            b0 = 1;
+            b1 = -2 * cos_w0;
+            b2 = 1;
+            a0 = 1 + alpha;
+            a1 = -2 * cos_w0;
+            a2 = 1 - alpha;
+            break;
+        case AUDIOFX_BIQUAD_PEAKING:
+            b0 = 1 + alpha * a;
+            b1 = -2 * cos_w0;
+            b2 = 1 - alpha * a;
+            a0 = 1 + alpha / a;
+            a1 = -2 * cos_w0;
+            a2 = 1 - alpha / a;
+            break;
+        case AUDIOFX_BIQUAD_LOW_SHELF:
+            b0 = a * ((a + 1) - (a - 1) * cos_w0 + sqrt_a_alpha);
+            b1 = 2 * a * ((a - 1) - (a + 1) * cos_w0);
+            b2 = a * ((a + 1) - (a - 1) * cos_w0 - sqrt_a_alpha);
+            a0 = (a + 1) + (a - 1) * cos_w0 + sqrt_a_alpha;
+            a1 = -2 * ((a - 1) + (a + 1) * cos_w0);
+            a2 = (a + 1) + (a - 1) * cos_w0 - sqrt_a_alpha;
+            break;
+        case AUDIOFX_BIQUAD_HIGH_SHELF:
+        default:
+            b0 = a * ((a + 1) + (a - 1) * cos_w0 + sqrt_a_alpha);
+            b1 = -2 * a * ((a - 1) + (a + 1) * cos_w0);
+            b2 = a * ((a + 1) + (a - 1) * cos_w0 - sqrt_a_alpha);
+            a0 = (a + 1) - (a - 1) * cos_w0 + sqrt_a_alpha;
+            a1 = 2 * ((a - 1) - (a + 1) * cos_w0);
+            a2 = (a + 1) - (a - 1) * cos_w0 - sqrt_a_alpha;
+            break;
+    }
+    mp_float_t scale = (1 << COEFFICIENT_BITS) / a0;
+    self->b0 = MICROPY_FLOAT_C_FUN(nearbyint)(b0 * scale);
+    self->b1 = MICROPY_FLOAT_C_FUN(nearbyint)(b1 * scale);
+    self->b2 = MICROPY_FLOAT_C_FUN(nearbyint)(b2 * scale);
+    self->a1 = MICROPY_FLOAT_C_FUN(nearbyint)(a1 * scale);
+    self->a2 = MICROPY_FLOAT_C_FUN(nearbyint)(a2 * scale);
+}
+
+void common_hal_audiofx_biquad_construct(audiofx_biquad_obj_t* self, mp_obj_t sample,
+                                         audiofx_biquad_kind_t kind, mp_float_t frequency,
+                                         mp_float_t q, mp_float_t gain, uint32_t buffer_size) {
+    audiofx_effect_construct(&self->effect, sample, buffer_size, biquad_process);
+    self->kind = kind;
+    self->frequency = frequency;
+    self->q = q;
+    self->gain = gain;
+    memset(self->x1, 0, sizeof(self->x1));
+    memset(self->x2, 0, sizeof(self->x2));
+    memset(self->y1, 0, sizeof(self->y1));
+    memset(self->y2, 0, sizeof(self->y2));
+    memset(self->error, 0, sizeof(self->error));
+    update_coefficients(self);
+}
+
+void common_hal_audiofx_biquad_deinit(audiofx_biquad_obj_t* self) {
+    audiofx_effect_deinit(&self->effect);
+}
+
+bool common_hal_audiofx_biquad_deinited(audiofx_biquad_obj_t* self) {
+    return audiofx_effect_deinited(&self->effect);
+}
+
+uint32_t common_hal_audiofx_biquad_get_sample_rate(audiofx_biquad_obj_t* self) {
+    return audiofx_effect_get_sample_rate(&self->effect);
+}
+
+audiofx_biquad_kind_t common_hal_audiofx_biquad_get_kind(audiofx_biquad_obj_t* self) {
+    return self->kind;
+}
+
+void common_hal_audiofx_biquad_set_kind(audiofx_biquad_obj_t* self, audiofx_biquad_kind_t kind) {
+    self->kind = kind;
+    update_coefficients(self);
+}
+
+mp_float_t common_hal_audiofx_biquad_get_frequency(audiofx_biquad_obj_t* self) {
+    return self->frequency;
+}
+
+void common_hal_audiofx_biquad_set_frequency(audiofx_biquad_obj_t* self, mp_float_t frequency) {
+    self->frequency = frequency;
+    update_coefficients(self);
+}
+
+mp_float_t common_hal_audiofx_biquad_get_q(audiofx_biquad_obj_t* self) {
+    return self->q;
+}
+
+void common_hal_audiofx_biquad_set_q(audiofx_biquad_obj_t* self, mp_float_t q) {
+    self->q = q;
+    update_coefficients(self);
+}
+
+mp_float_t common_hal_audiofx_biquad_get_gain(audiofx_biquad_obj_t* self) {
+    return self->gain;
+}
+
+void common_hal_audiofx_biquad_set_gain(audiofx_biquad_obj_t* self, mp_float_t gain) {
+    self->gain = gain;
+    update_coefficients(self);
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOFX_BIQUAD_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOFX_BIQUAD_H
+
+#include "shared-module/audiofx/__init__.h"
+
+typedef enum {
+    AUDIOFX_BIQUAD_LOW_PASS,
+    AUDIOFX_BIQUAD_HIGH_PASS,
+    AUDIOFX_BIQUAD_BAND_PASS,
+    AUDIOFX_BIQUAD_NOTCH,
+    AUDIOFX_BIQUAD_PEAKING,
+    AUDIOFX_BIQUAD_LOW_SHELF,
+    AUDIOFX_BIQUAD_HIGH_SHELF,
+} audiofx_biquad_kind_t;
+
+typedef struct {
+    audiofx_effect_obj_t effect;
+    audiofx_biquad_kind_t kind;
+    mp_float_t frequency;
+    mp_float_t q;
+    mp_float_t gain; // in dB, only used by peaking and shelf filters
+    // Coefficients normalized by a0 in 6.26 fixed point.
+    int32_t b0;
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+    // Per channel history.
+    int16_t x1[2];
+    int16_t x2[2];
+    int16_t y1[2];
+    int16_t y2[2];
+    int32_t error[2]; // fraction dropped from the last output, fed into the next one
+} audiofx_biquad_obj_t;
+
+#endif  // MICROPY_INCLUDED_SHARED_MODULE_AUDIOFX_BIQUAD_H
@@ -0,0 +1,139 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audiofx/Envelope.h"
+
+#include "py/runtime.h"
+
+static uint32_t time_to_frames(audiofx_envelope_obj_t* self, mp_float_t seconds) {
+    return audiofx_effect_seconds_to_frames(&self->effect, seconds);
+}
+
+// Moves on to the next stage once the current stage's ramp has finished.
+static void next_stage(audiofx_envelope_obj_t* self) {
+    switch (self->state) {
+        case AUDIOFX_ENVELOPE_ATTACK:
+            self->state = AUDIOFX_ENVELOPE_DECAY;
+            audiofx_ramp_start(&self->ramp, self->sustain_level, time_to_frames(self, self->decay_time), true);
+            break;
+        case AUDIOFX_ENVELOPE_DECAY:
+            self->state = AUDIOFX_ENVELOPE_SUSTAIN;
+            break;
+        case AUDIOFX_ENVELOPE_RELEASE:
+            self->state = AUDIOFX_ENVELOPE_IDLE;
+            break;
+        default:
+            break;
+    }
+}
+
+static void envelope_process(audiofx_effect_obj_t* effect, int16_t* samples, uint32_t frame_count) {
+    audiofx_envelope_obj_t* self = (audiofx_envelope_obj_t*) effect;
+    uint8_t channel_count = effect->channel_count;
+    while (frame_count > 0) {
+        if (self->ramp.frames == 0) {
+            next_stage(self);
+        }
+        uint32_t n = audiofx_ramp_apply(&self->ramp, samples, frame_count, channel_count);
+        samples += n * channel_count;
+        frame_count -= n;
+    }
+}
+
+void common_hal_audiofx_envelope_construct(audiofx_envelope_obj_t* self, mp_obj_t sample,
+                                           mp_float_t attack_time, mp_float_t decay_time,
+                                           mp_float_t sustain_level, mp_float_t release_time,
+                                           uint32_t buffer_size) {
+    audiofx_effect_construct(&self->effect, sample, buffer_size, envelope_process);
+    self->attack_time = attack_time;
+    self->decay_time = decay_time;
+    self->sustain_level = sustain_level;
+    self->release_time = release_time;
+    self->state = AUDIOFX_ENVELOPE_IDLE;
+    audiofx_ramp_set(&self->ramp, 0);
+}
+
+void common_hal_audiofx_envelope_deinit(audiofx_envelope_obj_t* self) {
+    audiofx_effect_deinit(&self->effect);
+}
+
+bool common_hal_audiofx_envelope_deinited(audiofx_envelope_obj_t* self) {
+    return audiofx_effect_deinited(&self->effect);
+}
+
+uint32_t common_hal_audiofx_envelope_get_sample_rate(audiofx_envelope_obj_t* self) {
+    return audiofx_effect_get_sample_rate(&self->effect);
+}
+
+void common_hal_audiofx_envelope_press(audiofx_envelope_obj_t* self) {
+    self->state = AUDIOFX_ENVELOPE_ATTACK;
+    audiofx_ramp_start(&self->ramp, 1, time_to_frames(self, self->attack_time), false);
+}
+
+void common_hal_audiofx_envelope_release(audiofx_envelope_obj_t* self) {
+    self->state = AUDIOFX_ENVELOPE_RELEASE;
+    audiofx_ramp_start(&self->ramp, 0, time_to_frames(self, self->release_time), true);
+}
+
+mp_float_t common_hal_audiofx_envelope_get_level(audiofx_envelope_obj_t* self) {
+    return audiofx_ramp_get(&self->ramp);
+}
+
+bool common_hal_audiofx_envelope_get_active(audiofx_envelope_obj_t* self) {
+    return self->state != AUDIOFX_ENVELOPE_IDLE;
+}
+
+mp_float_t common_hal_audiofx_envelope_get_attack_time(audiofx_envelope_obj_t* self) {
+    return self->attack_time;
+}
+
+void common_hal_audiofx_envelope_set_attack_time(audiofx_envelope_obj_t* self, mp_float_t attack_time) {
+    self->attack_time = attack_time;
+}
+
+mp_float_t common_hal_audiofx_envelope_get_decay_time(audiofx_envelope_obj_t* self) {
+    return self->decay_time;
+}
+
+void common_hal_audiofx_envelope_set_decay_time(audiofx_envelope_obj_t* self, mp_float_t decay_time) {
+    self->decay_time = decay_time;
+}
+
+mp_float_t common_hal_audiofx_envelope_get_sustain_level(audiofx_envelope_obj_t* self) {
+    return self->sustain_level;
+}
+
+void common_hal_audiofx_envelope_set_sustain_level(audiofx_envelope_obj_t* self, mp_float_t sustain_level) {
+    self->sustain_level = sustain_level;
+}
+
+mp_float_t common_hal_audiofx_envelope_get_release_time(audiofx_envelope_obj_t* self) {
+    return self->release_time;
+}
+
+void common_hal_audiofx_envelope_set_release_time(audiofx_envelope_obj_t* self, mp_float_t release_time) {
+    self->release_time = release_time;
+}
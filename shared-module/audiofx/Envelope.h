@@ -0,0 +1,50 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOFX_ENVELOPE_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOFX_ENVELOPE_H
+
+#include "shared-module/audiofx/__init__.h"
+
+typedef enum {
+    AUDIOFX_ENVELOPE_IDLE,
+    AUDIOFX_ENVELOPE_ATTACK,
+    AUDIOFX_ENVELOPE_DECAY,
+    AUDIOFX_ENVELOPE_SUSTAIN,
+    AUDIOFX_ENVELOPE_RELEASE,
+} audiofx_envelope_state_t;
+
+typedef struct {
+    audiofx_effect_obj_t effect;
+    audiofx_ramp_t ramp;
+    audiofx_envelope_state_t state;
+    mp_float_t attack_time;
+    mp_float_t decay_time;
+    mp_float_t sustain_level;
+    mp_float_t release_time;
+} audiofx_envelope_obj_t;
+
+#endif  // MICROPY_INCLUDED_SHARED_MODULE_AUDIOFX_ENVELOPE_H
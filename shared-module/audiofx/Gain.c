@@ -0,0 +1,75 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audiofx/Gain.h"
+
+#include "py/runtime.h"
+
+static void gain_process(audiofx_effect_obj_t* effect, int16_t* samples, uint32_t frame_count) {
+    audiofx_gain_obj_t* self = (audiofx_gain_obj_t*) effect;
+    uint8_t channel_count = effect->channel_count;
+    while (frame_count > 0) {
+        uint32_t n = audiofx_ramp_apply(&self->ramp, samples, frame_count, channel_count);
+        samples += n * channel_count;
+        frame_count -= n;
+    }
+}
+
+void common_hal_audiofx_gain_construct(audiofx_gain_obj_t* self, mp_obj_t sample, mp_float_t level,
+                                       uint32_t buffer_size) {
+    audiofx_effect_construct(&self->effect, sample, buffer_size, gain_process);
+    audiofx_ramp_set(&self->ramp, level);
+}
+
+void common_hal_audiofx_gain_deinit(audiofx_gain_obj_t* self) {
+    audiofx_effect_deinit(&self->effect);
+}
+
+bool common_hal_audiofx_gain_deinited(audiofx_gain_obj_t* self) {
+    return audiofx_effect_deinited(&self->effect);
+}
+
+uint32_t common_hal_audiofx_gain_get_sample_rate(audiofx_gain_obj_t* self) {
+    return audiofx_effect_get_sample_rate(&self->effect);
+}
+
+mp_float_t common_hal_audiofx_gain_get_level(audiofx_gain_obj_t* self) {
+    return audiofx_ramp_get(&self->ramp);
+}
+
+void common_hal_audiofx_gain_set_level(audiofx_gain_obj_t* self, mp_float_t level) {
+    audiofx_ramp_set(&self->ramp, level);
+}
+
+void common_hal_audiofx_gain_ramp(audiofx_gain_obj_t* self, mp_float_t level, mp_float_t duration,
+                                  bool exponential) {
+    uint32_t frames = audiofx_effect_seconds_to_frames(&self->effect, duration);
+    audiofx_ramp_start(&self->ramp, level, frames, exponential);
+}
+
+bool common_hal_audiofx_gain_get_ramping(audiofx_gain_obj_t* self) {
+    return self->ramp.frames != 0;
+}
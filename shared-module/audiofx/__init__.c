@@ -0,0 +1,313 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-module/audiofx/__init__.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-bindings/audiofx/Biquad.h"
+#include "shared-bindings/audiofx/Envelope.h"
+#include "shared-bindings/audiofx/Gain.h"
+#include "supervisor/shared/translate.h"
+
+// Unity gain for ramps.
+#define RAMP_FULL (1u << 30)
+// Exponential ramps never reach silence so they go to about -80dB and then jump to the target.
+#define RAMP_FLOOR (RAMP_FULL / 10000)
+
+void audiofx_effect_construct(audiofx_effect_obj_t* self, mp_obj_t sample, uint32_t buffer_size,
+                              audiofx_process_t process) {
+    bool single_buffer;
+    bool samples_signed;
+    uint32_t max_buffer_length;
+    uint8_t spacing;
+    audiosample_get_buffer_structure(sample, false, &single_buffer, &samples_signed,
+                                     &max_buffer_length, &spacing);
+    uint8_t bits_per_sample = audiosample_bits_per_sample(sample);
+    uint8_t channel_count = audiosample_channel_count(sample);
+    if ((bits_per_sample != 8 && bits_per_sample != 16) || channel_count < 1 || channel_count > 2) {
+        mp_raise_ValueError(translate("Sample must be 8 or 16 bit with 1 or 2 channels"));
+    }
+
+    self->len = buffer_size / 2 / sizeof(uint32_t) * sizeof(uint32_t);
+
+    self->first_buffer = m_malloc(self->len, false);
+    if (self->first_buffer == NULL) {
+        audiofx_effect_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate first buffer"));
+    }
+
+    self->second_buffer = m_malloc(self->len, false);
+    if (self->second_buffer == NULL) {
+        audiofx_effect_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate second buffer"));
+    }
+
+    self->sample = sample;
+    self->process = process;
+    self->source_signed = samples_signed;
+    self->source_bits_per_sample = bits_per_sample;
+    self->channel_count = channel_count;
+    audiofx_effect_reset_buffer(self, false, 0);
+}
+
+void audiofx_effect_deinit(audiofx_effect_obj_t* self) {
+    self->first_buffer = NULL;
+    self->second_buffer = NULL;
+    self->sample = MP_OBJ_NULL;
+}
+
+bool audiofx_effect_deinited(audiofx_effect_obj_t* self) {
+    return self->first_buffer == NULL;
+}
+
+uint32_t audiofx_effect_get_sample_rate(audiofx_effect_obj_t* self) {
+    return audiosample_sample_rate(self->sample);
+}
+
+uint32_t audiofx_effect_seconds_to_frames(audiofx_effect_obj_t* self, mp_float_t seconds) {
+    // Clamp before converting because long durations don't fit. Ramps divide by the frame count
+    // as a signed value so stay within INT32_MAX.
+    mp_float_t frames = seconds * audiofx_effect_get_sample_rate(self);
+    if (!(frames > 0)) {
+        return 0;
+    }
+    if (frames >= (mp_float_t) INT32_MAX) {
+        return INT32_MAX;
+    }
+    return frames;
+}
+
+bool audiofx_is_effect(mp_obj_t obj) {
+    return MP_OBJ_IS_TYPE(obj, &audiofx_biquad_type) ||
+        MP_OBJ_IS_TYPE(obj, &audiofx_envelope_type) ||
+        MP_OBJ_IS_TYPE(obj, &audiofx_gain_type);
+}
+
+void audiofx_effect_reset_buffer(audiofx_effect_obj_t* self,
+                                 bool single_channel,
+                                 uint8_t channel) {
+    if (single_channel && channel == 1) {
+        return;
+    }
+    audiosample_reset_buffer(self->sample, false, 0);
+    self->source_length = 0;
+    self->more_data = true;
+    self->done = false;
+    self->use_first_buffer = true;
+    self->read_count = 0;
+    self->left_read_count = 0;
+    self->right_read_count = 0;
+}
+
+// Copies as many source frames as fit into out as signed 16 bit samples. Returns the frame count.
+static uint32_t read_frames(audiofx_effect_obj_t* self, int16_t* out) {
+    uint8_t bytes_per_sample = self->source_bits_per_sample / 8;
+    uint8_t frame_size = bytes_per_sample * self->channel_count;
+    uint32_t frame_count = self->len / (sizeof(int16_t) * self->channel_count);
+    uint16_t flip = self->source_signed ? 0 : 0x8000;
+    uint32_t frames = 0;
+    while (frames < frame_count) {
+        if (self->source_length < frame_size) {
+            if (!self->more_data) {
+                break;
+            }
+            audioio_get_buffer_result_t result = audiosample_get_buffer(self->sample, false, 0, &self->source_buffer, &self->source_length);
+            if (result == GET_BUFFER_ERROR) {
+                self->source_length = 0;
+                self->more_data = false;
+                break;
+            }
+            self->more_data = result == GET_BUFFER_MORE_DATA;
+            continue;
+        }
+        uint32_t n = MIN(frame_count - frames, self->source_length / frame_size);
+        uint32_t sample_count = n * self->channel_count;
+        int16_t* o = out + frames * self->channel_count;
+        if (bytes_per_sample == 2) {
+            memcpy(o, self->source_buffer, sample_count * sizeof(int16_t));
+            if (flip != 0) {
+                for (uint32_t i = 0; i < sample_count; i++) {
+                    o[i] ^= flip;
+                }
+            }
+        } else {
+            for (uint32_t i = 0; i < sample_count; i++) {
+                o[i] = (self->source_buffer[i] << 8) ^ flip;
+            }
+        }
+        self->source_buffer += n * frame_size;
+        self->source_length -= n * frame_size;
+        frames += n;
+    }
+    return frames;
+}
+
+audioio_get_buffer_result_t audiofx_effect_get_buffer(audiofx_effect_obj_t* self,
+                                                      bool single_channel,
+                                                      uint8_t channel,
+                                                      uint8_t** buffer,
+                                                      uint32_t* buffer_length) {
+    if (!single_channel) {
+        channel = 0;
+    }
+
+    uint32_t channel_read_count = self->left_read_count;
+    if (channel == 1) {
+        channel_read_count = self->right_read_count;
+    }
+
+    bool need_more_data = self->read_count == channel_read_count;
+    if (need_more_data) {
+        int16_t* out;
+        if (self->use_first_buffer) {
+            out = self->first_buffer;
+        } else {
+            out = self->second_buffer;
+        }
+        self->use_first_buffer = !self->use_first_buffer;
+        *buffer = (uint8_t*) out;
+
+        uint32_t frames = read_frames(self, out);
+        if (frames > 0) {
+            self->process(self, out, frames);
+        }
+        self->buffer_length = frames * self->channel_count * sizeof(int16_t);
+        self->done = !self->more_data && self->source_length < self->source_bits_per_sample / 8 * self->channel_count;
+        self->read_count += 1;
+    } else if (!self->use_first_buffer) {
+        *buffer = (uint8_t*) self->first_buffer;
+    } else {
+        *buffer = (uint8_t*) self->second_buffer;
+    }
+    *buffer_length = self->buffer_length;
+
+    if (channel == 0) {
+        self->left_read_count += 1;
+    } else if (channel == 1) {
+        self->right_read_count += 1;
+        *buffer = *buffer + sizeof(int16_t);
+    }
+    return self->done ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
+}
+
+void audiofx_effect_background(audiofx_effect_obj_t* self) {
+    audiosample_background(self->sample);
+}
+
+void audiofx_effect_get_buffer_structure(audiofx_effect_obj_t* self, bool single_channel,
+                                         bool* single_buffer, bool* samples_signed,
+                                         uint32_t* max_buffer_length, uint8_t* spacing) {
+    *single_buffer = false;
+    *samples_signed = true;
+    *max_buffer_length = self->len;
+    if (single_channel) {
+        *spacing = self->channel_count;
+    } else {
+        *spacing = 1;
+    }
+}
+
+void audiofx_ramp_set(audiofx_ramp_t* ramp, mp_float_t level) {
+    // Stop any ramp first so a buffer being filled doesn't continue it.
+    ramp->frames = 0;
+    ramp->level = level * RAMP_FULL;
+    ramp->target = ramp->level;
+}
+
+mp_float_t audiofx_ramp_get(audiofx_ramp_t* ramp) {
+    return (mp_float_t) ramp->level / RAMP_FULL;
+}
+
+void audiofx_ramp_start(audiofx_ramp_t* ramp, mp_float_t target, uint32_t frames, bool exponential) {
+    if (frames == 0) {
+        audiofx_ramp_set(ramp, target);
+        return;
+    }
+    ramp->frames = 0;
+    ramp->target = target * RAMP_FULL;
+    if (exponential) {
+        uint32_t from = MAX(ramp->level, RAMP_FLOOR);
+        uint32_t to = MAX(ramp->target, RAMP_FLOOR);
+        mp_float_t ratio = MICROPY_FLOAT_C_FUN(pow)((mp_float_t) to / from, (mp_float_t) 1 / frames) * RAMP_FULL;
+        // Short ramps up from silence grow 4x or more each frame, which a 2.30 ratio can't hold,
+        // so they run linearly instead.
+        if (ratio < UINT32_MAX) {
+            ramp->level = from;
+            ramp->step = 0;
+            ramp->ratio = ratio;
+            ramp->frames = frames;
+            return;
+        }
+    }
+    ramp->ratio = 0;
+    ramp->step = ((int64_t) ramp->target - ramp->level) / (int32_t) frames;
+    ramp->frames = frames;
+}
+
+uint32_t audiofx_ramp_apply(audiofx_ramp_t* ramp, int16_t* samples, uint32_t frame_count,
+                            uint8_t channel_count) {
+    uint32_t level = ramp->level;
+    if (ramp->frames == 0) {
+        uint32_t sample_count = frame_count * channel_count;
+        if (level == 0) {
+            memset(samples, 0, sample_count * sizeof(int16_t));
+        } else if (level != RAMP_FULL) {
+            // 16.16 fixed point so a full gain can't overflow the product.
+            int32_t gain = level >> 14;
+            for (uint32_t i = 0; i < sample_count; i++) {
+                samples[i] = (samples[i] * gain) >> 16;
+            }
+        }
+        return frame_count;
+    }
+
+    uint32_t n = MIN(ramp->frames, frame_count);
+    uint32_t ratio = ramp->ratio;
+    int32_t step = ramp->step;
+    for (uint32_t i = 0; i < n; i++) {
+        if (ratio != 0) {
+            level = ((uint64_t) level * ratio + (1 << 29)) >> 30;
+            // Rounding may creep past full level on the way up.
+            level = MIN(level, RAMP_FULL);
+        } else {
+            level += step;
+        }
+        int32_t gain = level >> 14;
+        for (uint8_t c = 0; c < channel_count; c++) {
+            samples[c] = (samples[c] * gain) >> 16;
+        }
+        samples += channel_count;
+    }
+    ramp->frames -= n;
+    if (ramp->frames == 0) {
+        level = ramp->target;
+    }
+    ramp->level = level;
+    return n;
+}
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOFX__INIT__H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOFX__INIT__H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+
+#include "shared-module/audiocore/__init__.h"
+
+struct _audiofx_effect_obj_t;
+
+// Processes frame_count interleaved signed 16 bit frames in place.
+typedef void (*audiofx_process_t)(struct _audiofx_effect_obj_t* self, int16_t* samples, uint32_t frame_count);
+
+// Every effect object starts with this so that the audio outputs can play them all the same way.
+// Effects output signed 16 bit samples at the source's sample rate and channel count.
+typedef struct _audiofx_effect_obj_t {
+    mp_obj_base_t base;
+    mp_obj_t sample;
+    audiofx_process_t process;
+    int16_t* first_buffer;
+    int16_t* second_buffer;
+    uint32_t len; // in bytes
+    uint32_t buffer_length; // bytes filled in the current buffer
+    bool use_first_buffer;
+    bool more_data;
+    bool done;
+    bool source_signed;
+    uint8_t source_bits_per_sample;
+    uint8_t channel_count;
+    uint8_t* source_buffer;
+    uint32_t source_length; // in bytes
+
+    uint32_t read_count;
+    uint32_t left_read_count;
+    uint32_t right_read_count;
+} audiofx_effect_obj_t;
+
+// A gain that moves towards a target level one frame at a time.
+typedef struct {
+    uint32_t level; // 2.30 fixed point
+    uint32_t target; // 2.30 fixed point
+    int32_t step; // added to level each frame of a linear ramp
+    uint32_t ratio; // 2.30 fixed point multiplier each frame of an exponential ramp, 0 when linear
+    uint32_t frames; // left in the current ramp
+} audiofx_ramp_t;
+
+void audiofx_effect_construct(audiofx_effect_obj_t* self, mp_obj_t sample, uint32_t buffer_size,
+                              audiofx_process_t process);
+void audiofx_effect_deinit(audiofx_effect_obj_t* self);
+bool audiofx_effect_deinited(audiofx_effect_obj_t* self);
+uint32_t audiofx_effect_get_sample_rate(audiofx_effect_obj_t* self);
+// Converts a duration to frames at the source's sample rate, clamped to what a ramp can take.
+uint32_t audiofx_effect_seconds_to_frames(audiofx_effect_obj_t* self, mp_float_t seconds);
+
+// Returns true when the object is one of the effect types.
+bool audiofx_is_effect(mp_obj_t obj);
+
+// These are not available from Python because it may be called in an interrupt.
+void audiofx_effect_reset_buffer(audiofx_effect_obj_t* self,
+                                 bool single_channel,
+                                 uint8_t channel);
+audioio_get_buffer_result_t audiofx_effect_get_buffer(audiofx_effect_obj_t* self,
+                                                      bool single_channel,
+                                                      uint8_t channel,
+                                                      uint8_t** buffer,
+                                                      uint32_t* buffer_length); // length in bytes
+void audiofx_effect_background(audiofx_effect_obj_t* self);
+void audiofx_effect_get_buffer_structure(audiofx_effect_obj_t* self, bool single_channel,
+                                         bool* single_buffer, bool* samples_signed,
+                                         uint32_t* max_buffer_length, uint8_t* spacing);
+
+void audiofx_ramp_set(audiofx_ramp_t* ramp, mp_float_t level);
+mp_float_t audiofx_ramp_get(audiofx_ramp_t* ramp);
+void audiofx_ramp_start(audiofx_ramp_t* ramp, mp_float_t target, uint32_t frames, bool exponential);
+// Scales up to frame_count frames and returns how many were done. Stops early when a ramp ends.
+uint32_t audiofx_ramp_apply(audiofx_ramp_t* ramp, int16_t* samples, uint32_t frame_count,
+                            uint8_t channel_count);
+
+#endif  // MICROPY_INCLUDED_SHARED_MODULE_AUDIOFX__INIT__H
@@ -24,6 +24,7 @@
  * THE SOFTWARE.
  */
 #include "shared-bindings/audiomixer/Mixer.h"
+#include "shared-bindings/audiomixer/MixerVoice.h"
 #include "shared-module/audiomixer/MixerVoice.h"
 
 #include <stdint.h>
@@ -35,6 +36,8 @@
 void common_hal_audiomixer_mixervoice_construct(audiomixer_mixervoice_obj_t *self) {
     self->sample = NULL;
     self->level = ((1 << 15) - 1);
+    self->current_level = self->level;
+    self->playback_rate = 1 << 16;
 }
 
 void common_hal_audiomixer_mixervoice_set_parent(audiomixer_mixervoice_obj_t* self, audiomixer_mixer_obj_t *parent) {
@@ -49,33 +52,180 @@ void common_hal_audiomixer_mixervoice_set_level(audiomixer_mixervoice_obj_t* sel
 	self->level = level * ((1 << 15)-1);
 }
 
-void common_hal_audiomixer_mixervoice_play(audiomixer_mixervoice_obj_t* self, mp_obj_t sample, bool loop) {
-    if (audiosample_sample_rate(sample) != self->parent->sample_rate) {
-        mp_raise_ValueError(translate("The sample's sample rate does not match the mixer's"));
+float common_hal_audiomixer_mixervoice_get_playback_rate(audiomixer_mixervoice_obj_t* self) {
+    return (float) self->playback_rate / (1 << 16);
+}
+
+// Reads the next source frame as signed 16 bit samples laid out for the mixer's channel count.
+// Returns false once the sample has ended.
+static bool read_frame(audiomixer_mixervoice_obj_t* self, int16_t* frame) {
+    uint8_t bytes_per_sample = self->source_bits_per_sample / 8;
+    uint8_t frame_size = bytes_per_sample * self->source_channel_count;
+    bool reset = false;
+    while (self->source_length < frame_size) {
+        if (!self->more_data) {
+            // Only start over once so that an empty looping sample still ends.
+            if (!self->loop || reset) {
+                return false;
+            }
+            audiosample_reset_buffer(self->sample, false, 0);
+            reset = true;
+        }
+        audioio_get_buffer_result_t result = audiosample_get_buffer(self->sample, false, 0, &self->source_buffer, &self->source_length);
+        if (result == GET_BUFFER_ERROR) {
+            return false;
+        }
+        self->more_data = result == GET_BUFFER_MORE_DATA;
+    }
+
+    int16_t samples[2];
+    for (uint8_t c = 0; c < self->source_channel_count && c < 2; c++) {
+        const uint8_t* b = self->source_buffer + c * bytes_per_sample;
+        uint16_t value;
+        if (bytes_per_sample == 1) {
+            value = b[0] << 8;
+        } else {
+            value = b[0] | (b[1] << 8);
+        }
+        if (!self->source_signed) {
+            value ^= 0x8000;
+        }
+        samples[c] = value;
+    }
+    self->source_buffer += frame_size;
+    self->source_length -= frame_size;
+
+    if (self->parent->channel_count == 1) {
+        if (self->source_channel_count == 1) {
+            frame[0] = samples[0];
+        } else {
+            frame[0] = (samples[0] + samples[1]) / 2;
+        }
+    } else {
+        frame[0] = samples[0];
+        frame[1] = samples[self->source_channel_count == 1 ? 0 : 1];
     }
-    if (audiosample_channel_count(sample) != self->parent->channel_count) {
-        mp_raise_ValueError(translate("The sample's channel count does not match the mixer's"));
+    return true;
+}
+
+void audiomixer_mixervoice_update_step(audiomixer_mixervoice_obj_t* self) {
+    self->step = ((uint64_t) audiosample_sample_rate(self->sample) * self->playback_rate) / self->parent->sample_rate;
+}
+
+static void start_conversion(audiomixer_mixervoice_obj_t* self) {
+    self->convert = true;
+    self->source_done = false;
+    self->phase = 0;
+    audiomixer_mixervoice_update_step(self);
+    if (!read_frame(self, self->prev)) {
+        self->sample = NULL;
+        return;
     }
-    if (audiosample_bits_per_sample(sample) != self->parent->bits_per_sample) {
-        mp_raise_ValueError(translate("The sample's bits_per_sample does not match the mixer's"));
+    if (!read_frame(self, self->next)) {
+        self->next[0] = self->prev[0];
+        self->next[1] = self->prev[1];
+        self->source_done = true;
+    }
+}
+
+void common_hal_audiomixer_mixervoice_set_playback_rate(audiomixer_mixervoice_obj_t* self, float playback_rate) {
+    self->playback_rate = playback_rate * (1 << 16);
+    if (self->sample == NULL) {
+        return;
     }
+    if (self->convert) {
+        audiomixer_mixervoice_update_step(self);
+    } else if (self->playback_rate != 1 << 16) {
+        // Pick up converting from wherever direct playback had got to.
+        self->source_buffer = (uint8_t*) self->remaining_buffer;
+        self->source_length = self->buffer_length * sizeof(uint32_t);
+        start_conversion(self);
+    }
+}
+
+uint32_t audiomixer_mixervoice_get_converted_word(audiomixer_mixervoice_obj_t* self) {
+    audiomixer_mixer_obj_t* mixer = self->parent;
+    uint8_t bits = mixer->bits_per_sample;
+    uint32_t sign_flip = 0;
+    if (!mixer->samples_signed) {
+        sign_flip = 1 << (bits - 1);
+    }
+    uint32_t word = 0;
+    uint8_t shift = 0;
+    while (shift < 32) {
+        // Step the source forward to the frames either side of this output frame.
+        while (self->sample != NULL && self->phase >= (1 << 16)) {
+            self->phase -= 1 << 16;
+            if (self->source_done) {
+                self->sample = NULL;
+                break;
+            }
+            self->prev[0] = self->next[0];
+            self->prev[1] = self->next[1];
+            if (!read_frame(self, self->next)) {
+                // Hold the last frame until it has played.
+                self->source_done = true;
+            }
+        }
+        for (uint8_t c = 0; c < mixer->channel_count; c++) {
+            int32_t value = 0;
+            if (self->sample != NULL) {
+                // Linearly interpolate with a 15 bit fraction so the product fits in 32 bits.
+                int32_t delta = self->next[c] - self->prev[c];
+                value = self->prev[c] + ((delta * (int32_t) (self->phase >> 1)) >> 15);
+            }
+            uint32_t out = (uint16_t) value;
+            if (bits == 8) {
+                out >>= 8;
+            }
+            word |= (out ^ sign_flip) << shift;
+            shift += bits;
+        }
+        self->phase += self->step;
+    }
+    return word;
+}
+
+void common_hal_audiomixer_mixervoice_play(audiomixer_mixervoice_obj_t* self, mp_obj_t sample, bool loop) {
     bool single_buffer;
     bool samples_signed;
     uint32_t max_buffer_length;
     uint8_t spacing;
     audiosample_get_buffer_structure(sample, false, &single_buffer, &samples_signed,
                                      &max_buffer_length, &spacing);
-    if (samples_signed != self->parent->samples_signed) {
-        mp_raise_ValueError(translate("The sample's signedness does not match the mixer's"));
+    uint8_t bits_per_sample = audiosample_bits_per_sample(sample);
+    uint8_t channel_count = audiosample_channel_count(sample);
+    if ((bits_per_sample != 8 && bits_per_sample != 16) || channel_count < 1 || channel_count > 2) {
+        mp_raise_ValueError(translate("Sample must be 8 or 16 bit with 1 or 2 channels"));
     }
-    self->sample = sample;
+    // Stop first so the mixer doesn't read the voice while it changes.
+    self->sample = NULL;
     self->loop = loop;
+    // Start at the set level rather than ramping from wherever the last sample left off.
+    self->current_level = self->level;
+    self->source_signed = samples_signed;
+    self->source_bits_per_sample = bits_per_sample;
+    self->source_channel_count = channel_count;
 
     audiosample_reset_buffer(sample, false, 0);
+    if (samples_signed != self->parent->samples_signed ||
+        bits_per_sample != self->parent->bits_per_sample ||
+        channel_count != self->parent->channel_count ||
+        audiosample_sample_rate(sample) != self->parent->sample_rate ||
+        self->playback_rate != 1 << 16) {
+        self->sample = sample;
+        self->source_length = 0;
+        self->more_data = true;
+        start_conversion(self);
+        return;
+    }
+
+    self->convert = false;
     audioio_get_buffer_result_t result = audiosample_get_buffer(sample, false, 0, (uint8_t**) &self->remaining_buffer, &self->buffer_length);
     // Track length in terms of words.
     self->buffer_length /= sizeof(uint32_t);
     self->more_data = result == GET_BUFFER_MORE_DATA;
+    self->sample = sample;
 }
 
 bool common_hal_audiomixer_mixervoice_get_playing(audiomixer_mixervoice_obj_t* self) {
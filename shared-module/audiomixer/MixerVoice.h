@@ -40,7 +40,25 @@ typedef struct {
     uint32_t* remaining_buffer;
     uint32_t buffer_length;
     int16_t level;
+    int16_t current_level; // The level at the end of the last buffer. Changes ramp from here.
+    // Samples that don't match the mixer are converted a frame at a time using the fields below.
+    bool convert;
+    bool source_done;
+    bool source_signed;
+    uint8_t source_bits_per_sample;
+    uint8_t source_channel_count;
+    uint8_t* source_buffer;
+    uint32_t source_length; // in bytes
+    uint32_t playback_rate; // 16.16 fixed point
+    uint32_t phase; // 16.16 fixed point position between prev and next
+    uint32_t step; // 16.16 fixed point source frames per output frame
+    int16_t prev[2];
+    int16_t next[2];
 } audiomixer_mixervoice_obj_t;
 
+// These are not available from Python because they are called while filling mixer buffers.
+void audiomixer_mixervoice_update_step(audiomixer_mixervoice_obj_t* self);
+uint32_t audiomixer_mixervoice_get_converted_word(audiomixer_mixervoice_obj_t* self);
+
 
 #endif /* SHARED_MODULE_AUDIOMIXER_MIXERVOICE_H_ */
@@ -0,0 +1,131 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOMIXER_KERNELS_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOMIXER_KERNELS_H
+
+#include <limits.h>
+#include <stdint.h>
+
+// Mixing helpers that work on a full word of packed samples at a time. Cortex-M4 uses its SIMD
+// instructions and everything else uses plain integer math on lanes within the word. Both produce
+// identical results.
+//
+// Adding two words halves each lane sum (rounding down) so the result cannot overflow.
+
+static inline uint32_t add8signed(uint32_t a, uint32_t b) {
+    #if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+    return __SHADD8(a, b);
+    #else
+    // Flipping the sign bits turns signed lanes into offset unsigned ones and back.
+    a ^= 0x80808080;
+    b ^= 0x80808080;
+    return ((a & b) + (((a ^ b) >> 1) & 0x7f7f7f7f)) ^ 0x80808080;
+    #endif
+}
+
+static inline uint32_t add8unsigned(uint32_t a, uint32_t b) {
+    #if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+    return __UHADD8(a, b);
+    #else
+    return (a & b) + (((a ^ b) >> 1) & 0x7f7f7f7f);
+    #endif
+}
+
+static inline uint32_t add16signed(uint32_t a, uint32_t b) {
+    #if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+    return __SHADD16(a, b);
+    #else
+    a ^= 0x80008000;
+    b ^= 0x80008000;
+    return ((a & b) + (((a ^ b) >> 1) & 0x7fff7fff)) ^ 0x80008000;
+    #endif
+}
+
+static inline uint32_t add16unsigned(uint32_t a, uint32_t b) {
+    #if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+    return __UHADD16(a, b);
+    #else
+    return (a & b) + (((a ^ b) >> 1) & 0x7fff7fff);
+    #endif
+}
+
+// The voice level is Q15 but 8 bit samples only need an 8 bit gain. Full level maps to 256 so it
+// leaves samples untouched.
+static inline uint32_t gain8(int16_t level) {
+    return ((uint32_t) level + (1 << 6)) >> 7;
+}
+
+// Scales unsigned 8 bit lanes around their midpoint by gain / 256. Two lanes are multiplied at once
+// in 16 bit fields. Adding 128 * (256 - gain) keeps every field positive so the shift rounds down
+// like the signed math would, and a gain of at most 256 cannot overflow a field.
+static inline uint32_t mult8unsigned(uint32_t val, uint32_t gain) {
+    uint32_t bias = (128 * (256 - gain)) * 0x00010001;
+    uint32_t even = (val & 0x00ff00ff) * gain + bias;
+    uint32_t odd = ((val >> 8) & 0x00ff00ff) * gain + bias;
+    return ((even >> 8) & 0x00ff00ff) | (odd & 0xff00ff00);
+}
+
+static inline uint32_t mult8signed(uint32_t val, uint32_t gain) {
+    return mult8unsigned(val ^ 0x80808080, gain) ^ 0x80808080;
+}
+
+// Scales signed 16 bit lanes by level / 32768 with saturation.
+static inline uint32_t mult16signed(uint32_t val, int32_t mul) {
+    #if (defined (__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) //Cortex-M4 w/FPU
+    int32_t hi, lo;
+    enum { bits = 16 }; // saturate to 16 bits
+    enum { shift = 0 }; // shift is done automatically
+    // smulw* multiplies by a Q16 factor so double the Q15 level first.
+    mul <<= 1;
+    asm volatile("smulwb %0, %1, %2" : "=r" (lo) : "r" (mul), "r" (val));
+    asm volatile("smulwt %0, %1, %2" : "=r" (hi) : "r" (mul), "r" (val));
+    asm volatile("ssat %0, %1, %2, asr %3" : "=r" (lo) : "I" (bits), "r" (lo), "I" (shift));
+    asm volatile("ssat %0, %1, %2, asr %3" : "=r" (hi) : "I" (bits), "r" (hi), "I" (shift));
+    asm volatile("pkhbt %0, %1, %2, lsl #16" : "=r" (val) : "r" (lo), "r" (hi)); // pack
+    return val;
+    #else
+    int32_t lo = ((int32_t) (int16_t) val * mul) >> 15;
+    int32_t hi = ((int32_t) val >> 16) * mul >> 15;
+    if (lo > SHRT_MAX) {
+        lo = SHRT_MAX;
+    } else if (lo < SHRT_MIN) {
+        lo = SHRT_MIN;
+    }
+    if (hi > SHRT_MAX) {
+        hi = SHRT_MAX;
+    } else if (hi < SHRT_MIN) {
+        hi = SHRT_MIN;
+    }
+    return ((uint32_t) lo & 0xffff) | ((uint32_t) hi << 16);
+    #endif
+}
+
+static inline uint32_t mult16unsigned(uint32_t val, int32_t mul) {
+    return mult16signed(val ^ 0x80008000, mul) ^ 0x80008000;
+}
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_AUDIOMIXER_KERNELS_H
@@ -0,0 +1,252 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audiosink/AudioSink.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "py/mpstate.h"
+#include "py/mphal.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#define WAVE_HEADER_LENGTH (44)
+
+static void write_bytes(audiosink_audiosink_obj_t* self, const void* data, uint32_t length) {
+    int errcode;
+    mp_stream_write_exactly(self->file, data, length, &errcode);
+    if (errcode != 0) {
+        mp_raise_OSError(errcode);
+    }
+}
+
+static void put_uint16(uint8_t* buffer, uint16_t value) {
+    buffer[0] = value & 0xff;
+    buffer[1] = value >> 8;
+}
+
+static void put_uint32(uint8_t* buffer, uint32_t value) {
+    put_uint16(buffer, value & 0xffff);
+    put_uint16(buffer + 2, value >> 16);
+}
+
+static void write_header(audiosink_audiosink_obj_t* self) {
+    uint8_t header[WAVE_HEADER_LENGTH];
+    uint16_t block_align = self->channel_count * self->bits_per_sample / 8;
+    memcpy(header, "RIFF", 4);
+    put_uint32(header + 4, WAVE_HEADER_LENGTH - 8 + self->data_length + (self->data_length & 1));
+    memcpy(header + 8, "WAVEfmt ", 8);
+    put_uint32(header + 16, 16);
+    put_uint16(header + 20, 1); // PCM
+    put_uint16(header + 22, self->channel_count);
+    put_uint32(header + 24, self->sample_rate);
+    put_uint32(header + 28, self->sample_rate * block_align);
+    put_uint16(header + 32, block_align);
+    put_uint16(header + 34, self->bits_per_sample);
+    memcpy(header + 36, "data", 4);
+    put_uint32(header + 40, self->data_length);
+    write_bytes(self, header, WAVE_HEADER_LENGTH);
+}
+
+static bool seek(audiosink_audiosink_obj_t* self, mp_off_t offset, int whence) {
+    const mp_stream_p_t* stream = mp_get_stream(self->file);
+    if (stream->ioctl == NULL) {
+        return false;
+    }
+    struct mp_stream_seek_t seek_s = { .offset = offset, .whence = whence };
+    int errcode;
+    return stream->ioctl(self->file, MP_STREAM_SEEK, (uintptr_t) &seek_s, &errcode) != MP_STREAM_ERROR;
+}
+
+// Wave files store 8 bit samples unsigned and 16 bit samples signed. Samples in the other
+// encoding have their sign bit flipped on the way out.
+static void write_samples(audiosink_audiosink_obj_t* self, const uint8_t* buffer, uint32_t length) {
+    bool flip = self->samples_signed == (self->bits_per_sample == 8);
+    if (!flip) {
+        write_bytes(self, buffer, length);
+    } else {
+        uint8_t converted[256];
+        uint8_t sign_byte = self->bits_per_sample / 8 - 1;
+        for (uint32_t i = 0; i < length; i += sizeof(converted)) {
+            uint32_t chunk = MIN(length - i, sizeof(converted));
+            memcpy(converted, buffer + i, chunk);
+            for (uint32_t j = sign_byte; j < chunk; j += self->bits_per_sample / 8) {
+                converted[j] ^= 0x80;
+            }
+            write_bytes(self, converted, chunk);
+        }
+    }
+    self->data_length += length;
+}
+
+void common_hal_audiosink_audiosink_construct(audiosink_audiosink_obj_t* self, mp_obj_t file) {
+    self->file = file;
+    self->sample = MP_OBJ_NULL;
+    self->deinited = false;
+}
+
+bool common_hal_audiosink_audiosink_deinited(audiosink_audiosink_obj_t* self) {
+    return self->deinited;
+}
+
+void common_hal_audiosink_audiosink_deinit(audiosink_audiosink_obj_t* self) {
+    if (common_hal_audiosink_audiosink_deinited(self)) {
+        return;
+    }
+    common_hal_audiosink_audiosink_stop(self);
+    self->file = MP_OBJ_NULL;
+    self->deinited = true;
+}
+
+void common_hal_audiosink_audiosink_play(audiosink_audiosink_obj_t* self, mp_obj_t sample, bool loop) {
+    common_hal_audiosink_audiosink_stop(self);
+
+    audiosample_reset_buffer(sample, false, 0);
+    self->sample_rate = audiosample_sample_rate(sample);
+    self->bits_per_sample = audiosample_bits_per_sample(sample);
+    self->channel_count = audiosample_channel_count(sample);
+    bool single_buffer;
+    uint32_t max_buffer_length;
+    uint8_t spacing;
+    audiosample_get_buffer_structure(sample, false, &single_buffer, &self->samples_signed,
+                                     &max_buffer_length, &spacing);
+
+    self->data_length = 0;
+    self->buffer_count = 0;
+    self->frame_count = 0;
+    self->underrun_count = 0;
+    self->cpu_time_us = 0;
+    self->max_cpu_time_us = 0;
+    self->last_buffer_us = 0;
+    if (self->file != MP_OBJ_NULL) {
+        // The lengths are filled in when playback stops.
+        write_header(self);
+    }
+
+    self->loop = loop;
+    self->sample = sample;
+}
+
+void common_hal_audiosink_audiosink_stop(audiosink_audiosink_obj_t* self) {
+    if (self->sample == MP_OBJ_NULL) {
+        return;
+    }
+    self->sample = MP_OBJ_NULL;
+    if (self->file == MP_OBJ_NULL) {
+        return;
+    }
+    // Streams that can't seek keep the placeholder lengths.
+    if (self->data_length & 1) {
+        // Chunks are padded to an even length.
+        write_bytes(self, "", 1);
+    }
+    mp_off_t file_length = WAVE_HEADER_LENGTH + self->data_length + (self->data_length & 1);
+    if (seek(self, -file_length, MP_SEEK_CUR)) {
+        write_header(self);
+        seek(self, 0, MP_SEEK_END);
+    }
+}
+
+bool common_hal_audiosink_audiosink_get_playing(audiosink_audiosink_obj_t* self) {
+    return self->sample != MP_OBJ_NULL;
+}
+
+uint32_t common_hal_audiosink_audiosink_run(audiosink_audiosink_obj_t* self, mp_float_t duration) {
+    uint64_t frame_limit = UINT64_MAX;
+    if (duration >= 0) {
+        frame_limit = duration * self->sample_rate;
+    }
+    uint32_t bytes_per_frame = self->channel_count * self->bits_per_sample / 8;
+    uint32_t frames = 0;
+    while (self->sample != MP_OBJ_NULL && frames < frame_limit) {
+        uint8_t* buffer;
+        uint32_t buffer_length;
+        mp_uint_t start = mp_hal_ticks_us();
+        audioio_get_buffer_result_t result =
+            audiosample_get_buffer(self->sample, false, 0, &buffer, &buffer_length);
+        uint32_t elapsed = mp_hal_ticks_us() - start;
+        if (result == GET_BUFFER_ERROR) {
+            common_hal_audiosink_audiosink_stop(self);
+            break;
+        }
+
+        uint32_t buffer_frames = buffer_length / bytes_per_frame;
+        self->buffer_count += 1;
+        self->frame_count += buffer_frames;
+        frames += buffer_frames;
+        self->cpu_time_us += elapsed;
+        if (elapsed > self->max_cpu_time_us) {
+            self->max_cpu_time_us = elapsed;
+        }
+        // Output is double buffered: this buffer was generated while the previous one played out
+        // so it is late if it took longer than that.
+        if (self->buffer_count > 1 && elapsed > self->last_buffer_us) {
+            self->underrun_count += 1;
+        }
+        self->last_buffer_us = (uint64_t) buffer_frames * 1000000 / self->sample_rate;
+
+        if (self->file != MP_OBJ_NULL) {
+            write_samples(self, buffer, buffer_frames * bytes_per_frame);
+        }
+
+        if (result == GET_BUFFER_DONE) {
+            if (self->loop) {
+                audiosample_reset_buffer(self->sample, false, 0);
+            } else {
+                common_hal_audiosink_audiosink_stop(self);
+                break;
+            }
+        }
+        // Give the sample the same chance to read ahead that the DMA outputs do.
+        audiosample_background(self->sample);
+        // Return early for ctrl-C. The VM raises it once we're back.
+        if (MP_STATE_VM(mp_pending_exception) != MP_OBJ_NULL) {
+            break;
+        }
+    }
+    return frames;
+}
+
+uint32_t common_hal_audiosink_audiosink_get_buffer_count(audiosink_audiosink_obj_t* self) {
+    return self->buffer_count;
+}
+
+uint64_t common_hal_audiosink_audiosink_get_frame_count(audiosink_audiosink_obj_t* self) {
+    return self->frame_count;
+}
+
+uint32_t common_hal_audiosink_audiosink_get_underrun_count(audiosink_audiosink_obj_t* self) {
+    return self->underrun_count;
+}
+
+mp_float_t common_hal_audiosink_audiosink_get_cpu_time(audiosink_audiosink_obj_t* self) {
+    return self->cpu_time_us / MICROPY_FLOAT_CONST(1000000.0);
+}
+
+mp_float_t common_hal_audiosink_audiosink_get_max_cpu_time(audiosink_audiosink_obj_t* self) {
+    return self->max_cpu_time_us / MICROPY_FLOAT_CONST(1000000.0);
+}
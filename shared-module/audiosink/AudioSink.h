@@ -0,0 +1,58 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOSINK_AUDIOSINK_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOSINK_AUDIOSINK_H
+
+#include "py/obj.h"
+
+#include "shared-module/audiocore/__init__.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t file; // Stream the wave file is written to. MP_OBJ_NULL discards the audio.
+    mp_obj_t sample; // MP_OBJ_NULL when stopped.
+    bool loop;
+    bool deinited;
+
+    // Format of the sample being played. The wave file is written in this format.
+    uint32_t sample_rate;
+    uint8_t bits_per_sample;
+    uint8_t channel_count;
+    bool samples_signed;
+
+    uint32_t data_length; // in bytes written to the file
+
+    // Statistics since play() was called.
+    uint32_t buffer_count;
+    uint64_t frame_count;
+    uint32_t underrun_count;
+    uint64_t cpu_time_us;
+    uint32_t max_cpu_time_us;
+    uint32_t last_buffer_us; // How long the previous buffer takes to play out.
+} audiosink_audiosink_obj_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_AUDIOSINK_AUDIOSINK_H
@@ -26,6 +26,7 @@
 
 #include "shared-bindings/displayio/Bitmap.h"
 
+#include <math.h>
 #include <string.h>
 
 #include "py/runtime.h"
@@ -105,30 +106,18 @@ uint32_t common_hal_displayio_bitmap_get_pixel(displayio_bitmap_t *self, int16_t
     return 0;
 }
 
-void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value) {
-    if (self->read_only) {
-        mp_raise_RuntimeError(translate("Read-only object"));
+void displayio_bitmap_expand_dirty_area(displayio_bitmap_t *self, const displayio_area_t* area) {
+    if (area->x1 >= area->x2 || area->y1 >= area->y2) {
+        return;
     }
-    // Update the dirty area.
     if (self->dirty_area.x1 == self->dirty_area.x2) {
-        self->dirty_area.x1 = x;
-        self->dirty_area.x2 = x + 1;
-        self->dirty_area.y1 = y;
-        self->dirty_area.y2 = y + 1;
+        displayio_area_copy(area, &self->dirty_area);
     } else {
-        if (x < self->dirty_area.x1) {
-            self->dirty_area.x1 = x;
-        } else if (x >= self->dirty_area.x2) {
-            self->dirty_area.x2 = x + 1;
-        }
-        if (y < self->dirty_area.y1) {
-            self->dirty_area.y1 = y;
-        } else if (y >= self->dirty_area.y2) {
-            self->dirty_area.y2 = y + 1;
-        }
+        displayio_area_expand(&self->dirty_area, area);
     }
+}
 
-    // Update our data
+void displayio_bitmap_write_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value) {
     int32_t row_start = y * self->stride;
     uint32_t bytes_per_value = self->bits_per_value / 8;
     if (bytes_per_value < 1) {
@@ -150,6 +139,97 @@ void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *self, int16_t x,
     }
 }
 
+void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value) {
+    if (self->read_only) {
+        mp_raise_RuntimeError(translate("Read-only object"));
+    }
+    // Update the dirty area.
+    displayio_area_t pixel_area = {x, y, x + 1, y + 1, NULL};
+    displayio_bitmap_expand_dirty_area(self, &pixel_area);
+
+    // Update our data
+    displayio_bitmap_write_pixel(self, x, y, value);
+}
+
+void common_hal_displayio_bitmap_rotozoom(displayio_bitmap_t *self, displayio_bitmap_t *source,
+        int16_t ox, int16_t oy, int16_t px, int16_t py, mp_float_t angle, mp_float_t scale,
+        const displayio_area_t* clip, uint32_t skip_index, bool skip_index_none) {
+    mp_float_t sin_a = MICROPY_FLOAT_C_FUN(sin)(angle);
+    mp_float_t cos_a = MICROPY_FLOAT_C_FUN(cos)(angle);
+
+    // Find the destination bounds of the transformed source by mapping its corners.
+    mp_float_t corners[4][2] = {
+        {-px, -py},
+        {source->width - px, -py},
+        {-px, source->height - py},
+        {source->width - px, source->height - py}
+    };
+    mp_float_t min_x = MICROPY_FLOAT_CONST(32767.0);
+    mp_float_t min_y = MICROPY_FLOAT_CONST(32767.0);
+    mp_float_t max_x = MICROPY_FLOAT_CONST(-32768.0);
+    mp_float_t max_y = MICROPY_FLOAT_CONST(-32768.0);
+    for (uint8_t i = 0; i < 4; i++) {
+        mp_float_t x = ox + scale * (cos_a * corners[i][0] - sin_a * corners[i][1]);
+        mp_float_t y = oy + scale * (sin_a * corners[i][0] + cos_a * corners[i][1]);
+        min_x = MIN(min_x, x);
+        min_y = MIN(min_y, y);
+        max_x = MAX(max_x, x);
+        max_y = MAX(max_y, y);
+    }
+    // Clamp before converting so far off bounds can't overflow the int.
+    min_x = MAX(min_x, MICROPY_FLOAT_CONST(0.0));
+    min_y = MAX(min_y, MICROPY_FLOAT_CONST(0.0));
+    max_x = MIN(max_x, (mp_float_t) self->width);
+    max_y = MIN(max_y, (mp_float_t) self->height);
+    displayio_area_t area = {
+        .x1 = MAX(clip->x1, (int32_t) MICROPY_FLOAT_C_FUN(floor)(min_x)),
+        .y1 = MAX(clip->y1, (int32_t) MICROPY_FLOAT_C_FUN(floor)(min_y)),
+        .x2 = MIN(clip->x2, (int32_t) MICROPY_FLOAT_C_FUN(ceil)(max_x)),
+        .y2 = MIN(clip->y2, (int32_t) MICROPY_FLOAT_C_FUN(ceil)(max_y)),
+        .next = NULL
+    };
+    if (area.x1 >= area.x2 || area.y1 >= area.y2) {
+        return;
+    }
+
+    // Walk the destination and step through the source with the inverse transform in 16.16 fixed
+    // point. Moving one pixel right or down in the destination moves the source position by a
+    // constant so each pixel only costs two additions. The area only covers the transformed source
+    // plus a pixel of rounding so source coordinates stay within about twice the source size plus
+    // 2 / scale. The binding limits the source to 8192 pixels and scale to at least 1/256 so they
+    // fit.
+    int32_t du_dx = (int32_t) (cos_a / scale * 65536);
+    int32_t dv_dx = (int32_t) (-sin_a / scale * 65536);
+    int32_t du_dy = (int32_t) (sin_a / scale * 65536);
+    int32_t dv_dy = (int32_t) (cos_a / scale * 65536);
+    // Sample at the center of each destination pixel.
+    mp_float_t start_x = area.x1 + MICROPY_FLOAT_CONST(0.5) - ox;
+    mp_float_t start_y = area.y1 + MICROPY_FLOAT_CONST(0.5) - oy;
+    int32_t row_u = (int32_t) (((cos_a * start_x + sin_a * start_y) / scale + px) * 65536);
+    int32_t row_v = (int32_t) (((-sin_a * start_x + cos_a * start_y) / scale + py) * 65536);
+    // Unsigned so the compare below also rejects negative positions.
+    uint32_t width = (uint32_t) source->width << 16;
+    uint32_t height = (uint32_t) source->height << 16;
+
+    for (int16_t y = area.y1; y < area.y2; y++) {
+        int32_t u = row_u;
+        int32_t v = row_v;
+        for (int16_t x = area.x1; x < area.x2; x++) {
+            if ((uint32_t) u < width && (uint32_t) v < height) {
+                uint32_t value = common_hal_displayio_bitmap_get_pixel(source, u >> 16, v >> 16);
+                if (skip_index_none || value != skip_index) {
+                    displayio_bitmap_write_pixel(self, x, y, value);
+                }
+            }
+            u += du_dx;
+            v += dv_dx;
+        }
+        row_u += du_dy;
+        row_v += dv_dy;
+    }
+    displayio_bitmap_expand_dirty_area(self, &area);
+}
+
 displayio_area_t* displayio_bitmap_get_refresh_areas(displayio_bitmap_t *self, displayio_area_t* tail) {
     if (self->dirty_area.x1 == self->dirty_area.x2) {
         return tail;
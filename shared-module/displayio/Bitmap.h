@@ -48,6 +48,11 @@ typedef struct {
 } displayio_bitmap_t;
 
 void displayio_bitmap_finish_refresh(displayio_bitmap_t *self);
+
+// Writes a pixel without bounds checks or dirty tracking. Callers that write many pixels use it and
+// then mark everything they touched with displayio_bitmap_expand_dirty_area once.
+void displayio_bitmap_write_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value);
+void displayio_bitmap_expand_dirty_area(displayio_bitmap_t *self, const displayio_area_t* area);
 displayio_area_t* displayio_bitmap_get_refresh_areas(displayio_bitmap_t *self, displayio_area_t* tail);
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_BITMAP_H
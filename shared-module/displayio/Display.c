@@ -64,6 +64,8 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
     self->set_column_command = set_column_command;
     self->set_row_command = set_row_command;
     self->write_ram_command = write_ram_command;
+    self->set_vertical_scroll = set_vertical_scroll;
+    self->hardware_scroll = false;
     self->brightness_command = brightness_command;
     self->auto_brightness = auto_brightness;
     self->first_manual_refresh = !auto_refresh;
@@ -192,12 +194,44 @@ mp_obj_t common_hal_displayio_display_get_bus(displayio_display_obj_t* self) {
     return self->core.bus;
 }
 
+// Moves a scrolled TileGrid with the panel's vertical scroll when possible so that only the rows that
+// come into view need to be sent. Returns the extra areas to refresh.
+STATIC displayio_area_t* _scroll(displayio_display_obj_t *self) {
+    if (!self->hardware_scroll || !displayio_display_core_can_scroll(&self->core, self->set_vertical_scroll)) {
+        return NULL;
+    }
+    displayio_tilegrid_t* grid = displayio_group_get_scrolled_tilegrid(self->core.current_group);
+    if (grid == NULL) {
+        return NULL;
+    }
+    displayio_area_t area;
+    int16_t dy;
+    if (!displayio_tilegrid_get_pending_scroll(grid, &area, &dy)) {
+        return NULL;
+    }
+    displayio_area_t clipped;
+    if (!displayio_display_core_clip_area(&self->core, &area, &clipped)) {
+        return NULL;
+    }
+    // Only worth it when the scrolled area covers most of the display. Otherwise redrawing what
+    // moved with it costs more than redrawing the area itself.
+    if (displayio_area_size(&clipped) * 2 < displayio_area_size(&self->core.area)) {
+        return NULL;
+    }
+    uint16_t abs_dy = dy < 0 ? -dy : dy;
+    if (abs_dy >= displayio_area_height(&clipped)) {
+        return NULL;
+    }
+    displayio_tilegrid_claim_scroll(grid);
+    return displayio_display_core_scroll(&self->core, self->set_vertical_scroll, self->data_as_commands, &clipped, dy, NULL);
+}
+
 STATIC const displayio_area_t* _get_refresh_areas(displayio_display_obj_t *self) {
     if (self->core.full_refresh) {
         self->core.area.next = NULL;
         return &self->core.area;
     } else if (self->core.current_group != NULL) {
-        return displayio_group_get_refresh_areas(self->core.current_group, NULL);
+        return displayio_group_get_refresh_areas(self->core.current_group, _scroll(self));
     }
     return NULL;
 }
@@ -217,6 +251,15 @@ STATIC bool _refresh_area(displayio_display_obj_t* self, const displayio_area_t*
     if (!displayio_display_core_clip_area(&self->core, area, &clipped)) {
         return true;
     }
+    // Split areas that wrap around the end of the panel's scrolled rows.
+    uint16_t rows_until_wrap = displayio_display_core_rows_until_wrap(&self->core, clipped.y1);
+    if (displayio_area_height(&clipped) > rows_until_wrap) {
+        displayio_area_t wrapped;
+        displayio_area_copy(&clipped, &wrapped);
+        clipped.y2 = clipped.y1 + rows_until_wrap;
+        wrapped.y1 = clipped.y2;
+        return _refresh_area(self, &clipped) && _refresh_area(self, &wrapped);
+    }
     uint16_t subrectangles = 1;
     uint16_t rows_per_buffer = displayio_area_height(&clipped);
     uint8_t pixels_per_word = (sizeof(uint32_t) * 8) / self->core.colorspace.depth;
@@ -346,6 +389,25 @@ void common_hal_displayio_display_set_auto_refresh(displayio_display_obj_t* self
     self->auto_refresh = auto_refresh;
 }
 
+bool common_hal_displayio_display_get_hardware_scroll(displayio_display_obj_t* self) {
+    return self->hardware_scroll;
+}
+
+void common_hal_displayio_display_set_hardware_scroll(displayio_display_obj_t* self, bool hardware_scroll) {
+    if (hardware_scroll == self->hardware_scroll) {
+        return;
+    }
+    self->hardware_scroll = hardware_scroll;
+    // Put the panel back to its unscrolled state. The next refresh redraws it in place.
+    if (self->core.vertical_scroll != 0) {
+        while (!displayio_display_core_bus_free(&self->core)) {
+            RUN_BACKGROUND_TASKS;
+        }
+        displayio_display_core_set_vertical_scroll(&self->core, self->set_vertical_scroll, self->data_as_commands, 0);
+        self->core.full_refresh = true;
+    }
+}
+
 STATIC void _update_backlight(displayio_display_obj_t* self) {
     if (!self->auto_brightness || self->updating_backlight) {
         return;
@@ -381,6 +443,7 @@ void release_display(displayio_display_obj_t* self) {
 void reset_display(displayio_display_obj_t* self) {
     self->auto_refresh = true;
     self->auto_brightness = true;
+    common_hal_displayio_display_set_hardware_scroll(self, false);
     common_hal_displayio_display_show(self, NULL);
 }
 
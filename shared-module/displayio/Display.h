@@ -50,7 +50,9 @@ typedef struct {
     uint8_t set_column_command;
     uint8_t set_row_command;
     uint8_t write_ram_command;
+    uint8_t set_vertical_scroll;
     bool auto_refresh;
+    bool hardware_scroll;
     bool first_manual_refresh;
     bool data_as_commands;
     bool auto_brightness;
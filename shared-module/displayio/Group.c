@@ -361,3 +361,41 @@ displayio_area_t* displayio_group_get_refresh_areas(displayio_group_t *self, dis
 
     return tail;
 }
+
+displayio_tilegrid_t* displayio_group_get_scrolled_tilegrid(displayio_group_t *self) {
+    if (self->item_removed || self->hidden || self->hidden_by_parent) {
+        return NULL;
+    }
+    displayio_tilegrid_t* scrolled = NULL;
+    displayio_area_t scrolled_area;
+    int16_t dy;
+    for (uint16_t i = 0; i < self->size; i++) {
+        mp_obj_t layer = self->children[i].native;
+        // Nested groups could cover the scrolled area in ways we don't track so let them redraw.
+        if (!MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
+            return NULL;
+        }
+        displayio_tilegrid_t* grid = layer;
+        if (displayio_tilegrid_get_pending_scroll(grid, &scrolled_area, &dy)) {
+            if (scrolled != NULL) {
+                return NULL;
+            }
+            scrolled = grid;
+        }
+    }
+    if (scrolled == NULL) {
+        return NULL;
+    }
+    // Any other visible layer over the scrolled area would be moved with it.
+    for (uint16_t i = 0; i < self->size; i++) {
+        displayio_tilegrid_t* grid = self->children[i].native;
+        if (grid == scrolled || grid->hidden || grid->hidden_by_parent) {
+            continue;
+        }
+        displayio_area_t overlap;
+        if (displayio_area_compute_overlap(&scrolled_area, &grid->current_area, &overlap)) {
+            return NULL;
+        }
+    }
+    return scrolled;
+}
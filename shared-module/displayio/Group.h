@@ -33,6 +33,7 @@
 #include "py/obj.h"
 #include "shared-module/displayio/area.h"
 #include "shared-module/displayio/Palette.h"
+#include "shared-module/displayio/TileGrid.h"
 
 typedef struct {
     mp_obj_t native;
@@ -64,4 +65,8 @@ void displayio_group_update_transform(displayio_group_t *group, const displayio_
 void displayio_group_finish_refresh(displayio_group_t *self);
 displayio_area_t* displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t* tail);
 
+// Returns the child TileGrid that has only scrolled since the last refresh when nothing else in the
+// group overlaps it. Returns NULL otherwise.
+displayio_tilegrid_t* displayio_group_get_scrolled_tilegrid(displayio_group_t *self);
+
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_GROUP_H
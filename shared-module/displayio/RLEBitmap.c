@@ -0,0 +1,247 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "shared-bindings/displayio/RLEBitmap.h"
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/runtime.h"
+
+#define BMP_HEADER_SIZE 54
+
+// Returns the byte at *pos and advances it. Reads past the end return 0 so truncated data decodes
+// as end of line markers.
+STATIC uint8_t read_byte(displayio_rlebitmap_t *self, uint32_t* pos) {
+    uint32_t p = (*pos)++;
+    if (p >= self->data_len) {
+        return 0;
+    }
+    if (self->file == NULL) {
+        return self->data[p];
+    }
+    if (p < self->read_cache_offset || p >= self->read_cache_offset + self->read_cache_len) {
+        f_lseek(&self->file->fp, p);
+        UINT bytes_read;
+        if (f_read(&self->file->fp, self->read_cache, sizeof(self->read_cache), &bytes_read) != FR_OK) {
+            bytes_read = 0;
+        }
+        self->read_cache_offset = p;
+        self->read_cache_len = bytes_read;
+        if (bytes_read == 0) {
+            return 0;
+        }
+    }
+    return self->read_cache[p - self->read_cache_offset];
+}
+
+STATIC uint32_t read_word(const uint8_t* data) {
+    return data[0] | data[1] << 8 | data[2] << 16 | (uint32_t) data[3] << 24;
+}
+
+// Rows are stored bottom up so stream row 0 is the last display row.
+STATIC void set_row_start(displayio_rlebitmap_t *self, uint32_t stream_row, uint32_t offset, uint16_t x) {
+    uint16_t y = self->height - 1 - stream_row;
+    self->row_offsets[y] = offset;
+    self->row_start_x[y] = x;
+}
+
+void common_hal_displayio_rlebitmap_construct(displayio_rlebitmap_t *self, pyb_file_obj_t* file,
+        mp_obj_t buffer, const uint8_t* data, size_t len) {
+    self->file = file;
+    self->buffer = buffer;
+    self->data = data;
+    self->data_len = len;
+    self->read_cache_offset = 0;
+    self->read_cache_len = 0;
+    if (file != NULL) {
+        self->data_len = f_size(&file->fp);
+    }
+
+    uint8_t header[BMP_HEADER_SIZE];
+    uint32_t pos = 0;
+    for (uint8_t i = 0; i < BMP_HEADER_SIZE; i++) {
+        header[i] = read_byte(self, &pos);
+    }
+    if (self->data_len < BMP_HEADER_SIZE || memcmp(header, "BM", 2) != 0) {
+        mp_raise_ValueError(translate("Invalid BMP file"));
+    }
+    uint32_t data_offset = read_word(header + 10);
+    int32_t width = read_word(header + 18);
+    int32_t height = read_word(header + 22);
+    uint16_t bits_per_pixel = header[28] | header[29] << 8;
+    uint32_t compression = read_word(header + 30);
+    // RLE BMPs are always bottom up so the height is positive.
+    if (!((compression == 1 && bits_per_pixel == 8) || (compression == 2 && bits_per_pixel == 4)) ||
+        width <= 0 || width >= RLEBITMAP_EMPTY_ROW || height <= 0 || height > 0xffff) {
+        mp_raise_ValueError(translate("Only RLE4 and RLE8 compressed BMPs supported"));
+    }
+    self->rle4 = compression == 2;
+    self->width = width;
+    self->height = height;
+
+    self->row_offsets = m_malloc(self->height * sizeof(uint32_t), false);
+    self->row_start_x = m_malloc(self->height * sizeof(uint16_t), false);
+    self->row_cache = m_malloc(self->width * RLEBITMAP_CACHED_ROWS, false);
+    for (uint8_t i = 0; i < RLEBITMAP_CACHED_ROWS; i++) {
+        self->cached_rows[i] = -1;
+    }
+    self->next_cache_slot = 0;
+    for (uint16_t y = 0; y < self->height; y++) {
+        self->row_start_x[y] = RLEBITMAP_EMPTY_ROW;
+    }
+
+    // Walk the RLE data once to find where each row starts so any row can be decoded on its own.
+    pos = data_offset;
+    uint32_t row = 0;
+    uint32_t x = 0;
+    set_row_start(self, row, pos, 0);
+    while (row < self->height && pos < self->data_len) {
+        uint8_t count = read_byte(self, &pos);
+        uint8_t value = read_byte(self, &pos);
+        if (count > 0) {
+            // Encoded run.
+            x += count;
+        } else if (value == 0) {
+            // End of line.
+            row++;
+            x = 0;
+            if (row < self->height) {
+                set_row_start(self, row, pos, 0);
+            }
+        } else if (value == 1) {
+            // End of bitmap. The remaining rows are empty.
+            break;
+        } else if (value == 2) {
+            // Delta. Skipped pixels are zero.
+            x += read_byte(self, &pos);
+            uint8_t dy = read_byte(self, &pos);
+            if (dy > 0) {
+                row += dy;
+                if (row < self->height) {
+                    set_row_start(self, row, pos, MIN(x, self->width));
+                }
+            }
+        } else {
+            // Absolute run padded to a 16 bit boundary.
+            uint16_t bytes = self->rle4 ? (value + 1) / 2 : value;
+            pos += bytes + (bytes & 1);
+            x += value;
+        }
+    }
+}
+
+STATIC void decode_row(displayio_rlebitmap_t *self, int16_t y, uint8_t* row_cache) {
+    memset(row_cache, 0, self->width);
+    uint32_t x = self->row_start_x[y];
+    if (x == RLEBITMAP_EMPTY_ROW) {
+        return;
+    }
+    if (self->file == NULL) {
+        // A bytearray may have been resized and moved since the last row so get it again. Reads
+        // past a shorter buffer return 0 like truncated data.
+        mp_buffer_info_t bufinfo;
+        if (!mp_get_buffer(self->buffer, &bufinfo, MP_BUFFER_READ)) {
+            return;
+        }
+        self->data = bufinfo.buf;
+        self->data_len = bufinfo.len;
+    }
+    uint32_t pos = self->row_offsets[y];
+    while (pos < self->data_len && x < self->width) {
+        uint8_t count = read_byte(self, &pos);
+        uint8_t value = read_byte(self, &pos);
+        if (count > 0) {
+            // Encoded run. RLE4 runs alternate between the two nibbles.
+            uint8_t first = value;
+            uint8_t second = value;
+            if (self->rle4) {
+                first = value >> 4;
+                second = value & 0xf;
+            }
+            for (uint8_t i = 0; i < count && x < self->width; i++, x++) {
+                row_cache[x] = (i & 1) ? second : first;
+            }
+        } else if (value == 0 || value == 1) {
+            // End of line or bitmap.
+            break;
+        } else if (value == 2) {
+            x += read_byte(self, &pos);
+            if (read_byte(self, &pos) > 0) {
+                // The rest of this row was skipped.
+                break;
+            }
+        } else {
+            uint16_t bytes = self->rle4 ? (value + 1) / 2 : value;
+            uint32_t next = pos + bytes + (bytes & 1);
+            uint8_t pixels = 0;
+            for (uint8_t i = 0; i < value; i++, x++) {
+                uint8_t pixel;
+                if (!self->rle4) {
+                    pixel = read_byte(self, &pos);
+                } else if ((i & 1) == 0) {
+                    pixels = read_byte(self, &pos);
+                    pixel = pixels >> 4;
+                } else {
+                    pixel = pixels & 0xf;
+                }
+                if (x < self->width) {
+                    row_cache[x] = pixel;
+                }
+            }
+            pos = next;
+        }
+    }
+}
+
+uint32_t common_hal_displayio_rlebitmap_get_pixel(displayio_rlebitmap_t *self,
+        int16_t x, int16_t y) {
+    if (x < 0 || x >= self->width || y < 0 || y >= self->height) {
+        return 0;
+    }
+    // TileGrid reads pixels a row at a time so decode whole rows and keep the last few. Rows are
+    // replaced round robin.
+    uint8_t slot = 0;
+    while (slot < RLEBITMAP_CACHED_ROWS && self->cached_rows[slot] != y) {
+        slot++;
+    }
+    if (slot == RLEBITMAP_CACHED_ROWS) {
+        slot = self->next_cache_slot;
+        self->next_cache_slot = (slot + 1) % RLEBITMAP_CACHED_ROWS;
+        decode_row(self, y, self->row_cache + slot * self->width);
+        self->cached_rows[slot] = y;
+    }
+    return self->row_cache[slot * self->width + x];
+}
+
+uint16_t common_hal_displayio_rlebitmap_get_height(displayio_rlebitmap_t *self) {
+    return self->height;
+}
+
+uint16_t common_hal_displayio_rlebitmap_get_width(displayio_rlebitmap_t *self) {
+    return self->width;
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_RLEBITMAP_H
+#define MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_RLEBITMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+
+#include "extmod/vfs_fat.h"
+
+// row_start_x value for rows that have no RLE data and are all zero.
+#define RLEBITMAP_EMPTY_ROW 0xffff
+
+// TileGrid always reads its source a row at a time, even when transposed, but neighbouring tiles
+// can come from different source rows so a few decoded rows are kept.
+#define RLEBITMAP_CACHED_ROWS (4)
+
+typedef struct {
+    mp_obj_base_t base;
+    uint16_t width;
+    uint16_t height;
+    // The BMP is either in a buffer or in a file.
+    mp_obj_t buffer;
+    const uint8_t* data;
+    pyb_file_obj_t* file;
+    uint32_t data_len;
+    // Where each row's RLE data starts and the x its first run starts at, in display row order.
+    uint32_t* row_offsets;
+    uint16_t* row_start_x;
+    // Pixel values of the last few decoded rows, RLEBITMAP_CACHED_ROWS rows of width bytes.
+    uint8_t* row_cache;
+    int32_t cached_rows[RLEBITMAP_CACHED_ROWS];
+    uint8_t next_cache_slot;
+    // Small window of file data so decoding doesn't seek for every byte.
+    uint32_t read_cache_offset;
+    uint16_t read_cache_len;
+    uint8_t read_cache[32];
+    bool rle4;
+} displayio_rlebitmap_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_RLEBITMAP_H
@@ -26,10 +26,13 @@
 
 #include "shared-bindings/displayio/TileGrid.h"
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/displayio/OnDiskBitmap.h"
+#include "shared-bindings/displayio/RLEBitmap.h"
 #include "shared-bindings/displayio/Palette.h"
 #include "shared-bindings/displayio/Shape.h"
 
@@ -74,6 +77,8 @@ void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_
     self->flip_x = false;
     self->flip_y = false;
     self->transpose_xy = false;
+    self->scrolled_rows = 0;
+    self->scroll_claimed = false;
 }
 
 
@@ -208,29 +213,24 @@ uint16_t common_hal_displayio_tilegrid_get_height(displayio_tilegrid_t *self) {
     return self->height_in_tiles;
 }
 
-uint8_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
-    uint8_t* tiles = self->tiles;
+STATIC uint8_t* _get_tiles(displayio_tilegrid_t *self) {
     if (self->inline_tiles) {
-        tiles = (uint8_t*) &self->tiles;
+        return (uint8_t*) &self->tiles;
     }
+    return self->tiles;
+}
+
+uint8_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
+    uint8_t* tiles = _get_tiles(self);
     if (tiles == NULL) {
         return 0;
     }
     return tiles[y * self->width_in_tiles + x];
 }
 
-void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index) {
-    if (tile_index >= self->tiles_in_bitmap) {
-        mp_raise_ValueError(translate("Tile index out of bounds"));
-    }
-    uint8_t* tiles = self->tiles;
-    if (self->inline_tiles) {
-        tiles = (uint8_t*) &self->tiles;
-    }
-    if (tiles == NULL) {
-        return;
-    }
-    tiles[y * self->width_in_tiles + x] = tile_index;
+// Marks the tiles from (x1, y1) up to but not including (x2, y2) as changed. Coordinates are tile
+// indices so the range is rotated by top_left before it is converted to pixels.
+STATIC void _mark_tiles_dirty(displayio_tilegrid_t *self, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2) {
     displayio_area_t temp_area;
     displayio_area_t* tile_area;
     if (!self->partial_change) {
@@ -238,18 +238,29 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
     } else {
         tile_area = &temp_area;
     }
-    int16_t tx = (x - self->top_left_x) % self->width_in_tiles;
+    int16_t tx = (x1 - self->top_left_x) % self->width_in_tiles;
     if (tx < 0) {
         tx += self->width_in_tiles;
     }
+    uint16_t width = x2 - x1;
+    // The range wraps around the right edge so cover the full width instead.
+    if (tx + width > self->width_in_tiles) {
+        tx = 0;
+        width = self->width_in_tiles;
+    }
     tile_area->x1 = tx * self->tile_width;
-    tile_area->x2 = tile_area->x1 + self->tile_width;
-    int16_t ty = (y - self->top_left_y) % self->height_in_tiles;
+    tile_area->x2 = tile_area->x1 + width * self->tile_width;
+    int16_t ty = (y1 - self->top_left_y) % self->height_in_tiles;
     if (ty < 0) {
         ty += self->height_in_tiles;
     }
+    uint16_t height = y2 - y1;
+    if (ty + height > self->height_in_tiles) {
+        ty = 0;
+        height = self->height_in_tiles;
+    }
     tile_area->y1 = ty * self->tile_height;
-    tile_area->y2 = tile_area->y1 + self->tile_height;
+    tile_area->y2 = tile_area->y1 + height * self->tile_height;
 
     if (self->partial_change) {
         displayio_area_expand(&self->dirty_area, &temp_area);
@@ -258,6 +269,61 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
     self->partial_change = true;
 }
 
+void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index) {
+    if (tile_index >= self->tiles_in_bitmap) {
+        mp_raise_ValueError(translate("Tile index out of bounds"));
+    }
+    uint8_t* tiles = _get_tiles(self);
+    if (tiles == NULL) {
+        return;
+    }
+    tiles[y * self->width_in_tiles + x] = tile_index;
+    _mark_tiles_dirty(self, x, y, x + 1, y + 1);
+}
+
+void common_hal_displayio_tilegrid_set_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, const uint8_t* tile_indices, uint16_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (x + count > self->width_in_tiles || y >= self->height_in_tiles) {
+        mp_raise_ValueError(translate("Tile index out of bounds"));
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        if (tile_indices[i] >= self->tiles_in_bitmap) {
+            mp_raise_ValueError(translate("Tile index out of bounds"));
+        }
+    }
+    uint8_t* tiles = _get_tiles(self);
+    if (tiles == NULL) {
+        return;
+    }
+    memcpy(tiles + y * self->width_in_tiles + x, tile_indices, count);
+    _mark_tiles_dirty(self, x, y, x + count, y + 1);
+}
+
+void common_hal_displayio_tilegrid_fill_region(displayio_tilegrid_t *self, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t tile_index) {
+    if (tile_index >= self->tiles_in_bitmap) {
+        mp_raise_ValueError(translate("Tile index out of bounds"));
+    }
+    if (x2 > self->width_in_tiles) {
+        x2 = self->width_in_tiles;
+    }
+    if (y2 > self->height_in_tiles) {
+        y2 = self->height_in_tiles;
+    }
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    uint8_t* tiles = _get_tiles(self);
+    if (tiles == NULL) {
+        return;
+    }
+    for (uint16_t y = y1; y < y2; y++) {
+        memset(tiles + y * self->width_in_tiles + x1, tile_index, x2 - x1);
+    }
+    _mark_tiles_dirty(self, x1, y1, x2, y2);
+}
+
 bool common_hal_displayio_tilegrid_get_flip_x(displayio_tilegrid_t *self) {
     return self->flip_x;
 }
@@ -305,9 +371,78 @@ void common_hal_displayio_tilegrid_set_transpose_xy(displayio_tilegrid_t *self,
 }
 
 void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
-    self->top_left_x = x;
+    if (x == self->top_left_x && y == self->top_left_y) {
+        return;
+    }
+    if (x != self->top_left_x || self->full_change) {
+        self->top_left_x = x;
+        self->top_left_y = y;
+        self->full_change = true;
+        return;
+    }
+    // A vertical only change is tracked as a scroll so that displays that can shift their contents
+    // only need to redraw the rows that come into view.
+    int16_t rows = (y - self->top_left_y) % self->height_in_tiles;
+    if (rows > self->height_in_tiles / 2) {
+        rows -= self->height_in_tiles;
+    } else if (rows < -(self->height_in_tiles / 2)) {
+        rows += self->height_in_tiles;
+    }
     self->top_left_y = y;
-    self->full_change = true;
+    self->scrolled_rows += rows;
+
+    // Move the pending changes along with the content. Anything that wraps around lands in the rows
+    // that are redrawn because of the scroll. The area isn't clamped to where it moved to because a
+    // scroll back before the next refresh would then lose the clipped part. Instead it covers both
+    // where the changes were and where they are now.
+    if (self->partial_change) {
+        displayio_area_t moved;
+        displayio_area_copy(&self->dirty_area, &moved);
+        int16_t shift = rows * self->tile_height;
+        moved.y1 -= shift;
+        moved.y2 -= shift;
+        if (moved.y1 < 0) {
+            moved.y1 = 0;
+        }
+        if (moved.y2 > self->pixel_height) {
+            moved.y2 = self->pixel_height;
+        }
+        if (moved.y2 > moved.y1) {
+            displayio_area_expand(&self->dirty_area, &moved);
+        }
+    }
+}
+
+bool displayio_tilegrid_get_pending_scroll(displayio_tilegrid_t *self, displayio_area_t* area, int16_t* dy) {
+    bool first_draw = self->previous_area.x1 == self->previous_area.x2;
+    bool hidden = self->hidden || self->hidden_by_parent;
+    if (self->scrolled_rows == 0 || first_draw || hidden || self->moved || self->full_change ||
+        self->absolute_transform == NULL) {
+        return false;
+    }
+    // Scrolling only works when tile rows line up with display rows.
+    if (self->transpose_xy || self->absolute_transform->transpose_xy) {
+        return false;
+    }
+    int16_t rows = self->scrolled_rows;
+    if (rows < 0) {
+        rows = -rows;
+    }
+    if (rows >= self->height_in_tiles) {
+        return false;
+    }
+    // Positive scrolled rows move the content up within the TileGrid.
+    int16_t shift = -self->scrolled_rows * self->tile_height * self->absolute_transform->scale;
+    if (self->flip_y) {
+        shift = -shift;
+    }
+    *dy = shift * self->absolute_transform->dy;
+    displayio_area_copy(&self->current_area, area);
+    return true;
+}
+
+void displayio_tilegrid_claim_scroll(displayio_tilegrid_t *self) {
+    self->scroll_claimed = true;
 }
 
 bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const _displayio_colorspace_t* colorspace, const displayio_area_t* area, uint32_t* mask, uint32_t *buffer) {
@@ -434,6 +569,8 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const _displayio_c
                 input_pixel.pixel = common_hal_displayio_shape_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
             } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_ondiskbitmap_type)) {
                 input_pixel.pixel = common_hal_displayio_ondiskbitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
+            } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_rlebitmap_type)) {
+                input_pixel.pixel = common_hal_displayio_rlebitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
             }
             
             output_pixel.opaque = true;
@@ -491,6 +628,8 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     self->moved = false;
     self->full_change = false;
     self->partial_change = false;
+    self->scrolled_rows = 0;
+    self->scroll_claimed = false;
     if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
         displayio_palette_finish_refresh(self->pixel_shader);
     } else if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type)) {
@@ -503,6 +642,8 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_ondiskbitmap_type)) {
         // OnDiskBitmap changes will trigger a complete reload so no need to
         // track changes.
+    } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_rlebitmap_type)) {
+        // RLEBitmaps are read-only.
     }
     // TODO(tannewt): We could double buffer changes to position and move them over here.
     // That way they won't change during a refresh and tear.
@@ -545,7 +686,9 @@ displayio_area_t* displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *sel
         }
     }
 
+    // Scrolls that weren't handled by the display move every pixel.
     self->full_change = self->full_change ||
+        (self->scrolled_rows != 0 && !self->scroll_claimed) ||
         (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type) &&
          displayio_palette_needs_refresh(self->pixel_shader)) ||
         (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type) &&
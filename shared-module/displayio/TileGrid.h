@@ -50,6 +50,7 @@ typedef struct {
     uint16_t tile_height;
     uint16_t top_left_x;
     uint16_t top_left_y;
+    int16_t scrolled_rows; // Tile rows top_left_y has moved since the last refresh.
     uint8_t* tiles;
     const displayio_buffer_transform_t* absolute_transform;
     displayio_area_t dirty_area; // Stored as a relative area until the refresh area is fetched.
@@ -65,7 +66,8 @@ typedef struct {
     bool transpose_xy  :1;
     bool hidden :1;
     bool hidden_by_parent :1;
-    uint8_t padding :6;
+    bool scroll_claimed :1;
+    uint8_t padding :5;
 } displayio_tilegrid_t;
 
 void displayio_tilegrid_set_hidden_by_parent(displayio_tilegrid_t *self, bool hidden);
@@ -85,4 +87,12 @@ void displayio_tilegrid_update_transform(displayio_tilegrid_t *group, const disp
 bool displayio_tilegrid_get_previous_area(displayio_tilegrid_t *self, displayio_area_t* area);
 void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self);
 
+// Returns true when the TileGrid's content has only shifted vertically through top_left since the
+// last refresh. area is set to the absolute area that shifted and dy to the number of pixels it
+// moved by.
+bool displayio_tilegrid_get_pending_scroll(displayio_tilegrid_t *self, displayio_area_t* area, int16_t* dy);
+// Called by a display that has moved the shifted pixels itself, such as with a hardware scroll, so
+// only the tiles that changed are refreshed.
+void displayio_tilegrid_claim_scroll(displayio_tilegrid_t *self);
+
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_TILEGRID_H
@@ -53,6 +53,7 @@ void displayio_display_core_construct(displayio_display_core_t* self,
     self->current_group = NULL;
     self->colstart = colstart;
     self->rowstart = rowstart;
+    self->vertical_scroll = 0;
     self->last_refresh = 0;
 
     if (MP_OBJ_IS_TYPE(bus, &displayio_parallelbus_type)) {
@@ -198,6 +199,12 @@ void displayio_display_core_set_region_to_update(displayio_display_core_t* self,
     uint16_t x2 = area->x2;
     uint16_t y1 = area->y1;
     uint16_t y2 = area->y2;
+    // Map rows into the panel's scrolled memory. Callers split areas so they don't wrap.
+    if (self->vertical_scroll != 0) {
+        uint16_t scroll_height = self->area.y2;
+        y1 = (y1 + self->vertical_scroll) % scroll_height;
+        y2 = y1 + (area->y2 - area->y1);
+    }
     // Collapse down the dimension where multiple pixels are in a byte.
     if (self->colorspace.depth < 8) {
         uint8_t pixels_per_byte = 8 / self->colorspace.depth;
@@ -280,6 +287,72 @@ void displayio_display_core_set_region_to_update(displayio_display_core_t* self,
     }
 }
 
+bool displayio_display_core_can_scroll(displayio_display_core_t* self, uint8_t vertical_scroll_command) {
+    // The scroll command moves panel rows so it only helps when display rows are panel rows. The
+    // panel wraps rows at the end of its memory so the display must start at the first row too.
+    // Displays that pack pixels into columns address rows in groups so they are left out.
+    return vertical_scroll_command != 0 &&
+           !self->transform.transpose_xy &&
+           self->rowstart == 0 &&
+           self->colorspace.depth >= 8;
+}
+
+void displayio_display_core_set_vertical_scroll(displayio_display_core_t* self, uint8_t vertical_scroll_command, bool data_as_commands, uint16_t vertical_scroll) {
+    self->vertical_scroll = vertical_scroll;
+    displayio_display_core_begin_transaction(self);
+    if (data_as_commands) {
+        uint8_t data[3] = {vertical_scroll_command, vertical_scroll >> 8, vertical_scroll & 0xff};
+        self->send(self->bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, data, 3);
+    } else {
+        uint8_t data[2] = {vertical_scroll >> 8, vertical_scroll & 0xff};
+        self->send(self->bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, &vertical_scroll_command, 1);
+        self->send(self->bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, data, 2);
+    }
+    displayio_display_core_end_transaction(self);
+}
+
+uint16_t displayio_display_core_rows_until_wrap(displayio_display_core_t* self, uint16_t y) {
+    uint16_t scroll_height = self->area.y2;
+    return scroll_height - (y + self->vertical_scroll) % scroll_height;
+}
+
+STATIC displayio_area_t* _add_scroll_area(displayio_display_core_t* self, uint8_t* count, int16_t x1, int16_t y1, int16_t x2, int16_t y2, displayio_area_t* tail) {
+    if (x1 >= x2 || y1 >= y2) {
+        return tail;
+    }
+    displayio_area_t* area = &self->scroll_areas[(*count)++];
+    area->x1 = x1;
+    area->y1 = y1;
+    area->x2 = x2;
+    area->y2 = y2;
+    area->next = tail;
+    return area;
+}
+
+displayio_area_t* displayio_display_core_scroll(displayio_display_core_t* self, uint8_t vertical_scroll_command, bool data_as_commands, const displayio_area_t* scrolled, int16_t dy, displayio_area_t* tail) {
+    int16_t scroll_height = self->area.y2;
+    int16_t vertical_scroll = (self->vertical_scroll - dy) % scroll_height;
+    if (vertical_scroll < 0) {
+        vertical_scroll += scroll_height;
+    }
+    displayio_display_core_set_vertical_scroll(self, vertical_scroll_command, data_as_commands, vertical_scroll);
+
+    // Everything outside of the scrolled area moved with the panel so it must be redrawn.
+    uint8_t count = 0;
+    int16_t width = self->area.x2;
+    tail = _add_scroll_area(self, &count, 0, 0, width, scrolled->y1, tail);
+    tail = _add_scroll_area(self, &count, 0, scrolled->y2, width, scroll_height, tail);
+    tail = _add_scroll_area(self, &count, 0, scrolled->y1, scrolled->x1, scrolled->y2, tail);
+    tail = _add_scroll_area(self, &count, scrolled->x2, scrolled->y1, width, scrolled->y2, tail);
+    // The rows that scrolled into view within the area wrapped from its other edge.
+    if (dy < 0) {
+        tail = _add_scroll_area(self, &count, scrolled->x1, scrolled->y2 + dy, scrolled->x2, scrolled->y2, tail);
+    } else {
+        tail = _add_scroll_area(self, &count, scrolled->x1, scrolled->y1, scrolled->x2, scrolled->y1 + dy, tail);
+    }
+    return tail;
+}
+
 void displayio_display_core_start_refresh(displayio_display_core_t* self) {
     self->last_refresh = ticks_ms;
 }
@@ -45,6 +45,7 @@ typedef struct {
     display_bus_end_transaction end_transaction;
     displayio_buffer_transform_t transform;
     displayio_area_t area;
+    displayio_area_t scroll_areas[5]; // Areas invalidated by the last hardware scroll.
     uint16_t width;
     uint16_t height;
     uint16_t rotation;
@@ -53,6 +54,7 @@ typedef struct {
     _displayio_colorspace_t colorspace;
     int16_t colstart;
     int16_t rowstart;
+    uint16_t vertical_scroll; // First panel row shown at the top of the scroll area.
     bool full_refresh; // New group means we need to refresh the whole display.
 } displayio_display_core_t;
 
@@ -74,6 +76,15 @@ void displayio_display_core_end_transaction(displayio_display_core_t* self);
 
 void displayio_display_core_set_region_to_update(displayio_display_core_t* self, uint8_t column_command, uint8_t row_command, uint16_t set_current_column_command, uint16_t set_current_row_command, bool data_as_commands, bool always_toggle_chip_select, displayio_area_t* area);
 
+// Returns true if the panel can shift its rows in hardware with the given scroll command.
+bool displayio_display_core_can_scroll(displayio_display_core_t* self, uint8_t vertical_scroll_command);
+// Scrolls the panel so that content moves by dy rows. Returns the areas that no longer match the
+// group because they moved with the panel but not in the group, followed by tail.
+displayio_area_t* displayio_display_core_scroll(displayio_display_core_t* self, uint8_t vertical_scroll_command, bool data_as_commands, const displayio_area_t* scrolled, int16_t dy, displayio_area_t* tail);
+void displayio_display_core_set_vertical_scroll(displayio_display_core_t* self, uint8_t vertical_scroll_command, bool data_as_commands, uint16_t vertical_scroll);
+// Returns the number of rows from y until the panel's scrolled rows wrap around.
+uint16_t displayio_display_core_rows_until_wrap(displayio_display_core_t* self, uint16_t y);
+
 void release_display_core(displayio_display_core_t* self);
 
 void displayio_display_core_start_refresh(displayio_display_core_t* self);
@@ -0,0 +1,147 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "shared-bindings/fontio/BinaryFont.h"
+
+#include <string.h>
+
+#include "py/runtime.h"
+
+STATIC uint16_t read_u16(const uint8_t* data) {
+    return data[0] | (data[1] << 8);
+}
+
+STATIC uint32_t read_u32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t) data[3] << 24);
+}
+
+// Checks that the glyph's bitmap lies within the data. Written so that a large offset can't wrap
+// around and pass.
+STATIC bool glyph_in_bounds(const fontio_binaryfont_t *self, const uint8_t* entry) {
+    uint32_t offset = read_u32(entry + 8);
+    size_t glyph_len = ((entry[2] + 7) / 8) * entry[3];
+    return offset <= self->data_len && glyph_len <= self->data_len - offset;
+}
+
+// Points the tables at the font data. The counts come from the header read at construction.
+STATIC void set_tables(fontio_binaryfont_t *self, const uint8_t* data, size_t len) {
+    size_t tables_len = FONTIO_BINARYFONT_HEADER_SIZE +
+                        self->glyph_count * FONTIO_BINARYFONT_GLYPH_SIZE +
+                        self->kerning_count * FONTIO_BINARYFONT_KERNING_SIZE;
+    if (len < tables_len) {
+        mp_raise_ValueError(translate("Invalid font data"));
+    }
+    self->glyphs = data + FONTIO_BINARYFONT_HEADER_SIZE;
+    self->kerning = self->glyphs + self->glyph_count * FONTIO_BINARYFONT_GLYPH_SIZE;
+    self->data = self->kerning + self->kerning_count * FONTIO_BINARYFONT_KERNING_SIZE;
+    self->data_len = len - tables_len;
+}
+
+void common_hal_fontio_binaryfont_construct(fontio_binaryfont_t *self, mp_obj_t buffer, const uint8_t* data, size_t len) {
+    if (len < FONTIO_BINARYFONT_HEADER_SIZE || memcmp(data, "BFNT", 4) != 0) {
+        mp_raise_ValueError(translate("Invalid font data"));
+    }
+    self->buffer = buffer;
+    self->line_height = data[4];
+    self->baseline = data[5];
+    self->max_width = data[6];
+    self->glyph_count = read_u16(data + 8);
+    self->kerning_count = read_u16(data + 10);
+    set_tables(self, data, len);
+
+    // Check the glyph bitmaps up front so bad data is reported when the font is loaded.
+    for (uint16_t i = 0; i < self->glyph_count; i++) {
+        if (!glyph_in_bounds(self, self->glyphs + i * FONTIO_BINARYFONT_GLYPH_SIZE)) {
+            mp_raise_ValueError(translate("Invalid font data"));
+        }
+    }
+}
+
+void fontio_binaryfont_update_buffer(fontio_binaryfont_t *self) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(self->buffer, &bufinfo, MP_BUFFER_READ);
+    set_tables(self, bufinfo.buf, bufinfo.len);
+}
+
+uint16_t common_hal_fontio_binaryfont_get_line_height(fontio_binaryfont_t *self) {
+    return self->line_height;
+}
+
+mp_obj_t common_hal_fontio_binaryfont_get_bounding_box(fontio_binaryfont_t *self) {
+    mp_obj_t items[2] = {
+        MP_OBJ_NEW_SMALL_INT(self->max_width),
+        MP_OBJ_NEW_SMALL_INT(self->line_height)
+    };
+    return mp_obj_new_tuple(2, items);
+}
+
+bool fontio_binaryfont_get_glyph_info(const fontio_binaryfont_t *self, mp_uint_t codepoint, fontio_binaryfont_glyph_t* glyph) {
+    uint16_t lo = 0;
+    uint16_t hi = self->glyph_count;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        const uint8_t* entry = self->glyphs + mid * FONTIO_BINARYFONT_GLYPH_SIZE;
+        mp_uint_t potential_c = read_u16(entry);
+        if (potential_c == codepoint) {
+            // The buffer may have been written to since construction so check the bitmap again.
+            if (!glyph_in_bounds(self, entry)) {
+                return false;
+            }
+            glyph->width = entry[2];
+            glyph->height = entry[3];
+            glyph->x_offset = (int8_t) entry[4];
+            glyph->y_offset = (int8_t) entry[5];
+            glyph->advance = entry[6];
+            glyph->data = self->data + read_u32(entry + 8);
+            return true;
+        } else if (potential_c < codepoint) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return false;
+}
+
+int8_t fontio_binaryfont_get_kerning(const fontio_binaryfont_t *self, mp_uint_t left, mp_uint_t right) {
+    uint32_t pair = (left << 16) | right;
+    uint16_t lo = 0;
+    uint16_t hi = self->kerning_count;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        const uint8_t* entry = self->kerning + mid * FONTIO_BINARYFONT_KERNING_SIZE;
+        uint32_t potential_pair = ((uint32_t) read_u16(entry) << 16) | read_u16(entry + 2);
+        if (potential_pair == pair) {
+            return (int8_t) entry[4];
+        } else if (potential_pair < pair) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_FONTIO_BINARYFONT_H
+#define MICROPY_INCLUDED_SHARED_MODULE_FONTIO_BINARYFONT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+
+// Fonts are stored little endian in the following layout so they can be used straight out of a
+// buffer in flash:
+//
+//   header   "BFNT", line_height (u8), baseline (u8), max_width (u8), reserved (u8),
+//            glyph_count (u16), kerning_count (u16)
+//   glyphs   glyph_count entries sorted by codepoint: codepoint (u16), width (u8), height (u8),
+//            x_offset (i8), y_offset (i8), advance (u8), reserved (u8), data_offset (u32)
+//   kerning  kerning_count entries sorted by left then right codepoint: left (u16),
+//            right (u16), adjust (i8), reserved (u8)
+//   data     one bit per pixel glyph bitmaps, most significant bit first, each row padded to a byte
+//
+// y_offset is relative to the top of the line and data_offset is relative to the start of data.
+#define FONTIO_BINARYFONT_HEADER_SIZE 12
+#define FONTIO_BINARYFONT_GLYPH_SIZE 12
+#define FONTIO_BINARYFONT_KERNING_SIZE 6
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t buffer;
+    const uint8_t* glyphs;
+    const uint8_t* kerning;
+    const uint8_t* data;
+    size_t data_len;
+    uint16_t glyph_count;
+    uint16_t kerning_count;
+    uint8_t line_height;
+    uint8_t baseline;
+    uint8_t max_width;
+} fontio_binaryfont_t;
+
+typedef struct {
+    const uint8_t* data;
+    uint8_t width;
+    uint8_t height;
+    int8_t x_offset;
+    int8_t y_offset;
+    uint8_t advance;
+} fontio_binaryfont_glyph_t;
+
+// Finds the tables in the buffer again. It may have been resized and moved since the last call, so
+// this must be called before looking up glyphs or kerning after any Python code has run.
+void fontio_binaryfont_update_buffer(fontio_binaryfont_t *self);
+// Finds the glyph for codepoint without allocating. Returns false if the font doesn't have it.
+bool fontio_binaryfont_get_glyph_info(const fontio_binaryfont_t *self, mp_uint_t codepoint, fontio_binaryfont_glyph_t* glyph);
+// Returns the advance adjustment between the two codepoints or 0 if the pair isn't kerned.
+int8_t fontio_binaryfont_get_kerning(const fontio_binaryfont_t *self, mp_uint_t left, mp_uint_t right);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_FONTIO_BINARYFONT_H
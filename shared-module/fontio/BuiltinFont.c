@@ -46,20 +46,34 @@ uint8_t fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_
     if (codepoint >= 0x20 && codepoint <= 0x7e) {
         return codepoint - 0x20;
     }
-    // Do a linear search of the mapping for unicode.
-    const byte* j = self->unicode_characters;
-    uint8_t k = 0;
-    while (j < self->unicode_characters + self->unicode_characters_len) {
-        unichar potential_c = utf8_get_char(j);
-        j = utf8_next_char(j);
-        if (codepoint == potential_c) {
-            return 0x7f - 0x20 + k;
+    if (codepoint < 0x80 || codepoint > 0xffff) {
+        return 0xff;
+    }
+    // Binary search the sorted unicode codepoints.
+    uint16_t lo = 0;
+    uint16_t hi = self->unicode_codepoint_count;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        uint16_t potential_c = self->unicode_codepoints[mid];
+        if (potential_c == codepoint) {
+            return 0x7f - 0x20 + mid;
+        } else if (potential_c < codepoint) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
-        k++;
     }
     return 0xff;
 }
 
+mp_obj_t common_hal_fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_uint_t codepoint) {
+    uint8_t glyph_index = fontio_builtinfont_get_glyph_index(self, codepoint);
+    if (glyph_index == 0xff) {
+        return mp_const_none;
+    }
+    return MP_OBJ_NEW_SMALL_INT(glyph_index);
+}
+
 mp_obj_t common_hal_fontio_builtinfont_get_glyph(const fontio_builtinfont_t *self, mp_uint_t codepoint) {
     uint8_t glyph_index = fontio_builtinfont_get_glyph_index(self, codepoint);
     if (glyph_index == 0xff) {
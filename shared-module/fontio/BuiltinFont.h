@@ -38,10 +38,14 @@ typedef struct {
     const displayio_bitmap_t* bitmap;
     uint8_t width;
     uint8_t height;
-    const byte* unicode_characters;
-    uint16_t unicode_characters_len;
+    // Codepoints of the glyphs after ASCII in ascending order so they can be binary searched. The
+    // glyph for unicode_codepoints[i] is at index 0x7f - 0x20 + i.
+    const uint16_t* unicode_codepoints;
+    uint16_t unicode_codepoint_count;
 } fontio_builtinfont_t;
 
+// Returns the index of the codepoint's glyph in the font bitmap or 0xff if there is none. Doesn't
+// allocate so it is safe to call while rendering.
 uint8_t fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_uint_t codepoint);
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_FONTIO_BUILTINFONT_H
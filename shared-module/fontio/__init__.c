@@ -24,4 +24,253 @@
  * THE SOFTWARE.
  */
 
-// Nothing now.
+#include "shared-bindings/fontio/__init__.h"
+
+#include "py/misc.h"
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/displayio/TileGrid.h"
+#include "shared-bindings/fontio/BinaryFont.h"
+#include "shared-bindings/fontio/BuiltinFont.h"
+
+typedef struct {
+    const fontio_builtinfont_t* builtin_font;
+    const fontio_binaryfont_t* binary_font;
+    displayio_bitmap_t* bitmap;
+    displayio_tilegrid_t* tilegrid;
+    uint32_t color;
+    displayio_area_t dirty_area;
+} text_target_t;
+
+typedef struct {
+    fontio_binaryfont_glyph_t binary;
+    uint8_t tile_index;
+    int16_t kerning;
+    uint16_t advance;
+} text_glyph_t;
+
+// Looks up the glyph for c and how far it moves the pen. Kerning is against the previous glyph
+// drawn on the line, or 0 at the start of it.
+STATIC bool _get_glyph(const text_target_t* target, mp_uint_t previous, mp_uint_t c, text_glyph_t* glyph) {
+    glyph->kerning = 0;
+    if (target->builtin_font != NULL) {
+        glyph->tile_index = fontio_builtinfont_get_glyph_index(target->builtin_font, c);
+        if (glyph->tile_index == 0xff) {
+            return false;
+        }
+        glyph->advance = target->tilegrid != NULL ? 1 : target->builtin_font->width;
+        return true;
+    }
+    if (!fontio_binaryfont_get_glyph_info(target->binary_font, c, &glyph->binary)) {
+        return false;
+    }
+    if (previous != 0) {
+        glyph->kerning = fontio_binaryfont_get_kerning(target->binary_font, previous, c);
+    }
+    glyph->advance = glyph->binary.advance;
+    return true;
+}
+
+STATIC void _mark_dirty(text_target_t* target, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    displayio_area_t area = {
+        .x1 = MAX(x1, 0),
+        .y1 = MAX(y1, 0),
+        .x2 = MIN(x2, target->bitmap->width),
+        .y2 = MIN(y2, target->bitmap->height),
+        .next = NULL
+    };
+    if (area.x1 >= area.x2 || area.y1 >= area.y2) {
+        return;
+    }
+    if (target->dirty_area.x1 == target->dirty_area.x2) {
+        displayio_area_copy(&area, &target->dirty_area);
+    } else {
+        displayio_area_expand(&target->dirty_area, &area);
+    }
+}
+
+STATIC void _draw_glyph(text_target_t* target, const text_glyph_t* glyph, int32_t pen_x, int32_t top) {
+    displayio_bitmap_t* bitmap = target->bitmap;
+    if (target->builtin_font != NULL) {
+        const fontio_builtinfont_t* font = target->builtin_font;
+        displayio_bitmap_t* font_bitmap = (displayio_bitmap_t*) font->bitmap;
+        uint16_t tiles_per_row = font_bitmap->width / font->width;
+        int16_t source_x = (glyph->tile_index % tiles_per_row) * font->width;
+        int16_t source_y = (glyph->tile_index / tiles_per_row) * font->height;
+        for (int32_t j = 0; j < font->height; j++) {
+            int32_t y = top + j;
+            if (y < 0 || y >= bitmap->height) {
+                continue;
+            }
+            for (int32_t i = 0; i < font->width; i++) {
+                int32_t x = pen_x + i;
+                if (x < 0 || x >= bitmap->width) {
+                    continue;
+                }
+                if (common_hal_displayio_bitmap_get_pixel(font_bitmap, source_x + i, source_y + j) != 0) {
+                    displayio_bitmap_write_pixel(bitmap, x, y, target->color);
+                }
+            }
+        }
+        _mark_dirty(target, pen_x, top, pen_x + font->width, top + font->height);
+        return;
+    }
+    const fontio_binaryfont_glyph_t* g = &glyph->binary;
+    int32_t left = pen_x + g->x_offset;
+    int32_t glyph_top = top + g->y_offset;
+    uint8_t row_bytes = (g->width + 7) / 8;
+    for (int32_t j = 0; j < g->height; j++) {
+        int32_t y = glyph_top + j;
+        if (y < 0 || y >= bitmap->height) {
+            continue;
+        }
+        const uint8_t* row = g->data + j * row_bytes;
+        for (int32_t i = 0; i < g->width; i++) {
+            int32_t x = left + i;
+            if (x < 0 || x >= bitmap->width) {
+                continue;
+            }
+            if ((row[i / 8] & (0x80 >> (i % 8))) != 0) {
+                displayio_bitmap_write_pixel(bitmap, x, y, target->color);
+            }
+        }
+    }
+    _mark_dirty(target, left, glyph_top, left + g->width, glyph_top + g->height);
+}
+
+// Tiles are written to a TileGrid in runs of at most this many.
+#define TILE_BUFFER_SIZE (32)
+
+STATIC void _draw_line(text_target_t* target, const byte* text, const byte* end, int32_t x, int32_t top) {
+    displayio_tilegrid_t* tilegrid = target->tilegrid;
+    if (tilegrid != NULL && (top < 0 || top >= tilegrid->height_in_tiles)) {
+        return;
+    }
+    // Tiles are queued up and written to the TileGrid in runs. Every glyph is one tile wide so the
+    // visible ones are contiguous.
+    uint8_t tiles[TILE_BUFFER_SIZE];
+    uint16_t tile_count = 0;
+    int32_t first_tile = -1;
+
+    mp_uint_t previous = 0;
+    int32_t pen_x = x;
+    for (const byte* s = text; s < end; s = utf8_next_char(s)) {
+        unichar c = utf8_get_char(s);
+        text_glyph_t glyph;
+        if (!_get_glyph(target, previous, c, &glyph)) {
+            continue;
+        }
+        pen_x += glyph.kerning;
+        if (tilegrid != NULL) {
+            if (pen_x >= 0 && pen_x < tilegrid->width_in_tiles) {
+                if (first_tile < 0) {
+                    first_tile = pen_x;
+                }
+                if (tile_count == TILE_BUFFER_SIZE) {
+                    common_hal_displayio_tilegrid_set_tiles(tilegrid, first_tile, top, tiles, tile_count);
+                    first_tile += tile_count;
+                    tile_count = 0;
+                }
+                tiles[tile_count++] = glyph.tile_index;
+            }
+        } else {
+            _draw_glyph(target, &glyph, pen_x, top);
+        }
+        pen_x += glyph.advance;
+        previous = c;
+    }
+    if (tile_count > 0) {
+        common_hal_displayio_tilegrid_set_tiles(tilegrid, first_tile, top, tiles, tile_count);
+    }
+}
+
+void common_hal_fontio_render_text(const uint8_t* text, size_t len, mp_obj_t font, mp_obj_t target_obj,
+        int16_t x, int16_t y, uint16_t max_width, uint32_t color, uint16_t* width, uint16_t* height) {
+    text_target_t target = {
+        .builtin_font = NULL,
+        .binary_font = NULL,
+        .bitmap = NULL,
+        .tilegrid = NULL,
+        .color = color,
+        .dirty_area = {0, 0, 0, 0, NULL}
+    };
+    if (MP_OBJ_IS_TYPE(font, &fontio_builtinfont_type)) {
+        target.builtin_font = MP_OBJ_TO_PTR(font);
+    } else {
+        fontio_binaryfont_t* binary_font = MP_OBJ_TO_PTR(font);
+        fontio_binaryfont_update_buffer(binary_font);
+        target.binary_font = binary_font;
+    }
+    if (MP_OBJ_IS_TYPE(target_obj, &displayio_tilegrid_type)) {
+        target.tilegrid = MP_OBJ_TO_PTR(target_obj);
+    } else {
+        target.bitmap = MP_OBJ_TO_PTR(target_obj);
+    }
+
+    uint16_t line_height;
+    if (target.tilegrid != NULL) {
+        line_height = 1;
+    } else if (target.builtin_font != NULL) {
+        line_height = target.builtin_font->height;
+    } else {
+        line_height = target.binary_font->line_height;
+    }
+
+    const byte* s = text;
+    const byte* end = text + len;
+    int32_t widest = 0;
+    uint16_t line_count = 0;
+    while (s < end) {
+        // Measure how much fits on this line. Wrap at the last space that fits or, when a single
+        // word is too long, right before the character that doesn't fit.
+        const byte* line_end = end;
+        const byte* next_line = end;
+        const byte* space = NULL;
+        int32_t width_before_space = 0;
+        int32_t line_width = 0;
+        mp_uint_t previous = 0;
+        for (const byte* p = s; p < end; p = utf8_next_char(p)) {
+            unichar c = utf8_get_char(p);
+            if (c == '\n') {
+                line_end = p;
+                next_line = p + 1;
+                break;
+            }
+            text_glyph_t glyph;
+            if (!_get_glyph(&target, previous, c, &glyph)) {
+                continue;
+            }
+            int32_t advance = glyph.kerning + glyph.advance;
+            if (max_width > 0 && previous != 0 && line_width + advance > max_width) {
+                if (c == ' ') {
+                    line_end = p;
+                    next_line = p + 1;
+                } else if (space != NULL) {
+                    line_end = space;
+                    next_line = space + 1;
+                    line_width = width_before_space;
+                } else {
+                    line_end = p;
+                    next_line = p;
+                }
+                break;
+            }
+            if (c == ' ') {
+                space = p;
+                width_before_space = line_width;
+            }
+            line_width += advance;
+            previous = c;
+        }
+
+        _draw_line(&target, s, line_end, x, y + line_count * line_height);
+        widest = MAX(widest, line_width);
+        line_count++;
+        s = next_line;
+    }
+
+    if (target.bitmap != NULL) {
+        displayio_bitmap_expand_dirty_area(target.bitmap, &target.dirty_area);
+    }
+    *width = widest;
+    *height = line_count * line_height;
+}
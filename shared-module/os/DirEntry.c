@@ -0,0 +1,76 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "extmod/vfs.h"
+#include "py/runtime.h"
+#include "shared-bindings/os/__init__.h"
+#include "shared-bindings/os/DirEntry.h"
+
+void common_hal_os_direntry_construct(os_direntry_obj_t* self, mp_obj_t path, mp_obj_t entry) {
+    size_t len;
+    mp_obj_t *items;
+    mp_obj_tuple_get(entry, &len, &items);
+
+    self->name = items[0];
+    self->path = path;
+    self->mode = mp_obj_get_int(items[1]);
+    // Mount points listed in the root directory don't come with a size.
+    self->size = len > 3 ? items[3] : MP_OBJ_NEW_SMALL_INT(0);
+    self->mtime = len > 4 ? items[4] : MP_OBJ_NULL;
+}
+
+mp_obj_t common_hal_os_direntry_get_name(os_direntry_obj_t* self) {
+    return self->name;
+}
+
+mp_obj_t common_hal_os_direntry_get_path(os_direntry_obj_t* self) {
+    return self->path;
+}
+
+bool common_hal_os_direntry_is_dir(os_direntry_obj_t* self) {
+    return (self->mode & MP_S_IFDIR) != 0;
+}
+
+bool common_hal_os_direntry_is_file(os_direntry_obj_t* self) {
+    return (self->mode & MP_S_IFREG) != 0;
+}
+
+mp_obj_t common_hal_os_direntry_stat(os_direntry_obj_t* self) {
+    if (self->mtime == MP_OBJ_NULL) {
+        return common_hal_os_stat(mp_obj_str_get_str(self->path));
+    }
+    mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(10, NULL));
+    t->items[0] = MP_OBJ_NEW_SMALL_INT(self->mode); // st_mode
+    for (int i = 1; i <= 5; ++i) {
+        t->items[i] = MP_OBJ_NEW_SMALL_INT(0); // ino, dev, nlink, uid, gid
+    }
+    t->items[6] = self->size; // st_size
+    t->items[7] = self->mtime; // st_atime
+    t->items[8] = self->mtime; // st_mtime
+    t->items[9] = self->mtime; // st_ctime
+    return MP_OBJ_FROM_PTR(t);
+}
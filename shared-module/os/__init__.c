@@ -29,12 +29,16 @@
 #include <string.h>
 
 #include "extmod/vfs.h"
+#include "extmod/vfs_fat.h"
 #include "py/mperrno.h"
 #include "py/mpstate.h"
+#include "py/nlr.h"
 #include "py/obj.h"
+#include "py/objlist.h"
 #include "py/objstr.h"
 #include "py/runtime.h"
 #include "shared-bindings/os/__init__.h"
+#include "shared-bindings/os/DirEntry.h"
 
 // This provides all VFS related OS functions so that ports can share the code
 // as needed. It does not provide uname.
@@ -105,23 +109,36 @@ mp_obj_t common_hal_os_getcwd(void) {
     return mp_vfs_getcwd();
 }
 
-mp_obj_t common_hal_os_listdir(const char* path) {
+// Returns an iterator of ilistdir tuples for path. FAT filesystems are listed directly rather
+// than through a method lookup and, when with_mtime is set, their entries also carry the
+// modification time.
+STATIC mp_obj_t open_dir(const char* path, bool with_mtime) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_dir_path(path, &path_out);
 
-    mp_vfs_ilistdir_it_t iter;
-    mp_obj_t iter_obj = MP_OBJ_FROM_PTR(&iter);
-
     if (vfs == MP_VFS_ROOT) {
         // list the root directory
-        iter.base.type = &mp_type_polymorph_iter;
-        iter.iternext = mp_vfs_ilistdir_it_iternext;
-        iter.cur.vfs = MP_STATE_VM(vfs_mount_table);
-        iter.is_str = true;
-        iter.is_iter = false;
-    } else {
-        iter_obj = mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 1, &path_out);
+        mp_vfs_ilistdir_it_t *iter = m_new_obj(mp_vfs_ilistdir_it_t);
+        iter->base.type = &mp_type_polymorph_iter;
+        iter->iternext = mp_vfs_ilistdir_it_iternext;
+        iter->cur.vfs = MP_STATE_VM(vfs_mount_table);
+        iter->is_str = true;
+        iter->is_iter = false;
+        return MP_OBJ_FROM_PTR(iter);
+    }
+    if (vfs != MP_VFS_NONE && mp_obj_get_type(vfs->obj) == &mp_fat_vfs_type) {
+        fs_user_mount_t *fs = MP_OBJ_TO_PTR(vfs->obj);
+        const char *fs_path = mp_obj_str_get_str(path_out);
+        if (with_mtime) {
+            return fat_vfs_scandir(fs, fs_path);
+        }
+        return fat_vfs_ilistdir2(fs, fs_path, true);
     }
+    return mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 1, &path_out);
+}
+
+mp_obj_t common_hal_os_listdir(const char* path) {
+    mp_obj_t iter_obj = open_dir(path, false);
 
     mp_obj_t dir_list = mp_obj_new_list(0, NULL);
     mp_obj_t next;
@@ -133,6 +150,124 @@ mp_obj_t common_hal_os_listdir(const char* path) {
     return dir_list;
 }
 
+STATIC mp_obj_t join_path(mp_obj_t dir_path, mp_obj_t name) {
+    size_t dir_len;
+    const char* dir = mp_obj_str_get_data(dir_path, &dir_len);
+    size_t name_len;
+    const char* name_str = mp_obj_str_get_data(name, &name_len);
+    vstr_t path;
+    vstr_init(&path, dir_len + 1 + name_len);
+    vstr_add_strn(&path, dir, dir_len);
+    if (dir_len > 0 && dir[dir_len - 1] != '/') {
+        vstr_add_byte(&path, '/');
+    }
+    vstr_add_strn(&path, name_str, name_len);
+    return mp_obj_new_str_from_vstr(&mp_type_str, &path);
+}
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_fun_1_t iternext;
+    mp_obj_t iter;
+    mp_obj_t path;
+} os_scandir_it_t;
+
+STATIC mp_obj_t os_scandir_it_iternext(mp_obj_t self_in) {
+    os_scandir_it_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t next = mp_iternext(self->iter);
+    if (next == MP_OBJ_STOP_ITERATION) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    os_direntry_obj_t *entry = m_new_obj(os_direntry_obj_t);
+    entry->base.type = &os_direntry_type;
+    mp_obj_t name = mp_obj_subscr(next, MP_OBJ_NEW_SMALL_INT(0), MP_OBJ_SENTINEL);
+    common_hal_os_direntry_construct(entry, join_path(self->path, name), next);
+    return MP_OBJ_FROM_PTR(entry);
+}
+
+mp_obj_t common_hal_os_scandir(mp_obj_t path) {
+    os_scandir_it_t *iter = m_new_obj(os_scandir_it_t);
+    iter->base.type = &mp_type_polymorph_iter;
+    iter->iternext = os_scandir_it_iternext;
+    iter->iter = open_dir(mp_obj_str_get_str(path), true);
+    iter->path = path;
+    return MP_OBJ_FROM_PTR(iter);
+}
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_fun_1_t iternext;
+    // Directories still to visit. The next one is at the end.
+    mp_obj_list_t *pending;
+    // What was yielded last. Subdirectories are queued from dirnames only when the next
+    // directory is asked for so that the caller can prune it first.
+    mp_obj_t dirpath;
+    mp_obj_t dirnames;
+} os_walk_it_t;
+
+STATIC mp_obj_t os_walk_it_iternext(mp_obj_t self_in) {
+    os_walk_it_t *self = MP_OBJ_TO_PTR(self_in);
+
+    if (self->dirnames != MP_OBJ_NULL) {
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_list_get(self->dirnames, &len, &items);
+        // Push in reverse so the first subdirectory is visited first.
+        for (size_t i = len; i > 0; i--) {
+            mp_obj_list_append(MP_OBJ_FROM_PTR(self->pending), join_path(self->dirpath, items[i - 1]));
+        }
+        self->dirnames = MP_OBJ_NULL;
+    }
+
+    while (self->pending->len > 0) {
+        mp_obj_t dirpath = self->pending->items[--self->pending->len];
+        self->pending->items[self->pending->len] = MP_OBJ_NULL;
+
+        mp_obj_t dirnames = mp_obj_new_list(0, NULL);
+        mp_obj_t filenames = mp_obj_new_list(0, NULL);
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            // The directory is read once; the type of each entry comes from its listing.
+            mp_obj_t iter = open_dir(mp_obj_str_get_str(dirpath), false);
+            mp_obj_t next;
+            while ((next = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
+                size_t len;
+                mp_obj_t *items;
+                mp_obj_tuple_get(next, &len, &items);
+                if (mp_obj_get_int(items[1]) & MP_S_IFDIR) {
+                    mp_obj_list_append(dirnames, items[0]);
+                } else {
+                    mp_obj_list_append(filenames, items[0]);
+                }
+                RUN_BACKGROUND_TASKS;
+            }
+            nlr_pop();
+        } else {
+            // Like CPython, skip directories that can't be listed.
+            if (!mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(((mp_obj_base_t*)nlr.ret_val)->type), MP_OBJ_FROM_PTR(&mp_type_OSError))) {
+                nlr_jump(nlr.ret_val);
+            }
+            continue;
+        }
+
+        self->dirpath = dirpath;
+        self->dirnames = dirnames;
+        mp_obj_t t[3] = { dirpath, dirnames, filenames };
+        return mp_obj_new_tuple(3, t);
+    }
+    return MP_OBJ_STOP_ITERATION;
+}
+
+mp_obj_t common_hal_os_walk(mp_obj_t top) {
+    os_walk_it_t *iter = m_new_obj(os_walk_it_t);
+    iter->base.type = &mp_type_polymorph_iter;
+    iter->iternext = os_walk_it_iternext;
+    iter->pending = MP_OBJ_TO_PTR(mp_obj_new_list(1, &top));
+    iter->dirpath = MP_OBJ_NULL;
+    iter->dirnames = MP_OBJ_NULL;
+    return MP_OBJ_FROM_PTR(iter);
+}
+
 void common_hal_os_mkdir(const char* path) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_dir_path(path, &path_out);
@@ -0,0 +1,226 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "py/binary.h"
+#include "py/runtime.h"
+#include "shared-bindings/os/__init__.h"
+#include "shared-bindings/random/Random.h"
+#include "shared-bindings/time/__init__.h"
+
+#if CIRCUITPY_RANDOM_XOSHIRO
+
+// xoshiro128++ 1.0
+// by David Blackman and Sebastiano Vigna
+// http://prng.di.unimi.it/xoshiro128plusplus.c
+// Public Domain
+
+static inline uint32_t rotl(const uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+STATIC uint32_t xoshiro128plusplus(random_random_obj_t* self) {
+    uint32_t *s = self->s;
+    const uint32_t result = rotl(s[0] + s[3], 7) + s[0];
+    const uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 11);
+    return result;
+}
+
+// End of xoshiro128++
+
+void common_hal_random_random_seed(random_random_obj_t* self, mp_uint_t seed) {
+    // Spread the seed over the whole state with the SplitMix32 sequence so similar seeds give
+    // unrelated streams. The state can't end up all zero because the mix is a bijection.
+    uint32_t x = seed;
+    for (uint8_t i = 0; i < 4; i++) {
+        x += 0x9e3779b9;
+        uint32_t z = x;
+        z = (z ^ (z >> 16)) * 0x85ebca6b;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35;
+        self->s[i] = z ^ (z >> 16);
+    }
+    self->seeded = true;
+}
+
+#else
+
+// Yasmarang random number generator
+// by Ilya Levin
+// http://www.literatecode.com/yasmarang
+// Public Domain
+
+STATIC uint32_t yasmarang(random_random_obj_t* self)
+{
+   self->pad += self->dat + self->d * self->n;
+   self->pad = (self->pad<<3) + (self->pad>>29);
+   self->n = self->pad | 2;
+   self->d ^= (self->pad<<31) + (self->pad>>1);
+   self->dat ^= (char) self->pad ^ (self->d>>8) ^ 1;
+
+   return (self->pad^(self->d<<5)^(self->pad>>18)^(self->dat<<1));
+}  /* yasmarang */
+
+// End of Yasmarang
+
+void common_hal_random_random_seed(random_random_obj_t* self, mp_uint_t seed) {
+    self->pad = seed;
+    self->n = 69;
+    self->d = 233;
+    self->dat = 0;
+    self->seeded = true;
+}
+
+#endif
+
+STATIC uint32_t random_next(random_random_obj_t* self) {
+    if (!self->seeded) {
+        uint32_t seed;
+        if (!common_hal_os_urandom((uint8_t *)&seed, sizeof(uint32_t))) {
+            seed = common_hal_time_monotonic() & 0xffffffff;
+        }
+        common_hal_random_random_seed(self, seed);
+    }
+    #if CIRCUITPY_RANDOM_XOSHIRO
+    return xoshiro128plusplus(self);
+    #else
+    return yasmarang(self);
+    #endif
+}
+
+void common_hal_random_random_construct(random_random_obj_t* self) {
+    self->seeded = false;
+}
+
+// returns the smallest all ones mask that covers n - 1
+// n must not be zero
+STATIC uint32_t random_mask_below(uint32_t n) {
+    uint32_t mask = 1;
+    while ((n & mask) < n) {
+        mask = (mask << 1) | 1;
+    }
+    return mask;
+}
+
+// returns an unsigned integer below n using mask from random_mask_below(n)
+STATIC uint32_t random_below(random_random_obj_t* self, uint32_t n, uint32_t mask) {
+    uint32_t r;
+    do {
+        r = random_next(self) & mask;
+    } while (r >= n);
+    return r;
+}
+
+uint32_t common_hal_random_random_getrandbits(random_random_obj_t* self, uint8_t n) {
+    uint32_t mask = ~0;
+    // Beware of C undefined behavior when shifting by >= than bit size
+    mask >>= (32 - n);
+    return random_next(self) & mask;
+}
+
+mp_int_t common_hal_random_random_randrange(random_random_obj_t* self, mp_int_t start, mp_int_t stop, mp_int_t step) {
+    mp_int_t n;
+    if (step > 0) {
+        n = (stop - start + step - 1) / step;
+    } else {
+        n = (stop - start + step + 1) / step;
+    }
+    return start + step * random_below(self, n, random_mask_below(n));
+}
+
+// returns a number in the range [0..1) using the generator to fill in the fraction bits
+mp_float_t common_hal_random_random_random(random_random_obj_t* self) {
+    #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+    typedef uint64_t mp_float_int_t;
+    #elif MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
+    typedef uint32_t mp_float_int_t;
+    #endif
+    union {
+        mp_float_t f;
+        #if MP_ENDIANNESS_LITTLE
+        struct { mp_float_int_t frc:MP_FLOAT_FRAC_BITS, exp:MP_FLOAT_EXP_BITS, sgn:1; } p;
+        #else
+        struct { mp_float_int_t sgn:1, exp:MP_FLOAT_EXP_BITS, frc:MP_FLOAT_FRAC_BITS; } p;
+        #endif
+    } u;
+    u.p.sgn = 0;
+    u.p.exp = (1 << (MP_FLOAT_EXP_BITS - 1)) - 1;
+    if (MP_FLOAT_FRAC_BITS <= 32) {
+        u.p.frc = random_next(self);
+    } else {
+        u.p.frc = ((uint64_t)random_next(self) << 32) | (uint64_t)random_next(self);
+    }
+    return u.f - 1;
+}
+
+mp_float_t common_hal_random_random_uniform(random_random_obj_t* self, mp_float_t a, mp_float_t b) {
+    return a + (b - a) * common_hal_random_random_random(self);
+}
+
+void common_hal_random_random_fill_bytes(random_random_obj_t* self, uint8_t* buffer, size_t len) {
+    while (len >= sizeof(uint32_t)) {
+        uint32_t r = random_next(self);
+        memcpy(buffer, &r, sizeof(uint32_t));
+        buffer += sizeof(uint32_t);
+        len -= sizeof(uint32_t);
+    }
+    if (len > 0) {
+        uint32_t r = random_next(self);
+        memcpy(buffer, &r, len);
+    }
+}
+
+void common_hal_random_random_fill_randrange(random_random_obj_t* self, char typecode, void* buffer, size_t count, mp_int_t start, mp_int_t stop) {
+    uint32_t n = (mp_uint_t) stop - (mp_uint_t) start;
+    uint32_t mask = random_mask_below(n);
+    for (size_t i = 0; i < count; i++) {
+        mp_binary_set_val_array_from_int(typecode, buffer, i, start + random_below(self, n, mask));
+    }
+}
+
+void common_hal_random_random_fill_uniform(random_random_obj_t* self, char typecode, void* buffer, size_t count, mp_float_t a, mp_float_t b) {
+    mp_float_t range = b - a;
+    if (typecode == 'f') {
+        float *values = buffer;
+        for (size_t i = 0; i < count; i++) {
+            // 24 random bits fill the float mantissa exactly.
+            values[i] = a + range * ((random_next(self) >> 8) * (1.0f / (1 << 24)));
+        }
+    } else {
+        double *values = buffer;
+        for (size_t i = 0; i < count; i++) {
+            // Likewise 53 bits for a double.
+            uint64_t bits = ((uint64_t) (random_next(self) >> 5) << 26) | (random_next(self) >> 6);
+            values[i] = a + range * (bits * (1.0 / ((uint64_t) 1 << 53)));
+        }
+    }
+}
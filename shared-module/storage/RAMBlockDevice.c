@@ -0,0 +1,56 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <string.h>
+
+#include "py/misc.h"
+#include "shared-bindings/storage/RAMBlockDevice.h"
+
+void common_hal_storage_ramblockdevice_construct(storage_ramblockdevice_obj_t* self, uint32_t block_count) {
+    self->blocks = m_new(uint8_t, (size_t) block_count * FILESYSTEM_BLOCK_SIZE);
+    self->block_count = block_count;
+}
+
+uint32_t common_hal_storage_ramblockdevice_get_block_count(storage_ramblockdevice_obj_t* self) {
+    return self->block_count;
+}
+
+bool common_hal_storage_ramblockdevice_readblocks(storage_ramblockdevice_obj_t* self, uint32_t block_num, uint8_t* buffer, uint32_t num_blocks) {
+    if (block_num >= self->block_count || num_blocks > self->block_count - block_num) {
+        return false;
+    }
+    memcpy(buffer, self->blocks + block_num * FILESYSTEM_BLOCK_SIZE, num_blocks * FILESYSTEM_BLOCK_SIZE);
+    return true;
+}
+
+bool common_hal_storage_ramblockdevice_writeblocks(storage_ramblockdevice_obj_t* self, uint32_t block_num, const uint8_t* buffer, uint32_t num_blocks) {
+    if (block_num >= self->block_count || num_blocks > self->block_count - block_num) {
+        return false;
+    }
+    memcpy(self->blocks + block_num * FILESYSTEM_BLOCK_SIZE, buffer, num_blocks * FILESYSTEM_BLOCK_SIZE);
+    return true;
+}
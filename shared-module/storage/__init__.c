@@ -36,7 +36,6 @@
 #include "shared-bindings/os/__init__.h"
 #include "shared-bindings/storage/__init__.h"
 #include "supervisor/filesystem.h"
-#include "supervisor/flash.h"
 #include "supervisor/usb.h"
 
 STATIC mp_obj_t mp_vfs_proxy_call(mp_vfs_mount_t *vfs, qstr meth_name, size_t n_args, const mp_obj_t *args) {
@@ -0,0 +1,207 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/synthio/Synthesizer.h"
+#include "shared-bindings/synthio/Voice.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+
+#define DEFAULT_WAVEFORM_LENGTH (256)
+
+#ifndef MP_PI
+#define MP_PI MICROPY_FLOAT_CONST(3.14159265358979323846)
+#endif
+
+void common_hal_synthio_synthesizer_construct(synthio_synthesizer_obj_t* self,
+                                              uint8_t voice_count,
+                                              uint32_t buffer_size,
+                                              uint32_t sample_rate) {
+    self->len = buffer_size / 2 / sizeof(uint32_t) * sizeof(uint32_t);
+
+    self->first_buffer = m_malloc(self->len, false);
+    if (self->first_buffer == NULL) {
+        common_hal_synthio_synthesizer_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate first buffer"));
+    }
+
+    self->second_buffer = m_malloc(self->len, false);
+    if (self->second_buffer == NULL) {
+        common_hal_synthio_synthesizer_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate second buffer"));
+    }
+
+    self->sample_rate = sample_rate;
+    self->voice_count = voice_count;
+
+    // Fall back to a sine wave.
+    self->sine = m_malloc(DEFAULT_WAVEFORM_LENGTH * sizeof(int16_t), false);
+    for (uint32_t i = 0; i < DEFAULT_WAVEFORM_LENGTH; i++) {
+        self->sine[i] = MICROPY_FLOAT_C_FUN(sin)(2 * MP_PI * i / DEFAULT_WAVEFORM_LENGTH) * INT16_MAX;
+    }
+    self->waveform_obj = MP_OBJ_NULL;
+    self->waveform = self->sine;
+    self->waveform_length = DEFAULT_WAVEFORM_LENGTH;
+}
+
+void common_hal_synthio_synthesizer_deinit(synthio_synthesizer_obj_t* self) {
+    self->first_buffer = NULL;
+    self->second_buffer = NULL;
+}
+
+bool common_hal_synthio_synthesizer_deinited(synthio_synthesizer_obj_t* self) {
+    return self->first_buffer == NULL;
+}
+
+uint32_t common_hal_synthio_synthesizer_get_sample_rate(synthio_synthesizer_obj_t* self) {
+    return self->sample_rate;
+}
+
+bool common_hal_synthio_synthesizer_get_playing(synthio_synthesizer_obj_t* self) {
+    for (uint8_t v = 0; v < self->voice_count; v++) {
+        if (common_hal_synthio_voice_get_playing(MP_OBJ_TO_PTR(self->voice[v]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+mp_obj_t common_hal_synthio_synthesizer_get_waveform(synthio_synthesizer_obj_t* self) {
+    if (self->waveform_obj == MP_OBJ_NULL) {
+        return mp_const_none;
+    }
+    return self->waveform_obj;
+}
+
+void common_hal_synthio_synthesizer_set_waveform(synthio_synthesizer_obj_t* self, mp_obj_t waveform_obj) {
+    // The buffer itself is looked up when the next buffer is rendered.
+    self->waveform_obj = waveform_obj;
+}
+
+// Looks up the samples of a waveform array. Arrays too short to interpolate give NULL.
+static void get_waveform(mp_obj_t waveform_obj, const int16_t** waveform, uint32_t* waveform_length) {
+    mp_buffer_info_t bufinfo;
+    if (!mp_get_buffer(waveform_obj, &bufinfo, MP_BUFFER_READ) || bufinfo.len / sizeof(int16_t) < 2) {
+        *waveform = NULL;
+        *waveform_length = 0;
+        return;
+    }
+    *waveform = bufinfo.buf;
+    *waveform_length = bufinfo.len / sizeof(int16_t);
+}
+
+void synthio_synthesizer_reset_buffer(synthio_synthesizer_obj_t* self,
+                                      bool single_channel,
+                                      uint8_t channel) {
+    (void)single_channel;
+    (void)channel;
+    for (uint8_t v = 0; v < self->voice_count; v++) {
+        synthio_voice_obj_t* voice = MP_OBJ_TO_PTR(self->voice[v]);
+        voice->phase = 0;
+    }
+}
+
+audioio_get_buffer_result_t synthio_synthesizer_get_buffer(synthio_synthesizer_obj_t* self,
+                                                           bool single_channel,
+                                                           uint8_t channel,
+                                                           uint8_t** buffer,
+                                                           uint32_t* buffer_length) {
+    if (!single_channel) {
+        channel = 0;
+    }
+
+    uint32_t channel_read_count = self->left_read_count;
+    if (channel == 1) {
+        channel_read_count = self->right_read_count;
+    }
+    *buffer_length = self->len;
+
+    bool need_more_data = self->read_count == channel_read_count;
+    if (need_more_data) {
+        int16_t* sample_buffer;
+        if (self->use_first_buffer) {
+            sample_buffer = self->first_buffer;
+        } else {
+            sample_buffer = self->second_buffer;
+        }
+        *buffer = (uint8_t*) sample_buffer;
+        self->use_first_buffer = !self->use_first_buffer;
+
+        // Arrays can be resized, which may move them, while we play so look up every waveform
+        // again before using it.
+        if (self->waveform_obj == MP_OBJ_NULL) {
+            self->waveform = self->sine;
+            self->waveform_length = DEFAULT_WAVEFORM_LENGTH;
+        } else {
+            get_waveform(self->waveform_obj, &self->waveform, &self->waveform_length);
+        }
+
+        uint32_t frame_count = self->len / sizeof(int16_t);
+        bool voices_active = false;
+        for (uint8_t v = 0; v < self->voice_count; v++) {
+            synthio_voice_obj_t* voice = MP_OBJ_TO_PTR(self->voice[v]);
+            // Skip voices that are silent for the whole buffer.
+            if (!voice->pressed && voice->current_amplitude == 0) {
+                continue;
+            }
+            if (voice->waveform_obj != MP_OBJ_NULL) {
+                get_waveform(voice->waveform_obj, &voice->waveform, &voice->waveform_length);
+            }
+            // The first voice writes the buffer and the rest add to it.
+            synthio_voice_render(voice, sample_buffer, frame_count, !voices_active);
+            voices_active = true;
+        }
+        if (!voices_active) {
+            memset(sample_buffer, 0, self->len);
+        }
+
+        self->read_count += 1;
+    } else if (!self->use_first_buffer) {
+        *buffer = (uint8_t*) self->first_buffer;
+    } else {
+        *buffer = (uint8_t*) self->second_buffer;
+    }
+
+    if (channel == 0) {
+        self->left_read_count += 1;
+    } else if (channel == 1) {
+        self->right_read_count += 1;
+    }
+    return GET_BUFFER_MORE_DATA;
+}
+
+void synthio_synthesizer_get_buffer_structure(synthio_synthesizer_obj_t* self, bool single_channel,
+                                              bool* single_buffer, bool* samples_signed,
+                                              uint32_t* max_buffer_length, uint8_t* spacing) {
+    (void)single_channel;
+    *single_buffer = false;
+    *samples_signed = true;
+    *max_buffer_length = self->len;
+    *spacing = 1;
+}
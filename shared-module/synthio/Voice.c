@@ -0,0 +1,144 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/synthio/Voice.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+
+void common_hal_synthio_voice_construct(synthio_voice_obj_t* self) {
+    self->waveform_obj = MP_OBJ_NULL;
+    self->waveform = NULL;
+    self->waveform_length = 0;
+    self->frequency = 440;
+    self->phase = 0;
+    self->amplitude = INT16_MAX;
+    self->current_amplitude = 0;
+    self->pressed = false;
+}
+
+void common_hal_synthio_voice_set_parent(synthio_voice_obj_t* self, synthio_synthesizer_obj_t* parent) {
+    self->parent = parent;
+    common_hal_synthio_voice_set_frequency(self, self->frequency);
+}
+
+void common_hal_synthio_voice_note_on(synthio_voice_obj_t* self, mp_float_t frequency, mp_float_t amplitude) {
+    common_hal_synthio_voice_set_frequency(self, frequency);
+    common_hal_synthio_voice_set_amplitude(self, amplitude);
+    self->pressed = true;
+}
+
+void common_hal_synthio_voice_note_off(synthio_voice_obj_t* self) {
+    self->pressed = false;
+}
+
+bool common_hal_synthio_voice_get_playing(synthio_voice_obj_t* self) {
+    return self->pressed || self->current_amplitude != 0;
+}
+
+mp_float_t common_hal_synthio_voice_get_frequency(synthio_voice_obj_t* self) {
+    return self->frequency;
+}
+
+void common_hal_synthio_voice_set_frequency(synthio_voice_obj_t* self, mp_float_t frequency) {
+    self->frequency = frequency;
+    // Only the step changes so the waveform continues from where it is without a click.
+    self->phase_step = frequency / self->parent->sample_rate * MICROPY_FLOAT_CONST(4294967296.0);
+}
+
+mp_float_t common_hal_synthio_voice_get_amplitude(synthio_voice_obj_t* self) {
+    return (mp_float_t) self->amplitude / INT16_MAX;
+}
+
+void common_hal_synthio_voice_set_amplitude(synthio_voice_obj_t* self, mp_float_t amplitude) {
+    self->amplitude = amplitude * INT16_MAX;
+}
+
+mp_obj_t common_hal_synthio_voice_get_waveform(synthio_voice_obj_t* self) {
+    if (self->waveform_obj == MP_OBJ_NULL) {
+        return mp_const_none;
+    }
+    return self->waveform_obj;
+}
+
+void common_hal_synthio_voice_set_waveform(synthio_voice_obj_t* self, mp_obj_t waveform_obj) {
+    // The buffer itself is looked up when the next buffer is rendered.
+    self->waveform_obj = waveform_obj;
+}
+
+void synthio_voice_render(synthio_voice_obj_t* self, int16_t* out, uint32_t frame_count, bool first) {
+    int16_t target = self->pressed ? self->amplitude : 0;
+    const int16_t* table = self->waveform;
+    uint32_t length = self->waveform_length;
+    if (self->waveform_obj == MP_OBJ_NULL) {
+        table = self->parent->waveform;
+        length = self->parent->waveform_length;
+    }
+    if (table == NULL) {
+        // The array was shortened too much to play.
+        if (first) {
+            memset(out, 0, frame_count * sizeof(int16_t));
+        }
+        self->current_amplitude = target;
+        return;
+    }
+    // Amplitude changes, including note on and off, ramp across the buffer to avoid clicks.
+    int32_t amplitude = self->current_amplitude * 65536;
+    int32_t amplitude_step = (target - self->current_amplitude) * 65536 / (int32_t) frame_count;
+    uint32_t phase = self->phase;
+    uint32_t phase_step = self->phase_step;
+    for (uint32_t i = 0; i < frame_count; i++) {
+        // Scale the phase to the table length. The top word is the index and the bottom word
+        // is how far it is towards the next entry.
+        uint64_t position = (uint64_t) phase * length;
+        uint32_t index = position >> 32;
+        int32_t fraction = (uint32_t) position >> 17;
+        int32_t a = table[index];
+        uint32_t next_index = index + 1;
+        if (next_index == length) {
+            next_index = 0;
+        }
+        int32_t b = table[next_index];
+        int32_t sample = a + (((b - a) * fraction) >> 15);
+
+        amplitude += amplitude_step;
+        sample = (sample * (amplitude >> 16)) >> 15;
+        if (!first) {
+            sample += out[i];
+            if (sample > INT16_MAX) {
+                sample = INT16_MAX;
+            } else if (sample < INT16_MIN) {
+                sample = INT16_MIN;
+            }
+        }
+        out[i] = sample;
+        phase += phase_step;
+    }
+    self->phase = phase;
+    self->current_amplitude = target;
+}
@@ -0,0 +1,54 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_SYNTHIO_VOICE_H
+#define MICROPY_INCLUDED_SHARED_MODULE_SYNTHIO_VOICE_H
+
+#include "py/obj.h"
+
+#include "shared-module/synthio/Synthesizer.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    synthio_synthesizer_obj_t *parent;
+    // Single cycle waveform. MP_OBJ_NULL uses the synthesizer's. The synthesizer looks up the
+    // array's buffer at the start of every buffer it renders because the array may have been
+    // resized since. waveform is NULL when the array is too short.
+    mp_obj_t waveform_obj;
+    const int16_t* waveform;
+    uint32_t waveform_length;
+    mp_float_t frequency;
+    uint32_t phase; // position within the cycle as a fraction of 2**32
+    uint32_t phase_step;
+    int16_t amplitude; // Q15
+    int16_t current_amplitude; // The amplitude at the end of the last buffer. Changes ramp from here.
+    bool pressed;
+} synthio_voice_obj_t;
+
+// Adds the voice's next frame_count samples into out, or writes them when first is true.
+void synthio_voice_render(synthio_voice_obj_t* self, int16_t* out, uint32_t frame_count, bool first);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_SYNTHIO_VOICE_H
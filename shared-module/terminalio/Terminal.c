@@ -36,28 +36,48 @@ void common_hal_terminalio_terminal_construct(terminalio_terminal_obj_t *self, d
     self->tilegrid = tilegrid;
     self->first_row = 0;
 
-    for (uint16_t x = 0; x < self->tilegrid->width_in_tiles; x++) {
-        for (uint16_t y = 0; y < self->tilegrid->height_in_tiles; y++) {
-            common_hal_displayio_tilegrid_set_tile(self->tilegrid, x, y, 0);
-        }
-    }
+    common_hal_displayio_tilegrid_fill_region(self->tilegrid, 0, 0, self->tilegrid->width_in_tiles, self->tilegrid->height_in_tiles, 0);
 
     common_hal_displayio_tilegrid_set_top_left(self->tilegrid, 0, 1);
 }
 
+// Writes the glyphs queued up to the left of the cursor in one TileGrid update.
+STATIC void _flush_glyphs(terminalio_terminal_obj_t *self, uint8_t* glyphs, uint16_t* glyph_count) {
+    if (*glyph_count == 0) {
+        return;
+    }
+    common_hal_displayio_tilegrid_set_tiles(self->tilegrid, self->cursor_x - *glyph_count, self->cursor_y, glyphs, *glyph_count);
+    *glyph_count = 0;
+}
+
+// Glyphs are written to the TileGrid in runs of at most this many tiles.
+#define GLYPH_BUFFER_SIZE (32)
+
+STATIC void _queue_glyph(terminalio_terminal_obj_t *self, uint8_t* glyphs, uint16_t* glyph_count, uint8_t tile_index) {
+    if (*glyph_count == GLYPH_BUFFER_SIZE) {
+        _flush_glyphs(self, glyphs, glyph_count);
+    }
+    glyphs[(*glyph_count)++] = tile_index;
+    self->cursor_x++;
+}
+
 size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, const byte *data, size_t len, int *errcode) {
     const byte* i = data;
     uint16_t start_y = self->cursor_y;
+    uint16_t width = self->tilegrid->width_in_tiles;
+    uint8_t glyphs[GLYPH_BUFFER_SIZE];
+    uint16_t glyph_count = 0;
     while (i < data + len) {
         unichar c = utf8_get_char(i);
         i = utf8_next_char(i);
         // Always handle ASCII.
         if (c < 128) {
             if (c >= 0x20 && c <= 0x7e) {
-                uint8_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
-                common_hal_displayio_tilegrid_set_tile(self->tilegrid, self->cursor_x, self->cursor_y, tile_index);
-                self->cursor_x++;
-            } else if (c == '\r') {
+                _queue_glyph(self, glyphs, &glyph_count, fontio_builtinfont_get_glyph_index(self->font, c));
+            } else {
+                _flush_glyphs(self, glyphs, &glyph_count);
+            }
+            if (c == '\r') {
                 self->cursor_x = 0;
             } else if (c == '\n') {
                 self->cursor_y++;
@@ -70,9 +90,7 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
                 if (i[0] == '[') {
                     if (i[1] == 'K') {
                         // Clear the rest of the line.
-                        for (uint16_t j = self->cursor_x; j < self->tilegrid->width_in_tiles; j++) {
-                            common_hal_displayio_tilegrid_set_tile(self->tilegrid, j, self->cursor_y, 0);
-                        }
+                        common_hal_displayio_tilegrid_fill_region(self->tilegrid, self->cursor_x, self->cursor_y, width, self->cursor_y + 1, 0);
                         i += 2;
                     } else {
                         // Handle commands of the form \x1b[####D
@@ -101,27 +119,26 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
         } else {
             uint8_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
             if (tile_index != 0xff) {
-                common_hal_displayio_tilegrid_set_tile(self->tilegrid, self->cursor_x, self->cursor_y, tile_index);
-                self->cursor_x++;
-
+                _queue_glyph(self, glyphs, &glyph_count, tile_index);
             }
         }
-        if (self->cursor_x >= self->tilegrid->width_in_tiles) {
+        if (self->cursor_x >= width) {
+            _flush_glyphs(self, glyphs, &glyph_count);
             self->cursor_y++;
-            self->cursor_x %= self->tilegrid->width_in_tiles;
+            self->cursor_x %= width;
         }
         if (self->cursor_y >= self->tilegrid->height_in_tiles) {
             self->cursor_y %= self->tilegrid->height_in_tiles;
         }
         if (self->cursor_y != start_y) {
-            // clear the new row
-            for (uint16_t j = 0; j < self->tilegrid->width_in_tiles; j++) {
-                common_hal_displayio_tilegrid_set_tile(self->tilegrid, j, self->cursor_y, 0);
-                start_y = self->cursor_y;
-            }
+            start_y = self->cursor_y;
+            // Scroll before clearing the new row so the TileGrid sees a pure scroll followed by a
+            // single changed row.
             common_hal_displayio_tilegrid_set_top_left(self->tilegrid, 0, (start_y + self->tilegrid->height_in_tiles + 1) % self->tilegrid->height_in_tiles);
+            common_hal_displayio_tilegrid_fill_region(self->tilegrid, 0, self->cursor_y, width, self->cursor_y + 1, 0);
         }
     }
+    _flush_glyphs(self, glyphs, &glyph_count);
     return i - data;
 }
 
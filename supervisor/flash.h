@@ -49,5 +49,13 @@ struct _fs_user_mount_t;
 void supervisor_flash_init_vfs(struct _fs_user_mount_t *vfs);
 void supervisor_flash_flush(void);
 void supervisor_flash_release_cache(void);
+// Tells the flash that the filesystem no longer uses these blocks so their contents don't need to
+// be kept once the filesystem has synced.
+void supervisor_flash_trim_blocks(uint32_t block_num, uint32_t num_blocks);
+// Called after the filesystem syncs. Blocks trimmed before the sync are no longer used by the
+// filesystem on the flash so they may be erased.
+void supervisor_flash_commit_trimmed_blocks(void);
+// Does deferred flash work, such as erasing trimmed sectors, when there is time.
+void supervisor_flash_background(void);
 
 #endif  // MICROPY_INCLUDED_SUPERVISOR_FLASH_H
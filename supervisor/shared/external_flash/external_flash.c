@@ -42,16 +42,51 @@
 
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
-static uint32_t current_sector;
+#define BLOCKS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
+#define PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
+#define PAGES_PER_SECTOR (SPI_FLASH_ERASE_SIZE / SPI_FLASH_PAGE_SIZE)
 
 const external_flash_device possible_devices[EXTERNAL_FLASH_DEVICE_COUNT] = {EXTERNAL_FLASH_DEVICES};
 
 static const external_flash_device* flash_device = NULL;
 
-// Track which blocks (up to 32) in the current sector currently live in the
-// cache.
-static uint32_t dirty_mask;
+// One erase sector held in the write-back cache.
+typedef struct {
+    // Address of the cached sector or NO_SECTOR_LOADED.
+    uint32_t sector;
+    // Track which blocks (up to 32) in the sector currently live in the cache.
+    uint32_t dirty_mask;
+    // Value of cache_clock when the sector was last written. The smallest one
+    // is flushed first when the cache is full.
+    uint32_t last_use;
+} cached_sector_t;
+
+static cached_sector_t cached_sectors[SPI_FLASH_CACHE_SECTORS];
+
+// The number of sectors the cache has room for. It is zero until a write needs
+// the cache. When the sector is cached in the scratch sector at the end of the
+// flash it is one and MP_STATE_VM(flash_ram_cache) is NULL.
+static uint8_t cached_sector_count;
+
+static uint32_t cache_clock;
+
+// A sector that the filesystem has freed blocks in.
+typedef struct {
+    uint32_t sector;
+    // Track which blocks in the sector the filesystem no longer uses.
+    uint32_t free_mask;
+    // Blocks trimmed since the filesystem last synced. The FAT on the flash may still use them
+    // so they are kept until the sync.
+    uint32_t pending_mask;
+} trimmed_sector_t;
+
+#define ALL_BLOCKS_FREE ((1 << BLOCKS_PER_SECTOR) - 1)
+
+static trimmed_sector_t trimmed_sectors[SPI_FLASH_TRIMMED_SECTORS];
+static uint8_t next_trimmed_sector;
+
+static uint32_t flush_count;
+static uint32_t erase_count;
 
 static supervisor_allocation* supervisor_cache = NULL;
 
@@ -135,7 +170,7 @@ static bool page_erased(uint32_t sector_address) {
     uint8_t full_buffer[FILESYSTEM_BLOCK_SIZE];
     if (read_flash(sector_address, full_buffer, FILESYSTEM_BLOCK_SIZE)) {
         for (uint16_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
-            if (short_buffer[i] != 0xff) {
+            if (full_buffer[i] != 0xff) {
                 return false;
             }
         }
@@ -145,6 +180,23 @@ static bool page_erased(uint32_t sector_address) {
     return true;
 }
 
+static trimmed_sector_t* find_trimmed_sector(uint32_t sector) {
+    for (uint8_t i = 0; i < SPI_FLASH_TRIMMED_SECTORS; i++) {
+        if (trimmed_sectors[i].sector == sector) {
+            return &trimmed_sectors[i];
+        }
+    }
+    return NULL;
+}
+
+static uint32_t free_blocks_in_sector(uint32_t sector) {
+    trimmed_sector_t* trimmed = find_trimmed_sector(sector);
+    if (trimmed == NULL) {
+        return 0;
+    }
+    return trimmed->free_mask;
+}
+
 // Erases the given sector. Make sure you copied all of the data out of it you
 // need! Also note, sector_address is really 24 bits.
 static bool erase_sector(uint32_t sector_address) {
@@ -155,6 +207,14 @@ static bool erase_sector(uint32_t sector_address) {
     }
 
     spi_flash_sector_command(CMD_SECTOR_ERASE, sector_address);
+    erase_count++;
+    // Free blocks are blank now so writes to them don't need the erase.
+    trimmed_sector_t* trimmed = find_trimmed_sector(sector_address);
+    if (trimmed != NULL) {
+        trimmed->sector = NO_SECTOR_LOADED;
+        trimmed->free_mask = 0;
+        trimmed->pending_mask = 0;
+    }
     return true;
 }
 
@@ -252,9 +312,13 @@ void supervisor_flash_init(void) {
 
     wait_for_flash_ready();
 
-    current_sector = NO_SECTOR_LOADED;
-    dirty_mask = 0;
+    cached_sector_count = 0;
     MP_STATE_VM(flash_ram_cache) = NULL;
+    for (uint8_t i = 0; i < SPI_FLASH_TRIMMED_SECTORS; i++) {
+        trimmed_sectors[i].sector = NO_SECTOR_LOADED;
+        trimmed_sectors[i].free_mask = 0;
+        trimmed_sectors[i].pending_mask = 0;
+    }
 }
 
 // The size of each individual block.
@@ -269,20 +333,23 @@ uint32_t supervisor_flash_get_block_count(void) {
     return (flash_device->total_size - SPI_FLASH_ERASE_SIZE) / FILESYSTEM_BLOCK_SIZE;
 }
 
+static uint8_t* cached_page(uint8_t index, uint8_t page) {
+    return MP_STATE_VM(flash_ram_cache)[index * PAGES_PER_SECTOR + page];
+}
+
 // Flush the cache that was written to the scratch portion of flash. Only used
 // when ram is tight.
-static bool flush_scratch_flash(void) {
-    if (current_sector == NO_SECTOR_LOADED) {
-        return true;
-    }
+static bool flush_scratch_flash(cached_sector_t* cached) {
     // First, copy out any blocks that we haven't touched from the sector we've
     // cached.
+    // Blocks the filesystem has freed are left blank.
     bool copy_to_scratch_ok = true;
     uint32_t scratch_sector = flash_device->total_size - SPI_FLASH_ERASE_SIZE;
-    for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+    uint32_t keep_mask = ~(cached->dirty_mask | free_blocks_in_sector(cached->sector));
+    for (uint8_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
+        if ((keep_mask & (1 << i)) != 0) {
             copy_to_scratch_ok = copy_to_scratch_ok &&
-                copy_block(current_sector + i * FILESYSTEM_BLOCK_SIZE,
+                copy_block(cached->sector + i * FILESYSTEM_BLOCK_SIZE,
                            scratch_sector + i * FILESYSTEM_BLOCK_SIZE);
         }
     }
@@ -292,161 +359,195 @@ static bool flush_scratch_flash(void) {
         return false;
     }
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(cached->sector);
     // Finally, copy the new version into it.
-    for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
+    for (uint8_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
         copy_block(scratch_sector + i * FILESYSTEM_BLOCK_SIZE,
-                   current_sector + i * FILESYSTEM_BLOCK_SIZE);
+                   cached->sector + i * FILESYSTEM_BLOCK_SIZE);
     }
     return true;
 }
 
-// Attempts to allocate a new set of page buffers for caching a full sector in
-// ram. Each page is allocated separately so that the GC doesn't need to provide
-// one huge block. We can free it as we write if we want to also.
+// Attempts to allocate page buffers for caching whole sectors in ram. As many
+// sectors as fit in the free supervisor memory are used, up to
+// SPI_FLASH_CACHE_SECTORS. Otherwise a single sector is cached on the heap with
+// each page allocated separately so that the GC doesn't need to provide one
+// huge block.
 static bool allocate_ram_cache(void) {
-    uint8_t blocks_per_sector = SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE;
-    uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
-
-    uint32_t table_size = blocks_per_sector * pages_per_block * sizeof(uint32_t);
     // Attempt to allocate outside the heap first.
-    supervisor_cache = allocate_memory(table_size + SPI_FLASH_ERASE_SIZE, false);
-    if (supervisor_cache != NULL) {
-        MP_STATE_VM(flash_ram_cache) = (uint8_t **) supervisor_cache->ptr;
-        uint8_t* page_start = (uint8_t *) supervisor_cache->ptr + table_size;
-
-        for (uint8_t i = 0; i < blocks_per_sector; i++) {
-            for (uint8_t j = 0; j < pages_per_block; j++) {
-                uint32_t offset = i * pages_per_block + j;
-                MP_STATE_VM(flash_ram_cache)[offset] = page_start + offset * SPI_FLASH_PAGE_SIZE;
+    for (uint8_t count = SPI_FLASH_CACHE_SECTORS; count > 0; count--) {
+        uint32_t table_size = count * PAGES_PER_SECTOR * sizeof(uint8_t*);
+        supervisor_cache = allocate_memory(table_size + count * SPI_FLASH_ERASE_SIZE, false);
+        if (supervisor_cache != NULL) {
+            MP_STATE_VM(flash_ram_cache) = (uint8_t **) supervisor_cache->ptr;
+            uint8_t* page_start = (uint8_t *) supervisor_cache->ptr + table_size;
+            for (uint32_t i = 0; i < count * PAGES_PER_SECTOR; i++) {
+                MP_STATE_VM(flash_ram_cache)[i] = page_start + i * SPI_FLASH_PAGE_SIZE;
             }
+            cached_sector_count = count;
+            return true;
         }
-        return true;
     }
 
-    MP_STATE_VM(flash_ram_cache) = m_malloc_maybe(blocks_per_sector * pages_per_block * sizeof(uint32_t), false);
+    MP_STATE_VM(flash_ram_cache) = m_malloc_maybe(PAGES_PER_SECTOR * sizeof(uint8_t*), false);
     if (MP_STATE_VM(flash_ram_cache) == NULL) {
         return false;
     }
-    // Declare i and j outside the loops in case we fail to allocate everything
-    // we need. In that case we'll give it back.
-    uint8_t i = 0;
-    uint8_t j = 0;
-    bool success = true;
-    for (i = 0; i < blocks_per_sector; i++) {
-        for (j = 0; j < pages_per_block; j++) {
-            uint8_t *page_cache = m_malloc_maybe(SPI_FLASH_PAGE_SIZE, false);
-            if (page_cache == NULL) {
-                success = false;
-                break;
-            }
-            MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j] = page_cache;
-        }
-        if (!success) {
+    // Declare i outside the loop in case we fail to allocate everything we
+    // need. In that case we'll give it back.
+    uint8_t i;
+    for (i = 0; i < PAGES_PER_SECTOR; i++) {
+        uint8_t *page_cache = m_malloc_maybe(SPI_FLASH_PAGE_SIZE, false);
+        if (page_cache == NULL) {
             break;
         }
+        MP_STATE_VM(flash_ram_cache)[i] = page_cache;
     }
     // We couldn't allocate enough so give back what we got.
-    if (!success) {
-        // We add 1 so that we delete 0 when i is 1. Going to zero (i >= 0)
-        // would never stop because i is unsigned.
-        i++;
+    if (i < PAGES_PER_SECTOR) {
         for (; i > 0; i--) {
-            for (; j > 0; j--) {
-                m_free(MP_STATE_VM(flash_ram_cache)[(i - 1) * pages_per_block + (j - 1)]);
-            }
-            j = pages_per_block;
+            m_free(MP_STATE_VM(flash_ram_cache)[i - 1]);
         }
         m_free(MP_STATE_VM(flash_ram_cache));
         MP_STATE_VM(flash_ram_cache) = NULL;
+        return false;
     }
-    return success;
+    cached_sector_count = 1;
+    return true;
 }
 
 static void release_ram_cache(void) {
     if (supervisor_cache != NULL) {
         free_memory(supervisor_cache);
         supervisor_cache = NULL;
-    } else {
+    } else if (MP_STATE_VM(flash_ram_cache) != NULL) {
+        for (uint8_t i = 0; i < PAGES_PER_SECTOR; i++) {
+            m_free(MP_STATE_VM(flash_ram_cache)[i]);
+        }
         m_free(MP_STATE_VM(flash_ram_cache));
     }
     MP_STATE_VM(flash_ram_cache) = NULL;
+    cached_sector_count = 0;
 }
 
-// Flush the cached sector from ram onto the flash. We'll free the cache unless
-// keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (current_sector == NO_SECTOR_LOADED) {
-        if (!keep_cache) {
-            release_ram_cache();
+// Programming can only clear bits so the new data can be written without an
+// erase when it never needs a 0 turned back into a 1. Returns true when that's
+// the case for every dirty block and sets program_mask to the pages whose
+// contents actually change.
+static bool can_program_in_place(uint8_t index, uint32_t* program_mask) {
+    cached_sector_t* cached = &cached_sectors[index];
+    uint8_t buffer[SPI_FLASH_PAGE_SIZE];
+    *program_mask = 0;
+    for (uint8_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
+        if ((cached->dirty_mask & (1 << i)) == 0) {
+            continue;
+        }
+        for (uint8_t j = 0; j < PAGES_PER_BLOCK; j++) {
+            uint8_t page = i * PAGES_PER_BLOCK + j;
+            if (!read_flash(cached->sector + page * SPI_FLASH_PAGE_SIZE, buffer, SPI_FLASH_PAGE_SIZE)) {
+                return false;
+            }
+            const uint8_t* data = cached_page(index, page);
+            bool changed = false;
+            for (uint16_t k = 0; k < SPI_FLASH_PAGE_SIZE; k++) {
+                if ((buffer[k] & data[k]) != data[k]) {
+                    return false;
+                }
+                changed = changed || buffer[k] != data[k];
+            }
+            if (changed) {
+                *program_mask |= 1 << page;
+            }
+        }
+    }
+    return true;
+}
+
+// Flush a sector cached in ram onto the flash.
+static bool flush_ram_cache(uint8_t index) {
+    cached_sector_t* cached = &cached_sectors[index];
+    uint32_t program_mask;
+    if (can_program_in_place(index, &program_mask)) {
+        for (uint8_t page = 0; page < PAGES_PER_SECTOR; page++) {
+            if ((program_mask & (1 << page)) == 0) {
+                continue;
+            }
+            if (!write_flash(cached->sector + page * SPI_FLASH_PAGE_SIZE,
+                             cached_page(index, page),
+                             SPI_FLASH_PAGE_SIZE)) {
+                return false;
+            }
         }
         return true;
     }
     // First, copy out any blocks that we haven't touched from the sector
     // we've cached. If we don't do this we'll erase the data during the sector
-    // erase below.
-    bool copy_to_ram_ok = true;
-    uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
-    for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
-            for (uint8_t j = 0; j < pages_per_block; j++) {
-                copy_to_ram_ok = read_flash(
-                    current_sector + (i * pages_per_block + j) * SPI_FLASH_PAGE_SIZE,
-                    MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j],
-                    SPI_FLASH_PAGE_SIZE);
-                if (!copy_to_ram_ok) {
-                    break;
-                }
+    // erase below. Blocks the filesystem has freed are left blank instead.
+    uint32_t free_mask = free_blocks_in_sector(cached->sector);
+    for (uint8_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
+        if ((cached->dirty_mask & (1 << i)) != 0) {
+            continue;
+        }
+        if ((free_mask & (1 << i)) != 0) {
+            for (uint8_t j = 0; j < PAGES_PER_BLOCK; j++) {
+                memset(cached_page(index, i * PAGES_PER_BLOCK + j), 0xff, SPI_FLASH_PAGE_SIZE);
             }
+            continue;
         }
-        if (!copy_to_ram_ok) {
-            break;
+        for (uint8_t j = 0; j < PAGES_PER_BLOCK; j++) {
+            uint8_t page = i * PAGES_PER_BLOCK + j;
+            if (!read_flash(cached->sector + page * SPI_FLASH_PAGE_SIZE,
+                            cached_page(index, page),
+                            SPI_FLASH_PAGE_SIZE)) {
+                return false;
+            }
         }
     }
-
-    if (!copy_to_ram_ok) {
-        return false;
-    }
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(cached->sector);
     // Lastly, write all the data in ram that we've cached.
-    for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
-        for (uint8_t j = 0; j < pages_per_block; j++) {
-            write_flash(current_sector + (i * pages_per_block + j) * SPI_FLASH_PAGE_SIZE,
-                        MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j],
-                        SPI_FLASH_PAGE_SIZE);
-            if (!keep_cache && supervisor_cache == NULL) {
-                m_free(MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j]);
-            }
-        }
-    }
-    // We're done with the cache for now so give it back.
-    if (!keep_cache) {
-        release_ram_cache();
+    for (uint8_t page = 0; page < PAGES_PER_SECTOR; page++) {
+        write_flash(cached->sector + page * SPI_FLASH_PAGE_SIZE,
+                    cached_page(index, page),
+                    SPI_FLASH_PAGE_SIZE);
     }
     return true;
 }
 
-// Delegates to the correct flash flush method depending on the existing cache.
-// TODO Don't blink the status indicator if we don't actually do any writing (hard to tell right now).
-static void spi_flash_flush_keep_cache(bool keep_cache) {
+// Writes back one cached sector from wherever it is cached and empties its slot.
+static void flush_cached_sector(uint8_t index) {
+    if (cached_sectors[index].sector == NO_SECTOR_LOADED) {
+        return;
+    }
     #ifdef MICROPY_HW_LED_MSC
         port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
     #endif
     temp_status_color(ACTIVE_WRITE);
     // If we've cached to the flash itself flush from there.
     if (MP_STATE_VM(flash_ram_cache) == NULL) {
-        flush_scratch_flash();
+        flush_scratch_flash(&cached_sectors[index]);
     } else {
-        flush_ram_cache(keep_cache);
+        flush_ram_cache(index);
     }
-    current_sector = NO_SECTOR_LOADED;
+    cached_sectors[index].sector = NO_SECTOR_LOADED;
+    cached_sectors[index].dirty_mask = 0;
+    flush_count++;
     clear_temp_status();
     #ifdef MICROPY_HW_LED_MSC
         port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
     #endif
 }
 
+// Flushes every cached sector. We'll free the cache unless keep_cache is true.
+static void spi_flash_flush_keep_cache(bool keep_cache) {
+    for (uint8_t i = 0; i < cached_sector_count; i++) {
+        flush_cached_sector(i);
+    }
+    if (!keep_cache) {
+        release_ram_cache();
+    }
+}
+
 void supervisor_flash_flush(void) {
     spi_flash_flush_keep_cache(true);
 }
@@ -455,6 +556,58 @@ void supervisor_flash_release_cache(void) {
     spi_flash_flush_keep_cache(false);
 }
 
+uint32_t external_flash_get_flush_count(void) {
+    return flush_count;
+}
+
+uint32_t external_flash_get_erase_count(void) {
+    return erase_count;
+}
+
+static int8_t find_cached_sector(uint32_t sector) {
+    for (uint8_t i = 0; i < cached_sector_count; i++) {
+        if (cached_sectors[i].sector == sector) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns the index of an empty cache slot. When every slot is in use the least
+// recently written sector is flushed to make room.
+static uint8_t claim_cached_sector(void) {
+    if (MP_STATE_VM(flash_ram_cache) == NULL) {
+        // At most the scratch sector is in use so flush it and try to get ram
+        // again.
+        if (cached_sector_count > 0) {
+            flush_cached_sector(0);
+        }
+        if (!allocate_ram_cache()) {
+            erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
+            wait_for_flash_ready();
+            cached_sector_count = 1;
+            cached_sectors[0].sector = NO_SECTOR_LOADED;
+            cached_sectors[0].dirty_mask = 0;
+            return 0;
+        }
+        for (uint8_t i = 0; i < cached_sector_count; i++) {
+            cached_sectors[i].sector = NO_SECTOR_LOADED;
+            cached_sectors[i].dirty_mask = 0;
+        }
+    }
+    uint8_t oldest = 0;
+    for (uint8_t i = 0; i < cached_sector_count; i++) {
+        if (cached_sectors[i].sector == NO_SECTOR_LOADED) {
+            return i;
+        }
+        if (cached_sectors[i].last_use < cached_sectors[oldest].last_use) {
+            oldest = i;
+        }
+    }
+    flush_cached_sector(oldest);
+    return oldest;
+}
+
 static int32_t convert_block_to_flash_addr(uint32_t block) {
     if (0 <= block && block < supervisor_flash_get_block_count()) {
         // a block in partition 1
@@ -464,6 +617,96 @@ static int32_t convert_block_to_flash_addr(uint32_t block) {
     return -1;
 }
 
+void supervisor_flash_trim_blocks(uint32_t block_num, uint32_t num_blocks) {
+    for (uint32_t block = block_num; block < block_num + num_blocks; block++) {
+        int32_t address = convert_block_to_flash_addr(block);
+        if (address == -1) {
+            return;
+        }
+        uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
+        uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
+        trimmed_sector_t* trimmed = find_trimmed_sector(this_sector);
+        if (trimmed == NULL) {
+            trimmed = find_trimmed_sector(NO_SECTOR_LOADED);
+        }
+        if (trimmed == NULL) {
+            // Take the slots in turn when they are all in use. Forgetting a
+            // sector only means it gets erased later when it's written.
+            trimmed = &trimmed_sectors[next_trimmed_sector];
+            next_trimmed_sector = (next_trimmed_sector + 1) % SPI_FLASH_TRIMMED_SECTORS;
+        }
+        if (trimmed->sector != this_sector) {
+            trimmed->sector = this_sector;
+            trimmed->free_mask = 0;
+            trimmed->pending_mask = 0;
+        }
+        trimmed->pending_mask |= 1 << block_index;
+    }
+}
+
+void supervisor_flash_commit_trimmed_blocks(void) {
+    for (uint8_t i = 0; i < SPI_FLASH_TRIMMED_SECTORS; i++) {
+        trimmed_sectors[i].free_mask |= trimmed_sectors[i].pending_mask;
+        trimmed_sectors[i].pending_mask = 0;
+    }
+}
+
+static bool flash_busy(void) {
+    uint8_t read_status_response[1] = {0x00};
+    if (!spi_flash_read_command(CMD_READ_STATUS, read_status_response, 1)) {
+        return true;
+    }
+    // The write in progress bit.
+    return (read_status_response[0] & 0x1) != 0;
+}
+
+static bool sector_erased(uint32_t sector_address) {
+    uint8_t buffer[SPI_FLASH_PAGE_SIZE];
+    for (uint32_t offset = 0; offset < SPI_FLASH_ERASE_SIZE; offset += SPI_FLASH_PAGE_SIZE) {
+        if (!read_flash(sector_address + offset, buffer, SPI_FLASH_PAGE_SIZE)) {
+            return false;
+        }
+        for (uint16_t i = 0; i < SPI_FLASH_PAGE_SIZE; i++) {
+            if (buffer[i] != 0xff) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Starts erasing one sector that the filesystem has freed entirely so a later
+// write to it can be programmed directly. The erase finishes while other code
+// runs and only the next flash access waits for it.
+void supervisor_flash_background(void) {
+    if (flash_device == NULL) {
+        return;
+    }
+    // Leave the flash alone while writes are still being cached.
+    for (uint8_t i = 0; i < cached_sector_count; i++) {
+        if (cached_sectors[i].sector != NO_SECTOR_LOADED) {
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < SPI_FLASH_TRIMMED_SECTORS; i++) {
+        trimmed_sector_t* trimmed = &trimmed_sectors[i];
+        if (trimmed->sector == NO_SECTOR_LOADED || trimmed->free_mask != ALL_BLOCKS_FREE) {
+            continue;
+        }
+        if (flash_busy()) {
+            return;
+        }
+        if (sector_erased(trimmed->sector)) {
+            trimmed->sector = NO_SECTOR_LOADED;
+            trimmed->free_mask = 0;
+            trimmed->pending_mask = 0;
+        } else {
+            erase_sector(trimmed->sector);
+        }
+        return;
+    }
+}
+
 bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     int32_t address = convert_block_to_flash_addr(block);
     if (address == -1) {
@@ -473,15 +716,15 @@ bool external_flash_read_block(uint8_t *dest, uint32_t block) {
 
     // Mask out the lower bits that designate the address within the sector.
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
-    uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE);
-    uint8_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
-    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
+    uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
+    uint32_t mask = 1 << (block_index);
+    int8_t index = find_cached_sector(this_sector);
+    // We're reading from a cached sector.
+    if (index >= 0 && (mask & cached_sectors[index].dirty_mask) > 0) {
         if (MP_STATE_VM(flash_ram_cache) != NULL) {
-            uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
-            for (int i = 0; i < pages_per_block; i++) {
+            for (int i = 0; i < PAGES_PER_BLOCK; i++) {
                 memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                       MP_STATE_VM(flash_ram_cache)[block_index * pages_per_block + i],
+                       cached_page(index, block_index * PAGES_PER_BLOCK + i),
                        SPI_FLASH_PAGE_SIZE);
             }
             return true;
@@ -504,32 +747,38 @@ bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     wait_for_flash_ready();
     // Mask out the lower bits that designate the address within the sector.
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
-    uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE);
-    uint8_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
-    if (current_sector != this_sector || (mask & dirty_mask) > 0) {
+    uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
+    uint32_t mask = 1 << (block_index);
+    // The block is in use again.
+    trimmed_sector_t* trimmed = find_trimmed_sector(this_sector);
+    if (trimmed != NULL) {
+        trimmed->free_mask &= ~mask;
+        trimmed->pending_mask &= ~mask;
+    }
+    int8_t index = find_cached_sector(this_sector);
+    // A block in the scratch sector can't be written again without an erase so
+    // flush the cache if we're writing the same block again.
+    if (index >= 0 && MP_STATE_VM(flash_ram_cache) == NULL &&
+        (mask & cached_sectors[index].dirty_mask) > 0) {
+        flush_cached_sector(index);
+        index = -1;
+    }
+    if (index < 0) {
         // Check to see if we'd write to an erased page. In that case we
         // can write directly.
         if (page_erased(address)) {
             return write_flash(address, data, FILESYSTEM_BLOCK_SIZE);
         }
-        if (current_sector != NO_SECTOR_LOADED) {
-            supervisor_flash_flush();
-        }
-        if (MP_STATE_VM(flash_ram_cache) == NULL && !allocate_ram_cache()) {
-            erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
-            wait_for_flash_ready();
-        }
-        current_sector = this_sector;
-        dirty_mask = 0;
+        index = claim_cached_sector();
+        cached_sectors[index].sector = this_sector;
+        cached_sectors[index].dirty_mask = 0;
     }
-    dirty_mask |= mask;
+    cached_sectors[index].dirty_mask |= mask;
+    cached_sectors[index].last_use = ++cache_clock;
     // Copy the block to the appropriate cache.
     if (MP_STATE_VM(flash_ram_cache) != NULL) {
-        uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
-        for (int i = 0; i < pages_per_block; i++) {
-            memcpy(MP_STATE_VM(flash_ram_cache)[block_index * pages_per_block + i],
+        for (int i = 0; i < PAGES_PER_BLOCK; i++) {
+            memcpy(cached_page(index, block_index * PAGES_PER_BLOCK + i),
                    data + i * SPI_FLASH_PAGE_SIZE,
                    SPI_FLASH_PAGE_SIZE);
         }
@@ -540,10 +789,35 @@ bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     }
 }
 
+// Whether the latest copy of a block is in the cache rather than in place on the flash.
+static bool block_is_cached(uint32_t block) {
+    uint32_t address = block * FILESYSTEM_BLOCK_SIZE;
+    int8_t index = find_cached_sector(address & (~(SPI_FLASH_ERASE_SIZE - 1)));
+    return index >= 0 && (cached_sectors[index].dirty_mask & (1 << (block % BLOCKS_PER_SECTOR))) != 0;
+}
+
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
-    for (size_t i = 0; i < num_blocks; i++) {
-        if (!external_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
-            return 1; // error
+    if (block_num + num_blocks > supervisor_flash_get_block_count()) {
+        return 1; // error
+    }
+    size_t i = 0;
+    while (i < num_blocks) {
+        // Blocks that are only on the flash are read with one command per run.
+        size_t run = 0;
+        while (i + run < num_blocks && !block_is_cached(block_num + i + run)) {
+            run++;
+        }
+        if (run > 0) {
+            if (!read_flash((block_num + i) * FILESYSTEM_BLOCK_SIZE, dest + i * FILESYSTEM_BLOCK_SIZE,
+                            run * FILESYSTEM_BLOCK_SIZE)) {
+                return 1; // error
+            }
+            i += run;
+        } else {
+            if (!external_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
+                return 1; // error
+            }
+            i++;
         }
     }
     return 0; // success
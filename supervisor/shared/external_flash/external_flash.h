@@ -41,8 +41,25 @@
 #define SPI_FLASH_SYSTICK_MASK    (0x1ff) // 512ms
 #define SPI_FLASH_IDLE_TICK(tick) (((tick) & SPI_FLASH_SYSTICK_MASK) == 2)
 
+// The most erase sectors to cache in ram at once. Fewer are used when there
+// isn't enough supervisor memory for all of them.
+#ifndef SPI_FLASH_CACHE_SECTORS
+#define SPI_FLASH_CACHE_SECTORS (4)
+#endif
+
+// How many sectors with blocks freed by the filesystem to remember. Sectors
+// that are entirely free are erased in the background.
+#ifndef SPI_FLASH_TRIMMED_SECTORS
+#define SPI_FLASH_TRIMMED_SECTORS (16)
+#endif
+
 #ifndef SPI_FLASH_MAX_BAUDRATE
 #define SPI_FLASH_MAX_BAUDRATE 8000000
 #endif
 
+// The number of cached sectors written back to the flash and the number of
+// sectors erased since power on.
+uint32_t external_flash_get_flush_count(void);
+uint32_t external_flash_get_erase_count(void);
+
 #endif  // MICROPY_INCLUDED_SUPERVISOR_SHARED_EXTERNAL_FLASH_EXTERNAL_FLASH_H
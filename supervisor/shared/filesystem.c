@@ -43,10 +43,13 @@ volatile bool filesystem_flush_requested = false;
 void filesystem_background(void) {
     if (filesystem_flush_requested) {
         filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
-        // Flush but keep caches
+        // Flush but keep caches. Sectors cached above the flash go first so they reach it. Only
+        // the internal flash is written back because other block devices may run Python code.
+        fat_vfs_sync_sector_cache(&_internal_vfs);
         supervisor_flash_flush();
         filesystem_flush_requested = false;
     }
+    supervisor_flash_background();
 }
 
 inline void filesystem_tick(void) {
@@ -122,6 +125,8 @@ void filesystem_init(bool create_allowed, bool force_create) {
 void filesystem_flush(void) {
     // Reset interval before next flush.
     filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
+    // Sectors cached above the block devices go first so they reach the flash below.
+    fat_vfs_release_sector_cache(NULL);
     supervisor_flash_flush();
     // Don't keep caches because this is called when starting or stopping the VM.
     supervisor_flash_release_cache();
@@ -143,9 +143,20 @@ STATIC mp_obj_t supervisor_flash_obj_ioctl(mp_obj_t self, mp_obj_t cmd_in, mp_ob
     switch (cmd) {
         case BP_IOCTL_INIT: supervisor_flash_init(); return MP_OBJ_NEW_SMALL_INT(0);
         case BP_IOCTL_DEINIT: supervisor_flash_flush(); return MP_OBJ_NEW_SMALL_INT(0); // TODO properly
-        case BP_IOCTL_SYNC: supervisor_flash_flush(); return MP_OBJ_NEW_SMALL_INT(0);
+        case BP_IOCTL_SYNC:
+            supervisor_flash_flush();
+            // The FAT written by this sync no longer uses the trimmed blocks.
+            supervisor_flash_commit_trimmed_blocks();
+            return MP_OBJ_NEW_SMALL_INT(0);
         case BP_IOCTL_SEC_COUNT: return MP_OBJ_NEW_SMALL_INT(flash_get_block_count());
         case BP_IOCTL_SEC_SIZE: return MP_OBJ_NEW_SMALL_INT(supervisor_flash_get_block_size());
+        case BP_IOCTL_TRIM: {
+            mp_int_t block_num = mp_obj_get_int(arg_in);
+            if (block_num >= PART1_START_BLOCK) {
+                supervisor_flash_trim_blocks(block_num - PART1_START_BLOCK, 1);
+            }
+            return MP_OBJ_NEW_SMALL_INT(0);
+        }
         default: return mp_const_none;
     }
 }
@@ -168,7 +179,7 @@ const mp_obj_type_t supervisor_flash_type = {
 
 void supervisor_flash_init_vfs(fs_user_mount_t *vfs) {
     vfs->base.type = &mp_fat_vfs_type;
-    vfs->flags |= FSUSER_NATIVE | FSUSER_HAVE_IOCTL;
+    vfs->flags |= FSUSER_NATIVE | FSUSER_HAVE_IOCTL | FSUSER_HAVE_TRIM;
     vfs->fatfs.drv = vfs;
     vfs->fatfs.part = 1; // flash filesystem lives on first partition
     vfs->readblocks[0] = (mp_obj_t)&supervisor_flash_obj_readblocks_obj;
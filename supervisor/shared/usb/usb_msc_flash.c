@@ -32,6 +32,7 @@
 #include "extmod/vfs_fat.h"
 #include "lib/oofatfs/diskio.h"
 #include "lib/oofatfs/ff.h"
+#include "py/misc.h"
 #include "py/mpstate.h"
 
 #include "supervisor/filesystem.h"
@@ -114,16 +115,107 @@ bool tud_msc_is_writable_cb(uint8_t lun) {
     return true;
 }
 
+// Writes blocks to the disk and refreshes FatFs's window if it holds one of them.
+static void write_blocks(fs_user_mount_t* vfs, const uint8_t* buffer, uint32_t lba, uint32_t block_count) {
+    disk_write(vfs, buffer, lba, block_count);
+    // Since by getting here we assume the mount is read-only to
+    // MicroPython let's update the cached FatFs sector if it's one
+    // we just wrote.
+    #if _MAX_SS != _MIN_SS
+    if (vfs->ssize == MSC_FLASH_BLOCK_SIZE) {
+    #else
+    // The compiler can optimize this away.
+    if (_MAX_SS == FILESYSTEM_BLOCK_SIZE) {
+    #endif
+        if (vfs->fatfs.winsect >= lba && vfs->fatfs.winsect < lba + block_count && vfs->fatfs.winsect > 0) {
+            memcpy(vfs->fatfs.win,
+                   buffer + MSC_FLASH_BLOCK_SIZE * (vfs->fatfs.winsect - lba),
+                   MSC_FLASH_BLOCK_SIZE);
+        }
+    }
+}
+
+#if CIRCUITPY_USB_MSC_STAGING_BLOCKS > 0
+// Hosts send and fetch data one transfer buffer at a time, often a single block. Sequential
+// writes are gathered here until an aligned run of CIRCUITPY_USB_MSC_STAGING_BLOCKS (an erase
+// sector of external flash) is complete so the disk sees one write per sector. Sequential
+// reads fetch that many blocks at once and serve the following callbacks from here.
+static uint8_t staging[CIRCUITPY_USB_MSC_STAGING_BLOCKS * MSC_FLASH_BLOCK_SIZE] __attribute__((aligned(4)));
+static uint32_t staged_lba;
+static uint32_t staged_count;
+// True when staging holds blocks read ahead rather than blocks waiting to be written.
+static bool staged_for_read;
+// The block after the last one the host read, used to spot sequential reads.
+static uint32_t next_read_lba;
+
+static void flush_staged_writes(fs_user_mount_t* vfs) {
+    if (staged_for_read) {
+        return;
+    }
+    if (staged_count > 0) {
+        write_blocks(vfs, staging, staged_lba, staged_count);
+    }
+    staged_count = 0;
+}
+
+// Fills staging with blocks from lba on, up to the end of the disk.
+static bool read_ahead(fs_user_mount_t* vfs, uint32_t lba) {
+    DWORD disk_blocks;
+    if (disk_ioctl(vfs, GET_SECTOR_COUNT, &disk_blocks) != RES_OK || lba >= disk_blocks) {
+        return false;
+    }
+    uint32_t count = MIN(CIRCUITPY_USB_MSC_STAGING_BLOCKS, disk_blocks - lba);
+    staged_for_read = true;
+    staged_lba = lba;
+    staged_count = 0;
+    if (disk_read(vfs, staging, lba, count) != RES_OK) {
+        return false;
+    }
+    staged_count = count;
+    return true;
+}
+#endif
+
 // Callback invoked when received READ10 command.
 // Copy disk's data to buffer (up to bufsize) and return number of copied bytes.
 int32_t tud_msc_read10_cb (uint8_t lun, uint32_t lba, uint32_t offset, void* buffer, uint32_t bufsize) {
     (void) lun;
-    (void) offset;
 
     const uint32_t block_count = bufsize / MSC_FLASH_BLOCK_SIZE;
 
     fs_user_mount_t * vfs = get_vfs(lun);
+    #if CIRCUITPY_USB_MSC_STAGING_BLOCKS > 0
+    // Blocks still waiting to be written are newer than what's on the disk.
+    flush_staged_writes(vfs);
+    // MicroPython may have changed the disk since the last command if it can write to it.
+    if (offset == 0 && !filesystem_is_writable_by_usb(vfs)) {
+        staged_count = 0;
+    }
+    uint8_t* dest = buffer;
+    uint32_t copied = 0;
+    while (copied < block_count) {
+        uint32_t block = lba + copied;
+        uint32_t remaining = block_count - copied;
+        if (staged_count > 0 && block >= staged_lba && block < staged_lba + staged_count) {
+            uint32_t n = MIN(staged_lba + staged_count - block, remaining);
+            memcpy(dest + copied * MSC_FLASH_BLOCK_SIZE,
+                   staging + (block - staged_lba) * MSC_FLASH_BLOCK_SIZE,
+                   n * MSC_FLASH_BLOCK_SIZE);
+            copied += n;
+        } else if (block == next_read_lba && remaining < CIRCUITPY_USB_MSC_STAGING_BLOCKS &&
+                   read_ahead(vfs, block)) {
+            // Loop around to copy out of the blocks just read.
+        } else {
+            // Random access and requests at least as big as staging go straight to the disk.
+            disk_read(vfs, dest + copied * MSC_FLASH_BLOCK_SIZE, block, remaining);
+            copied = block_count;
+        }
+    }
+    next_read_lba = lba + block_count;
+    #else
+    (void) offset;
     disk_read(vfs, buffer, lba, block_count);
+    #endif
 
     return block_count * MSC_FLASH_BLOCK_SIZE;
 }
@@ -137,22 +229,41 @@ int32_t tud_msc_write10_cb (uint8_t lun, uint32_t lba, uint32_t offset, uint8_t*
     const uint32_t block_count = bufsize / MSC_FLASH_BLOCK_SIZE;
 
     fs_user_mount_t * vfs = get_vfs(lun);
-    disk_write(vfs, buffer, lba, block_count);
-    // Since by getting here we assume the mount is read-only to
-    // MicroPython let's update the cached FatFs sector if it's the one
-    // we just wrote.
-    #if _MAX_SS != _MIN_SS
-    if (vfs->ssize == MSC_FLASH_BLOCK_SIZE) {
-    #else
-    // The compiler can optimize this away.
-    if (_MAX_SS == FILESYSTEM_BLOCK_SIZE) {
-    #endif
-        if (lba == vfs->fatfs.winsect && lba > 0) {
-            memcpy(vfs->fatfs.win,
-                   buffer + MSC_FLASH_BLOCK_SIZE * (vfs->fatfs.winsect - lba),
-                   MSC_FLASH_BLOCK_SIZE);
+    #if CIRCUITPY_USB_MSC_STAGING_BLOCKS > 0
+    if (staged_for_read) {
+        // Read-ahead blocks may be about to change.
+        staged_count = 0;
+        staged_for_read = false;
+    }
+    uint32_t written = 0;
+    while (written < block_count) {
+        uint32_t block = lba + written;
+        if (staged_count > 0 && block != staged_lba + staged_count) {
+            flush_staged_writes(vfs);
+        }
+        // Never stage past the end of the aligned run this block is in.
+        uint32_t n = MIN(CIRCUITPY_USB_MSC_STAGING_BLOCKS - block % CIRCUITPY_USB_MSC_STAGING_BLOCKS,
+                         block_count - written);
+        if (staged_count == 0 && n == CIRCUITPY_USB_MSC_STAGING_BLOCKS) {
+            // A whole aligned run can be written straight from the USB buffer.
+            write_blocks(vfs, buffer + written * MSC_FLASH_BLOCK_SIZE, block, n);
+        } else {
+            if (staged_count == 0) {
+                staged_lba = block;
+            }
+            memcpy(staging + staged_count * MSC_FLASH_BLOCK_SIZE,
+                   buffer + written * MSC_FLASH_BLOCK_SIZE,
+                   n * MSC_FLASH_BLOCK_SIZE);
+            staged_count += n;
+            if ((staged_lba + staged_count) % CIRCUITPY_USB_MSC_STAGING_BLOCKS == 0) {
+                flush_staged_writes(vfs);
+            }
         }
+        written += n;
     }
+    #else
+    write_blocks(vfs, buffer, lba, block_count);
+    #endif
 
     return block_count * MSC_FLASH_BLOCK_SIZE;
 }
@@ -160,7 +271,12 @@ int32_t tud_msc_write10_cb (uint8_t lun, uint32_t lba, uint32_t offset, uint8_t*
 // Callback invoked when WRITE10 command is completed (status received and accepted by host).
 // used to flush any pending cache.
 void tud_msc_write10_complete_cb (uint8_t lun) {
+    #if CIRCUITPY_USB_MSC_STAGING_BLOCKS > 0
+    // The host considers the data written so don't hold on to any of it.
+    flush_staged_writes(get_vfs(lun));
+    #else
     (void) lun;
+    #endif
 
     // This write is complete, start the autoreload clock.
     autoreload_start();
@@ -206,6 +322,9 @@ bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, boo
             if (current_mount == NULL) {
                 return false;
             }
+            #if CIRCUITPY_USB_MSC_STAGING_BLOCKS > 0
+            flush_staged_writes(current_mount);
+            #endif
             if (disk_ioctl(current_mount, CTRL_SYNC, NULL) != RES_OK) {
                 return false;
             } else {
@@ -34,6 +34,14 @@ void filesystem_init(bool create_allowed, bool force_create) {
 void filesystem_flush(void) {
 }
 
+void filesystem_set_internal_writable_by_usb(bool writable) {
+    (void) writable;
+}
+
+void filesystem_set_internal_concurrent_write_protection(bool concurrent_write_protection) {
+    (void) concurrent_write_protection;
+}
+
 bool filesystem_is_writable_by_python(fs_user_mount_t *vfs) {
     (void) vfs;
     return true;
@@ -64,3 +64,9 @@ mp_uint_t supervisor_flash_write_blocks(const uint8_t *src, uint32_t block_num,
 void supervisor_flash_release_cache(void) {
 }
 
+void supervisor_flash_trim_blocks(uint32_t block_num, uint32_t num_blocks) {
+}
+
+void supervisor_flash_background(void) {
+}
+
@@ -25,6 +25,7 @@
  */
 
 #include "supervisor/serial.h"
+#include "supervisor/usb.h"
 
 void serial_init(void) {
 
@@ -45,3 +46,7 @@ bool serial_bytes_available(void) {
 void serial_write(const char* text) {
     (void) text;
 }
+
+bool usb_enabled(void) {
+    return false;
+}
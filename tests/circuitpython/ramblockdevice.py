@@ -0,0 +1,48 @@
+import skip_if
+try:
+    import storage
+    storage.RAMBlockDevice
+except (ImportError, AttributeError):
+    skip_if.skip()
+
+def bad_size(make_count):
+    try:
+        storage.RAMBlockDevice(make_count())
+    except (ValueError, OverflowError, MemoryError):
+        return
+    assert False
+
+bad_size(lambda: 0)
+bad_size(lambda: -1)
+# Too many bytes for a 32 bit size_t.
+bad_size(lambda: 1 << 23)
+# Too many blocks for 32 bit block numbers.
+bad_size(lambda: 1 << 32)
+
+ram = storage.RAMBlockDevice(128)
+assert ram.ioctl(4, 0) == 128
+assert ram.ioctl(5, 0) == 512
+
+# Raw block access, including past the end.
+block = bytearray(range(256)) * 2
+assert ram.writeblocks(127, block) == 0
+readback = bytearray(512)
+assert ram.readblocks(127, readback) == 0
+assert readback == block
+assert ram.writeblocks(128, block) == 1
+assert ram.readblocks(127, bytearray(1024)) == 1
+
+# A filesystem on it.
+storage.VfsFat.mkfs(ram)
+storage.mount(storage.VfsFat(ram), "/ramtest")
+with open("/ramtest/test.txt", "w") as f:
+    f.write("hello" * 200)
+with open("/ramtest/test.txt", "r") as f:
+    assert f.read() == "hello" * 200
+storage.umount("/ramtest")
+
+# The data stays with the device.
+storage.mount(storage.VfsFat(ram), "/ramtest")
+with open("/ramtest/test.txt", "r") as f:
+    assert f.read() == "hello" * 200
+storage.umount("/ramtest")
@@ -0,0 +1,128 @@
+# test os.scandir, DirEntry and os.walk on a FAT filesystem
+try:
+    import os
+    import uos
+
+    os.scandir
+    uos.VfsFat
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMFS:
+
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        for i in range(len(buf)):
+            buf[i] = self.data[n * self.SEC_SIZE + i]
+        return 0
+
+    def writeblocks(self, n, buf):
+        for i in range(len(buf)):
+            self.data[n * self.SEC_SIZE + i] = buf[i]
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # BP_IOCTL_SEC_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # BP_IOCTL_SEC_SIZE
+            return self.SEC_SIZE
+
+
+# a filesystem whose directories can't be listed
+class BrokenFS:
+
+    def __init__(self, exc):
+        self.exc = exc
+
+    def mount(self, readonly, mkfs):
+        pass
+
+    def umount(self):
+        pass
+
+    def ilistdir(self, path):
+        raise self.exc
+
+    def stat(self, path):
+        raise OSError(2)
+
+
+try:
+    bdev = RAMFS(50)
+except MemoryError:
+    print("SKIP")
+    raise SystemExit
+
+# first we umount any existing mount points the target may have
+try:
+    uos.umount('/')
+except OSError:
+    pass
+for path in uos.listdir('/'):
+    uos.umount('/' + path)
+
+uos.VfsFat.mkfs(bdev)
+uos.mount(bdev, '/fat')
+
+os.mkdir('/fat/a')
+os.mkdir('/fat/a/deep')
+os.mkdir('/fat/b')
+os.mkdir('/fat/skip')
+os.mkdir('/fat/skip/inner')
+with open('/fat/top.txt', 'w') as f:
+    f.write('x' * 10)
+with open('/fat/a/one.txt', 'w') as f:
+    f.write('y' * 100)
+with open('/fat/a/deep/two.txt', 'w') as f:
+    f.write('z')
+with open('/fat/skip/inner/hidden.txt', 'w') as f:
+    f.write('h')
+
+# scandir entries carry the name, path and type
+for e in sorted(os.scandir('/fat'), key=lambda e: e.name):
+    print(e.name, e.path, e.is_dir(), e.is_file())
+for e in os.scandir('/fat/a/'):
+    print(e.name, e.path)
+
+# stat() of an entry matches os.stat, including size and mtime
+for e in os.scandir('/fat/a'):
+    st = e.stat()
+    print(e.name, st[6], st == os.stat(e.path), st[8] == os.stat(e.path)[8])
+
+# the root lists mount points as directories
+for e in os.scandir('/'):
+    print(e.name, e.path, e.is_dir(), e.stat()[0] == os.stat(e.path)[0])
+
+# walk is top-down and skips the subdirectories removed from dirnames
+for dirpath, dirnames, filenames in os.walk('/fat'):
+    dirnames.sort()
+    print(dirpath, dirnames, sorted(filenames))
+    if 'skip' in dirnames:
+        dirnames.remove('skip')
+
+# directories that can't be listed are skipped
+uos.mount(BrokenFS(OSError(5)), '/broken')
+for dirpath, dirnames, filenames in os.walk('/'):
+    dirnames.sort()
+    print(dirpath, dirnames, sorted(filenames))
+    if 'fat' in dirnames:
+        dirnames.remove('fat')
+print(list(os.walk('/broken')))
+print(list(os.walk('/fat/missing')))
+uos.umount('/broken')
+
+# but other errors are raised
+uos.mount(BrokenFS(ValueError('bad')), '/broken')
+try:
+    list(os.walk('/broken'))
+except ValueError as e:
+    print('ValueError', e)
+uos.umount('/broken')
+
+uos.umount('/fat')
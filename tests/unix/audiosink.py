@@ -0,0 +1,128 @@
+# test playing audio samples through audiosink
+try:
+    import array
+    import uio
+    import ustruct
+    import audiocore
+    import audiofx
+    import audiomixer
+    import audiosink
+    import synthio
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def header(wave):
+    riff, riff_len, fmt = ustruct.unpack("<4sI8s", wave)
+    channels, rate, byte_rate, align, bits = ustruct.unpack("<HIIHH", wave[22:36])
+    data, data_len = ustruct.unpack("<4sI", wave[36:44])
+    print(riff, riff_len == len(wave) - 8, fmt, channels, rate, byte_rate, align, bits, data, data_len)
+
+
+def peak(wave, start=44):
+    return max(abs(s) for s in array.array("h", wave[start:]))
+
+
+samples = array.array("h", [0, 1000, -1000, 32767] * 64)
+sample = audiocore.RawSample(samples, sample_rate=8000)
+
+# play once into a wave file
+f = uio.BytesIO()
+with audiosink.AudioSink(f) as sink:
+    print(sink.playing)
+    sink.play(sample)
+    print(sink.playing)
+    print(sink.run())
+    print(sink.playing, sink.frames, sink.buffers)
+wave = f.getvalue()
+header(wave)
+print(array.array("h", wave[44:]) == samples)
+
+# 8 bit signed samples are stored unsigned in wave files
+f = uio.BytesIO()
+sink = audiosink.AudioSink(f)
+sink.play(audiocore.RawSample(array.array("b", [-128, -1, 0, 127]), sample_rate=8000))
+print(sink.run())
+sink.deinit()
+wave = f.getvalue()
+header(wave)
+print(wave[44:])
+
+# looping continues until stopped, audio is discarded without a file
+sink = audiosink.AudioSink()
+sink.play(sample, loop=True)
+print(sink.run(0.1) >= 800, sink.playing)
+sink.stop()
+print(sink.playing)
+sink.deinit()
+
+# mixer voice
+mixer = audiomixer.Mixer(voice_count=2, sample_rate=8000, channel_count=1,
+                         bits_per_sample=16, samples_signed=True)
+f = uio.BytesIO()
+sink = audiosink.AudioSink(f)
+sink.play(mixer, loop=True)
+mixer.voice[0].play(sample, loop=True)
+print(sink.run(0.25) >= 2000)
+sink.stop()
+print(peak(f.getvalue()) > 0)
+
+# gain halves the level
+f = uio.BytesIO()
+sink = audiosink.AudioSink(f)
+sink.play(audiofx.Gain(sample, 0.5))
+sink.run()
+sink.stop()
+print(peak(f.getvalue()) in (16383, 16384))
+
+# filtered sample plays to the end
+sink = audiosink.AudioSink()
+sink.play(audiofx.Biquad(sample, audiofx.Biquad.LOW_PASS, 1000))
+print(sink.run(), sink.playing)
+
+# short exponential ramps up from silence still reach full level every frame count
+flat = audiocore.RawSample(array.array("h", [16384] * 16), sample_rate=8000)
+for frames in range(1, 9):
+    gain = audiofx.Gain(flat, 0.0)
+    gain.ramp(1.0, frames / 8000, exponential=True)
+    f = uio.BytesIO()
+    sink = audiosink.AudioSink(f)
+    sink.play(gain)
+    sink.run()
+    sink.deinit()
+    print(frames, list(array.array("h", f.getvalue()[44:46 + 2 * frames])))
+
+# synthesizer voices
+synth = synthio.Synthesizer(voice_count=2, sample_rate=8000)
+f = uio.BytesIO()
+sink = audiosink.AudioSink(f)
+sink.play(synth)
+sink.run(0.1)
+print(peak(f.getvalue()) == 0)
+synth.voice[0].note_on(440, amplitude=0.5)
+start = len(f.getvalue())
+sink.run(0.1)
+print(peak(f.getvalue(), start) > 0)
+synth.voice[0].note_off()
+sink.deinit()
+
+# values that can't be played are rejected
+nan = float("nan")
+for f in (
+    lambda: audiofx.Gain(sample, nan),
+    lambda: audiofx.Gain(sample).ramp(0.5, nan),
+    lambda: audiofx.Biquad(sample, audiofx.Biquad.LOW_PASS, nan),
+    lambda: audiofx.Biquad(sample, audiofx.Biquad.LOW_PASS, 1000, q=nan),
+    lambda: audiofx.Envelope(sample, sustain_level=nan),
+    lambda: audiofx.Gain(sample, buffer_size=4),
+    lambda: audiofx.Biquad(sample, audiofx.Biquad.LOW_PASS, 1000, buffer_size=7),
+    lambda: audiofx.Envelope(sample, buffer_size=0),
+    lambda: synth.voice[0].note_on(nan),
+    lambda: synth.voice[0].note_on(440, amplitude=nan),
+):
+    try:
+        f()
+        print("no error")
+    except ValueError:
+        print("ValueError")
@@ -0,0 +1,65 @@
+# test read-only file mappings from uos.mmap
+try:
+    import uos
+    import gc
+    uos.mmap
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+path = "os_mmap_test.bin"
+with open(path, "wb") as f:
+    f.write(bytes(range(256)) * 4)
+
+# the mapping is the file contents
+m = uos.mmap(path)
+print(len(m))
+v = memoryview(m)
+print(len(v), v[0], v[255], v[1023])
+print(bytes(v[250:260]))
+print(bytes(m) == bytes(range(256)) * 4)
+
+# it can't be written to
+try:
+    v[0] = 1
+except TypeError:
+    print("TypeError")
+
+# closing stops new uses but views taken before stay readable
+m.close()
+print(len(m))
+try:
+    memoryview(m)
+except TypeError:
+    print("TypeError")
+print(v[255], bytes(v[1020:]))
+m.close()
+
+# views still read the file after the mapping object is collected
+m = None
+gc.collect()
+print(len(v), bytes(v[:4]), bytes(v[1020:]))
+v = None
+
+# including the memoryview(uos.mmap(path)) idiom, where nothing else holds the mapping
+v = memoryview(uos.mmap(path))
+gc.collect()
+print(bytes(v[250:260]))
+v = None
+
+# a mapping that was never used is released by close()
+with uos.mmap(path) as m:
+    print(len(m))
+print(len(m))
+
+# empty files give an empty buffer
+with open(path, "wb") as f:
+    pass
+with uos.mmap(path) as m:
+    print(len(m), bytes(m))
+
+uos.unlink(path)
+try:
+    uos.mmap(path)
+except OSError:
+    print("OSError")
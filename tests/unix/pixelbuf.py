@@ -0,0 +1,53 @@
+# test _pixelbuf bulk fills, gradients and gamma
+try:
+    import _pixelbuf
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# fills in GRB order
+buf = bytearray(12)
+pb = _pixelbuf.PixelBuf(4, buf, byteorder=_pixelbuf.GRB)
+pb.fill((1, 2, 3))
+print(buf)
+pb.fill_range(1, 3, 0x102030)
+print(buf)
+pb.fill_range(2, 2, (9, 9, 9))
+print(buf)
+
+# gradients run from the start color to the end color
+buf = bytearray(12)
+pb = _pixelbuf.PixelBuf(4, buf, byteorder=_pixelbuf.RGB)
+pb.gradient(0, 4, (0, 0, 0), (200, 100, 40))
+print(buf)
+pb.gradient(1, 2, (5, 6, 7), (255, 255, 255))
+print(buf)
+
+# gamma applies to the output buffer on show
+buf = bytearray(3)
+raw = bytearray(3)
+pb = _pixelbuf.PixelBuf(1, buf, byteorder=_pixelbuf.RGB, rawbuf=raw, gamma=2.0)
+pb[0] = (255, 128, 0)
+pb.show()
+print(pb.gamma, raw, buf)
+pb.gamma = 1.0
+pb.show()
+print(buf)
+
+# bad arguments are rejected
+for f in (
+    lambda: pb.fill_range(0, 2, 0),
+    lambda: pb.fill_range(1, 0, 0),
+    lambda: pb.gradient(-1, 1, 0, 0),
+    lambda: _pixelbuf.PixelBuf(1, bytearray(3), gamma=float("nan")),
+    lambda: _pixelbuf.PixelBuf(1, bytearray(3), gamma=float("inf")),
+    lambda: _pixelbuf.PixelBuf(1, bytearray(3), gamma=0),
+    lambda: setattr(pb, "gamma", float("nan")),
+    lambda: setattr(pb, "gamma", -1),
+):
+    try:
+        f()
+        print("no error")
+    except Exception as e:
+        print(type(e).__name__, e)
+print(pb.gamma)
@@ -0,0 +1,78 @@
+# test random.Random generators and the bulk fill functions
+try:
+    import array
+    import random
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# a seed gives the same sequence every time, independently of other generators
+r = random.Random(42)
+first = [r.getrandbits(32) for i in range(4)]
+r.seed(42)
+other = random.Random(7)
+other.random()
+print([r.getrandbits(32) for i in range(4)] == first)
+print(random.Random(42).getrandbits(32) == first[0])
+print(first)
+
+# the module functions share one generator and seed it the same way
+random.seed(42)
+print([random.getrandbits(32) for i in range(4)] == first)
+
+# ranges and choices stay within bounds
+r.seed(1)
+print(all(0 <= r.randrange(10) < 10 for i in range(100)))
+print(all(r.randrange(-5, 5, 5) in (-5, 0) for i in range(100)))
+print(all(1 <= r.randint(1, 3) <= 3 for i in range(100)))
+print(all(r.choice("abc") in "abc" for i in range(100)))
+print(all(2 <= r.uniform(2, 3) <= 3 for i in range(100)))
+
+# bulk fills are reproducible, stay in range and match drawing values one at a time
+r.seed(3)
+b = bytearray(8)
+r.fill_bytes(b)
+r.seed(3)
+b2 = bytearray(8)
+r.fill_bytes(b2)
+print(b == b2, b != bytearray(8))
+
+a = array.array("h", [0] * 100)
+r.fill_randrange(a, -3, 4)
+print(min(a) >= -3 and max(a) < 4, len(set(a)) == 7)
+a = array.array("B", [0] * 100)
+r.fill_randrange(a, 250, 256)
+print(min(a) >= 250)
+
+f = array.array("f", [0] * 100)
+r.fill_uniform(f, -1, 1)
+print(min(f) >= -1 and max(f) <= 1, min(f) < 0 < max(f))
+
+r.seed(9)
+a = array.array("I", [0] * 4)
+r.fill_randrange(a, 0, 1000)
+r.seed(9)
+print(list(a) == [r.randrange(1000) for i in range(4)])
+
+# bad arguments are rejected
+for f in (
+    lambda: r.getrandbits(0),
+    lambda: r.getrandbits(33),
+    lambda: r.randrange(0),
+    lambda: r.randrange(5, 5),
+    lambda: r.randrange(0, 10, 0),
+    lambda: r.randrange(0, 10, -1),
+    lambda: r.randint(3, 1),
+    lambda: r.choice([]),
+    lambda: r.fill_randrange(array.array("f", [0]), 0, 10),
+    lambda: r.fill_randrange(bytearray(1), 5, 5),
+    lambda: r.fill_randrange(bytearray(1), 0, 257),
+    lambda: r.fill_randrange(array.array("b", [0]), -129, 0),
+    lambda: r.fill_uniform(bytearray(1), 0, 1),
+    lambda: random.fill_uniform(array.array("h", [0]), 0, 1),
+):
+    try:
+        f()
+        print("no error")
+    except Exception as e:
+        print(type(e).__name__, e)
@@ -0,0 +1,28 @@
+# test importing source files, which the reader maps into memory
+try:
+    import uos
+    import sys
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+files = {
+    "reader_mmap_empty.py": "",
+    "reader_mmap_small.py": "x = 1\nprint('small', x)\n",
+    # spans several pages and has no trailing newline
+    "reader_mmap_large.py": "n = 0\n" + "n += 1\n" * 3000 + "print('large', n)",
+}
+for name, src in files.items():
+    with open(name, "w") as f:
+        f.write(src)
+
+sys.path.insert(0, "")
+try:
+    import reader_mmap_empty
+    import reader_mmap_small
+    import reader_mmap_large
+    print(reader_mmap_small.x, reader_mmap_large.n)
+finally:
+    sys.path.pop(0)
+    for name in files:
+        uos.unlink(name)
@@ -0,0 +1,41 @@
+# test storage.RAMBlockDevice as a block device and under a FAT filesystem
+try:
+    import storage
+
+    storage.RAMBlockDevice
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# sizes that can't be allocated or addressed are rejected
+for count in (0, -1, 1 << 23, 1 << 32):
+    try:
+        storage.RAMBlockDevice(count)
+        print("no error")
+    except (ValueError, OverflowError, MemoryError):
+        print("rejected")
+
+ram = storage.RAMBlockDevice(128)
+print(ram.ioctl(4, 0), ram.ioctl(5, 0))
+
+# raw block access, including past the end
+block = bytearray(range(256)) * 2
+print(ram.writeblocks(127, block))
+readback = bytearray(512)
+print(ram.readblocks(127, readback), readback == block)
+print(ram.writeblocks(128, block), ram.readblocks(127, bytearray(1024)))
+
+# a filesystem on it keeps its data across mounts
+storage.VfsFat.mkfs(ram)
+storage.mount(storage.VfsFat(ram), "/ramtest")
+with open("/ramtest/test.txt", "w") as f:
+    f.write("hello" * 200)
+with open("/ramtest/test.txt", "r") as f:
+    print(f.read() == "hello" * 200)
+storage.umount("/ramtest")
+
+storage.mount(storage.VfsFat(ram), "/ramtest")
+with open("/ramtest/test.txt", "r") as f:
+    print(f.read() == "hello" * 200)
+print(storage.getmount("/ramtest").ilistdir("/").__next__()[0])
+storage.umount("/ramtest")
@@ -0,0 +1,79 @@
+import argparse
+
+import struct
+import sys
+
+sys.path.append("bitmap_font")
+sys.path.append("../../tools/bitmap_font")
+
+from adafruit_bitmap_font import bitmap_font
+
+parser = argparse.ArgumentParser(description='Generate a fontio.BinaryFont from a BDF or PCF font.')
+parser.add_argument('--font', type=str,
+                    help='Font path', required=True)
+parser.add_argument('--characters', type=str,
+                    help='Characters to include. Defaults to visible ASCII.')
+parser.add_argument('--sample_file', type=argparse.FileType('r'),
+                    help='Text file whose characters are also included.')
+parser.add_argument('--kerning', type=argparse.FileType('r'),
+                    help='Text file with one "left right adjust" kerning pair per line.')
+parser.add_argument('--output', type=argparse.FileType('wb'), required=True)
+
+args = parser.parse_args()
+
+class BitmapStub:
+    def __init__(self, width, height, color_depth):
+        self.width = width
+        self.rows = [b''] * height
+
+    def _load_row(self, y, row):
+        self.rows[y] = bytes(row)
+
+f = bitmap_font.load_font(args.font, BitmapStub)
+
+characters = set(args.characters or bytes(range(0x20, 0x7f)).decode("utf-8"))
+if args.sample_file:
+    for line in args.sample_file:
+        characters.update(line.strip())
+
+f.load_glyphs(characters)
+
+font_width, font_height, font_dx, font_dy = f.get_bounding_box()
+# The top of a line is the top of the font's bounding box.
+line_top = font_height + font_dy
+
+glyphs = []
+data = bytearray()
+for c in sorted(characters):
+    codepoint = ord(c)
+    if codepoint > 0xffff:
+        raise RuntimeError("Codepoint outside the Basic Multilingual Plane: {:x}".format(codepoint))
+    g = f.get_glyph(codepoint)
+    if not g:
+        print("Font missing character:", c, codepoint)
+        continue
+    width, height, dx, dy = g["bounds"]
+    y_offset = line_top - (height + dy)
+    glyphs.append(struct.pack("<HBBbbBBI", codepoint, width, height, dx, y_offset,
+                              g["shift"][0], 0, len(data)))
+    row_bytes = (width + 7) // 8
+    for row in g["bitmap"].rows:
+        data.extend(row[:row_bytes].ljust(row_bytes, b'\0'))
+
+kerning = []
+if args.kerning:
+    for line in args.kerning:
+        if not line.strip() or line.startswith("#"):
+            continue
+        left, right, adjust = line.split()
+        kerning.append((ord(left), ord(right), int(adjust)))
+kerning.sort()
+
+out = args.output
+out.write(b"BFNT")
+out.write(struct.pack("<BBBBHH", font_height, line_top, font_width, 0, len(glyphs), len(kerning)))
+for glyph in glyphs:
+    out.write(glyph)
+for left, right, adjust in kerning:
+    out.write(struct.pack("<HHbB", left, right, adjust, 0))
+out.write(data)
@@ -63,6 +63,13 @@ for c in all_characters:
     if g["shift"][1] != 0:
         raise RuntimeError("y shift")
 
+# Keep the non-ASCII characters sorted by codepoint so the glyph lookup can binary search them.
+extra_characters = "".join(sorted(c for c in filtered_characters if c not in visible_ascii))
+for c in extra_characters:
+    if ord(c) > 0xffff:
+        raise RuntimeError("Codepoint outside the Basic Multilingual Plane: {:x}".format(ord(c)))
+filtered_characters = "".join(c for c in filtered_characters if c in visible_ascii) + extra_characters
+
 x, y, dx, dy = f.get_bounding_box()
 tile_x, tile_y = x - dx, y - dy
 total_bits = tile_x * len(all_characters)
@@ -83,11 +90,6 @@ for x, c in enumerate(filtered_characters):
                 b[overall_bit // 8] |= 1 << (7 - (overall_bit % 8))
 
 
-extra_characters = ""
-for c in filtered_characters:
-    if c not in visible_ascii:
-        extra_characters += c
-
 c_file = args.output_c_file
 
 c_file.write("""\
@@ -176,16 +178,30 @@ displayio_bitmap_t supervisor_terminal_font_bitmap = {{
 """.format(len(all_characters) * tile_x, tile_y, bytes_per_row / 4))
 
 
+codepoints = "NULL"
+if extra_characters:
+    c_file.write("""\
+const uint16_t supervisor_terminal_font_codepoints[{}] = {{
+""".format(len(extra_characters)))
+    for i, c in enumerate(extra_characters):
+        c_file.write("0x{:04x}, ".format(ord(c)))
+        if (i + 1) % 8 == 0:
+            c_file.write("\n")
+    c_file.write("""\
+};
+""")
+    codepoints = "supervisor_terminal_font_codepoints"
+
 c_file.write("""\
 const fontio_builtinfont_t supervisor_terminal_font = {{
     .base = {{.type = &fontio_builtinfont_type }},
     .bitmap = &supervisor_terminal_font_bitmap,
     .width = {},
     .height = {},
-    .unicode_characters = (const uint8_t*) "{}",
-    .unicode_characters_len = {}
+    .unicode_codepoints = {},
+    .unicode_codepoint_count = {}
 }};
-""".format(tile_x, tile_y, extra_characters, len(extra_characters.encode("utf-8"))))
+""".format(tile_x, tile_y, codepoints, len(extra_characters)))
 
 c_file.write("""\
 terminalio_terminal_obj_t supervisor_terminal = {